@@ -218,6 +218,91 @@ extern "C" {
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
+    /*!
+     @defgroup tsilencedetector tSilenceDetector
+     @ingroup analysis
+     @brief Block-level silence detector, for letting feedback objects drop to zero state once their input has gone quiet.
+     @details Feed it each input block. Once every sample has stayed below the threshold for the hold time, it reports silence; at that point clear the downstream filters, reverbs or waveguides (tOnePole_clear(), tSVF_clear(), tNReverb_clear(), tLivingString_clear(), tVoc_clear()) and output zeros instead of ticking them, until it stops reporting silence. Choose a hold time at least as long as the objects' tails.
+     @{
+     
+     @fn void    tSilenceDetector_init           (tSilenceDetector* const, Lfloat threshold, Lfloat holdTime, LEAF* const leaf)
+     @brief Initialize a tSilenceDetector to the default mempool of a LEAF instance.
+     @param detector A pointer to the tSilenceDetector to initialize.
+     @param threshold The absolute level at or below which a sample counts as silent.
+     @param holdTime How long the input must stay silent before silence is reported, in ms.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tSilenceDetector_initToPool     (tSilenceDetector* const, Lfloat threshold, Lfloat holdTime, tMempool* const)
+     @brief Initialize a tSilenceDetector to a specified mempool.
+     @param detector A pointer to the tSilenceDetector to initialize.
+     @param threshold The absolute level at or below which a sample counts as silent.
+     @param holdTime How long the input must stay silent before silence is reported, in ms.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tSilenceDetector_free           (tSilenceDetector* const)
+     @brief Free a tSilenceDetector from its mempool.
+     @param detector A pointer to the tSilenceDetector to free.
+     
+     @fn int     tSilenceDetector_tickBlock      (tSilenceDetector* const, const Lfloat* input, int size)
+     @brief Pass a block of input into the detector.
+     @param detector A pointer to the relevant tSilenceDetector.
+     @param input The input block.
+     @param size The number of samples in the block.
+     @return 1 if the input has been silent for at least the hold time, otherwise 0.
+     
+     @fn int     tSilenceDetector_isSilent       (tSilenceDetector* const)
+     @brief Get the result of the last tSilenceDetector_tickBlock().
+     @param detector A pointer to the relevant tSilenceDetector.
+     @return 1 if silent, otherwise 0.
+     
+     @fn void    tSilenceDetector_reset          (tSilenceDetector* const)
+     @brief Restart the hold time, so silence has to last a full hold time again before it is reported.
+     @param detector A pointer to the relevant tSilenceDetector.
+     
+     @fn void    tSilenceDetector_setThreshold   (tSilenceDetector* const, Lfloat threshold)
+     @brief Set the silence threshold.
+     @param detector A pointer to the relevant tSilenceDetector.
+     @param threshold The absolute level at or below which a sample counts as silent.
+     
+     @fn void    tSilenceDetector_setHoldTime    (tSilenceDetector* const, Lfloat holdTime)
+     @brief Set the hold time.
+     @param detector A pointer to the relevant tSilenceDetector.
+     @param holdTime The hold time in ms.
+     
+     @fn void    tSilenceDetector_setSampleRate  (tSilenceDetector* const, Lfloat sr)
+     @brief Set the sample rate used to convert the hold time to samples.
+     @param detector A pointer to the relevant tSilenceDetector.
+     @param sr The sample rate.
+     
+     @} */
+    
+    typedef struct _tSilenceDetector
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        Lfloat threshold;
+        Lfloat holdTime;
+        Lfloat sampleRate;
+        uint32_t holdSamples;
+        uint32_t silentSamples;
+        int silent;
+    } _tSilenceDetector;
+    
+    typedef _tSilenceDetector* tSilenceDetector;
+    
+    void    tSilenceDetector_init           (tSilenceDetector* const, Lfloat threshold, Lfloat holdTime, LEAF* const leaf);
+    void    tSilenceDetector_initToPool     (tSilenceDetector* const, Lfloat threshold, Lfloat holdTime, tMempool* const);
+    void    tSilenceDetector_free           (tSilenceDetector* const);
+    
+    int     tSilenceDetector_tickBlock      (tSilenceDetector* const, const Lfloat* input, int size);
+    int     tSilenceDetector_isSilent       (tSilenceDetector* const);
+    void    tSilenceDetector_reset          (tSilenceDetector* const);
+    void    tSilenceDetector_setThreshold   (tSilenceDetector* const, Lfloat threshold);
+    void    tSilenceDetector_setHoldTime    (tSilenceDetector* const, Lfloat holdTime);
+    void    tSilenceDetector_setSampleRate  (tSilenceDetector* const, Lfloat sr);
+    
+    // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
+    
     /*!
      @defgroup tenvpd tEnvPD
      @ingroup analysis
@@ -354,6 +439,7 @@ extern "C" {
     typedef struct _tAttackDetection
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat env;
         
         //Attack & Release times in msec
@@ -442,6 +528,12 @@ extern "C" {
      @brief
      @param snac A pointer to the relevant tSNAC.
      @return The periodic fidelity of the input
+     @fn void    tSNAC_setScratch    (tSNAC* const, Lfloat* processbuf, Lfloat* spectrumbuf)
+     @brief Use caller-owned FFT work buffers, so that several tSNAC analysed one after another can share them. Pass NULL for both to go back to private buffers.
+     @param snac A pointer to the relevant tSNAC.
+     @param processbuf A buffer of SNAC_FRAME_SIZE * 2 Lfloats.
+     @param spectrumbuf A buffer of SNAC_FRAME_SIZE / 2 Lfloats.
+     
      ￼￼￼
      @} */
     
@@ -459,6 +551,8 @@ extern "C" {
         Lfloat* processbuf;
         Lfloat* spectrumbuf;
         Lfloat* biasbuf;
+        Lfloat* fftScratch; // only allocated when LEAF_KERNEL_FFT_NEEDS_SCRATCH
+        int sharedScratch;
         uint16_t timeindex;
         uint16_t framesize;
         uint16_t overlap;
@@ -485,6 +579,7 @@ extern "C" {
     /*To get freq, perform SAMPLE_RATE/snac_getperiod() */
     Lfloat   tSNAC_getPeriod     (tSNAC *s);
     Lfloat   tSNAC_getFidelity   (tSNAC *s);
+    void    tSNAC_setScratch    (tSNAC* const, Lfloat* processbuf, Lfloat* spectrumbuf);
     
     /*!
      @defgroup tperioddetection tPeriodDetection
@@ -549,6 +644,11 @@ extern "C" {
      @brief
      @param detection A pointer to the relevant tPeriodDetection.
      @param tolerance
+     @fn void    tPeriodDetection_setAnalysisPhase   (tPeriodDetection* const, Lfloat phase)
+     @brief Offset the schedule of SNAC analyses, so detectors running side by side don't all analyse in the same block.
+     @param detection A pointer to the relevant tPeriodDetection.
+     @param phase The offset as a fraction of the analysis period, from 0.0 to 1.0.
+     
      ￼￼￼
      @} */
     
@@ -562,6 +662,7 @@ extern "C" {
     typedef struct _tPeriodDetection
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tEnvPD env;
         tSNAC snac;
@@ -611,6 +712,7 @@ extern "C" {
     void    tPeriodDetection_setFidelityThreshold(tPeriodDetection* const, Lfloat threshold);
     void    tPeriodDetection_setAlpha           (tPeriodDetection* const, Lfloat alpha);
     void    tPeriodDetection_setTolerance       (tPeriodDetection* const, Lfloat tolerance);
+    void    tPeriodDetection_setAnalysisPhase   (tPeriodDetection* const, Lfloat phase);
     void    tPeriodDetection_setSampleRate      (tPeriodDetection* const, Lfloat sr);
     
     //==============================================================================
@@ -649,7 +751,13 @@ extern "C" {
     {
         tMempool mempool;
         
-        tZeroCrossingInfo* _info;
+        // crossing records, stored by value in parallel rings of _size slots
+        Lfloat* _before_crossing;
+        Lfloat* _after_crossing;
+        Lfloat* _crossing_peak;
+        Lfloat* _crossing_width;
+        int* _leading_edge;
+        int* _trailing_edge;
         unsigned int _size;
         unsigned int _pos;
         unsigned int _mask;
@@ -683,20 +791,66 @@ extern "C" {
     Lfloat   tZeroCrossingCollector_getPeak(tZeroCrossingCollector* const zc);
     int     tZeroCrossingCollector_isReset(tZeroCrossingCollector* const zc);
     
-    tZeroCrossingInfo const tZeroCrossingCollector_getCrossing(tZeroCrossingCollector* const zc, int index);
-
     void    tZeroCrossingCollector_setHysteresis(tZeroCrossingCollector* const zc, Lfloat hysteresis);
     
+    // Crossings are visited by ring slot. tZeroCrossingCollector_getSlot gives the slot of crossing
+    // index (0 is the oldest, getNumEdges() - 1 the newest) and nextSlot / prevSlot step to the
+    // next newer / older crossing, so loops over the crossings read straight out of the rings.
+    static inline int tZeroCrossingCollector_getSlot(tZeroCrossingCollector* const zc, int index)
+    {
+        _tZeroCrossingCollector* z = *zc;
+        return (z->_pos + (z->_num_edges - 1) - index) & z->_mask;
+    }
+    
+    static inline int tZeroCrossingCollector_nextSlot(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (slot - 1) & (*zc)->_mask;
+    }
+    
+    static inline int tZeroCrossingCollector_prevSlot(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (slot + 1) & (*zc)->_mask;
+    }
+    
+    static inline int tZeroCrossingCollector_getLeadingEdge(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (*zc)->_leading_edge[slot];
+    }
+    
+    static inline int tZeroCrossingCollector_getTrailingEdge(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (*zc)->_trailing_edge[slot];
+    }
+    
+    static inline Lfloat tZeroCrossingCollector_getCrossingPeak(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (*zc)->_crossing_peak[slot];
+    }
+    
+    static inline Lfloat tZeroCrossingCollector_getCrossingWidth(tZeroCrossingCollector* const zc, int slot)
+    {
+        return (*zc)->_crossing_width[slot];
+    }
+    
+    static inline int tZeroCrossingCollector_getPeriod(tZeroCrossingCollector* const zc, int slot, int nextSlot)
+    {
+        _tZeroCrossingCollector* z = *zc;
+        return z->_leading_edge[nextSlot] - z->_leading_edge[slot];
+    }
+    
+    Lfloat   tZeroCrossingCollector_getFractionalPeriod(tZeroCrossingCollector* const zc, int slot, int nextSlot);
+    
     //==============================================================================
     
     typedef struct _tBitset
     {
         tMempool mempool;
         
+        unsigned int _num_bits;
         unsigned int _value_size;
         unsigned int _size;
         unsigned int _bit_size;
-        unsigned int* _bits;
+        uint64_t* _bits;
     } _tBitset;
     
     typedef _tBitset* tBitset;
@@ -706,7 +860,7 @@ extern "C" {
     void    tBitset_free    (tBitset* const bitset);
     
     int     tBitset_get     (tBitset* const bitset, int index);
-    unsigned int*   tBitset_getData   (tBitset* const bitset);
+    uint64_t*   tBitset_getData   (tBitset* const bitset);
     
     void    tBitset_set     (tBitset* const bitset, int index, unsigned int val);
     void    tBitset_setMultiple (tBitset* const bitset, int index, int n, unsigned int val);
@@ -717,12 +871,16 @@ extern "C" {
     
     //==============================================================================
     
+#define BACF_MAX_LAGS 8
+    
     typedef struct _tBACF
     {
         tMempool mempool;
         
         tBitset _bitset;
+        unsigned int _mid_bits;
         unsigned int _mid_array;
+        unsigned int _mid_tail;
     } _tBACF;
     
     typedef _tBACF* tBACF;
@@ -732,6 +890,7 @@ extern "C" {
     void    tBACF_free  (tBACF* const bacf);
     
     int     tBACF_getCorrelation    (tBACF* const bacf, int pos);
+    void    tBACF_getCorrelations   (tBACF* const bacf, const int* positions, int* counts, int numPositions);
     void    tBACF_set  (tBACF* const bacf, tBitset* const bitset);
     
     //==============================================================================
@@ -789,6 +948,11 @@ extern "C" {
      @param detector A pointer to the relevant tPeriodDetector.
      @param hysteresis The hysteresis in decibels. Defaults to -40db.
      
+     @fn void    tPeriodDetector_setAnalysisPhase    (tPeriodDetector* const detector, Lfloat phase)
+     @brief Offset the zero crossing window, so detectors running side by side don't all autocorrelate on the same sample.
+     @param detector A pointer to the relevant tPeriodDetector.
+     @param phase The offset as a fraction of half the window, from 0.0 to 1.0.
+     
      @} */
     
 #define PULSE_THRESHOLD 0.6f
@@ -829,6 +993,7 @@ extern "C" {
     typedef struct _tPeriodDetector
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tZeroCrossingCollector          _zc;
         _period_info            _fundamental;
@@ -870,6 +1035,7 @@ extern "C" {
 
     void    tPeriodDetector_setHysteresis   (tPeriodDetector* const detector, Lfloat hysteresis);
     void    tPeriodDetector_setSampleRate   (tPeriodDetector* const detector, Lfloat sr);
+    void    tPeriodDetector_setAnalysisPhase    (tPeriodDetector* const detector, Lfloat phase);
     
     //==============================================================================
     
@@ -941,6 +1107,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tPeriodDetector _pd;
         _pitch_info _current;
@@ -1031,12 +1198,18 @@ extern "C" {
      @brief Set the threshold for periodicity of a signal to be considered as pitched.
      @param detector A pointer to the relevant tDualPitchDetector.
      @param threshold The periodicity threshold from 0.0 to 1.0 with 1.0 being perfectly periodic.
+     @fn void    tDualPitchDetector_setAnalysisPhase    (tDualPitchDetector* const detector, Lfloat phase)
+     @brief Offset the analysis schedules of both detection algorithms.
+     @param detector A pointer to the relevant tDualPitchDetector.
+     @param phase The offset as a fraction of each algorithm's analysis period, from 0.0 to 1.0.
+     
      ￼￼￼
      @} */
 
     typedef struct _tDualPitchDetector
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tPeriodDetection _pd1;
         tPitchDetector _pd2;
@@ -1067,6 +1240,124 @@ extern "C" {
     void    tDualPitchDetector_setHysteresis    (tDualPitchDetector* const detector, Lfloat hysteresis);
     void    tDualPitchDetector_setPeriodicityThreshold (tDualPitchDetector* const detector, Lfloat thresh);
     void    tDualPitchDetector_setSampleRate    (tDualPitchDetector* const detector, Lfloat sr);
+    void    tDualPitchDetector_setAnalysisPhase    (tDualPitchDetector* const detector, Lfloat phase);
+    
+    //==============================================================================
+    
+    /*!
+     @defgroup tpitchtrackerbank tPitchTrackerBank
+     @ingroup analysis
+     @brief A bank of tDualPitchDetectors for several inputs, sharing FFT scratch and spreading their analyses evenly over time.
+     @{
+     
+     @fn void tPitchTrackerBank_init (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, LEAF* const leaf)
+     @brief Initialize a tPitchTrackerBank to the default mempool of a LEAF instance.
+     @param bank A pointer to the tPitchTrackerBank to initialize.
+     @param numChannels The number of inputs to track.
+     @param lowestFreq The lowest frequency to detect.
+     @param highestFreq The highest frequency to detect.
+     @param bufSize Size of the input buffer allocated for each channel, as passed to tDualPitchDetector.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void tPitchTrackerBank_initToPool (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, tMempool* const mempool)
+     @brief Initialize a tPitchTrackerBank to a specified mempool.
+     @param bank A pointer to the tPitchTrackerBank to initialize.
+     @param numChannels The number of inputs to track.
+     @param lowestFreq The lowest frequency to detect.
+     @param highestFreq The highest frequency to detect.
+     @param bufSize Size of the input buffer allocated for each channel.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPitchTrackerBank_free (tPitchTrackerBank* const bank)
+     @brief Free a tPitchTrackerBank from its mempool.
+     @param bank A pointer to the tPitchTrackerBank to free.
+     
+     @fn int     tPitchTrackerBank_tick    (tPitchTrackerBank* const bank, Lfloat* samples)
+     @brief Track one sample of every channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param samples One sample for each channel.
+     @return The number of channels that completed an analysis.
+     
+     @fn int     tPitchTrackerBank_tickBlock    (tPitchTrackerBank* const bank, Lfloat** inputs, int size)
+     @brief Track a block of every channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param inputs One buffer of size samples for each channel.
+     @param size The number of samples in each buffer.
+     @return The number of analyses completed across all channels.
+     
+     @fn Lfloat   tPitchTrackerBank_getFrequency    (tPitchTrackerBank* const bank, int channel)
+     @brief Get the last published frequency of a channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param channel The channel index.
+     @return The detected frequency in Hz.
+     
+     @fn Lfloat   tPitchTrackerBank_getPeriodicity    (tPitchTrackerBank* const bank, int channel)
+     @brief Get the last published periodicity of a channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param channel The channel index.
+     @return The periodicity from 0.0 to 1.0.
+     
+     @fn Lfloat*  tPitchTrackerBank_getFrequencies    (tPitchTrackerBank* const bank)
+     @brief Get the published frequencies of all channels.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @return An array of numChannels frequencies in Hz.
+     
+     @fn Lfloat*  tPitchTrackerBank_getPeriodicities    (tPitchTrackerBank* const bank)
+     @brief Get the published periodicities of all channels.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @return An array of numChannels periodicities.
+     
+     @fn void    tPitchTrackerBank_setHysteresis    (tPitchTrackerBank* const bank, Lfloat hysteresis)
+     @brief Set the hysteresis used in zero crossing detection on every channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param hysteresis The hysteresis in decibels.
+     
+     @fn void    tPitchTrackerBank_setPeriodicityThreshold    (tPitchTrackerBank* const bank, Lfloat thresh)
+     @brief Set the periodicity threshold on every channel.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param thresh The periodicity threshold from 0.0 to 1.0.
+     
+     @fn void    tPitchTrackerBank_setSampleRate    (tPitchTrackerBank* const bank, Lfloat sr)
+     @brief Set the sample rate of every channel, keeping their analyses staggered.
+     @param bank A pointer to the relevant tPitchTrackerBank.
+     @param sr The new sample rate.
+     
+     @} */
+    
+    typedef struct _tPitchTrackerBank
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        
+        int numChannels;
+        int bufSize;
+        tDualPitchDetector* detectors;
+        Lfloat** buffers;
+        
+        // FFT work buffers shared by every channel's tSNAC
+        Lfloat* processbuf;
+        Lfloat* spectrumbuf;
+        
+        Lfloat* frequencies;
+        Lfloat* periodicities;
+    } _tPitchTrackerBank;
+    
+    typedef _tPitchTrackerBank* tPitchTrackerBank;
+    
+    void    tPitchTrackerBank_init  (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, LEAF* const leaf);
+    void    tPitchTrackerBank_initToPool    (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, tMempool* const mempool);
+    void    tPitchTrackerBank_free  (tPitchTrackerBank* const bank);
+    
+    int     tPitchTrackerBank_tick  (tPitchTrackerBank* const bank, Lfloat* samples);
+    int     tPitchTrackerBank_tickBlock (tPitchTrackerBank* const bank, Lfloat** inputs, int size);
+    Lfloat   tPitchTrackerBank_getFrequency  (tPitchTrackerBank* const bank, int channel);
+    Lfloat   tPitchTrackerBank_getPeriodicity    (tPitchTrackerBank* const bank, int channel);
+    Lfloat*  tPitchTrackerBank_getFrequencies    (tPitchTrackerBank* const bank);
+    Lfloat*  tPitchTrackerBank_getPeriodicities  (tPitchTrackerBank* const bank);
+    
+    void    tPitchTrackerBank_setHysteresis (tPitchTrackerBank* const bank, Lfloat hysteresis);
+    void    tPitchTrackerBank_setPeriodicityThreshold   (tPitchTrackerBank* const bank, Lfloat thresh);
+    void    tPitchTrackerBank_setSampleRate (tPitchTrackerBank* const bank, Lfloat sr);
     
 #ifdef __cplusplus
 }
@@ -106,6 +106,7 @@ extern "C" {
     typedef struct _tDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat* buff;
@@ -224,6 +225,7 @@ extern "C" {
     typedef struct _tLinearDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat* buff;
@@ -368,6 +370,7 @@ extern "C" {
     typedef struct _tHermiteDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat* buff;
         uint32_t bufferMask;
@@ -504,6 +507,7 @@ extern "C" {
     typedef struct _tLagrangeDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
 
         Lfloat* buff;
         uint32_t bufferMask;
@@ -621,6 +625,7 @@ extern "C" {
     typedef struct _tAllpassDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat* buff;
@@ -739,6 +744,7 @@ extern "C" {
     typedef struct _tTapeDelay
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat* buff;
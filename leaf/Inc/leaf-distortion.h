@@ -130,6 +130,7 @@ extern "C" {
         uint32_t ratio;
         uint32_t offset;
         Lfloat* pCoeffs;
+        Lfloat* phaseCoeffs; // pCoeffs split into one contiguous run per upsampling phase, scaled by ratio
         Lfloat* upState;
         Lfloat* downState;
         uint32_t numTaps;
@@ -61,6 +61,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat tauAttack, tauRelease;
         Lfloat T, R, W, M; // Threshold, compression Ratio, decibel Width of knee transition, decibel Make-up gain
@@ -94,6 +95,112 @@ extern "C" {
     void tCompressor_setTables(tCompressor* const comp, Lfloat* atodb, Lfloat* dbtoa, Lfloat atodbMinIn, Lfloat atodbMaxIn, Lfloat dbtoaMinIn, Lfloat dbtoaMaxIn, int atodbTableSize, int dbtoaTableSize);
     void    tCompressor_setParams   (tCompressor* const comp, Lfloat thresh, Lfloat ratio, Lfloat knee, Lfloat makeup, Lfloat attack, Lfloat release);
     void tCompressor_setSampleRate(tCompressor* const comp, Lfloat sampleRate);
+    void tCompressor_tickBlockWithTable(tCompressor* const comp, Lfloat* in, Lfloat* out, int size);
+    
+    //==============================================================================
+    
+    /*!
+     @defgroup tmultibandcompressor tMultibandCompressor
+     @ingroup dynamics
+     @brief Multiband compressor with phase-coherent Linkwitz-Riley crossovers.
+     @details Splits the input into 2 to 4 bands with 4th order Linkwitz-Riley crossovers arranged as a tree. Lower bands are passed through allpass sections matching the higher crossovers so that the bands sum back flat in magnitude and phase. Crossover filters are run a whole block at a time, and each band is compressed with tCompressor's table-based gain computer.
+     @{
+     
+     @fn void    tMultibandCompressor_init           (tMultibandCompressor* const, int numBands, int maxBlockSize, LEAF* const leaf)
+     @brief Initialize a tMultibandCompressor to the default mempool of a LEAF instance.
+     @param compressor A pointer to the tMultibandCompressor to initialize.
+     @param numBands The number of bands, from 2 to MULTIBAND_MAX_BANDS.
+     @param maxBlockSize The largest block that will be processed at once. Larger blocks are split internally.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tMultibandCompressor_initToPool     (tMultibandCompressor* const, int numBands, int maxBlockSize, tMempool* const)
+     @brief Initialize a tMultibandCompressor to a specified mempool.
+     @param compressor A pointer to the tMultibandCompressor to initialize.
+     @param numBands The number of bands, from 2 to MULTIBAND_MAX_BANDS.
+     @param maxBlockSize The largest block that will be processed at once. Larger blocks are split internally.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tMultibandCompressor_free           (tMultibandCompressor* const)
+     @brief Free a tMultibandCompressor from its mempool.
+     @param compressor A pointer to the tMultibandCompressor to free.
+     
+     @fn Lfloat   tMultibandCompressor_tick           (tMultibandCompressor* const, Lfloat input)
+     @brief Process a single sample. Prefer tMultibandCompressor_tickBlock() where possible.
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param input The input sample.
+     @return The compressed output sample.
+     
+     @fn void    tMultibandCompressor_tickBlock      (tMultibandCompressor* const, Lfloat* in, Lfloat* out, int size)
+     @brief Process a block of samples. In and out may point to the same buffer.
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param in The input block.
+     @param out The output block.
+     @param size The number of samples in the block.
+     
+     @fn void    tMultibandCompressor_setCrossover   (tMultibandCompressor* const, int which, Lfloat freq)
+     @brief Set the frequency of a crossover. Crossovers should be kept in ascending order.
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param which The index of the crossover, from 0 to numBands - 2.
+     @param freq The crossover frequency in Hz.
+     
+     @fn void    tMultibandCompressor_setBandParams  (tMultibandCompressor* const, int band, Lfloat thresh, Lfloat ratio, Lfloat knee, Lfloat makeup, Lfloat attack, Lfloat release)
+     @brief Set the compressor parameters of a band. See tCompressor_setParams().
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param band The index of the band, from 0 (lowest) to numBands - 1.
+     
+     @fn tCompressor* tMultibandCompressor_getBand     (tMultibandCompressor* const, int band)
+     @brief Get the tCompressor used for a band.
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param band The index of the band, from 0 (lowest) to numBands - 1.
+     
+     @fn void    tMultibandCompressor_setSampleRate  (tMultibandCompressor* const, Lfloat sampleRate)
+     @brief Set the sample rate and recompute the crossover coefficients.
+     @param compressor A pointer to the relevant tMultibandCompressor.
+     @param sampleRate The new sample rate.
+     
+     @} */
+    
+#define MULTIBAND_MAX_BANDS 4
+#define MULTIBAND_TABLE_SIZE 2048
+    
+    typedef struct _tMultibandCompressor
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        
+        int numBands;
+        int maxBlockSize;
+        Lfloat sampleRate;
+        
+        Lfloat freqs[MULTIBAND_MAX_BANDS-1];
+        
+        // Butterworth sections shared by the LR4 lowpass, highpass, and compensating allpass of each crossover
+        Lfloat lpB0[MULTIBAND_MAX_BANDS-1], hpB0[MULTIBAND_MAX_BANDS-1];
+        Lfloat a1[MULTIBAND_MAX_BANDS-1], a2[MULTIBAND_MAX_BANDS-1];
+        
+        // transposed direct form II state, [crossover][lp1, hp1, lp2, hp2]
+        Lfloat z1[MULTIBAND_MAX_BANDS-1][4], z2[MULTIBAND_MAX_BANDS-1][4];
+        // allpass state, [band][crossover]
+        Lfloat apz1[MULTIBAND_MAX_BANDS][MULTIBAND_MAX_BANDS-1], apz2[MULTIBAND_MAX_BANDS][MULTIBAND_MAX_BANDS-1];
+        
+        tCompressor comps[MULTIBAND_MAX_BANDS];
+        Lfloat* atodbTable;
+        Lfloat* dbtoaTable;
+        Lfloat* bands[MULTIBAND_MAX_BANDS];
+    } _tMultibandCompressor;
+    
+    typedef _tMultibandCompressor* tMultibandCompressor;
+    
+    void    tMultibandCompressor_init           (tMultibandCompressor* const, int numBands, int maxBlockSize, LEAF* const leaf);
+    void    tMultibandCompressor_initToPool     (tMultibandCompressor* const, int numBands, int maxBlockSize, tMempool* const);
+    void    tMultibandCompressor_free           (tMultibandCompressor* const);
+    
+    Lfloat   tMultibandCompressor_tick           (tMultibandCompressor* const, Lfloat input);
+    void    tMultibandCompressor_tickBlock      (tMultibandCompressor* const, Lfloat* in, Lfloat* out, int size);
+    void    tMultibandCompressor_setCrossover   (tMultibandCompressor* const, int which, Lfloat freq);
+    void    tMultibandCompressor_setBandParams  (tMultibandCompressor* const, int band, Lfloat thresh, Lfloat ratio, Lfloat knee, Lfloat makeup, Lfloat attack, Lfloat release);
+    tCompressor* tMultibandCompressor_getBand     (tMultibandCompressor* const, int band);
+    void    tMultibandCompressor_setSampleRate  (tMultibandCompressor* const, Lfloat sampleRate);
     
     /*!
      @defgroup tfeedbackleveler tFeedbackLeveler
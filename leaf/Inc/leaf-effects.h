@@ -96,6 +96,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat param[NUM_TALKBOX_PARAM];
         
@@ -215,6 +216,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat param[NUM_TALKBOX_PARAM];
         
@@ -303,6 +305,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat param[NUM_VOCODER_PARAM];
         
@@ -381,6 +384,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat phase;
         Lfloat openLength;
         Lfloat pulseLength;
@@ -460,6 +464,7 @@ extern "C" {
     typedef struct _tSOLAD
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tAttackDetection ad;
         tHighpass hp;
@@ -537,6 +542,7 @@ extern "C" {
     typedef struct _tPitchShift
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         _tDualPitchDetector* pd;
         tSOLAD sola;
@@ -563,6 +569,146 @@ extern "C" {
     void    tPitchShift_setPickiness (tPitchShift* const, Lfloat p);
     void    tPitchShift_setSampleRate(tPitchShift* const, Lfloat sr);
     
+    /*!
+     @defgroup tphasevocoder tPhaseVocoder
+     @ingroup effects
+     @brief STFT phase vocoder for polyphonic pitch shifting and time stretching, with identity phase locking.
+     @{
+     
+     @fn void    tPhaseVocoder_init          (tPhaseVocoder* const, int frameSize, int overlap, LEAF* const leaf)
+     @brief Initialize a tPhaseVocoder to the default mempool of a LEAF instance.
+     @param vocoder A pointer to the tPhaseVocoder to initialize.
+     @param frameSize The FFT frame size in samples. Must be a power of two.
+     @param overlap The number of overlapping frames. Must be a power of two of at least 4. The hop size is frameSize / overlap.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tPhaseVocoder_initToPool    (tPhaseVocoder* const, int frameSize, int overlap, tMempool* const)
+     @brief Initialize a tPhaseVocoder to a specified mempool.
+     @param vocoder A pointer to the tPhaseVocoder to initialize.
+     @param frameSize The FFT frame size in samples. Must be a power of two.
+     @param overlap The number of overlapping frames. Must be a power of two of at least 4.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPhaseVocoder_free          (tPhaseVocoder* const)
+     @brief Free a tPhaseVocoder from its mempool.
+     @param vocoder A pointer to the tPhaseVocoder to free.
+     
+     @fn Lfloat   tPhaseVocoder_tick          (tPhaseVocoder* const, Lfloat input)
+     @brief Pitch shift one sample of a live input stream.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param input The input sample.
+     @return The shifted output, delayed by tPhaseVocoder_getLatency() samples.
+     
+     @fn void    tPhaseVocoder_tickBlock     (tPhaseVocoder* const, Lfloat* in, Lfloat* out, int size)
+     @brief Pitch shift a block of a live input stream. Blocks can be any size and need not line up with the hop size.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param in The input block.
+     @param out The output block. May be the same as the input block.
+     @param size The number of samples in the block.
+     
+     @fn void    tPhaseVocoder_stretchBlock  (tPhaseVocoder* const, Lfloat* source, int length, Lfloat* out, int size)
+     @brief Render a block from a stored source, advancing through it at 1/stretch of the output rate. The source is read from the current position and silence is read outside of it.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param source The source samples.
+     @param length The number of samples in the source.
+     @param out The output block.
+     @param size The number of samples to render.
+     
+     @fn void    tPhaseVocoder_setPitch      (tPhaseVocoder* const, Lfloat ratio)
+     @brief Set the pitch ratio, clipped to 0.25 - 4.0.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param ratio The pitch ratio. 2.0 is an octave up.
+     
+     @fn void    tPhaseVocoder_setStretch    (tPhaseVocoder* const, Lfloat stretch)
+     @brief Set the time stretch used by tPhaseVocoder_stretchBlock(), clipped to 0.1 - 10.0. Live input is never stretched.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param stretch The stretch factor. 2.0 plays the source at half speed.
+     
+     @fn void    tPhaseVocoder_setPhaseLocking (tPhaseVocoder* const, int lock)
+     @brief Turn identity phase locking around spectral peaks on or off. On by default.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param lock 1 to lock the phases of each peak's region to the peak, 0 to advance every bin independently.
+     
+     @fn void    tPhaseVocoder_setPosition   (tPhaseVocoder* const, Lfloat position)
+     @brief Move the source read position used by tPhaseVocoder_stretchBlock() and clear the vocoder state.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     @param position The start of the next analysis frame in source samples.
+     
+     @fn Lfloat   tPhaseVocoder_getPosition   (tPhaseVocoder* const)
+     @brief Get the start of the next analysis frame in source samples.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     
+     @fn int     tPhaseVocoder_getLatency    (tPhaseVocoder* const)
+     @brief Get the delay in samples between live input and output at unity pitch.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     
+     @fn void    tPhaseVocoder_clear         (tPhaseVocoder* const)
+     @brief Clear the input, output and phase state.
+     @param vocoder A pointer to the relevant tPhaseVocoder.
+     
+     @} */
+    
+    typedef struct _tPhaseVocoder
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        
+        int frameSize;
+        int overlap;
+        int hopSize;
+        int numBins;
+        
+        Lfloat* window;
+        Lfloat* frame;
+        Lfloat* magnitude;
+        Lfloat* phase;
+        Lfloat* lastPhase;
+        Lfloat* synthPhase;
+        int* peaks;
+        Lfloat* ola;
+        Lfloat norm;
+        
+        // live input ring, indexed by absolute sample count
+        Lfloat* input;
+        uint32_t inputMask;
+        uint32_t inputWrite;
+        
+        // start of the next analysis frame, in input or source samples
+        uint32_t analysisPos;
+        Lfloat analysisFrac;
+        int analysisHop;
+        
+        // synthesized signal waiting to be resampled by the pitch ratio
+        Lfloat* output;
+        uint32_t outputMask;
+        uint32_t outputWrite;
+        uint32_t outputRead;
+        Lfloat outputFrac;
+        
+        int primed;
+        int firstFrame;
+        int phaseLocking;
+        Lfloat pitch;
+        Lfloat stretch;
+    } _tPhaseVocoder;
+    
+    typedef _tPhaseVocoder* tPhaseVocoder;
+    
+    void    tPhaseVocoder_init          (tPhaseVocoder* const, int frameSize, int overlap, LEAF* const leaf);
+    void    tPhaseVocoder_initToPool    (tPhaseVocoder* const, int frameSize, int overlap, tMempool* const);
+    void    tPhaseVocoder_free          (tPhaseVocoder* const);
+    
+    Lfloat   tPhaseVocoder_tick          (tPhaseVocoder* const, Lfloat input);
+    void    tPhaseVocoder_tickBlock     (tPhaseVocoder* const, Lfloat* in, Lfloat* out, int size);
+    void    tPhaseVocoder_stretchBlock  (tPhaseVocoder* const, Lfloat* source, int length, Lfloat* out, int size);
+    void    tPhaseVocoder_setPitch      (tPhaseVocoder* const, Lfloat ratio);
+    void    tPhaseVocoder_setStretch    (tPhaseVocoder* const, Lfloat stretch);
+    void    tPhaseVocoder_setPhaseLocking (tPhaseVocoder* const, int lock);
+    void    tPhaseVocoder_setPosition   (tPhaseVocoder* const, Lfloat position);
+    Lfloat   tPhaseVocoder_getPosition   (tPhaseVocoder* const);
+    int     tPhaseVocoder_getLatency    (tPhaseVocoder* const);
+    void    tPhaseVocoder_clear         (tPhaseVocoder* const);
+    
     /*!
      @defgroup tsimpleretune tSimpleRetune
      @ingroup effects
@@ -604,6 +750,7 @@ extern "C" {
     typedef struct _tSimpleRetune
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tDualPitchDetector dp;
         Lfloat minInputFreq, maxInputFreq;
@@ -678,6 +825,7 @@ extern "C" {
     typedef struct _tRetune
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tDualPitchDetector dp;
         Lfloat minInputFreq, maxInputFreq;
@@ -765,6 +913,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         int ford;
         Lfloat falph;
         Lfloat flamb;
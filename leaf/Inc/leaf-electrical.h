@@ -112,6 +112,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         WDFComponentType type;
         Lfloat port_resistance_up;
         Lfloat port_resistance_left;
@@ -164,6 +164,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat factor, oneminusfactor;
         Lfloat curr,dest;
         //Lfloat invSampleRate;
@@ -251,6 +252,17 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSR.
      
+     @fn void    tADSR_tickBlock     (tADSR* const, Lfloat* out, int size)
+     @brief Render a block of envelope gains. Each stage is run as its own loop rather than branching on the stage every sample, and an idle envelope is filled with silence without ticking.
+     @param adsr A pointer to the relevant tADSR.
+     @param out The buffer to write the gains to.
+     @param size The number of samples to render.
+     
+     @fn int     tADSR_isIdle        (tADSR* const)
+     @brief Check whether the envelope has finished its release (or was never started), so a voice engine can skip rendering the voice.
+     @param adsr A pointer to the relevant tADSR.
+     @return 1 if the envelope is idle, 0 otherwise.
+     
      @} */
     
     /* ADSR */
@@ -258,6 +270,7 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         const Lfloat *exp_buff;
         const Lfloat *inc_buff;
@@ -287,6 +300,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSR_free          (tADSR* const);
     
     Lfloat   tADSR_tick          (tADSR* const);
+    void    tADSR_tickBlock     (tADSR* const, Lfloat* out, int size);
+    int     tADSR_isIdle        (tADSR* const);
     void    tADSR_setAttack     (tADSR* const, Lfloat attack);
     void    tADSR_setDecay      (tADSR* const, Lfloat decay);
     void    tADSR_setSustain    (tADSR* const, Lfloat sustain);
@@ -354,6 +369,17 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSRT.
      
+     @fn void    tADSRT_tickBlock     (tADSRT* const, Lfloat* out, int size)
+     @brief Render a block of envelope gains. Each stage is run as its own loop rather than branching on the stage every sample, and an idle envelope is filled with silence without ticking.
+     @param adsr A pointer to the relevant tADSRT.
+     @param out The buffer to write the gains to.
+     @param size The number of samples to render.
+     
+     @fn int     tADSRT_isIdle        (tADSRT* const)
+     @brief Check whether the envelope has finished its release (or was never started), so a voice engine can skip rendering the voice.
+     @param adsr A pointer to the relevant tADSRT.
+     @return 1 if the envelope is idle, 0 otherwise.
+     
      @} */
     
     typedef struct _tADSRT
@@ -390,6 +416,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     
     Lfloat   tADSRT_tick          (tADSRT* const);
     Lfloat   tADSRT_tickNoInterp  (tADSRT* const adsrenv);
+    void    tADSRT_tickBlock     (tADSRT* const, Lfloat* out, int size);
+    int     tADSRT_isIdle        (tADSRT* const);
     void    tADSRT_setAttack     (tADSRT* const, Lfloat attack);
     void    tADSRT_setDecay      (tADSRT* const, Lfloat decay);
     void    tADSRT_setSustain    (tADSRT* const, Lfloat sustain);
@@ -454,6 +482,17 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSRS.
      
+     @fn void    tADSRS_tickBlock     (tADSRS* const, Lfloat* out, int size)
+     @brief Render a block of envelope gains. Each stage is run as its own loop rather than branching on the stage every sample, and an idle envelope is filled with silence without ticking.
+     @param adsr A pointer to the relevant tADSRS.
+     @param out The buffer to write the gains to.
+     @param size The number of samples to render.
+     
+     @fn int     tADSRS_isIdle        (tADSRS* const)
+     @brief Check whether the envelope has finished its release (or was never started), so a voice engine can skip rendering the voice.
+     @param adsr A pointer to the relevant tADSRS.
+     @return 1 if the envelope is idle, 0 otherwise.
+     
      @} */
     
     enum envState {
@@ -469,6 +508,7 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat sampleRate;
         Lfloat sampleRateInMs;
         int state;
@@ -503,6 +543,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSRS_free          (tADSRS* const);
     
     Lfloat   tADSRS_tick          (tADSRS* const);
+    void    tADSRS_tickBlock     (tADSRS* const, Lfloat* out, int size);
+    int     tADSRS_isIdle        (tADSRS* const);
     void    tADSRS_setAttack     (tADSRS* const, Lfloat attack);
     void    tADSRS_setDecay      (tADSRS* const, Lfloat decay);
     void    tADSRS_setSustain    (tADSRS* const, Lfloat sustain);
@@ -512,6 +554,89 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSRS_off           (tADSRS* const);
     void    tADSRS_setSampleRate (tADSRS* const, Lfloat sr);
     
+#ifdef SIMD_64
+    // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
+    
+    /*!
+     @defgroup tpolyadsrs tPolyADSRS
+     @ingroup envelopes
+     @brief tADSRS running POLY_FLOAT_LANES voices at once. The times and sustain level are shared; each voice is triggered and released on its own. Only available when SIMD_64 is defined.
+     @{
+     
+     @fn void    tPolyADSRS_init          (tPolyADSRS* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf)
+     @brief Initialize a tPolyADSRS to the default mempool of a LEAF instance.
+     @param adsr A pointer to the tPolyADSRS to initialize.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tPolyADSRS_initToPool    (tPolyADSRS* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool* const)
+     @brief Initialize a tPolyADSRS to a specified mempool.
+     @param adsr A pointer to the tPolyADSRS to initialize.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPolyADSRS_free          (tPolyADSRS* const)
+     @brief Free a tPolyADSRS from its mempool.
+     @param adsr A pointer to the tPolyADSRS to free.
+     
+     @fn poly_float tPolyADSRS_tick        (tPolyADSRS* const)
+     @brief Tick every voice.
+     @param adsr A pointer to the relevant tPolyADSRS.
+     @return The envelope of each voice, one per lane.
+     
+     @fn void    tPolyADSRS_on            (tPolyADSRS* const, int voice, Lfloat velocity)
+     @brief Start one voice's envelope.
+     @param adsr A pointer to the relevant tPolyADSRS.
+     @param voice The lane of the voice.
+     
+     @fn void    tPolyADSRS_off           (tPolyADSRS* const, int voice)
+     @brief Release one voice's envelope.
+     @param adsr A pointer to the relevant tPolyADSRS.
+     @param voice The lane of the voice.
+     
+     @fn int     tPolyADSRS_isIdle        (tPolyADSRS* const, int voice)
+     @brief Check whether one voice's envelope has finished.
+     @param adsr A pointer to the relevant tPolyADSRS.
+     @param voice The lane of the voice.
+     
+     @} */
+    
+    typedef struct _tPolyADSRS
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        Lfloat sampleRate;
+        Lfloat sampleRateInMs;
+        Lfloat invSampleRate;
+        Lfloat attack, decay, release;
+        Lfloat attackCoef, decayCoef, releaseCoef;
+        Lfloat attackBase, decayBase, releaseBase;
+        Lfloat sustainLevel;
+        Lfloat targetRatioA, targetRatioDR;
+        Lfloat baseLeakFactor, leakFactor;
+        Lfloat factor, oneMinusFactor;
+        Lfloat state[POLY_FLOAT_LANES]; // envState per voice, kept as floats for lane compares
+        Lfloat output[POLY_FLOAT_LANES];
+        Lfloat gain[POLY_FLOAT_LANES];
+        Lfloat targetGainSquared[POLY_FLOAT_LANES];
+    } _tPolyADSRS;
+    
+    typedef _tPolyADSRS* tPolyADSRS;
+    
+    void    tPolyADSRS_init          (tPolyADSRS* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf);
+    void    tPolyADSRS_initToPool    (tPolyADSRS* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool* const);
+    void    tPolyADSRS_free          (tPolyADSRS* const);
+    
+    poly_float tPolyADSRS_tick        (tPolyADSRS* const);
+    void    tPolyADSRS_setAttack     (tPolyADSRS* const, Lfloat attack);
+    void    tPolyADSRS_setDecay      (tPolyADSRS* const, Lfloat decay);
+    void    tPolyADSRS_setSustain    (tPolyADSRS* const, Lfloat sustain);
+    void    tPolyADSRS_setRelease    (tPolyADSRS* const, Lfloat release);
+    void    tPolyADSRS_setLeakFactor (tPolyADSRS* const, Lfloat leakFactor);
+    void    tPolyADSRS_on            (tPolyADSRS* const, int voice, Lfloat velocity);
+    void    tPolyADSRS_off           (tPolyADSRS* const, int voice);
+    int     tPolyADSRS_isIdle        (tPolyADSRS* const, int voice);
+    void    tPolyADSRS_setSampleRate (tPolyADSRS* const, Lfloat sr);
+#endif // SIMD_64
+    
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
     /*!
@@ -559,6 +684,7 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     typedef struct _tRamp
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat inc;
         Lfloat sampleRate;
         Lfloat inv_sr_ms;
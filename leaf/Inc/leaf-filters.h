@@ -151,6 +151,7 @@ typedef struct _tThiranAllpassSOCascade
 {
     
     tMempool mempool;
+    LEAFObjectNode node;
     
     int numFilts;
     tAllpassSO* filters;
@@ -229,6 +230,10 @@ void   tThiranAllpassSOCascade_clear            (tThiranAllpassSOCascade* const
      @fn void    tOnePole_setGain        (tOnePole* const, Lfloat gain)
      @brief
      @param filter A pointer to the relevant tOnePole.
+     @fn void    tOnePole_clear          (tOnePole* const)
+     @brief Zero the filter state.
+     @param filter A pointer to the relevant tOnePole.
+     
      ￼￼￼
      @} */
     
@@ -236,6 +241,7 @@ void   tThiranAllpassSOCascade_clear            (tThiranAllpassSOCascade* const
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq;
         Lfloat gain;
         Lfloat a0,a1;
@@ -258,6 +264,7 @@ void   tThiranAllpassSOCascade_clear            (tThiranAllpassSOCascade* const
     void    tOnePole_setCoefficients(tOnePole* const, Lfloat b0, Lfloat a1);
     void    tOnePole_setGain        (tOnePole* const, Lfloat gain);
     void    tOnePole_setSampleRate  (tOnePole* const, Lfloat sr);
+    void    tOnePole_clear          (tOnePole* const);
     
     //==============================================================================
 //==============================================================================
@@ -316,6 +323,7 @@ typedef struct _tCookOnePole
 {
     
     tMempool mempool;
+    LEAFObjectNode node;
     Lfloat poleCoeff, sgain, output;
     Lfloat twoPiTimesInvSampleRate;
     Lfloat gain;
@@ -387,6 +395,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat a0, a1, a2;
@@ -471,6 +480,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tOneZero
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat gain;
         Lfloat b0,b1;
         Lfloat lastIn, lastOut, frequency;
@@ -548,6 +558,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tTwoZero
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat b0, b1, b2;
@@ -725,6 +736,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tBiQuad
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         Lfloat a0, a1, a2;
@@ -800,6 +812,10 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
      @brief
      @param filter A pointer to the relevant tSVF.
      @param type which kind of filter do you want to change the SVF to?
+     @fn void    tSVF_clear          (tSVF* const)
+     @brief Zero the filter state.
+     @param filter A pointer to the relevant tSVF.
+     
      @} */
     
     typedef enum SVFType
@@ -816,6 +832,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tSVF
     {
         tMempool mempool;
+        LEAFObjectNode node;
         SVFType type;
         Lfloat cutoff, Q, cutoffMIDI;
         Lfloat ic1eq,ic2eq;
@@ -844,13 +861,94 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     void    tSVF_setFreqAndQFast(tSVF* const svff, Lfloat cutoff, Lfloat Q);
     void    tSVF_setFilterType  (tSVF* const svff, SVFType type);
     void    tSVF_setSampleRate  (tSVF* const svff, Lfloat sr);
+    void    tSVF_clear          (tSVF* const svff);
     Lfloat    tSVF_getPhaseAtFrequency  (tSVF* const svff, Lfloat freq);
     
+#ifdef SIMD_64
+    //==============================================================================
+    
+    /*!
+     @defgroup tpolysvf tPolySVF
+     @ingroup filters
+     @brief State variable filter running POLY_FLOAT_LANES voices at once, each with its own cutoff and Q. Only available when SIMD_64 is defined.
+     @{
+     
+     @fn void    tPolySVF_init           (tPolySVF* const, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+     @brief Initialize a tPolySVF to the default mempool of a LEAF instance. Every voice starts at the same cutoff and Q.
+     @param filter A pointer to the tPolySVF to initialize.
+     @param type The filter type, shared by all voices.
+     @param freq The initial cutoff in Hz.
+     @param Q The initial resonance.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tPolySVF_initToPool     (tPolySVF* const, SVFType type, Lfloat freq, Lfloat Q, tMempool* const)
+     @brief Initialize a tPolySVF to a specified mempool.
+     @param filter A pointer to the tPolySVF to initialize.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPolySVF_free           (tPolySVF* const)
+     @brief Free a tPolySVF from its mempool.
+     @param filter A pointer to the tPolySVF to free.
+     
+     @fn poly_float tPolySVF_tick         (tPolySVF* const, poly_float v0)
+     @brief Filter one sample of every voice.
+     @param filter A pointer to the relevant tPolySVF.
+     @param v0 The input samples, one per lane.
+     
+     @fn void    tPolySVF_setFreq        (tPolySVF* const, int voice, Lfloat freq)
+     @brief Set the cutoff of one voice.
+     @param filter A pointer to the relevant tPolySVF.
+     @param voice The lane of the voice.
+     
+     @fn void    tPolySVF_setQ           (tPolySVF* const, int voice, Lfloat Q)
+     @brief Set the resonance of one voice.
+     @param filter A pointer to the relevant tPolySVF.
+     @param voice The lane of the voice.
+     
+     @fn void    tPolySVF_setFreqAndQ    (tPolySVF* const, int voice, Lfloat freq, Lfloat Q)
+     @brief Set the cutoff and resonance of one voice.
+     @param filter A pointer to the relevant tPolySVF.
+     @param voice The lane of the voice.
+     
+     @fn void    tPolySVF_setFilterType  (tPolySVF* const, SVFType type)
+     @brief Change the filter type of every voice.
+     @param filter A pointer to the relevant tPolySVF.
+     
+     @} */
+    
+    typedef struct _tPolySVF
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        SVFType type;
+        Lfloat cutoff[POLY_FLOAT_LANES], Q[POLY_FLOAT_LANES];
+        Lfloat ic1eq[POLY_FLOAT_LANES], ic2eq[POLY_FLOAT_LANES];
+        Lfloat k[POLY_FLOAT_LANES], a1[POLY_FLOAT_LANES], a2[POLY_FLOAT_LANES], a3[POLY_FLOAT_LANES];
+        Lfloat cH,cB,cL,cBK;
+        Lfloat sampleRate;
+        Lfloat invSampleRate;
+    } _tPolySVF;
+    
+    typedef _tPolySVF* tPolySVF;
+    
+    void    tPolySVF_init           (tPolySVF* const, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf);
+    void    tPolySVF_initToPool     (tPolySVF* const, SVFType type, Lfloat freq, Lfloat Q, tMempool* const);
+    void    tPolySVF_free           (tPolySVF* const);
+    
+    poly_float tPolySVF_tick         (tPolySVF* const, poly_float v0);
+    void    tPolySVF_setFreq        (tPolySVF* const, int voice, Lfloat freq);
+    void    tPolySVF_setQ           (tPolySVF* const, int voice, Lfloat Q);
+    void    tPolySVF_setFreqAndQ    (tPolySVF* const, int voice, Lfloat freq, Lfloat Q);
+    void    tPolySVF_setFilterType  (tPolySVF* const, SVFType type);
+    void    tPolySVF_setSampleRate  (tPolySVF* const, Lfloat sr);
+#endif // SIMD_64
+    
 //==============================================================================
 
     typedef struct _tSVF_LP
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat ic1eq,ic2eq;
         Lfloat g,onePlusg,k,a0,a1,a2,a3,a4,a5;
         Lfloat sampleRate;
@@ -915,6 +1013,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         SVFType type;
         Lfloat cutoff, Q;
         Lfloat ic1eq,ic2eq;
@@ -966,12 +1065,17 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
      @fn Lfloat   tHighpass_getFreq       (tHighpass* const)
      @brief
      @param filter A pointer to the relevant tHighpass.
+     @fn void    tHighpass_clear         (tHighpass* const)
+     @brief Zero the filter state.
+     @param filter A pointer to the relevant tHighpass.
+     
      ￼￼￼
      @} */
     
     typedef struct _tHighpass
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat xs, ys, R;
         Lfloat frequency;
         Lfloat twoPiTimesInvSampleRate;
@@ -987,6 +1091,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     void    tHighpass_setFreq       (tHighpass* const, Lfloat freq);
     Lfloat   tHighpass_getFreq       (tHighpass* const);
     void    tHighpass_setSampleRate (tHighpass* const, Lfloat sr);
+    void    tHighpass_clear         (tHighpass* const);
     
     //==============================================================================
     
@@ -1031,6 +1136,13 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
      @fn void    tButterworth_setFreqs       (tButterworth* const, Lfloat f1, Lfloat f2)
      @brief
      @param filter A pointer to the relevant tButterworth.
+     @fn void    tButterworth_tickBlock      (tButterworth* const, Lfloat* in, Lfloat* out, int size)
+     @brief Filter a block of samples, running each section across the whole block before the next. Gives the same output as calling tButterworth_tick() on each sample.
+     @param filter A pointer to the relevant tButterworth.
+     @param in The input samples.
+     @param out The buffer to write the filtered samples to. May be the same as in.
+     @param size The number of samples.
+     
      ￼￼￼
      @} */
     
@@ -1038,6 +1150,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tButterworth
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat gain;
         int order;
@@ -1055,6 +1168,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     void    tButterworth_free           (tButterworth* const);
     
     Lfloat   tButterworth_tick           (tButterworth* const, Lfloat input);
+    void    tButterworth_tickBlock      (tButterworth* const, Lfloat* in, Lfloat* out, int size);
     void    tButterworth_setF1          (tButterworth* const, Lfloat in);
     void    tButterworth_setF2          (tButterworth* const, Lfloat in);
     void    tButterworth_setFreqs       (tButterworth* const, Lfloat f1, Lfloat f2);
@@ -1085,6 +1199,13 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
      @fn Lfloat   tFIR_tick           (tFIR* const, Lfloat input)
      @brief
      @param filter A pointer to the relevant tFIR.
+     
+     @fn void    tFIR_tickBlock      (tFIR* const, Lfloat* in, Lfloat* out, int size)
+     @brief Filter a block of samples.
+     @param filter A pointer to the relevant tFIR.
+     @param in The input samples.
+     @param out The buffer to write the filtered samples to. May be the same as in.
+     @param size The number of samples.
      ￼￼￼
      @} */
     
@@ -1092,9 +1213,10 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     {
         
         tMempool mempool;
-        Lfloat* past;
+        Lfloat* past; // doubled delay line, see LEAF_kernel_fir()
         Lfloat* coeff;
         int numTaps;
+        int pos;
     } _tFIR;
     
     typedef _tFIR* tFIR;
@@ -1104,6 +1226,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     void    tFIR_free           (tFIR* const);
     
     Lfloat   tFIR_tick           (tFIR* const, Lfloat input);
+    void    tFIR_tickBlock      (tFIR* const, Lfloat* in, Lfloat* out, int size);
     
     
     //==============================================================================
@@ -1237,6 +1360,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
     typedef struct _tVZFilter
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         VZFilterType type;
         // state:
@@ -1298,6 +1422,7 @@ void    tCookOnePole_setSampleRate  (tCookOnePole* const, Lfloat sr);
 typedef struct _tVZFilterLS
 {
     tMempool mempool;
+    LEAFObjectNode node;
     // state:
     Lfloat s1, s2;
     
@@ -1340,6 +1465,7 @@ void    tVZFilterLS_setFreqFastAndResonanceAndGain           (tVZFilterLS* const
 typedef struct _tVZFilterHS
 {
     tMempool mempool;
+    LEAFObjectNode node;
     // state:
     Lfloat s1, s2;
     
@@ -1382,6 +1508,7 @@ void    tVZFilterHS_setFreqFastAndResonanceAndGain           (tVZFilterHS* const
 typedef struct _tVZFilterBell
 {
     tMempool mempool;
+    LEAFObjectNode node;
     // state:
     Lfloat s1, s2;
     
@@ -1424,6 +1551,7 @@ void    tVZFilterBell_setGain                  (tVZFilterBell* const, Lfloat gai
 typedef struct _tVZFilterBR
 {
     tMempool mempool;
+    LEAFObjectNode node;
     // state:
     Lfloat s1, s2;
     
@@ -1492,6 +1620,7 @@ void    tVZFilterBR_setFreqAndResonanceFast          (tVZFilterBR* const vf, Lfl
     typedef struct _tDiodeFilter
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat cutoff;
         Lfloat f;
         Lfloat r;
@@ -1530,6 +1659,7 @@ void    tVZFilterBR_setFreqAndResonanceFast          (tVZFilterBR* const vf, Lfl
     typedef struct _tLadderFilter
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat cutoff;
         Lfloat invSampleRate;
         Lfloat sampleRatio;
@@ -1564,6 +1694,7 @@ void    tVZFilterBR_setFreqAndResonanceFast          (tVZFilterBR* const vf, Lfl
 typedef struct _tTiltFilter
 {
     tMempool mempool;
+    LEAFObjectNode node;
     Lfloat cutoff;
     Lfloat sr3;
     Lfloat gfactor;
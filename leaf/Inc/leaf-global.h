@@ -16,6 +16,7 @@ extern "C" {
 #endif
     
 #include "leaf-mempool.h"
+#include "stdint.h"
     
 #if _WIN32 || _WIN64
 #include "..\leaf-config.h"
@@ -23,6 +24,90 @@ extern "C" {
 #include "../leaf-config.h"
 #endif
     
+    //! Acquire load, release store and exchange for data shared between one producer and one consumer thread, compare-and-swap for several producers, add (returning the new value) for shared counters, and a full fence. All of them act on 32-bit values.
+#if defined(__GNUC__) || defined(__clang__)
+#define LEAF_ATOMIC_LOAD(ptr)           __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define LEAF_ATOMIC_STORE(ptr, val)     __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define LEAF_ATOMIC_EXCHANGE(ptr, val)  __atomic_exchange_n((ptr), (val), __ATOMIC_ACQ_REL)
+#define LEAF_ATOMIC_CAS(ptr, old, val)  __sync_bool_compare_and_swap((ptr), (old), (val))
+#define LEAF_ATOMIC_ADD(ptr, val)       __atomic_add_fetch((ptr), (val), __ATOMIC_ACQ_REL)
+#define LEAF_ATOMIC_FENCE()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+    // MSVC only orders volatile accesses under /volatile:ms, which isn't the default on ARM,
+    // so loads and stores are plain 32-bit accesses with explicit barriers. x86 keeps them in
+    // order itself and only needs the compiler held back.
+#include <intrin.h>
+#if defined(_M_ARM) || defined(_M_ARM64)
+#define LEAF_ATOMIC_BARRIER()           __dmb(0xB)
+#define LEAF_ATOMIC_FENCE()             __dmb(0xB)
+#else
+#define LEAF_ATOMIC_BARRIER()           _ReadWriteBarrier()
+#define LEAF_ATOMIC_FENCE()             _mm_mfence()
+#endif
+    static __forceinline long leaf_atomicLoad(const volatile void* ptr)
+    {
+        long val = __iso_volatile_load32((const volatile __int32*) ptr);
+        LEAF_ATOMIC_BARRIER();
+        return val;
+    }
+    static __forceinline void leaf_atomicStore(volatile void* ptr, long val)
+    {
+        LEAF_ATOMIC_BARRIER();
+        __iso_volatile_store32((volatile __int32*) ptr, (__int32) val);
+    }
+#define LEAF_ATOMIC_LOAD(ptr)           leaf_atomicLoad((ptr))
+#define LEAF_ATOMIC_STORE(ptr, val)     leaf_atomicStore((ptr), (long)(val))
+#define LEAF_ATOMIC_EXCHANGE(ptr, val)  _InterlockedExchange((volatile long*)(ptr), (long)(val))
+#define LEAF_ATOMIC_CAS(ptr, old, val)  (_InterlockedCompareExchange((volatile long*)(ptr), (long)(val), (long)(old)) == (long)(old))
+#define LEAF_ATOMIC_ADD(ptr, val)       (_InterlockedExchangeAdd((volatile long*)(ptr), (long)(val)) + (long)(val))
+#endif
+    
+    /*!
+     * @ingroup leaf
+     * @brief Floating point state saved by LEAF_enterDenormalScope() and restored by LEAF_exitDenormalScope().
+     */
+    typedef struct LEAFDenormalScope
+    {
+        uint64_t savedState;
+    } LEAFDenormalScope;
+    
+    /*!
+     * @ingroup leaf
+     * @brief Registry entry embedded in each LEAF object that depends on the sample rate or holds signal state.
+     * @details Each mempool keeps a list of the objects allocated from it, so objects on an arena only ever touch their own thread's list. LEAF_setSampleRate() and LEAF_clearObjects() walk the lists of every mempool to reach every live object. The callbacks take a pointer to the object handle, like the tX_setSampleRate() and tX_clear() functions they point to.
+     */
+    typedef struct LEAFObjectNode
+    {
+        struct LEAFObjectNode* prev;
+        struct LEAFObjectNode* next;
+        void* object;
+        void (*setSampleRate)(void** const, Lfloat);
+        void (*clear)(void** const);
+    } LEAFObjectNode;
+    
+    //! Casts for passing tX_setSampleRate() and tX_clear() to LEAF_registerObject().
+    typedef void (*LEAFSampleRateFunc)(void** const, Lfloat);
+    typedef void (*LEAFClearFunc)(void** const);
+    
+    //! Add an object to the registry of the mempool it was allocated from.
+    /*!
+     LEAF objects call this from their init functions. Only needed for objects defined outside LEAF.
+     @param pool The object's mempool.
+     @param node The registry entry, usually a field of the object.
+     @param object The object, passed back to the callbacks by handle.
+     @param setSampleRate Called by LEAF_setSampleRate(), or NULL.
+     @param clear Called by LEAF_clearObjects(), or NULL.
+     */
+    void    LEAF_registerObject     (_tMempool* const pool, LEAFObjectNode* const node, void* object,
+                                     LEAFSampleRateFunc setSampleRate, LEAFClearFunc clear);
+    
+    //! Remove an object from the registry. LEAF objects call this from their free functions.
+    /*!
+     @param pool The object's mempool.
+     @param node The entry passed to LEAF_registerObject().
+     */
+    void    LEAF_unregisterObject   (_tMempool* const pool, LEAFObjectNode* const node);
+    
     /*!
      * @ingroup leaf
      * @brief Struct for an instance of LEAF.
@@ -42,8 +127,9 @@ extern "C" {
         size_t header_size; //!< The size in bytes of memory region headers within mempools.
         void (*errorCallback)(LEAF* const, LEAFErrorType); //!< A pointer to the callback function for LEAF errors. Can be set by the user.
         int     errorState[LEAFErrorNil]; //!< An array of flags that indicate which errors have occurred.
-        unsigned int allocCount; //!< A count of LEAF memory allocations.
-        unsigned int freeCount; //!< A count of LEAF memory frees.
+        unsigned int allocCount; //!< A count of LEAF memory allocations outside arenas.
+        unsigned int freeCount; //!< A count of LEAF memory frees outside arenas.
+        struct _tLeafTables* tables; //!< Tables built by LEAF_init() when LEAF_GENERATE_TABLES is set, or NULL.
         ///@}
     };
     
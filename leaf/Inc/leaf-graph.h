@@ -0,0 +1,250 @@
+/*==============================================================================
+
+ leaf-graph.h
+
+ ==============================================================================*/
+
+#ifndef LEAF_GRAPH_H_INCLUDED
+#define LEAF_GRAPH_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include "leaf-global.h"
+#include "leaf-mempool.h"
+
+    /*!
+     @defgroup tblockgraph tBlockGraph
+     @ingroup graph
+     @brief A graph of block functions rendered in parallel once per audio block.
+     @details Each node wraps a function that renders one block, typically a chain of LEAF _tick calls on its own objects, and runs once per tBlockGraph_process() after all the nodes it depends on. Nodes are shared among a fixed set of threads, the calling thread plus numThreads - 1 workers started at init. Every thread keeps its own deque of ready nodes: it runs the node it pushed last, so a chain of dependent nodes stays on one core, and steals the oldest node from another thread's deque when its own is empty. Independent chains such as channel strips are dealt out across the deques at the start of each block.
+
+     Nodes on different threads run at the same time, so two nodes must not share objects unless one depends on the other, and node functions must not allocate from or free to a mempool that another node uses. Idle workers spin briefly between blocks and then sleep until the next one. A block is rendered by whichever threads are awake for it: tBlockGraph_process() waits only for the workers that joined it, not for ones still asleep or descheduled.
+
+     Workers take the scheduling policy and priority of the thread that calls tBlockGraph_init(), so call it from the audio thread or from a thread at the same priority. Workers below the audio thread get preempted mid-block by other work, which shows up as deadline misses. Workers above it can starve it on a shared core while they wait for its nodes.
+
+     When LEAF_USE_THREADS is 0 no workers are started and tBlockGraph_process() runs every node on the calling thread in dependency order.
+
+     Each block is timed against a deadline, by default the length of the block at the LEAF sample rate. The load and deadline misses are kept for monitoring. Timing uses the platform's monotonic clock when LEAF_USE_THREADS is set; elsewhere supply a clock with tBlockGraph_setClock().
+     @{
+
+     @fn void    tBlockGraph_init                (tBlockGraph* const graph, int maxNodes, int numThreads, LEAF* const leaf)
+     @brief Initialize a tBlockGraph to the default mempool of a LEAF instance and start its worker threads.
+     @param graph A pointer to the tBlockGraph to initialize.
+     @param maxNodes The maximum number of nodes.
+     @param numThreads The number of threads that render nodes, including the one that calls tBlockGraph_process(). Forced to 1 when LEAF_USE_THREADS is 0.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tBlockGraph_initToPool          (tBlockGraph* const graph, int maxNodes, int numThreads, tMempool* const pool)
+     @brief Initialize a tBlockGraph to a specified mempool and start its worker threads.
+     @param graph A pointer to the tBlockGraph to initialize.
+     @param maxNodes The maximum number of nodes.
+     @param numThreads The number of threads that render nodes, including the one that calls tBlockGraph_process(). Forced to 1 when LEAF_USE_THREADS is 0.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tBlockGraph_free                (tBlockGraph* const graph)
+     @brief Stop the worker threads and free a tBlockGraph from its mempool.
+     @param graph A pointer to the tBlockGraph to free.
+
+     @fn int     tBlockGraph_addNode             (tBlockGraph* const graph, void (*process)(void* userData, int blockSize), void* userData)
+     @brief Add a node. Don't change the graph while tBlockGraph_process() is running.
+     @param graph A pointer to the relevant tBlockGraph.
+     @param process The function that renders one block for this node.
+     @param userData Passed to the function.
+     @return The index of the new node, or -1 if the graph is full.
+
+     @fn int     tBlockGraph_addDependency       (tBlockGraph* const graph, int first, int then)
+     @brief Make a node wait each block until another node has finished. Don't change the graph while tBlockGraph_process() is running.
+     @param graph A pointer to the relevant tBlockGraph.
+     @param first The node that runs first.
+     @param then The node that waits for it.
+     @return 1 on success, or 0 if either index is invalid or the dependency would create a cycle.
+
+     @fn void    tBlockGraph_process             (tBlockGraph* const graph, int blockSize)
+     @brief Run every node once and return when all of them have finished. The calling thread renders nodes too. Call once per audio block.
+     @param graph A pointer to the relevant tBlockGraph.
+     @param blockSize Passed to every node function.
+
+     @fn void    tBlockGraph_setDeadline         (tBlockGraph* const graph, Lfloat fraction)
+     @brief Set the deadline for tBlockGraph_process() as a fraction of the block length. Defaults to 1.
+     @param graph A pointer to the relevant tBlockGraph.
+     @param fraction The share of the block length, at the LEAF sample rate, that processing may take.
+
+     @fn void    tBlockGraph_setClock            (tBlockGraph* const graph, double (*clock)(void))
+     @brief Set the clock used to time blocks, for example a cycle counter on targets without an operating system.
+     @param graph A pointer to the relevant tBlockGraph.
+     @param clock A function returning the time in seconds, or NULL to stop timing.
+
+     @fn uint32_t tBlockGraph_getNumDeadlineMisses (tBlockGraph* const graph)
+     @brief Get the number of blocks that took longer than the deadline since init or the last tBlockGraph_resetStats().
+     @param graph A pointer to the relevant tBlockGraph.
+
+     @fn Lfloat  tBlockGraph_getLoad             (tBlockGraph* const graph)
+     @brief Get the time the last block took as a fraction of the block length.
+     @param graph A pointer to the relevant tBlockGraph.
+
+     @fn Lfloat  tBlockGraph_getPeakLoad         (tBlockGraph* const graph)
+     @brief Get the highest load since init or the last tBlockGraph_resetStats().
+     @param graph A pointer to the relevant tBlockGraph.
+
+     @fn void    tBlockGraph_resetStats          (tBlockGraph* const graph)
+     @brief Reset the deadline miss count and the peak load.
+     @param graph A pointer to the relevant tBlockGraph.
+
+     @} */
+
+    typedef struct _tBlockGraphNode
+    {
+        void (*process)(void* userData, int blockSize);
+        void* userData;
+        int* successors;
+        int numSuccessors;
+        int maxSuccessors;
+        int numPredecessors;
+        volatile int pending; // predecessors still to finish this block
+    } _tBlockGraphNode;
+
+    typedef struct _tBlockGraph
+    {
+        tMempool mempool;
+
+        _tBlockGraphNode* nodes;
+        int numNodes;
+        int maxNodes;
+
+        int numThreads;
+        int maxThreads;
+        struct _tBlockGraphWorker* workers; // one per thread, the calling thread first
+        struct _tBlockGraphSync* sync;
+        volatile int generation; // bumped to start a block
+        volatile int remaining; // nodes not yet finished this block
+        volatile int active; // workers in this block, or negative once it is closed
+        volatile int sleepers;
+        volatile int quit;
+        int blockSize;
+
+        double (*clock)(void);
+        Lfloat deadline;
+        Lfloat load;
+        Lfloat peakLoad;
+        uint32_t deadlineMisses;
+    } _tBlockGraph;
+
+    typedef _tBlockGraph* tBlockGraph;
+
+    void    tBlockGraph_init                (tBlockGraph* const graph, int maxNodes, int numThreads, LEAF* const leaf);
+    void    tBlockGraph_initToPool          (tBlockGraph* const graph, int maxNodes, int numThreads, tMempool* const pool);
+    void    tBlockGraph_free                (tBlockGraph* const graph);
+
+    int     tBlockGraph_addNode             (tBlockGraph* const graph, void (*process)(void* userData, int blockSize), void* userData);
+    int     tBlockGraph_addDependency       (tBlockGraph* const graph, int first, int then);
+    void    tBlockGraph_process             (tBlockGraph* const graph, int blockSize);
+
+    void    tBlockGraph_setDeadline         (tBlockGraph* const graph, Lfloat fraction);
+    void    tBlockGraph_setClock            (tBlockGraph* const graph, double (*clock)(void));
+    uint32_t tBlockGraph_getNumDeadlineMisses (tBlockGraph* const graph);
+    Lfloat  tBlockGraph_getLoad             (tBlockGraph* const graph);
+    Lfloat  tBlockGraph_getPeakLoad         (tBlockGraph* const graph);
+    void    tBlockGraph_resetStats          (tBlockGraph* const graph);
+    
+    //==============================================================================
+    
+    /*!
+     @defgroup tparamsnapshot tParamSnapshot
+     @ingroup graph
+     @brief Lock-free parameter snapshots passed from a control thread to the audio thread once per block.
+     @details The control thread sets values and publishes them as a complete snapshot; the audio thread calls tParamSnapshot_update() at the start of each block to pick up the newest one. Three buffers rotate between the two threads, so neither ever waits and a block never sees a half-written set of parameters. Each parameter can be bound to a setter such as tSVF_setFreq(), which update() calls only when that parameter's value has changed, so coefficient math runs at most once per block per changed parameter instead of on every control event.
+     @{
+     
+     @fn void    tParamSnapshot_init             (tParamSnapshot* const snapshot, int numParams, LEAF* const leaf)
+     @brief Initialize a tParamSnapshot to the default mempool of a LEAF instance. All values start at 0.
+     @param snapshot A pointer to the tParamSnapshot to initialize.
+     @param numParams The number of parameters.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tParamSnapshot_initToPool       (tParamSnapshot* const snapshot, int numParams, tMempool* const pool)
+     @brief Initialize a tParamSnapshot to a specified mempool. All values start at 0.
+     @param snapshot A pointer to the tParamSnapshot to initialize.
+     @param numParams The number of parameters.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tParamSnapshot_free             (tParamSnapshot* const snapshot)
+     @brief Free a tParamSnapshot from its mempool.
+     @param snapshot A pointer to the tParamSnapshot to free.
+     
+     @fn void    tParamSnapshot_bind             (tParamSnapshot* const snapshot, int index, void (*set)(void* const object, Lfloat value), void* object)
+     @brief Bind a parameter to a setter that the audio thread calls when its value changes. Call before audio starts.
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     @param index The parameter index.
+     @param set The setter, for example (void (*)(void* const, Lfloat)) tSVF_setFreq, or NULL to unbind.
+     @param object Passed to the setter, for example a pointer to the tSVF.
+     
+     @fn void    tParamSnapshot_setValue         (tParamSnapshot* const snapshot, int index, Lfloat value)
+     @brief Set a value from the control thread. It reaches the audio thread with the next tParamSnapshot_publish(). A NaN is ignored and the parameter keeps its previous value.
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     @param index The parameter index.
+     @param value The new value.
+     
+     @fn void    tParamSnapshot_publish          (tParamSnapshot* const snapshot)
+     @brief Publish all values set so far from the control thread. If the audio thread hasn't picked up the previous snapshot, this one replaces it.
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     
+     @fn int     tParamSnapshot_update           (tParamSnapshot* const snapshot)
+     @brief Pick up the newest published snapshot from the audio thread and call the setters of parameters that have changed. Call once at the start of each block. The first call treats every parameter as changed.
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     @return The number of parameters that changed.
+     
+     @fn Lfloat  tParamSnapshot_getValue         (tParamSnapshot* const snapshot, int index)
+     @brief Get a value from the snapshot the audio thread is using.
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     @param index The parameter index.
+     
+     @fn int     tParamSnapshot_hasChanged       (tParamSnapshot* const snapshot, int index)
+     @brief Check from the audio thread whether a parameter changed in the last tParamSnapshot_update().
+     @param snapshot A pointer to the relevant tParamSnapshot.
+     @param index The parameter index.
+     
+     @} */
+    
+    typedef struct _tParamSnapshot
+    {
+        tMempool mempool;
+        
+        int numParams;
+        Lfloat* buffers[3];
+        volatile int middle; // buffer index handed between the threads, or'd with 4 when it holds a new snapshot
+        int writeBuffer; // control thread only
+        int readBuffer; // audio thread only
+        
+        Lfloat* applied;
+        uint32_t* changed;
+        int primed;
+        
+        void (**setters)(void* const object, Lfloat value);
+        void** objects;
+    } _tParamSnapshot;
+    
+    typedef _tParamSnapshot* tParamSnapshot;
+    
+    void    tParamSnapshot_init             (tParamSnapshot* const snapshot, int numParams, LEAF* const leaf);
+    void    tParamSnapshot_initToPool       (tParamSnapshot* const snapshot, int numParams, tMempool* const pool);
+    void    tParamSnapshot_free             (tParamSnapshot* const snapshot);
+    
+    void    tParamSnapshot_bind             (tParamSnapshot* const snapshot, int index, void (*set)(void* const object, Lfloat value), void* object);
+    void    tParamSnapshot_setValue         (tParamSnapshot* const snapshot, int index, Lfloat value);
+    void    tParamSnapshot_publish          (tParamSnapshot* const snapshot);
+    int     tParamSnapshot_update           (tParamSnapshot* const snapshot);
+    Lfloat  tParamSnapshot_getValue         (tParamSnapshot* const snapshot, int index);
+    int     tParamSnapshot_hasChanged       (tParamSnapshot* const snapshot, int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_GRAPH_H_INCLUDED
+
+//==============================================================================
+
@@ -20,6 +20,7 @@ extern "C" {
 #include "leaf-oscillators.h"
 #include "leaf-filters.h"
 #include "leaf-envelopes.h"
+#include "leaf-midi.h"
     
     /*!
      * @internal
@@ -88,6 +89,7 @@ extern "C" {
     typedef struct _t808Cowbell
     {
         tMempool mempool;
+        LEAFObjectNode node;
         tSquare p[2];
         tNoise stick;
         tSVF bandpassOsc;
@@ -193,6 +195,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         // 6 Square waves
         tSquare p[6];
         tNoise n;
@@ -298,6 +301,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         // Tone 1, Tone 2, Noise
         tTriangle tone[2]; // Tri (not yet antialiased or wavetabled)
         tNoise noiseOsc;
@@ -406,6 +410,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         // Tone 1, Tone 2, Noise
         tPBTriangle tone[2]; // Tri 
         tNoise noiseOsc;
@@ -512,6 +517,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tCycle tone; // Tri
         tNoise noiseOsc;
@@ -547,7 +553,7 @@ extern "C" {
     void    t808Kick_setToneNoiseMix    (t808Kick* const, Lfloat toneNoiseMix);
     void    t808Kick_setNoiseFilterFreq (t808Kick* const, Lfloat noiseFilterFreq);
     void    t808Kick_setNoiseFilterQ    (t808Kick* const, Lfloat noiseFilterQ);
-    void    t808kick_setSampleRate      (t808Kick* const, Lfloat sr);
+    void    t808Kick_setSampleRate      (t808Kick* const, Lfloat sr);
     
     //==============================================================================
 
@@ -618,6 +624,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tCycle tone; // Tri
         tNoise noiseOsc;
@@ -657,6 +664,141 @@ extern "C" {
     
     //==============================================================================
     
+    /*!
+     @defgroup tvoiceengine tVoiceEngine
+     @ingroup instruments
+     @brief Polyphonic subtractive synth that renders all of its voices in one block pass.
+     @details Each voice is a polyBLEP sawtooth into a state variable lowpass filter with an ADSR amplitude envelope, the same chain an application would build from tPoly, tPBSaw, tSVF, and tADSRT. Voice state is stored as one array per field rather than one object per voice. Voices whose release has decayed to silence are returned to the internal tSimplePoly and skipped entirely, so rendering cost scales with the number of sounding voices rather than the number allocated.
+     @{
+     
+     @fn void    tVoiceEngine_init           (tVoiceEngine* const, int maxNumVoices, int maxBlockSize, LEAF* const leaf)
+     @brief Initialize a tVoiceEngine to the default mempool of a LEAF instance.
+     @param engine A pointer to the tVoiceEngine to initialize.
+     @param maxNumVoices The number of voice slots.
+     @param maxBlockSize The largest block that will be rendered at once. Larger blocks are split internally.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tVoiceEngine_initToPool     (tVoiceEngine* const, int maxNumVoices, int maxBlockSize, tMempool* const)
+     @brief Initialize a tVoiceEngine to a specified mempool.
+     @param engine A pointer to the tVoiceEngine to initialize.
+     @param maxNumVoices The number of voice slots.
+     @param maxBlockSize The largest block that will be rendered at once. Larger blocks are split internally.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tVoiceEngine_free           (tVoiceEngine* const)
+     @brief Free a tVoiceEngine from its mempool.
+     @param engine A pointer to the tVoiceEngine to free.
+     
+     @fn int     tVoiceEngine_noteOn         (tVoiceEngine* const, int note, uint8_t vel)
+     @brief Start a note.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param note The MIDI note number.
+     @param vel The MIDI velocity.
+     @return The voice that will play the note, or -1.
+     
+     @fn int     tVoiceEngine_noteOff        (tVoiceEngine* const, int note)
+     @brief Release a note. The voice keeps sounding until its release has finished.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param note The MIDI note number.
+     @return The voice that was playing the note, or -1.
+     
+     @fn void    tVoiceEngine_tickBlock      (tVoiceEngine* const, Lfloat* out, int size)
+     @brief Render and sum all sounding voices into a block.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param out The output block, which is overwritten.
+     @param size The number of samples in the block.
+     
+     @fn void    tVoiceEngine_setEnvelope    (tVoiceEngine* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release)
+     @brief Set the amplitude envelope of all voices.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param attack The attack time in milliseconds.
+     @param decay The decay time constant in milliseconds.
+     @param sustain The sustain level from 0 to 1.
+     @param release The release time constant in milliseconds.
+     
+     @fn void    tVoiceEngine_setCutoff      (tVoiceEngine* const, Lfloat freq)
+     @brief Set the filter cutoff of all voices.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param freq The cutoff in Hz.
+     
+     @fn void    tVoiceEngine_setResonance   (tVoiceEngine* const, Lfloat Q)
+     @brief Set the filter resonance of all voices.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param Q The filter Q.
+     
+     @fn void    tVoiceEngine_setPitch       (tVoiceEngine* const, int voice, Lfloat pitch)
+     @brief Override the pitch of a voice, for glide or per-note pitch bend.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param voice The voice.
+     @param pitch The pitch as a fractional MIDI note number.
+     
+     @fn int     tVoiceEngine_getNumSoundingVoices (tVoiceEngine* const)
+     @brief Get the number of voices that will be rendered in the next block, including voices in their release.
+     @param engine A pointer to the relevant tVoiceEngine.
+     
+     @fn int     tVoiceEngine_isSounding     (tVoiceEngine* const, int voice)
+     @brief Check whether a voice is sounding.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param voice The voice.
+     
+     @fn void    tVoiceEngine_setSampleRate  (tVoiceEngine* const, Lfloat sr)
+     @brief Set the sample rate.
+     @param engine A pointer to the relevant tVoiceEngine.
+     @param sr The new sample rate.
+     
+     @} */
+    
+    typedef struct _tVoiceEngine
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        
+        tSimplePoly poly;
+        int maxNumVoices;
+        int maxBlockSize;
+        Lfloat sampleRate;
+        Lfloat invSampleRate;
+        
+        // shared parameters
+        Lfloat attack, decay, sustain, release;
+        Lfloat attackInc, decayCoeff, releaseCoeff;
+        Lfloat cutoff, Q;
+        
+        // per-voice state, indexed by voice
+        int* stage;
+        Lfloat* level;
+        Lfloat* gain;
+        Lfloat* phase;
+        Lfloat* inc;
+        Lfloat* a1;
+        Lfloat* a2;
+        Lfloat* a3;
+        Lfloat* ic1eq;
+        Lfloat* ic2eq;
+        
+        Lfloat* voiceBuffer;
+        Lfloat* envBuffer;
+    } _tVoiceEngine;
+    
+    typedef _tVoiceEngine* tVoiceEngine;
+    
+    void    tVoiceEngine_init           (tVoiceEngine* const, int maxNumVoices, int maxBlockSize, LEAF* const leaf);
+    void    tVoiceEngine_initToPool     (tVoiceEngine* const, int maxNumVoices, int maxBlockSize, tMempool* const);
+    void    tVoiceEngine_free           (tVoiceEngine* const);
+    
+    int     tVoiceEngine_noteOn         (tVoiceEngine* const, int note, uint8_t vel);
+    int     tVoiceEngine_noteOff        (tVoiceEngine* const, int note);
+    void    tVoiceEngine_tickBlock      (tVoiceEngine* const, Lfloat* out, int size);
+    void    tVoiceEngine_setEnvelope    (tVoiceEngine* const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release);
+    void    tVoiceEngine_setCutoff      (tVoiceEngine* const, Lfloat freq);
+    void    tVoiceEngine_setResonance   (tVoiceEngine* const, Lfloat Q);
+    void    tVoiceEngine_setPitch       (tVoiceEngine* const, int voice, Lfloat pitch);
+    int     tVoiceEngine_getNumSoundingVoices (tVoiceEngine* const);
+    int     tVoiceEngine_isSounding     (tVoiceEngine* const, int voice);
+    void    tVoiceEngine_setSampleRate  (tVoiceEngine* const, Lfloat sr);
+    
+    //==============================================================================
+    
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,70 @@
+/*==============================================================================
+
+ leaf-kernels.h
+
+ ==============================================================================*/
+
+#ifndef LEAF_KERNELS_H_INCLUDED
+#define LEAF_KERNELS_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "leaf-global.h"
+
+    /*!
+     @file leaf-kernels.h
+     @brief Internal block kernels shared by the FIR, oversampling, filter and analysis objects.
+
+     @details Each kernel has three backends, picked at compile time: CMSIS-DSP when LEAF_USE_CMSIS is nonzero, poly_float (SSE, AVX or NEON, see leaf_polyvalues.h) when the target has a vector unit, and plain C otherwise. All of them give the same results up to float rounding, since the vector backends sum in a different order.
+
+     The real FFT keeps the layout LEAF has always used with mayer_realfft(): for an n point transform buf[0] is DC, buf[k] is the real part of bin k for k up to n/2, and buf[n-k] is minus its imaginary part. The inverse is unscaled, so a round trip multiplies by n. The CMSIS backend needs n Lfloats of scratch to do this; the other backends ignore it, so pass NULL there.
+     */
+
+    //==============================================================================
+
+//! Nonzero when LEAF_kernel_realFFT() and LEAF_kernel_realIFFT() need a scratch buffer.
+#if LEAF_USE_CMSIS
+#define LEAF_KERNEL_FFT_NEEDS_SCRATCH 1
+#else
+#define LEAF_KERNEL_FFT_NEEDS_SCRATCH 0
+#endif
+
+    //! Returns the sum of a[i] * b[i] over n values.
+    Lfloat  LEAF_kernel_dot             (const Lfloat* a, const Lfloat* b, int n);
+
+    //! out[i] = a[i] + b[i]. out may be either input.
+    void    LEAF_kernel_add             (const Lfloat* a, const Lfloat* b, Lfloat* out, int n);
+
+    //! out[i] = a[i] * b[i]. out may be either input.
+    void    LEAF_kernel_mul             (const Lfloat* a, const Lfloat* b, Lfloat* out, int n);
+
+    //! out[i] = in[i] * scale. out may be in.
+    void    LEAF_kernel_scale           (const Lfloat* in, Lfloat scale, Lfloat* out, int n);
+
+    //! Returns the largest absolute value among n values, or 0 when n is 0.
+    Lfloat  LEAF_kernel_maxAbs          (const Lfloat* in, int n);
+
+    //! FIR filter over a doubled delay line. hist holds 2 * numTaps Lfloats and *pos is the index of the newest input; each input is written to hist[pos] and hist[pos + numTaps], so the most recent numTaps inputs are always contiguous, newest first, and coeffs[i] applies to the input i samples back. in and out may be the same buffer.
+    void    LEAF_kernel_fir             (const Lfloat* coeffs, int numTaps, Lfloat* hist, int* pos,
+                                         const Lfloat* in, Lfloat* out, int n);
+
+    //! Cascade of biquads in transposed direct form II. coeffs holds {b0, b1, b2, a1, a2} per stage with the feedback terms negated (y = b0*x + d1, d1 = b1*x + a1*y + d2, d2 = b2*x + a2*y), the layout arm_biquad_cascade_df2T_f32() uses, and state holds {d1, d2} per stage. in and out may be the same buffer.
+    void    LEAF_kernel_biquadCascade   (const Lfloat* coeffs, Lfloat* state, int numStages,
+                                         const Lfloat* in, Lfloat* out, int n);
+
+    //! In-place real FFT of n points, n a power of two, in the layout described above.
+    void    LEAF_kernel_realFFT         (Lfloat* buf, Lfloat* scratch, int n);
+
+    //! Unscaled inverse of LEAF_kernel_realFFT().
+    void    LEAF_kernel_realIFFT        (Lfloat* buf, Lfloat* scratch, int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_KERNELS_H_INCLUDED
+
+//==============================================================================
+
@@ -692,6 +692,27 @@ static inline Lfloat fastSine(Lfloat x)
     void LEAF_generate_dbtoa(Lfloat* buffer, int size, Lfloat minDb, Lfloat maxDb);
     void LEAF_generate_mtof(Lfloat* buffer, Lfloat startMIDI, Lfloat endMIDI, int size);
     void LEAF_generate_ftom(Lfloat* buffer, Lfloat startFreq, Lfloat endFreq, int size);
+
+    // Block versions of the approximations above, for when a whole buffer
+    // needs the same function. They run POLY_FLOAT_LANES values at a time
+    // with the SIMD of leaf_polyvalues.h, and in may equal out.
+    //
+    // Max error against double precision libm, by tier:
+    //   tier 1, a few 1e-6 or better (relative for exp2/mtof/dbtoa, absolute otherwise;
+    //   mtof and dbtoa lose a little more to rounding of the scaled argument)
+    //     LEAF_exp2_array       2.5e-7 relative, x in [-126, 127], clamped outside
+    //     LEAF_mtof_array       4.0e-6 relative, MIDI note in [-1400, 1400]
+    //     LEAF_dbtoa_array      3.5e-6 relative, dB in [-700, 700]
+    //     LEAF_tanh_array       1.5e-7 absolute, any x
+    //     LEAF_sin_array        3.0e-7 absolute, |x| up to 1e4
+    //   tier 2, about 1e-4 absolute
+    //     LEAF_fast_tanh_array  1.0e-4, the fast_tanh() curve, clamped at +-4.97 where it reaches 1
+    void LEAF_exp2_array(const Lfloat* in, Lfloat* out, int n);
+    void LEAF_mtof_array(const Lfloat* in, Lfloat* out, int n);
+    void LEAF_dbtoa_array(const Lfloat* in, Lfloat* out, int n);
+    void LEAF_tanh_array(const Lfloat* in, Lfloat* out, int n);
+    void LEAF_fast_tanh_array(const Lfloat* in, Lfloat* out, int n);
+    void LEAF_sin_array(const Lfloat* in, Lfloat* out, int n);
     
 
 
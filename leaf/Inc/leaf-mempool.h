@@ -47,6 +47,7 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
     
     //==============================================================================
     
@@ -59,6 +60,7 @@ extern "C" {
         LEAFMempoolOverrun = 0,
         LEAFMempoolFragmentation,
         LEAFInvalidFree,
+        LEAFMempoolWrongThread,
         LEAFErrorNil
     } LEAFErrorType;
     
@@ -77,6 +79,13 @@ extern "C" {
         size_t size;
     } mpool_node_t;
     
+    // slot of an arena's cross-thread free queue
+    typedef struct mpool_deferred_t {
+        volatile uint32_t sequence;
+        char* ptr;
+        void (*freeObject)(void** const);
+    } mpool_deferred_t;
+    
     typedef struct _tMempool _tMempool;
     typedef _tMempool* tMempool;
     struct _tMempool
@@ -87,6 +96,17 @@ extern "C" {
         size_t        usize;       // used size of the pool
         size_t        msize;       // max size of the pool
         mpool_node_t* head;        // first node of memory pool free list
+        
+        struct LEAFObjectNode* objects; // objects registered to this pool, newest first
+        _tMempool*    children;    // pools made from this one, reached by LEAF_setSampleRate()
+        _tMempool*    nextSibling;
+        
+        // arenas only
+        mpool_deferred_t* freeQueue;
+        uint32_t      freeQueueMask;
+        volatile uint32_t freeQueueWrite;
+        uint32_t      freeQueueRead;
+        const void*   owner;       // thread marker set by tMempool_claim()
     };
     
     //! Initialize a tMempool for a given memory location and size to the default mempool of a LEAF instance.
@@ -114,6 +134,62 @@ extern "C" {
      @param poolTo A pointer to the tMempool to which this tMempool should be initialized.
      */
     void    tMempool_initToPool     (tMempool* const mp, char* memory, size_t size, tMempool* const mem);
+    
+    
+    //! Initialize an arena: a tMempool for one thread, carved out of the default mempool of a LEAF instance.
+    /*!
+     mpool_alloc() and mpool_free() aren't thread-safe, so give each worker thread its own arena and allocate that thread's objects from it with the _initToPool functions. Arenas are made and freed on the thread that owns the LEAF instance. Freeing an arena returns its memory to the parent mempool.
+     @param arena A pointer to the tMempool to initialize.
+     @param size The size in bytes of the memory to carve out for the arena.
+     @param freeQueueSize The number of frees other threads can queue with tMempool_queueFree() before the owner processes them. Rounded up to a power of two.
+     @param leaf A pointer to the leaf instance.
+     */
+    void    tMempool_initArena      (tMempool* const arena, size_t size, int freeQueueSize, LEAF* const leaf);
+    
+    
+    //! Initialize an arena carved out of a specified mempool.
+    /*!
+     @param arena A pointer to the tMempool to initialize.
+     @param size The size in bytes of the memory to carve out for the arena.
+     @param freeQueueSize The number of frees other threads can queue before the owner processes them. Rounded up to a power of two.
+     @param mem A pointer to the tMempool to carve the arena out of.
+     */
+    void    tMempool_initArenaToPool(tMempool* const arena, size_t size, int freeQueueSize, tMempool* const mem);
+    
+    
+    //! Make the calling thread the owner of an arena.
+    /*!
+     With LEAF_CHECK_MEMPOOL_OWNER set, allocating from or freeing to the arena on any other thread reports LEAFMempoolWrongThread. Call again from another thread to hand the arena over once its previous owner is done with it.
+     @param arena A pointer to the arena.
+     */
+    void    tMempool_claim          (tMempool* const arena);
+    
+    
+    //! Queue a block allocated from an arena to be freed by the arena's owner. Safe from any number of threads at once.
+    /*!
+     @param arena A pointer to the arena the block came from.
+     @param ptr The block.
+     @return 1 if the free was queued, 0 if the queue was full or the pool isn't an arena.
+     */
+    int     tMempool_queueFree      (tMempool* const arena, char* ptr);
+    
+    
+    //! Queue a LEAF object allocated from an arena to be freed by the arena's owner. Safe from any number of threads at once.
+    /*!
+     @param arena A pointer to the arena the object came from.
+     @param freeObject The object's free function, cast like (void (*)(void** const)) tCycle_free.
+     @param object The object, which the free function receives by handle.
+     @return 1 if the free was queued, 0 if the queue was full or the pool isn't an arena.
+     */
+    int     tMempool_queueFreeObject(tMempool* const arena, void (*freeObject)(void** const), void* object);
+    
+    
+    //! Carry out the frees queued for an arena. Call from the arena's owner, for example at the start of each block.
+    /*!
+     @param arena A pointer to the arena.
+     @return The number of blocks and objects freed.
+     */
+    int     tMempool_processFreeQueue(tMempool* const arena);
 
     /*!￼￼￼
      @} */
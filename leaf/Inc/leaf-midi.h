@@ -36,6 +36,7 @@ extern "C" {
      @defgroup tstack tStack
      @ingroup midi
      @brief A basic stack of integers with a fixed capacity of 128, used by tPoly to keep track of MIDI notes.
+     @details Values must be in the range 0 to STACK_SIZE - 1 and are held at most once. Presence is tracked in a 128-bit bitmap and order in a doubly linked list indexed by value, so adding, removing, and checking for a value take constant time.
      @{
      
      @fn void    tStack_init                 (tStack* const stack, LEAF* const leaf)
@@ -63,7 +64,7 @@ extern "C" {
      @param item The value to be added.
      
      @fn void    tStack_add                  (tStack* const stack, uint16_t item)
-     @brief Add a value to the stack.
+     @brief Add a value to the stack. Values already in the stack are left where they are.
      @param stack A pointer to the relevant tStack.
      @param item The value to be added.
      
@@ -87,11 +88,34 @@ extern "C" {
      @return The current size of the stack.
      
      @fn int     tStack_contains             (tStack* const stack, uint16_t item)
-     @brief Check if the stack contains a value, and if it does, get the index of that value.
+     @brief Check if the stack contains a value, and if it does, get the index of that value. Use tStack_has() when the index is not needed.
      @param stack A pointer to the relevant tStack.
      @param item The value to check against the stack.
      @return The index of the value or -1 if the stack does not contain the value.
      
+     @fn int     tStack_has                  (tStack* const stack, uint16_t item)
+     @brief Check if the stack contains a value in constant time.
+     @param stack A pointer to the relevant tStack.
+     @param item The value to check against the stack.
+     @return 1 if the stack contains the value, 0 otherwise.
+     
+     @fn int     tStack_last                 (tStack* const stack)
+     @brief Get the last value in the stack.
+     @param stack A pointer to the relevant tStack.
+     @return The last value in the stack or -1 if the stack is empty.
+     
+     @fn int     tStack_after                (tStack* const stack, uint16_t item)
+     @brief Get the value one index after a value in the stack, for walking the stack from first to last.
+     @param stack A pointer to the relevant tStack.
+     @param item A value in the stack.
+     @return The value after the given value or -1 if there is none.
+     
+     @fn int     tStack_before               (tStack* const stack, uint16_t item)
+     @brief Get the value one index before a value in the stack, for walking the stack from last to first.
+     @param stack A pointer to the relevant tStack.
+     @param item A value in the stack.
+     @return The value before the given value or -1 if there is none.
+     
      @fn int     tStack_next                 (tStack* const stack)
      @brief Get the next value in the stack, starting from the earliest added values.
      @param stack A pointer to the relevant tStack.
@@ -101,7 +125,7 @@ extern "C" {
      @brief Get the value at a given index of the stack.
      @param stack A pointer to the relevant tStack.
      @param index The index of the stack from which to get a value.
-     @return The value at the given index.
+     @return The value at the given index or -1 if the index is out of range.
      
      @} */
     
@@ -110,7 +134,11 @@ extern "C" {
     {
         
         tMempool mempool;
-        int data[STACK_SIZE];
+        uint32_t present[STACK_SIZE / 32]; // bitmap of values in the stack
+        int8_t next[STACK_SIZE]; // value at the following index, -1 at the end
+        int8_t prev[STACK_SIZE]; // value at the preceding index, -1 at the front
+        int8_t head;
+        int8_t tail;
         uint16_t pos;
         uint16_t size;
         uint16_t capacity;
@@ -131,6 +159,10 @@ extern "C" {
     int     tStack_first                (tStack* const stack);
     int     tStack_getSize              (tStack* const stack);
     int     tStack_contains             (tStack* const stack, uint16_t item);
+    int     tStack_has                  (tStack* const stack, uint16_t item);
+    int     tStack_last                 (tStack* const stack);
+    int     tStack_after                (tStack* const stack, uint16_t item);
+    int     tStack_before               (tStack* const stack, uint16_t item);
     int     tStack_next                 (tStack* const stack);
     int     tStack_get                  (tStack* const stack, int index);
     
@@ -252,6 +284,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tStack stack;
         tStack orderStack;
@@ -432,6 +465,302 @@ extern "C" {
 
     //==============================================================================
     
+    /*!
+     @defgroup tmidieventqueue tMidiEventQueue
+     @ingroup midi
+     @brief Lock-free queue of timestamped MIDI events with a sample-accurate block renderer.
+     @details One thread pushes events stamped with a sample offset into the next audio block, and the audio thread renders that block with tMidiEventQueue_renderBlock(). The block is split at each event so that note ons, note offs, and pitch bend reach the attached tPoly or tSimplePoly on the sample they were stamped with. Pushing and popping are safe from one producer and one consumer thread without locks.
+     @{
+     
+     @fn void    tMidiEventQueue_init            (tMidiEventQueue* const queue, int capacity, LEAF* const leaf)
+     @brief Initialize a tMidiEventQueue to the default mempool of a LEAF instance.
+     @param queue A pointer to the tMidiEventQueue to initialize.
+     @param capacity The maximum number of queued events. Rounded up to a power of two.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tMidiEventQueue_initToPool      (tMidiEventQueue* const queue, int capacity, tMempool* const pool)
+     @brief Initialize a tMidiEventQueue to a specified mempool.
+     @param queue A pointer to the tMidiEventQueue to initialize.
+     @param capacity The maximum number of queued events. Rounded up to a power of two.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tMidiEventQueue_free            (tMidiEventQueue* const queue)
+     @brief Free a tMidiEventQueue from its mempool.
+     @param queue A pointer to the tMidiEventQueue to free.
+     
+     @fn int     tMidiEventQueue_push            (tMidiEventQueue* const queue, uint32_t offset, uint8_t status, uint8_t data1, uint8_t data2)
+     @brief Push an event from the producer thread. Events should be pushed in order of offset.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param offset The sample offset of the event into the next rendered block. Offsets past the end of the block are clamped to its last sample.
+     @param status The MIDI status byte.
+     @param data1 The first MIDI data byte.
+     @param data2 The second MIDI data byte.
+     @return 1 if the event was queued, 0 if the queue was full and the event was dropped.
+     
+     @fn int     tMidiEventQueue_pop             (tMidiEventQueue* const queue, tMidiEvent* const event)
+     @brief Pop the oldest event from the consumer thread.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param event A pointer to the tMidiEvent to fill.
+     @return 1 if an event was popped, 0 if the queue was empty.
+     
+     @fn int     tMidiEventQueue_getNumEvents    (tMidiEventQueue* const queue)
+     @brief Get the number of events currently in the queue.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     
+     @fn uint32_t tMidiEventQueue_getNumDropped  (tMidiEventQueue* const queue)
+     @brief Get the number of events dropped because the queue was full.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     
+     @fn void    tMidiEventQueue_setPoly         (tMidiEventQueue* const queue, tPoly* const poly)
+     @brief Set a tPoly to receive note on, note off, and pitch bend events. Pass NULL to detach.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param poly A pointer to the tPoly.
+     
+     @fn void    tMidiEventQueue_setSimplePoly   (tMidiEventQueue* const queue, tSimplePoly* const poly)
+     @brief Set a tSimplePoly to receive note on and note off events. Pass NULL to detach.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param poly A pointer to the tSimplePoly.
+     
+     @fn void    tMidiEventQueue_setPitchBendRange (tMidiEventQueue* const queue, Lfloat semitones)
+     @brief Set the pitch bend range used when passing pitch bend to a tPoly.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param semitones The bend in semitones at full deflection. Defaults to 2.
+     
+     @fn void    tMidiEventQueue_setEventCallback (tMidiEventQueue* const queue, void (*callback)(void* userData, tMidiEvent event), void* userData)
+     @brief Set a function to receive every event at its sample position, after any poly handler has been updated.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param callback The event function, or NULL.
+     @param userData A pointer passed back to the event function.
+     
+     @fn void    tMidiEventQueue_renderBlock     (tMidiEventQueue* const queue, int blockSize, void (*render)(void* userData, int offset, int numSamples), void* userData)
+     @brief Render a block, dispatching the events queued for it at their sample offsets.
+     @param queue A pointer to the relevant tMidiEventQueue.
+     @param blockSize The number of samples in the block.
+     @param render A function that renders numSamples samples starting offset samples into the block. Called once for each span between events.
+     @param userData A pointer passed back to the render function.
+     
+     @} */
+    
+    typedef struct tMidiEvent
+    {
+        uint32_t offset;
+        uint8_t status;
+        uint8_t data1;
+        uint8_t data2;
+    } tMidiEvent;
+    
+    typedef struct _tMidiEventQueue
+    {
+        tMempool mempool;
+        
+        tMidiEvent* events;
+        uint32_t mask;
+        volatile uint32_t writeIndex;
+        volatile uint32_t readIndex;
+        volatile uint32_t dropped;
+        
+        tPoly* poly;
+        tSimplePoly* simplePoly;
+        Lfloat bendRange;
+        
+        void (*eventCallback)(void* userData, tMidiEvent event);
+        void* eventUserData;
+    } _tMidiEventQueue;
+    
+    typedef _tMidiEventQueue* tMidiEventQueue;
+    
+    void    tMidiEventQueue_init            (tMidiEventQueue* const queue, int capacity, LEAF* const leaf);
+    void    tMidiEventQueue_initToPool      (tMidiEventQueue* const queue, int capacity, tMempool* const pool);
+    void    tMidiEventQueue_free            (tMidiEventQueue* const queue);
+    
+    int     tMidiEventQueue_push            (tMidiEventQueue* const queue, uint32_t offset, uint8_t status, uint8_t data1, uint8_t data2);
+    int     tMidiEventQueue_pop             (tMidiEventQueue* const queue, tMidiEvent* const event);
+    int     tMidiEventQueue_getNumEvents    (tMidiEventQueue* const queue);
+    uint32_t tMidiEventQueue_getNumDropped  (tMidiEventQueue* const queue);
+    void    tMidiEventQueue_setPoly         (tMidiEventQueue* const queue, tPoly* const poly);
+    void    tMidiEventQueue_setSimplePoly   (tMidiEventQueue* const queue, tSimplePoly* const poly);
+    void    tMidiEventQueue_setPitchBendRange (tMidiEventQueue* const queue, Lfloat semitones);
+    void    tMidiEventQueue_setEventCallback (tMidiEventQueue* const queue, void (*callback)(void* userData, tMidiEvent event), void* userData);
+    void    tMidiEventQueue_renderBlock     (tMidiEventQueue* const queue, int blockSize, void (*render)(void* userData, int offset, int numSamples), void* userData);
+    
+    //==============================================================================
+    
+    /*!
+     @defgroup tmpepoly tMPEPoly
+     @ingroup midi
+     @brief MPE polyphony handler with smoothed per-voice pitch bend, pressure, and timbre.
+     @details Voices are allocated by an internal tSimplePoly. Each sounding note remembers the channel it arrived on, so pitch bend, channel pressure, and CC74 (timbre) on a member channel only affect that note's voice, while the same messages on the master channel reach every voice. Polyphonic aftertouch only affects the voice playing its note. Expression for all voices is stored in contiguous arrays and smoothed with linear ramps once per block by tMPEPoly_tickBlock(), rather than with one tRamp object per voice and dimension.
+     @{
+     
+     @fn void    tMPEPoly_init                 (tMPEPoly* const poly, int maxNumVoices, LEAF* const leaf)
+     @brief Initialize a tMPEPoly to the default mempool of a LEAF instance.
+     @param poly A pointer to the tMPEPoly to initialize.
+     @param maxNumVoices The maximum number of voices this tMPEPoly can handle at once.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tMPEPoly_initToPool           (tMPEPoly* const poly, int maxNumVoices, tMempool* const pool)
+     @brief Initialize a tMPEPoly to a specified mempool.
+     @param poly A pointer to the tMPEPoly to initialize.
+     @param maxNumVoices The maximum number of voices this tMPEPoly can handle at once.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tMPEPoly_free                 (tMPEPoly* const poly)
+     @brief Free a tMPEPoly from its mempool.
+     @param poly A pointer to the tMPEPoly to free.
+     
+     @fn int     tMPEPoly_noteOn               (tMPEPoly* const poly, int channel, int note, uint8_t vel)
+     @brief Add a note on a given channel. The voice starts from the expression last received on that channel without smoothing.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param note The MIDI note number.
+     @param vel The MIDI velocity.
+     @return The voice that will play the note, or -1.
+     
+     @fn int     tMPEPoly_noteOff              (tMPEPoly* const poly, int channel, int note)
+     @brief Remove a note. Ignored unless the note was last started on the same channel.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param note The MIDI note number.
+     @return The voice that was playing the note, or -1 if none was freed.
+     
+     @fn void    tMPEPoly_setPitchBend         (tMPEPoly* const poly, int channel, int value)
+     @brief Set the pitch bend of a channel. Bend on the master channel applies to all voices.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param value The 14-bit pitch bend value, 0 to 16383 with 8192 at center.
+     
+     @fn void    tMPEPoly_setPressure          (tMPEPoly* const poly, int channel, int value)
+     @brief Set the pressure of a channel. Pressure on the master channel applies to all channels.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param value The pressure, 0 to 127.
+     
+     @fn void    tMPEPoly_setNotePressure      (tMPEPoly* const poly, int channel, int note, int value)
+     @brief Set the pressure of one note, as sent by polyphonic aftertouch. Ignored unless the note is playing and was started on the same channel.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param note The MIDI note number.
+     @param value The pressure, 0 to 127.
+     
+     @fn void    tMPEPoly_setTimbre            (tMPEPoly* const poly, int channel, int value)
+     @brief Set the timbre (CC74) of a channel. Timbre on the master channel applies to all channels.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param channel The MIDI channel, 0 to 15.
+     @param value The timbre, 0 to 127.
+     
+     @fn void    tMPEPoly_processMessage       (tMPEPoly* const poly, uint8_t status, uint8_t data1, uint8_t data2)
+     @brief Parse a raw MIDI message and apply it. Can be used as the event callback of a tMidiEventQueue.
+     @param poly A pointer to the relevant tMPEPoly.
+     
+     @fn void    tMPEPoly_tickBlock            (tMPEPoly* const poly, int numSamples)
+     @brief Advance the expression ramps of every voice by a block of samples.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param numSamples The number of samples in the block.
+     
+     @fn void    tMPEPoly_setMasterChannel     (tMPEPoly* const poly, int channel)
+     @brief Set the master channel of the MPE zone. Defaults to channel 0 (MIDI channel 1).
+     @param poly A pointer to the relevant tMPEPoly.
+     
+     @fn void    tMPEPoly_setPitchBendRange    (tMPEPoly* const poly, Lfloat memberSemitones, Lfloat masterSemitones)
+     @brief Set the pitch bend ranges of the member and master channels. Default to 48 and 2 semitones.
+     @param poly A pointer to the relevant tMPEPoly.
+     
+     @fn void    tMPEPoly_setSmoothingTime     (tMPEPoly* const poly, Lfloat time)
+     @brief Set how long expression changes take to ramp in.
+     @param poly A pointer to the relevant tMPEPoly.
+     @param time The ramp time in milliseconds.
+     
+     @fn Lfloat  tMPEPoly_getPitch             (tMPEPoly* const poly, int voice)
+     @brief Get the pitch of a voice, including member and master pitch bend.
+     @return The pitch as a fractional MIDI note number.
+     
+     @fn Lfloat  tMPEPoly_getPressure          (tMPEPoly* const poly, int voice)
+     @brief Get the smoothed pressure of a voice, from 0 to 1.
+     
+     @fn Lfloat  tMPEPoly_getTimbre            (tMPEPoly* const poly, int voice)
+     @brief Get the smoothed timbre of a voice, from 0 to 1.
+     
+     @fn Lfloat* tMPEPoly_getExpressionArray   (tMPEPoly* const poly, MPEDimension dimension)
+     @brief Get the smoothed values of one expression dimension for all voices, indexed by voice.
+     
+     @fn int     tMPEPoly_getKey               (tMPEPoly* const poly, int voice)
+     @brief Get the MIDI note number of a voice, or -1 if it is inactive.
+     
+     @fn int     tMPEPoly_getVelocity          (tMPEPoly* const poly, int voice)
+     @brief Get the MIDI velocity of a voice.
+     
+     @fn int     tMPEPoly_getChannel           (tMPEPoly* const poly, int voice)
+     @brief Get the channel of the note a voice is playing.
+     
+     @fn void    tMPEPoly_setSampleRate        (tMPEPoly* const poly, Lfloat sr)
+     @brief Set the sample rate used for smoothing.
+     
+     @} */
+    
+    typedef enum MPEDimension
+    {
+        MPEPitchBend = 0,
+        MPEPressure,
+        MPETimbre,
+        MPEDimensionNil
+    } MPEDimension;
+    
+    typedef struct _tMPEPoly
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        
+        tSimplePoly poly;
+        int maxNumVoices;
+        
+        int masterChannel;
+        Lfloat memberBendRange;
+        Lfloat masterBendRange;
+        Lfloat masterBend;
+        
+        // last expression received on each channel, in output units
+        Lfloat channelState[16][MPEDimensionNil];
+        int noteChannels[128];
+        int* voiceChannels;
+        
+        // [dimension * maxNumVoices + voice]
+        Lfloat* values;
+        Lfloat* targets;
+        Lfloat* incs;
+        
+        Lfloat sampleRate;
+        Lfloat time;
+        Lfloat factor;
+    } _tMPEPoly;
+    
+    typedef _tMPEPoly* tMPEPoly;
+    
+    void    tMPEPoly_init                 (tMPEPoly* const poly, int maxNumVoices, LEAF* const leaf);
+    void    tMPEPoly_initToPool           (tMPEPoly* const poly, int maxNumVoices, tMempool* const pool);
+    void    tMPEPoly_free                 (tMPEPoly* const poly);
+    
+    int     tMPEPoly_noteOn               (tMPEPoly* const poly, int channel, int note, uint8_t vel);
+    int     tMPEPoly_noteOff              (tMPEPoly* const poly, int channel, int note);
+    void    tMPEPoly_setPitchBend         (tMPEPoly* const poly, int channel, int value);
+    void    tMPEPoly_setPressure          (tMPEPoly* const poly, int channel, int value);
+    void    tMPEPoly_setNotePressure      (tMPEPoly* const poly, int channel, int note, int value);
+    void    tMPEPoly_setTimbre            (tMPEPoly* const poly, int channel, int value);
+    void    tMPEPoly_processMessage       (tMPEPoly* const poly, uint8_t status, uint8_t data1, uint8_t data2);
+    void    tMPEPoly_tickBlock            (tMPEPoly* const poly, int numSamples);
+    void    tMPEPoly_setMasterChannel     (tMPEPoly* const poly, int channel);
+    void    tMPEPoly_setPitchBendRange    (tMPEPoly* const poly, Lfloat memberSemitones, Lfloat masterSemitones);
+    void    tMPEPoly_setSmoothingTime     (tMPEPoly* const poly, Lfloat time);
+    Lfloat  tMPEPoly_getPitch             (tMPEPoly* const poly, int voice);
+    Lfloat  tMPEPoly_getPressure          (tMPEPoly* const poly, int voice);
+    Lfloat  tMPEPoly_getTimbre            (tMPEPoly* const poly, int voice);
+    Lfloat* tMPEPoly_getExpressionArray   (tMPEPoly* const poly, MPEDimension dimension);
+    int     tMPEPoly_getKey               (tMPEPoly* const poly, int voice);
+    int     tMPEPoly_getVelocity          (tMPEPoly* const poly, int voice);
+    int     tMPEPoly_getChannel           (tMPEPoly* const poly, int voice);
+    void    tMPEPoly_setSampleRate        (tMPEPoly* const poly, Lfloat sr);
+    
+    //==============================================================================
+    
 #ifdef __cplusplus
 }
 #endif
@@ -64,12 +64,14 @@ extern "C" {
     typedef struct _tCycle
     {
         tMempool mempool;
+        LEAFObjectNode node;
         // Underlying phasor
         uint32_t phase;
         int32_t inc;
 		Lfloat freq;
         Lfloat invSampleRateTimesTwoTo32;
         uint32_t mask;
+        const Lfloat* table;
     } _tCycle;
     
     typedef _tCycle* tCycle;
@@ -120,6 +122,7 @@ extern "C" {
     typedef struct _tTriangle
     {
         tMempool mempool;
+        LEAFObjectNode node;
         // Underlying phasor
         uint32_t phase;
         int32_t inc;
@@ -129,6 +132,7 @@ extern "C" {
         Lfloat invSampleRate;
         Lfloat invSampleRateTimesTwoTo32;
         uint32_t mask;
+        const Lfloat (*table)[TRI_TABLE_SIZE];
     } _tTriangle;
     
     typedef _tTriangle* tTriangle;
@@ -179,6 +183,7 @@ extern "C" {
     typedef struct _tSquare
     {
         tMempool mempool;
+        LEAFObjectNode node;
         // Underlying phasor
         uint32_t phase;
         int32_t inc;
@@ -188,6 +193,7 @@ extern "C" {
         Lfloat invSampleRate;
         Lfloat invSampleRateTimesTwoTo32;
         uint32_t mask;
+        const Lfloat (*table)[SQR_TABLE_SIZE];
     } _tSquare;
     
     typedef _tSquare* tSquare;
@@ -241,6 +247,7 @@ extern "C" {
     typedef struct _tSawtooth
     {
         tMempool mempool;
+        LEAFObjectNode node;
         // Underlying phasor
         uint32_t phase;
         int32_t inc;
@@ -250,6 +257,7 @@ extern "C" {
         Lfloat invSampleRate;
         Lfloat invSampleRateTimesTwoTo32;
         uint32_t mask;
+        const Lfloat (*table)[SAW_TABLE_SIZE];
     } _tSawtooth;
     
     typedef _tSawtooth* tSawtooth;
@@ -302,6 +310,7 @@ extern "C" {
     typedef struct _tPBSineTriangle
     {
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         tCycle sine;
         int32_t inc;
@@ -338,6 +347,7 @@ extern "C" {
     typedef struct _tPBTriangle
     {
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -405,6 +415,7 @@ extern "C" {
     typedef struct _tPBPulse
     {
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -468,6 +479,7 @@ extern "C" {
     typedef struct _tPBSaw
     {
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -495,11 +507,75 @@ extern "C" {
 #endif
     void    tPBSaw_setSampleRate (tPBSaw* const osc, Lfloat sr);
     
+#ifdef SIMD_64
+    //==============================================================================
+    
+    /*!
+     @defgroup tpolypbsaw tPolyPBSaw
+     @ingroup oscillators
+     @brief Saw wave oscillator with polyBLEP anti-aliasing, running POLY_FLOAT_LANES voices at once. Only available when SIMD_64 is defined.
+     @{
+     
+     @fn void    tPolyPBSaw_init          (tPolyPBSaw* const osc, LEAF* const leaf)
+     @brief Initialize a tPolyPBSaw to the default mempool of a LEAF instance.
+     @param osc A pointer to the tPolyPBSaw to initialize.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tPolyPBSaw_initToPool    (tPolyPBSaw* const osc, tMempool* const mempool)
+     @brief Initialize a tPolyPBSaw to a specified mempool.
+     @param osc A pointer to the tPolyPBSaw to initialize.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPolyPBSaw_free          (tPolyPBSaw* const osc)
+     @brief Free a tPolyPBSaw from its mempool.
+     @param osc A pointer to the tPolyPBSaw to free.
+     
+     @fn poly_float tPolyPBSaw_tick        (tPolyPBSaw* const osc)
+     @brief Tick every voice.
+     @param osc A pointer to the relevant tPolyPBSaw.
+     @return One sample per voice.
+     
+     @fn void    tPolyPBSaw_setFreq       (tPolyPBSaw* const osc, int voice, Lfloat freq)
+     @brief Set the frequency of one voice.
+     @param osc A pointer to the relevant tPolyPBSaw.
+     @param voice The lane of the voice.
+     @param freq The frequency in Hz.
+     
+     @fn void    tPolyPBSaw_setFreqs      (tPolyPBSaw* const osc, poly_float freqs)
+     @brief Set the frequency of every voice.
+     @param osc A pointer to the relevant tPolyPBSaw.
+     @param freqs The frequencies in Hz, one per lane.
+     
+     @} */
+    
+    typedef struct _tPolyPBSaw
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+        Lfloat phase[POLY_FLOAT_LANES];
+        Lfloat inc[POLY_FLOAT_LANES];
+        Lfloat freq[POLY_FLOAT_LANES];
+        Lfloat invSampleRate;
+    } _tPolyPBSaw;
+    
+    typedef _tPolyPBSaw* tPolyPBSaw;
+    
+    void    tPolyPBSaw_init          (tPolyPBSaw* const osc, LEAF* const leaf);
+    void    tPolyPBSaw_initToPool    (tPolyPBSaw* const osc, tMempool* const mempool);
+    void    tPolyPBSaw_free          (tPolyPBSaw* const osc);
+    
+    poly_float tPolyPBSaw_tick        (tPolyPBSaw* const osc);
+    void    tPolyPBSaw_setFreq       (tPolyPBSaw* const osc, int voice, Lfloat freq);
+    void    tPolyPBSaw_setFreqs      (tPolyPBSaw* const osc, poly_float freqs);
+    void    tPolyPBSaw_setSampleRate (tPolyPBSaw* const osc, Lfloat sr);
+#endif // SIMD_64
+    
     //==============================================================================
     
 typedef struct _tPBSawSquare
 {
     tMempool mempool;
+    LEAFObjectNode node;
     uint32_t phase;
     int32_t inc;
     Lfloat freq;
@@ -535,6 +611,7 @@ void    tPBSawSquare_setSampleRate (tPBSawSquare* const osc, Lfloat sr);
     typedef struct _tSawOS
     {
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -594,6 +671,7 @@ void    tPBSawSquare_setSampleRate (tPBSawSquare* const osc, Lfloat sr);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -768,6 +846,7 @@ void    tPBSawSquare_setSampleRate (tPBSawSquare* const osc, Lfloat sr);
     typedef struct _tNeuron
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         tPoleZero f;
         
@@ -848,6 +927,13 @@ void    tPBSawSquare_setSampleRate (tPBSawSquare* const osc, Lfloat sr);
      @fn void tMBPulse_setSyncMode(tMBPulse* const osc, int hardOrSoft)
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
+     
+     @fn void tMBPulse_tickBlock(tMBPulse* const osc, Lfloat* out, int size)
+     @brief Render a block of samples. Each BLEP is added into the block once, when its discontinuity occurs, rather than walking the active BLEP list every sample. Equivalent to calling tMBPulse_tick size times, to within float rounding.
+     @param osc A pointer to the relevant tMBPulse.
+     @param out The buffer to write the samples to.
+     @param size The number of samples to render.
+     
      ￼￼￼
      @} */
     
@@ -855,6 +941,7 @@ void    tPBSawSquare_setSampleRate (tPBSawSquare* const osc, Lfloat sr);
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat    out;
         Lfloat    freq;
         Lfloat    waveform;    // duty cycle, must be in [-1, 1]
@@ -886,6 +973,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
 void tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
 #endif
     Lfloat tMBPulse_tick(tMBPulse* const osc);
+    void tMBPulse_tickBlock(tMBPulse* const osc, Lfloat* out, int size);
     void tMBPulse_setFreq(tMBPulse* const osc, Lfloat f);
     void tMBPulse_setWidth(tMBPulse* const osc, Lfloat w);
     Lfloat tMBPulse_sync(tMBPulse* const osc, Lfloat sync);
@@ -932,12 +1020,19 @@ void tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phas
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
 
+     @fn void tMBTriangle_tickBlock(tMBTriangle* const osc, Lfloat* out, int size)
+     @brief Render a block of samples. Each BLEP is added into the block once, when its discontinuity occurs, rather than walking the active BLEP list every sample. Equivalent to calling tMBTriangle_tick size times, to within float rounding.
+     @param osc A pointer to the relevant tMBTriangle.
+     @param out The buffer to write the samples to.
+     @param size The number of samples to render.
+     
      @} */
     
     typedef struct _tMBTriangle
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat    out;
         Lfloat    freq;
         Lfloat    waveform;    // duty cycle, must be in [-1, 1]
@@ -970,6 +1065,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTri
 void tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
 #endif
     Lfloat tMBTriangle_tick(tMBTriangle* const osc);
+    void tMBTriangle_tickBlock(tMBTriangle* const osc, Lfloat* out, int size);
     void tMBTriangle_setFreq(tMBTriangle* const osc, Lfloat f);
     void tMBTriangle_setWidth(tMBTriangle* const osc, Lfloat w);
     Lfloat tMBTriangle_sync(tMBTriangle* const osc, Lfloat sync);
@@ -986,6 +1082,7 @@ void tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat pha
     {
 
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat    out;
         Lfloat    freq;
         Lfloat    waveform;    // duty cycle, must be in [-1, 1]
@@ -1007,6 +1104,7 @@ void tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat pha
         Lfloat 	BLEPproperties[64][3];
         Lfloat invSampleRate;
         uint32_t sineMask;
+        const Lfloat* sineTable;
     } _tMBSineTri;
 
     typedef _tMBSineTri* tMBSineTri;
@@ -1067,12 +1165,20 @@ void tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase
      @fn void tMBSaw_setSyncMode(tMBSaw* const osc, int hardOrSoft)
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
+     
+     @fn void tMBSaw_tickBlock(tMBSaw* const osc, Lfloat* out, int size)
+     @brief Render a block of samples. Each BLEP is added into the block once, when its discontinuity occurs, rather than walking the active BLEP list every sample. Equivalent to calling tMBSaw_tick size times, to within float rounding.
+     @param osc A pointer to the relevant tMBSaw.
+     @param out The buffer to write the samples to.
+     @param size The number of samples to render.
+     
      ￼￼￼
      @} */
     
     typedef struct _tMBSaw
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat    out;
         Lfloat    freq;
         Lfloat    lastsyncin;
@@ -1097,6 +1203,7 @@ void tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase
     void tMBSaw_initToPool(tMBSaw* const osc, tMempool* const mempool);
     void tMBSaw_free(tMBSaw* const osc);
     Lfloat tMBSaw_tick(tMBSaw* const osc);
+    void tMBSaw_tickBlock(tMBSaw* const osc, Lfloat* out, int size);
     void tMBSaw_setFreq(tMBSaw* const osc, Lfloat f);
     Lfloat tMBSaw_sync(tMBSaw* const osc, Lfloat sync);
     void tMBSaw_setPhase(tMBSaw* const osc, Lfloat phase);
@@ -1148,12 +1255,20 @@ void tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase
      @fn void tMBSaw_setSyncMode(tMBSaw* const osc, int hardOrSoft)
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
+     
+     @fn void tMBSawPulse_tickBlock(tMBSawPulse* const osc, Lfloat* out, int size)
+     @brief Render a block of samples. Each BLEP is added into the block once, when its discontinuity occurs, rather than walking the active BLEP list every sample. Equivalent to calling tMBSawPulse_tick size times, to within float rounding.
+     @param osc A pointer to the relevant tMBSawPulse.
+     @param out The buffer to write the samples to.
+     @param size The number of samples to render.
+     
      ￼￼￼
      @} */
 
     typedef struct _tMBSawPulse
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat    out;
         Lfloat    freq;
         Lfloat    lastsyncin;
@@ -1188,6 +1303,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
 #endif
     Lfloat tMBSawPulse_tick(tMBSawPulse* const osc);
+    void tMBSawPulse_tickBlock(tMBSawPulse* const osc, Lfloat* out, int size);
     void tMBSawPulse_setFreq(tMBSawPulse* const osc, Lfloat f);
     Lfloat tMBSawPulse_sync(tMBSawPulse* const osc, Lfloat sync);
     void tMBSawPulse_setPhase(tMBSawPulse* const osc, Lfloat phase);
@@ -1236,6 +1352,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tTable
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat* waveTable;
         int size;
@@ -1289,6 +1406,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tWaveTable
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat* baseTable;
         Lfloat** tables;
@@ -1357,6 +1475,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tWaveOsc
        {
            tMempool mempool;
+           LEAFObjectNode node;
            tWaveTable* tables;
            int numTables;
            Lfloat index;
@@ -1427,6 +1546,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tWaveTableS
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat* baseTable;
         Lfloat** tables;
@@ -1495,6 +1615,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tWaveOscS
     {
         tMempool mempool;
+        LEAFObjectNode node;
         
         //tWaveTableS* tables;
 
@@ -1575,6 +1696,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         uint32_t phase;
         uint32_t inc;
         Lfloat freq;
@@ -1631,6 +1753,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat pulsewidth;
         tIntPhasor phasor;
         tIntPhasor invPhasor;
@@ -1651,6 +1774,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tSawSquareLFO
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat shape;
         tIntPhasor saw;
         tSquareLFO square;
@@ -1703,6 +1827,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         int32_t phase;
         int32_t inc;
         Lfloat freq;
@@ -1725,6 +1850,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
     typedef struct _tSineTriLFO
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat shape;
         tTriLFO tri;
         tCycle sine;
@@ -1749,6 +1875,7 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
 typedef struct _tDampedOscillator
 	{
 		tMempool mempool;
+		LEAFObjectNode node;
 
 		Lfloat freq_;
 		Lfloat decay_;
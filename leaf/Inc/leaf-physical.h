@@ -96,6 +96,7 @@ Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity* const p, Lfloat
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tAllpassDelay     delayLine; // Allpass or Linear??  big difference...
         tOneZero    loopFilter;
@@ -200,6 +201,7 @@ Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity* const p, Lfloat
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         tAllpassDelay  delayLine;
         tLinearDelay combDelay;
@@ -237,6 +239,7 @@ Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity* const p, Lfloat
     void    tKarplusStrong_setPickupPosition  (tKarplusStrong* const, Lfloat position );
     void    tKarplusStrong_setBaseLoopGain    (tKarplusStrong* const, Lfloat aGain );
     Lfloat   tKarplusStrong_getLastOut         (tKarplusStrong* const);
+    void    tKarplusStrong_setSampleRate      (tKarplusStrong* const, Lfloat sr);
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
@@ -306,6 +309,7 @@ Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity* const p, Lfloat
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq, waveLengthInSamples;        // the frequency of the string, determining delay length
         Lfloat dampFreq;    // frequency for the bridge LP filter, in Hz
         Lfloat decay; // amplitude damping factor for the string (only active in mode 0)
@@ -350,6 +354,7 @@ Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity* const p, Lfloat
     {
 
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq, waveLengthInSamples;        // the frequency of the string, determining delay length
         Lfloat brightness;    // frequency for the bridge LP filter, in Hz
         Lfloat decay; // amplitude damping factor for the string (only active in mode 0)
@@ -392,6 +397,7 @@ typedef struct _tSimpleLivingString3
 {
     
     tMempool mempool;
+    LEAFObjectNode node;
     Lfloat freq, waveLengthInSamples;        // the frequency of the string, determining delay length
     Lfloat dampFreq;    // frequency for the bridge LP filter, in Hz
     Lfloat decay, userDecay; // amplitude damping factor for the string (only active in mode 0)
@@ -448,6 +454,7 @@ typedef struct _tSimpleLivingString4
 {
     
     tMempool mempool;
+    LEAFObjectNode node;
     Lfloat freq, waveLengthInSamples;        // the frequency of the string, determining delay length
     Lfloat dampFreq;    // frequency for the bridge LP filter, in Hz
     Lfloat decay, userDecay; // amplitude damping factor for the string (only active in mode 0)
@@ -507,6 +514,7 @@ typedef struct _tSimpleLivingString5
 {
     
     tMempool mempool;
+    LEAFObjectNode node;
     Lfloat freq, waveLengthInSamples;        // the frequency of the string, determining delay length
     Lfloat dampFreq;    // frequency for the bridge LP filter, in Hz
     Lfloat decay, userDecay; // amplitude damping factor for the string (only active in mode 0)
@@ -642,11 +650,16 @@ void   tSimpleLivingString5_setFFAmount(tSimpleLivingString5* const pl, Lfloat f
      @brief
      @param string A pointer to the relevant tLivingString.
      
+     @fn void    tLivingString_clear                 (tLivingString* const)
+     @brief Silence the string by zeroing its delay lines and filter states.
+     @param string A pointer to the relevant tLivingString.
+     
      @} */
     
     typedef struct _tLivingString
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq, waveLengthInSamples;        // the frequency of the whole string, determining delay length
         Lfloat pickPos;    // the pick position, dividing the string in two, in ratio
         Lfloat prepIndex;    // the amount of pressure on the pickpoint of the string (near 0=soft obj, near 1=hard obj)
@@ -685,6 +698,7 @@ void   tSimpleLivingString5_setFFAmount(tSimpleLivingString5* const pl, Lfloat f
     void    tLivingString_setLevStrength        (tLivingString* const, Lfloat levStrength);
     void    tLivingString_setLevMode            (tLivingString* const, int levMode);
     void    tLivingString_setSampleRate         (tLivingString* const, Lfloat sr);
+    void    tLivingString_clear                 (tLivingString* const);
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
@@ -768,6 +782,7 @@ void   tSimpleLivingString5_setFFAmount(tSimpleLivingString5* const pl, Lfloat f
     typedef struct _tLivingString2
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq, waveLengthInSamples;        // the frequency of the whole string, determining delay length
         Lfloat pickPos;    // the pick position, dividing the string in two, in ratio
         Lfloat prepPos;    // the preparation position, dividing the string in two, in ratio
@@ -894,6 +909,7 @@ void   tSimpleLivingString5_setFFAmount(tSimpleLivingString5* const pl, Lfloat f
     typedef struct _tComplexLivingString
     {
         tMempool mempool;
+        LEAFObjectNode node;
         Lfloat freq, waveLengthInSamples;        // the frequency of the whole string, determining delay length
         Lfloat pickPos;    // the pick position, dividing the string, in ratio
         Lfloat prepPos;    // preparation position, in ratio
@@ -1211,6 +1227,7 @@ void    tTString_setPickupAmount               (tTString* const bw, Lfloat amoun
 typedef struct _tStiffString
     {
         tMempool mempool;
+        LEAFObjectNode node;
         int numModes;
         tCycle *osc; // array of oscillators
         Lfloat *amplitudes;
@@ -1251,6 +1268,7 @@ typedef struct _tStiffString
     void tStiffString_updateOscillators(tStiffString* const pm);
     void tStiffString_updateOutputWeights(tStiffString* const pm);
     void tStiffString_mute(tStiffString* const pm);
+    void tStiffString_setSampleRate(tStiffString* const pm, Lfloat sr);
 
     void tStiffString_setStiffnessNoUpdate(tStiffString* const, Lfloat newValue);
     void tStiffString_setFreqNoUpdate(tStiffString* const, Lfloat newFreq);
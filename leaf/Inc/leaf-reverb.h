@@ -74,6 +74,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat mix, t60;
         
@@ -123,7 +124,7 @@ extern "C" {
      @param reverb A pointer to the tNReverb to free.
      
      @fn void    tNReverb_clear          (tNReverb* const)
-     @brief
+     @brief Zero the reverb's delay lines and damping filter.
      @param reverb A pointer to the relevant tNReverb.
      
      @fn Lfloat   tNReverb_tick           (tNReverb* const, Lfloat input)
@@ -148,6 +149,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat mix, t60;
         
@@ -248,6 +250,7 @@ extern "C" {
     {
         
         tMempool mempool;
+        LEAFObjectNode node;
         
         Lfloat   sampleRate;
         Lfloat   predelay;
@@ -33,6 +33,146 @@ extern "C"
 
     //==============================================================================
 
+    /*!
+     @defgroup tsamplestream tSampleStream
+     @ingroup sampling
+     @brief Disk-streamed sample source for tBuffer and tSampler.
+     @details Disk-streamed sample source for tBuffer and tSampler. Only the first few milliseconds of a sample are kept in memory. The rest is read on demand through a user supplied read function and handed to the audio thread through a lock-free single producer, single consumer ring. Two more resident regions follow the sampler's start and end points so that retriggers and loop crossfades never wait on the disk. Attach a stream to a tBuffer with tBuffer_setStream() and play it with a tSampler as usual.
+
+     The read function is only called from tSampleStream_init() and tSampleStream_service(). A worker thread, or a low priority task on targets without threads, should call tSampleStream_service() regularly. Reads the audio thread could not be served in time return silence and are counted as underruns.
+
+     A stream follows a single play head, so a streamed tBuffer should be played by one tSampler at a time. Streaming is forward only. Reverse playback is served from the resident regions and the recent history kept in the ring.
+     @{
+
+     @fn void    tSampleStream_init          (tSampleStream* const, tSampleStreamReadFunc read, void* userData, uint32_t length, uint32_t channels, uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, LEAF* const leaf)
+     @brief Initialize a tSampleStream to the default mempool of a LEAF instance. The resident head is read immediately, so this should not be called from the audio thread.
+     @param stream A pointer to the tSampleStream to initialize.
+     @param read The function used to read interleaved frames from the sample. It returns the number of frames actually read.
+     @param userData A pointer passed back to the read function, such as a file handle.
+     @param length The length of the whole sample in frames.
+     @param channels The number of interleaved channels, 1 or 2.
+     @param sampleRate The sample rate of the sample.
+     @param headMs The length of the resident head in milliseconds. The start and end regions have the same length.
+     @param ringLength The length of the streaming ring in frames. Rounded up to a power of two.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tSampleStream_initToPool    (tSampleStream* const, tSampleStreamReadFunc read, void* userData, uint32_t length, uint32_t channels, uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, tMempool* const)
+     @brief Initialize a tSampleStream to a specified mempool.
+     @param stream A pointer to the tSampleStream to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tSampleStream_free          (tSampleStream* const)
+     @brief Free a tSampleStream from its mempool.
+     @param stream A pointer to the tSampleStream to free.
+
+     @fn uint32_t tSampleStream_service      (tSampleStream* const)
+     @brief Refill the start and end regions and the ring. Call from the streaming worker only.
+     @param stream A pointer to the relevant tSampleStream.
+     @return The number of frames read, 0 if the stream had nothing to do.
+
+     @fn void    tSampleStream_update        (tSampleStream* const, Lfloat position, int32_t startFrame, int32_t endFrame)
+     @brief Tell the stream where the play head is and which region to keep resident. tSampler calls this once per tick, so it only needs calling when reading the stream directly.
+     @param stream A pointer to the relevant tSampleStream.
+     @param position The current play position in frames.
+     @param startFrame The first frame of the region to keep resident, or -1 for none.
+     @param endFrame The last frame of the region to keep resident, or -1 for none.
+
+     @fn Lfloat   tSampleStream_get          (tSampleStream* const, int idx)
+     @brief Read one interleaved sample from the audio thread.
+     @param stream A pointer to the relevant tSampleStream.
+     @param idx The sample index, frame * channels + channel.
+     @return The sample, or 0 if it was not available.
+
+     @fn uint32_t tSampleStream_getNumUnderruns (tSampleStream* const)
+     @brief Get the number of reads that were not available in time.
+     @param stream A pointer to the relevant tSampleStream.
+     @return The number of underrun reads since initialization or the last reset.
+
+     @fn void    tSampleStream_resetUnderruns (tSampleStream* const)
+     @brief Reset the underrun counter. Call from the audio thread.
+     @param stream A pointer to the relevant tSampleStream.
+
+     @} */
+
+#define SAMPLE_STREAM_TAIL_LENGTH 4
+
+    typedef uint32_t (*tSampleStreamReadFunc)(void* userData, Lfloat* dest, uint32_t startFrame, uint32_t numFrames);
+
+    typedef struct _tSampleStreamRegion
+    {
+        Lfloat* data;
+
+        // written by the audio thread
+        int32_t request;
+        uint32_t epoch;
+
+        // written by the worker
+        uint32_t filled;
+        uint32_t fillEpoch;
+
+        // audio thread view, in interleaved samples
+        int valid;
+        uint32_t lo, hi;
+    } _tSampleStreamRegion;
+
+    typedef struct _tSampleStream
+    {
+
+        tMempool mempool;
+
+        tSampleStreamReadFunc read;
+        void* userData;
+
+        uint32_t length;
+        uint32_t channels;
+        uint32_t sampleRate;
+
+        Lfloat* head;
+        uint32_t headLength;
+        uint32_t headEnd;
+        Lfloat tail[SAMPLE_STREAM_TAIL_LENGTH * 2];
+        uint32_t tailStart;
+
+        _tSampleStreamRegion region[2];
+
+        Lfloat* ring;
+        uint32_t ringLength;
+        uint32_t ringMask;
+        uint32_t chunkLength;
+        uint32_t history;
+
+        // written by the audio thread
+        uint32_t seekFrame;
+        uint32_t seekEpoch;
+        uint32_t readPos;
+
+        // written by the worker
+        uint32_t writePos;
+        uint32_t fillEpoch;
+
+        // audio thread view, in interleaved samples
+        int ringValid;
+        uint32_t ringLo, ringHi;
+
+        uint32_t underruns;
+    } _tSampleStream;
+
+    typedef _tSampleStream *tSampleStream;
+
+    void tSampleStream_init(tSampleStream *const, tSampleStreamReadFunc read, void *userData, uint32_t length, uint32_t channels,
+                            uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, LEAF *const leaf);
+    void tSampleStream_initToPool(tSampleStream *const, tSampleStreamReadFunc read, void *userData, uint32_t length, uint32_t channels,
+                                  uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, tMempool *const mp);
+    void tSampleStream_free(tSampleStream *const);
+
+    uint32_t tSampleStream_service(tSampleStream *const);
+    void tSampleStream_update(tSampleStream *const, Lfloat position, int32_t startFrame, int32_t endFrame);
+    Lfloat tSampleStream_get(tSampleStream *const, int idx);
+    uint32_t tSampleStream_getNumUnderruns(tSampleStream *const);
+    void tSampleStream_resetUnderruns(tSampleStream *const);
+
+    //==============================================================================
+
     /*!
      @defgroup tbuffer tBuffer
      @ingroup sampling
@@ -52,6 +192,20 @@ extern "C"
      @param length The length of the buffer in samples.
      @param mempool A pointer to the tMempool to use.
 
+     @fn void  tBuffer_initWithFormat        (tBuffer* const, uint32_t length, BufferFormat format, LEAF* const leaf)
+     @brief Initialize a tBuffer with compact sample storage to the default mempool of a LEAF instance.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param length The length of the buffer in samples.
+     @param format The storage format, BufferFloat, BufferInt16 (half the memory) or BufferInt24 (packed, three quarters of the memory).
+     @param leaf A pointer to the leaf instance.
+
+     @fn void  tBuffer_initToPoolWithFormat  (tBuffer* const, uint32_t length, BufferFormat format, tMempool* const)
+     @brief Initialize a tBuffer with compact sample storage to a specified mempool.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param length The length of the buffer in samples.
+     @param format The storage format.
+     @param mempool A pointer to the tMempool to use.
+
      @fn void  tBuffer_free                  (tBuffer* const)
      @brief Free a tBuffer from its mempool.
      @param sampler A pointer to the tBuffer to free.
@@ -68,11 +222,18 @@ extern "C"
      @param length The length of the input buffer.
 
      @fn Lfloat tBuffer_get                   (tBuffer* const, int idx)
-     @brief Get the sample recorded at a given position in the buffer.
+     @brief Get the sample recorded at a given frame in the buffer. For an interleaved buffer this is the first channel.
      @param sampler A pointer to the relevant tBuffer.
-     @param position The position to get a sample from.
+     @param position The frame to get a sample from.
      @return The recorded sample.
 
+     @fn void  tBuffer_getBlock              (tBuffer* const, int idx, Lfloat* output, int size)
+     @brief Convert a run of frames from the buffer's storage format into an output array. Interleaved buffers give their first channel, and frames outside the buffer read as 0.
+     @param sampler A pointer to the relevant tBuffer.
+     @param position The first frame.
+     @param output The array to write to.
+     @param size The number of frames to convert.
+
      @fn void  tBuffer_record                (tBuffer* const)
      @brief Start recording samples into the buffer.
      @param sampler A pointer to the relevant tBuffer.
@@ -110,6 +271,25 @@ extern "C"
      @param sampler A pointer to the relevant tBuffer.
      @return The length in samples of recorded audio.
 
+     @fn void  tBuffer_setBufferWithFormat   (tBuffer* const sb, void* externalBuffer, int length, int channels, int sampleRate, BufferFormat format)
+     @brief Play from an external array stored in the given format, such as 16 bit audio loaded straight from a file.
+     @param sampler A pointer to the relevant tBuffer.
+     @param externalBuffer The interleaved sample data. int16_t for BufferInt16, packed little endian 3 byte samples for BufferInt24.
+     @param length The total number of samples in the array, across all channels.
+     @param channels The number of interleaved channels.
+     @param sampleRate The sample rate of the audio.
+     @param format The format of the array.
+
+     @fn void  tBuffer_setScale              (tBuffer* const sb, Lfloat scale)
+     @brief Set the factor integer samples are multiplied by when read. Defaults to 1/32768 for BufferInt16, 1/8388608 for BufferInt24 and 1 for BufferFloat. Recording divides by the same factor.
+     @param sampler A pointer to the relevant tBuffer.
+     @param scale The scaling factor.
+
+     @fn BufferFormat tBuffer_getFormat      (tBuffer* const sb)
+     @brief Get the storage format of the buffer.
+     @param sampler A pointer to the relevant tBuffer.
+     @return The storage format.
+
      @fn void     tBuffer_setRecordedLength    (tBuffer* const sb, int length)
      @brief Set the length of what is considered recorded audio in the buffer.
      @param sampler A pointer to the relevant tBuffer.
@@ -120,6 +300,11 @@ extern "C"
      @param sampler A pointer to the relevant tBuffer.
      @return 1 if recording, 0 if not.
 
+     @fn void    tBuffer_setStream           (tBuffer* const sb, tSampleStream* const stream)
+     @brief Play the buffer from a tSampleStream instead of its own memory. The buffer takes the length, channel count and sample rate of the stream, and can no longer be recorded into. Call tSampler_setSample() afterwards so that samplers pick up the new length.
+     @param sampler A pointer to the relevant tBuffer.
+     @param stream A pointer to the tSampleStream to read from.
+
      @} */
 
     typedef enum RecordMode
@@ -129,12 +314,24 @@ extern "C"
         RecordModeNil
     } RecordMode;
 
+    typedef enum BufferFormat
+    {
+        BufferFloat = 0,
+        BufferInt16,
+        BufferInt24,
+        BufferFormatNil
+    } BufferFormat;
+
     typedef struct _tBuffer
     {
 
         tMempool mempool;
 
         Lfloat *buff;
+        void *data;
+        BufferFormat format;
+        Lfloat scale;
+        Lfloat invScale;
 
         uint32_t idx;
         uint32_t bufferLength;
@@ -144,20 +341,28 @@ extern "C"
         RecordMode mode;
 
         int active;
+
+        tSampleStream stream;
     } _tBuffer;
 
     typedef _tBuffer *tBuffer;
 
     void tBuffer_init(tBuffer *const, uint32_t length, LEAF *const leaf);
     void tBuffer_initToPool(tBuffer *const sb, uint32_t length, tMempool *const mp);
+    void tBuffer_initWithFormat(tBuffer *const, uint32_t length, BufferFormat format, LEAF *const leaf);
+    void tBuffer_initToPoolWithFormat(tBuffer *const sb, uint32_t length, BufferFormat format, tMempool *const mp);
     void tBuffer_free(tBuffer *const);
 
     void tBuffer_tick(tBuffer *const, Lfloat sample);
     void tBuffer_read(tBuffer *const, Lfloat *buff, uint32_t len);
     Lfloat tBuffer_get(tBuffer *const, int idx);
+    void tBuffer_getBlock(tBuffer *const, int idx, Lfloat *output, int size);
     void tBuffer_record(tBuffer *const);
     void tBuffer_stop(tBuffer *const);
     void tBuffer_setBuffer(tBuffer *const sb, Lfloat *externalBuffer, int length, int channels, int sampleRate);
+    void tBuffer_setBufferWithFormat(tBuffer *const sb, void *externalBuffer, int length, int channels, int sampleRate, BufferFormat format);
+    void tBuffer_setScale(tBuffer *const sb, Lfloat scale);
+    BufferFormat tBuffer_getFormat(tBuffer *const sb);
     int tBuffer_getRecordPosition(tBuffer *const);
     void tBuffer_setRecordPosition(tBuffer *const, int pos);
     void tBuffer_setRecordMode(tBuffer *const, RecordMode mode);
@@ -166,6 +371,63 @@ extern "C"
     uint32_t tBuffer_getRecordedLength(tBuffer *const sb);
     void tBuffer_setRecordedLength(tBuffer *const sb, int length);
     int tBuffer_isActive(tBuffer *const sb);
+    void tBuffer_setStream(tBuffer *const sb, tSampleStream *const stream);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tsincinterpolator tSincInterpolator
+     @ingroup sampling
+     @brief Polyphase windowed-sinc interpolator for sample playback.
+     @details Polyphase windowed-sinc interpolator for sample playback. Holds a table of 16 tap Blackman windowed sinc kernels, precomputed into the mempool for a number of fractional phases and for several cutoffs. Kernels for adjacent phases are linearly interpolated. When playing back faster than the original rate, the cutoff is lowered in steps of one band per unit of playback rate so that pitching up doesn't alias. One table can be shared by any number of tSamplers and tMBSamplers with tSampler_setInterpolator() and tMBSampler_setInterpolator().
+     @{
+
+     @fn void    tSincInterpolator_init          (tSincInterpolator* const, int numPhases, int numBands, LEAF* const leaf)
+     @brief Initialize a tSincInterpolator to the default mempool of a LEAF instance.
+     @param interpolator A pointer to the tSincInterpolator to initialize.
+     @param numPhases The number of fractional positions to precompute. 128 to 512 is typical.
+     @param numBands The number of cutoffs to precompute. Band n is used for playback rates up to n + 1 times the original, so 4 covers two octaves up. Faster rates use the last band.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tSincInterpolator_initToPool    (tSincInterpolator* const, int numPhases, int numBands, tMempool* const)
+     @brief Initialize a tSincInterpolator to a specified mempool.
+     @param interpolator A pointer to the tSincInterpolator to initialize.
+     @param numPhases The number of fractional positions to precompute.
+     @param numBands The number of cutoffs to precompute.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tSincInterpolator_free          (tSincInterpolator* const)
+     @brief Free a tSincInterpolator from its mempool.
+     @param interpolator A pointer to the tSincInterpolator to free.
+
+     @fn Lfloat   tSincInterpolator_tick          (tSincInterpolator* const, const Lfloat* input, Lfloat alpha, Lfloat rate)
+     @brief Interpolate between two samples.
+     @param interpolator A pointer to the relevant tSincInterpolator.
+     @param input SINC_TAPS consecutive samples. The result lies between input[SINC_TAPS / 2 - 1] and input[SINC_TAPS / 2].
+     @param alpha The fractional position between those two samples, from 0 to 1.
+     @param rate The absolute playback rate, used to pick the cutoff.
+     @return The interpolated sample.
+
+     @} */
+
+#define SINC_TAPS 16
+
+    typedef struct _tSincInterpolator
+    {
+        tMempool mempool;
+
+        Lfloat* table;
+        int numPhases;
+        int numBands;
+    } _tSincInterpolator;
+
+    typedef _tSincInterpolator *tSincInterpolator;
+
+    void tSincInterpolator_init(tSincInterpolator *const, int numPhases, int numBands, LEAF *const leaf);
+    void tSincInterpolator_initToPool(tSincInterpolator *const, int numPhases, int numBands, tMempool *const mp);
+    void tSincInterpolator_free(tSincInterpolator *const);
+
+    Lfloat tSincInterpolator_tick(tSincInterpolator *const, const Lfloat *input, Lfloat alpha, Lfloat rate);
 
     //==============================================================================
 
@@ -195,6 +457,12 @@ extern "C"
      @brief
      @param sampler A pointer to the relevant tSampler.
 
+     @fn void    tSampler_tickBlock          (tSampler* const, Lfloat* output, int size)
+     @brief Render a block of samples. Produces the same output as calling tSampler_tick() size times, but only does the loop, crossfade and fade bookkeeping on the ticks that need it.
+     @param sampler A pointer to the relevant tSampler.
+     @param output The array to write to. Overwritten, not added to.
+     @param size The number of samples to render.
+
      @fn void    tSampler_setSample          (tSampler* const, tBuffer* const)
      @brief
      @param sampler A pointer to the relevant tSampler.
@@ -231,6 +499,11 @@ extern "C"
      @brief
      @param sampler A pointer to the relevant tSampler.
 
+     @fn void    tSampler_setInterpolator    (tSampler* const, tSincInterpolator* const)
+     @brief Interpolate with a windowed-sinc kernel instead of 4 point Hermite.
+     @param sampler A pointer to the relevant tSampler.
+     @param interpolator A pointer to the tSincInterpolator to use, or NULL to go back to Hermite interpolation.
+
      @} */
 
     typedef enum PlayMode
@@ -244,6 +517,7 @@ extern "C"
     typedef struct _tSampler
     {
         tMempool mempool;
+        LEAFObjectNode node;
 
         tBuffer samp;
 
@@ -278,6 +552,8 @@ extern "C"
 
         Lfloat flipStart;
         Lfloat flipIdx;
+
+        tSincInterpolator sinc;
     } _tSampler;
 
     typedef _tSampler *tSampler;
@@ -288,6 +564,7 @@ extern "C"
 
     Lfloat tSampler_tick(tSampler *const);
     Lfloat tSampler_tickStereo(tSampler *const sp, Lfloat *outputArray);
+    void tSampler_tickBlock(tSampler *const, Lfloat *output, int size);
     void tSampler_setSample(tSampler *const, tBuffer *const);
     void tSampler_setMode(tSampler *const, PlayMode mode);
     void tSampler_play(tSampler *const);
@@ -300,6 +577,7 @@ extern "C"
     void tSampler_setCrossfadeLength(tSampler *const, uint32_t length);
     void tSampler_setRate(tSampler *const, Lfloat rate);
     void tSampler_setSampleRate(tSampler *const, Lfloat sr);
+    void tSampler_setInterpolator(tSampler *const, tSincInterpolator *const);
 
     //==============================================================================
 
@@ -365,6 +643,7 @@ extern "C"
     {
 
         tMempool mempool;
+        LEAFObjectNode node;
         tSampler sampler;
         tEnvelopeFollower ef;
         uint32_t windowSize;
@@ -452,6 +731,11 @@ extern "C"
      @brief
      @param sampler A pointer to the relevant tMBSampler.
 
+     @fn void    tMBSampler_setInterpolator    (tMBSampler* const, tSincInterpolator* const)
+     @brief Interpolate with a windowed-sinc kernel instead of linear interpolation.
+     @param sampler A pointer to the relevant tMBSampler.
+     @param interpolator A pointer to the tSincInterpolator to use, or NULL to go back to linear interpolation.
+
      @} */
 #ifndef FILLEN
 #define FILLEN 128
@@ -480,6 +764,8 @@ extern "C"
 
         int start, end;
         int currentLoopLength;
+
+        tSincInterpolator sinc;
     } _tMBSampler;
 
     typedef _tMBSampler *tMBSampler;
@@ -497,6 +783,163 @@ extern "C"
     void tMBSampler_setEnd(tMBSampler *const, int32_t end);
     void tMBSampler_setLength(tMBSampler *const, int32_t length);
     void tMBSampler_setRate(tMBSampler *const, Lfloat rate);
+    void tMBSampler_setInterpolator(tMBSampler *const, tSincInterpolator *const);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tgranulator tGranulator
+     @ingroup sampling
+     @brief Granular cloud generator reading from a tBuffer.
+     @details Granular cloud generator reading from a tBuffer. Grains come from a fixed pool allocated at initialization and are recycled through a free list, so spawning a grain never allocates. All grains share one Hann window table. Each block is rendered grain by grain from per-grain arrays, split only where a new grain starts, so hundreds of overlapping grains are affordable.
+     @{
+
+     @fn void    tGranulator_init               (tGranulator* const, tBuffer* const, int maxGrains, LEAF* const leaf)
+     @brief Initialize a tGranulator to the default mempool of a LEAF instance.
+     @param granulator A pointer to the tGranulator to initialize.
+     @param buffer A pointer to the tBuffer to read grains from.
+     @param maxGrains The maximum number of grains that can sound at once.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tGranulator_initToPool         (tGranulator* const, tBuffer* const, int maxGrains, tMempool* const)
+     @brief Initialize a tGranulator to a specified mempool.
+     @param granulator A pointer to the tGranulator to initialize.
+     @param buffer A pointer to the tBuffer to read grains from.
+     @param maxGrains The maximum number of grains that can sound at once.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tGranulator_free               (tGranulator* const)
+     @brief Free a tGranulator from its mempool.
+     @param granulator A pointer to the tGranulator to free.
+
+     @fn Lfloat   tGranulator_tick               (tGranulator* const)
+     @brief Render one sample.
+     @param granulator A pointer to the relevant tGranulator.
+     @return The output sample.
+
+     @fn void    tGranulator_tickBlock          (tGranulator* const, Lfloat* output, int size)
+     @brief Render a block of samples.
+     @param granulator A pointer to the relevant tGranulator.
+     @param output The array to write to. Overwritten, not added to.
+     @param size The number of samples to render.
+
+     @fn void    tGranulator_trigger            (tGranulator* const)
+     @brief Start a grain now with the current settings. Does nothing if every grain is in use.
+     @param granulator A pointer to the relevant tGranulator.
+
+     @fn void    tGranulator_setBuffer          (tGranulator* const, tBuffer* const)
+     @brief Read new grains from a different buffer. Sounding grains are stopped.
+     @param granulator A pointer to the relevant tGranulator.
+     @param buffer A pointer to the new tBuffer.
+
+     @fn void    tGranulator_setPosition        (tGranulator* const, Lfloat position)
+     @brief Set where in the recorded audio new grains start.
+     @param granulator A pointer to the relevant tGranulator.
+     @param position The start position from 0 (beginning) to 1 (end).
+
+     @fn void    tGranulator_setPositionSpread  (tGranulator* const, Lfloat spread)
+     @brief Set the random offset applied to each grain's start position.
+     @param granulator A pointer to the relevant tGranulator.
+     @param spread The largest offset either side of the position, as a fraction of the recorded length.
+
+     @fn void    tGranulator_setGrainSize       (tGranulator* const, Lfloat ms)
+     @brief Set the length of new grains.
+     @param granulator A pointer to the relevant tGranulator.
+     @param ms The grain length in milliseconds.
+
+     @fn void    tGranulator_setSizeSpread      (tGranulator* const, Lfloat spread)
+     @brief Set the random variation of grain length.
+     @param granulator A pointer to the relevant tGranulator.
+     @param spread The largest variation either way, as a fraction of the grain size from 0 to 1.
+
+     @fn void    tGranulator_setDensity         (tGranulator* const, Lfloat grainsPerSecond)
+     @brief Set how many grains start each second.
+     @param granulator A pointer to the relevant tGranulator.
+     @param grainsPerSecond The spawn rate, or 0 to only start grains with tGranulator_trigger().
+
+     @fn void    tGranulator_setRate            (tGranulator* const, Lfloat rate)
+     @brief Set the playback rate of new grains.
+     @param granulator A pointer to the relevant tGranulator.
+     @param rate The playback rate, 1 for original pitch. Negative rates play grains backwards.
+
+     @fn void    tGranulator_setRateSpread      (tGranulator* const, Lfloat semitones)
+     @brief Set the random pitch variation of new grains.
+     @param granulator A pointer to the relevant tGranulator.
+     @param semitones The largest variation either way in semitones.
+
+     @fn void    tGranulator_setGain            (tGranulator* const, Lfloat gain)
+     @brief Set the amplitude of new grains.
+     @param granulator A pointer to the relevant tGranulator.
+     @param gain The grain amplitude.
+
+     @fn int     tGranulator_getNumActiveGrains (tGranulator* const)
+     @brief Get the number of grains currently sounding.
+     @param granulator A pointer to the relevant tGranulator.
+     @return The number of active grains.
+
+     @fn void    tGranulator_setSampleRate      (tGranulator* const, Lfloat sr)
+     @brief Set the sample rate.
+     @param granulator A pointer to the relevant tGranulator.
+     @param sr The new sample rate.
+
+     @} */
+
+#define GRANULATOR_WINDOW_SIZE 1024
+
+    typedef struct _tGranulator
+    {
+        tMempool mempool;
+        LEAFObjectNode node;
+
+        tBuffer samp;
+        Lfloat sampleRate;
+
+        Lfloat* window;
+
+        // grain pool, one array per grain parameter
+        int maxGrains;
+        Lfloat* pos;
+        Lfloat* inc;
+        Lfloat* phase;
+        Lfloat* phaseInc;
+        Lfloat* amp;
+        int* active;
+        int numActive;
+        int* freeList;
+        int numFree;
+
+        Lfloat position;
+        Lfloat positionSpread;
+        Lfloat grainSize;
+        Lfloat sizeSpread;
+        Lfloat rate;
+        Lfloat rateSpread;
+        Lfloat gain;
+        Lfloat density;
+        Lfloat spawnInterval;
+        Lfloat spawnCountdown;
+    } _tGranulator;
+
+    typedef _tGranulator *tGranulator;
+
+    void tGranulator_init(tGranulator *const, tBuffer *const, int maxGrains, LEAF *const leaf);
+    void tGranulator_initToPool(tGranulator *const, tBuffer *const, int maxGrains, tMempool *const);
+    void tGranulator_free(tGranulator *const);
+
+    Lfloat tGranulator_tick(tGranulator *const);
+    void tGranulator_tickBlock(tGranulator *const, Lfloat *output, int size);
+    void tGranulator_trigger(tGranulator *const);
+    void tGranulator_setBuffer(tGranulator *const, tBuffer *const);
+    void tGranulator_setPosition(tGranulator *const, Lfloat position);
+    void tGranulator_setPositionSpread(tGranulator *const, Lfloat spread);
+    void tGranulator_setGrainSize(tGranulator *const, Lfloat ms);
+    void tGranulator_setSizeSpread(tGranulator *const, Lfloat spread);
+    void tGranulator_setDensity(tGranulator *const, Lfloat grainsPerSecond);
+    void tGranulator_setRate(tGranulator *const, Lfloat rate);
+    void tGranulator_setRateSpread(tGranulator *const, Lfloat semitones);
+    void tGranulator_setGain(tGranulator *const, Lfloat gain);
+    int tGranulator_getNumActiveGrains(tGranulator *const);
+    void tGranulator_setSampleRate(tGranulator *const, Lfloat sr);
 
 #ifdef __cplusplus
 }
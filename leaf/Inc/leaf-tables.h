@@ -117,6 +117,29 @@ extern "C" {
     extern const Lfloat_value_delta step_dd_table[];
     extern const  Lfloat             slope_dd_table[];
     
+    //==============================================================================
+    
+    // Table access for objects. These return the const tables above, or with
+    // LEAF_GENERATE_TABLES set, tables built in the LEAF mempool by LEAF_init().
+    // The triangle, square and sawtooth sets are 11 octaves of SIZE samples
+    // each, laid out one after another.
+    const Lfloat* LEAF_getSineTable              (LEAF* const leaf);
+    const Lfloat* LEAF_getTriangleTable          (LEAF* const leaf);
+    const Lfloat* LEAF_getSquareTable            (LEAF* const leaf);
+    const Lfloat* LEAF_getSawtoothTable          (LEAF* const leaf);
+    const Lfloat* LEAF_getExpDecayTable          (LEAF* const leaf);
+    const Lfloat* LEAF_getAttackDecayIncTable    (LEAF* const leaf);
+    // Cutoff table for the fast SVF and ladder filters, to be scaled by 48000 / sampleRate.
+    // With the const tables, the 96k table is used when sampleRate is above switchRate.
+    const Lfloat* LEAF_getFilterTanTable         (LEAF* const leaf, Lfloat sampleRate, Lfloat switchRate);
+    
+#if LEAF_GENERATE_TABLES
+    // Builds the generated tables. Called by LEAF_init().
+    void          leaf_tables_init               (LEAF* const leaf);
+    // Rebuilds the generated tables that depend on sample rate. Called by LEAF_setSampleRate().
+    void          leaf_tables_setSampleRate      (LEAF* const leaf, Lfloat sampleRate);
+#endif
+    
     /*! @} */
     
     //==============================================================================
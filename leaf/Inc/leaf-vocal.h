@@ -45,6 +45,7 @@ void glottis_init(glottis *glo, LEAF* const leaf);
 void glottis_initToPool(glottis *glo, tMempool* const mp);
 Lfloat glottis_compute(glottis *glo);
 void glottis_setup_waveform(glottis *glo);
+void glottis_clear(glottis* const glo);
 
 
 
@@ -154,6 +155,7 @@ void tract_calculate_reflections(tract *t);
 void tract_newLength(tract *t, int newLength);
 void tract_reshape(tract *t);
 void tract_compute(tract *t, Lfloat  in, Lfloat  lambda);
+void tract_clear(tract* const t);
 void tract_calculate_nose_reflections(tract *t);
 int append_transient(transient_pool *pool, int position);
 void remove_transient(transient_pool *pool, unsigned int id);
@@ -167,6 +169,7 @@ void tract_addTurbulenceNoiseAtPosition(tract* const t, Lfloat turbulenceNoise,
 typedef struct _tVoc
 {
     tMempool mempool;
+    LEAFObjectNode node;
     glottis  glot; /*The Glottis*/
     tract  tr; /*The Vocal Tract */
     int doubleCompute;
@@ -185,6 +188,7 @@ Lfloat   tVoc_tick         (tVoc* const voc);
 
 void    tVoc_tractCompute     (tVoc* const voc, Lfloat *in, Lfloat *out);
 void    tVoc_setSampleRate(tVoc* const voc, Lfloat sr);
+void    tVoc_clear        (tVoc* const voc);
 
 
 void    tVoc_setFreq      (tVoc* const voc, Lfloat freq);
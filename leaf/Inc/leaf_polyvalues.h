@@ -0,0 +1,287 @@
+/*==============================================================================
+
+ leaf_polyvalues.h
+
+ ==============================================================================*/
+
+#ifndef LEAF_POLYVALUES_H_INCLUDED
+#define LEAF_POLYVALUES_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+    /*!
+     @file leaf_polyvalues.h
+     @brief poly_float, a small vector of floats that holds one value per voice, and lane-aware versions of the leaf-math helpers.
+
+     @details The vector width is picked from the target: 8 lanes with AVX, 4 lanes with SSE2 or NEON, and 4 lanes of plain floats otherwise (or when LEAF_POLY_NO_SIMD is defined). POLY_FLOAT_LANES holds the width. Use poly_load() and poly_store() to move voices in and out of float arrays; they don't require any alignment, so poly values can live in mempool allocations.
+
+     Comparisons return a poly_mask, which poly_select() uses to pick per lane between two values in place of an if statement. poly_pow2i() builds 2^k straight from the exponent bits, for whole-number k in [-126, 127].
+     */
+
+    //==============================================================================
+
+// Everything here is meant to dissolve into the calling loop; without forced
+// inlining the plain-float fallback in particular ends up far slower than scalar code.
+#if defined(_MSC_VER)
+#define POLY_INLINE static __forceinline
+#elif defined(__GNUC__)
+#define POLY_INLINE static inline __attribute__((always_inline))
+#else
+#define POLY_INLINE static inline
+#endif
+
+#if defined(LEAF_POLY_NO_SIMD)
+#define LEAF_POLY_SCALAR 1
+#elif defined(__AVX__)
+#define LEAF_POLY_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEAF_POLY_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LEAF_POLY_NEON 1
+#else
+#define LEAF_POLY_SCALAR 1
+#endif
+
+#if LEAF_POLY_AVX
+
+#include <immintrin.h>
+#define POLY_FLOAT_LANES 8
+    typedef __m256 poly_float;
+    typedef __m256 poly_mask;
+
+    POLY_INLINE poly_float poly_set1  (float x)                       { return _mm256_set1_ps(x); }
+    POLY_INLINE poly_float poly_load  (const float* p)                { return _mm256_loadu_ps(p); }
+    POLY_INLINE void       poly_store (float* p, poly_float a)        { _mm256_storeu_ps(p, a); }
+    POLY_INLINE poly_float poly_add   (poly_float a, poly_float b)    { return _mm256_add_ps(a, b); }
+    POLY_INLINE poly_float poly_sub   (poly_float a, poly_float b)    { return _mm256_sub_ps(a, b); }
+    POLY_INLINE poly_float poly_mul   (poly_float a, poly_float b)    { return _mm256_mul_ps(a, b); }
+    POLY_INLINE poly_float poly_div   (poly_float a, poly_float b)    { return _mm256_div_ps(a, b); }
+    POLY_INLINE poly_float poly_min   (poly_float a, poly_float b)    { return _mm256_min_ps(a, b); }
+    POLY_INLINE poly_float poly_max   (poly_float a, poly_float b)    { return _mm256_max_ps(a, b); }
+    POLY_INLINE poly_float poly_abs   (poly_float a)                  { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    POLY_INLINE poly_float poly_trunc (poly_float a)                  { return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a)); }
+    POLY_INLINE poly_mask  poly_lt    (poly_float a, poly_float b)    { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    POLY_INLINE poly_mask  poly_le    (poly_float a, poly_float b)    { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    POLY_INLINE poly_mask  poly_gt    (poly_float a, poly_float b)    { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    POLY_INLINE poly_mask  poly_ge    (poly_float a, poly_float b)    { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    POLY_INLINE poly_mask  poly_eq    (poly_float a, poly_float b)    { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    POLY_INLINE poly_mask  poly_and   (poly_mask a, poly_mask b)      { return _mm256_and_ps(a, b); }
+    POLY_INLINE poly_mask  poly_or    (poly_mask a, poly_mask b)      { return _mm256_or_ps(a, b); }
+    POLY_INLINE int        poly_any   (poly_mask m)                   { return _mm256_movemask_ps(m) != 0; }
+    POLY_INLINE poly_float poly_select(poly_mask m, poly_float a, poly_float b) { return _mm256_blendv_ps(b, a, m); }
+    POLY_INLINE poly_float poly_pow2i (poly_float k)                  { return _mm256_castsi256_ps(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(k, _mm256_set1_ps(127.0f)), _mm256_set1_ps(8388608.0f)))); }
+
+#elif LEAF_POLY_SSE
+
+#include <emmintrin.h>
+#define POLY_FLOAT_LANES 4
+    typedef __m128 poly_float;
+    typedef __m128 poly_mask;
+
+    POLY_INLINE poly_float poly_set1  (float x)                       { return _mm_set1_ps(x); }
+    POLY_INLINE poly_float poly_load  (const float* p)                { return _mm_loadu_ps(p); }
+    POLY_INLINE void       poly_store (float* p, poly_float a)        { _mm_storeu_ps(p, a); }
+    POLY_INLINE poly_float poly_add   (poly_float a, poly_float b)    { return _mm_add_ps(a, b); }
+    POLY_INLINE poly_float poly_sub   (poly_float a, poly_float b)    { return _mm_sub_ps(a, b); }
+    POLY_INLINE poly_float poly_mul   (poly_float a, poly_float b)    { return _mm_mul_ps(a, b); }
+    POLY_INLINE poly_float poly_div   (poly_float a, poly_float b)    { return _mm_div_ps(a, b); }
+    POLY_INLINE poly_float poly_min   (poly_float a, poly_float b)    { return _mm_min_ps(a, b); }
+    POLY_INLINE poly_float poly_max   (poly_float a, poly_float b)    { return _mm_max_ps(a, b); }
+    POLY_INLINE poly_float poly_abs   (poly_float a)                  { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    POLY_INLINE poly_float poly_trunc (poly_float a)                  { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+    POLY_INLINE poly_mask  poly_lt    (poly_float a, poly_float b)    { return _mm_cmplt_ps(a, b); }
+    POLY_INLINE poly_mask  poly_le    (poly_float a, poly_float b)    { return _mm_cmple_ps(a, b); }
+    POLY_INLINE poly_mask  poly_gt    (poly_float a, poly_float b)    { return _mm_cmpgt_ps(a, b); }
+    POLY_INLINE poly_mask  poly_ge    (poly_float a, poly_float b)    { return _mm_cmpge_ps(a, b); }
+    POLY_INLINE poly_mask  poly_eq    (poly_float a, poly_float b)    { return _mm_cmpeq_ps(a, b); }
+    POLY_INLINE poly_mask  poly_and   (poly_mask a, poly_mask b)      { return _mm_and_ps(a, b); }
+    POLY_INLINE poly_mask  poly_or    (poly_mask a, poly_mask b)      { return _mm_or_ps(a, b); }
+    POLY_INLINE int        poly_any   (poly_mask m)                   { return _mm_movemask_ps(m) != 0; }
+    POLY_INLINE poly_float poly_select(poly_mask m, poly_float a, poly_float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    POLY_INLINE poly_float poly_pow2i (poly_float k)                  { return _mm_castsi128_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(k, _mm_set1_ps(127.0f)), _mm_set1_ps(8388608.0f)))); }
+
+#elif LEAF_POLY_NEON
+
+#include <arm_neon.h>
+#define POLY_FLOAT_LANES 4
+    typedef float32x4_t poly_float;
+    typedef uint32x4_t poly_mask;
+
+    POLY_INLINE poly_float poly_set1  (float x)                       { return vdupq_n_f32(x); }
+    POLY_INLINE poly_float poly_load  (const float* p)                { return vld1q_f32(p); }
+    POLY_INLINE void       poly_store (float* p, poly_float a)        { vst1q_f32(p, a); }
+    POLY_INLINE poly_float poly_add   (poly_float a, poly_float b)    { return vaddq_f32(a, b); }
+    POLY_INLINE poly_float poly_sub   (poly_float a, poly_float b)    { return vsubq_f32(a, b); }
+    POLY_INLINE poly_float poly_mul   (poly_float a, poly_float b)    { return vmulq_f32(a, b); }
+    POLY_INLINE poly_float poly_div   (poly_float a, poly_float b)
+    {
+#if defined(__aarch64__)
+        return vdivq_f32(a, b);
+#else
+        // ARMv7 has no vector divide; refine the reciprocal estimate twice
+        float32x4_t r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+#endif
+    }
+    POLY_INLINE poly_float poly_min   (poly_float a, poly_float b)    { return vminq_f32(a, b); }
+    POLY_INLINE poly_float poly_max   (poly_float a, poly_float b)    { return vmaxq_f32(a, b); }
+    POLY_INLINE poly_float poly_abs   (poly_float a)                  { return vabsq_f32(a); }
+    POLY_INLINE poly_float poly_trunc (poly_float a)                  { return vcvtq_f32_s32(vcvtq_s32_f32(a)); }
+    POLY_INLINE poly_mask  poly_lt    (poly_float a, poly_float b)    { return vcltq_f32(a, b); }
+    POLY_INLINE poly_mask  poly_le    (poly_float a, poly_float b)    { return vcleq_f32(a, b); }
+    POLY_INLINE poly_mask  poly_gt    (poly_float a, poly_float b)    { return vcgtq_f32(a, b); }
+    POLY_INLINE poly_mask  poly_ge    (poly_float a, poly_float b)    { return vcgeq_f32(a, b); }
+    POLY_INLINE poly_mask  poly_eq    (poly_float a, poly_float b)    { return vceqq_f32(a, b); }
+    POLY_INLINE poly_mask  poly_and   (poly_mask a, poly_mask b)      { return vandq_u32(a, b); }
+    POLY_INLINE poly_mask  poly_or    (poly_mask a, poly_mask b)      { return vorrq_u32(a, b); }
+    POLY_INLINE int        poly_any   (poly_mask m)
+    {
+#if defined(__aarch64__)
+        return vmaxvq_u32(m) != 0;
+#else
+        uint32x2_t r = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+        return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+#endif
+    }
+    POLY_INLINE poly_float poly_select(poly_mask m, poly_float a, poly_float b) { return vbslq_f32(m, a, b); }
+    POLY_INLINE poly_float poly_pow2i (poly_float k)                  { return vreinterpretq_f32_s32(vcvtq_s32_f32(vmulq_f32(vaddq_f32(k, vdupq_n_f32(127.0f)), vdupq_n_f32(8388608.0f)))); }
+
+#else
+
+#define POLY_FLOAT_LANES 4
+    typedef struct { float v[POLY_FLOAT_LANES]; } poly_float;
+    typedef struct { int v[POLY_FLOAT_LANES]; } poly_mask;
+
+#define POLY_LANEWISE(expr) int i; for (i = 0; i < POLY_FLOAT_LANES; i++) { expr; }
+
+    POLY_INLINE poly_float poly_set1  (float x)                       { poly_float r; POLY_LANEWISE(r.v[i] = x) return r; }
+    POLY_INLINE poly_float poly_load  (const float* p)                { poly_float r; POLY_LANEWISE(r.v[i] = p[i]) return r; }
+    POLY_INLINE void       poly_store (float* p, poly_float a)        { POLY_LANEWISE(p[i] = a.v[i]) }
+    POLY_INLINE poly_float poly_add   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = a.v[i] + b.v[i]) return r; }
+    POLY_INLINE poly_float poly_sub   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = a.v[i] - b.v[i]) return r; }
+    POLY_INLINE poly_float poly_mul   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = a.v[i] * b.v[i]) return r; }
+    POLY_INLINE poly_float poly_div   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = a.v[i] / b.v[i]) return r; }
+    POLY_INLINE poly_float poly_min   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i]) return r; }
+    POLY_INLINE poly_float poly_max   (poly_float a, poly_float b)    { poly_float r; POLY_LANEWISE(r.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i]) return r; }
+    POLY_INLINE poly_float poly_abs   (poly_float a)                  { poly_float r; POLY_LANEWISE(r.v[i] = (a.v[i] < 0.0f) ? -a.v[i] : a.v[i]) return r; }
+    POLY_INLINE poly_float poly_trunc (poly_float a)                  { poly_float r; POLY_LANEWISE(r.v[i] = (float)(int32_t)a.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_lt    (poly_float a, poly_float b)    { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] < b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_le    (poly_float a, poly_float b)    { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] <= b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_gt    (poly_float a, poly_float b)    { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] > b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_ge    (poly_float a, poly_float b)    { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] >= b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_eq    (poly_float a, poly_float b)    { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] == b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_and   (poly_mask a, poly_mask b)      { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] && b.v[i]) return r; }
+    POLY_INLINE poly_mask  poly_or    (poly_mask a, poly_mask b)      { poly_mask r; POLY_LANEWISE(r.v[i] = a.v[i] || b.v[i]) return r; }
+    POLY_INLINE int        poly_any   (poly_mask m)                   { int any = 0; POLY_LANEWISE(any |= m.v[i]) return any != 0; }
+    POLY_INLINE poly_float poly_select(poly_mask m, poly_float a, poly_float b) { poly_float r; POLY_LANEWISE(r.v[i] = m.v[i] ? a.v[i] : b.v[i]) return r; }
+    POLY_INLINE poly_float poly_pow2i (poly_float k)                  { poly_float r; POLY_LANEWISE(union { float f; int32_t i; } u; u.i = (int32_t)(k.v[i] + 127.0f) << 23; r.v[i] = u.f) return r; }
+
+#undef POLY_LANEWISE
+
+#endif
+
+    //==============================================================================
+
+    POLY_INLINE float poly_getLane(poly_float a, int lane)
+    {
+        float v[POLY_FLOAT_LANES];
+        poly_store(v, a);
+        return v[lane];
+    }
+
+    POLY_INLINE poly_float poly_setLane(poly_float a, int lane, float x)
+    {
+        float v[POLY_FLOAT_LANES];
+        poly_store(v, a);
+        v[lane] = x;
+        return poly_load(v);
+    }
+
+    // Round to the nearest whole number, halves away from zero
+    POLY_INLINE poly_float poly_round(poly_float a)
+    {
+        poly_float half = poly_select(poly_lt(a, poly_set1(0.0f)), poly_set1(-0.5f), poly_set1(0.5f));
+        return poly_trunc(poly_add(a, half));
+    }
+
+    //==============================================================================
+
+    // Lane-aware versions of the leaf-math helpers. Each matches its scalar
+    // counterpart lane by lane, up to rounding.
+
+    POLY_INLINE poly_float poly_clip(poly_float min, poly_float val, poly_float max)
+    {
+        return poly_min(poly_max(val, min), max);
+    }
+
+    POLY_INLINE poly_float poly_fast_tanh(poly_float x)
+    {
+        poly_float x2 = poly_mul(x, x);
+        poly_float a = poly_mul(x, poly_add(poly_set1(135135.0f), poly_mul(x2, poly_add(poly_set1(17325.0f), poly_mul(x2, poly_add(poly_set1(378.0f), x2))))));
+        poly_float b = poly_add(poly_set1(135135.0f), poly_mul(x2, poly_add(poly_set1(62370.0f), poly_mul(x2, poly_add(poly_set1(3150.0f), poly_mul(x2, poly_set1(28.0f)))))));
+        return poly_div(a, b);
+    }
+
+    POLY_INLINE poly_float poly_fast_tanh2(poly_float x)
+    {
+        poly_float x2 = poly_mul(x, x);
+        poly_float x4 = poly_mul(x2, x2);
+        poly_float x6 = poly_mul(x4, x2);
+        poly_float a = poly_add(poly_add(poly_set1(2027025.0f), poly_mul(poly_set1(270270.0f), x2)), poly_add(poly_mul(poly_set1(6930.0f), x4), poly_mul(poly_set1(36.0f), x6)));
+        poly_float b = poly_add(poly_add(poly_set1(2027025.0f), poly_mul(poly_set1(945945.0f), x2)), poly_add(poly_add(poly_mul(poly_set1(51975.0f), x4), poly_mul(poly_set1(630.0f), x6)), poly_mul(x4, x4)));
+        return poly_div(poly_mul(x, a), b);
+    }
+
+    POLY_INLINE poly_float poly_fast_tanh4(poly_float x)
+    {
+        poly_float xa = poly_abs(x);
+        poly_float x2 = poly_mul(xa, xa);
+        poly_float x3 = poly_mul(xa, x2);
+        poly_float x4 = poly_mul(x2, x2);
+        poly_float x7 = poly_mul(x3, x4);
+        poly_float den = poly_add(poly_add(poly_add(poly_set1(1.0f), xa), poly_add(x2, poly_mul(poly_set1(0.58576695f), x3))), poly_add(poly_mul(poly_set1(0.55442112f), x4), poly_mul(poly_set1(0.057481508f), x7)));
+        poly_float res = poly_sub(poly_set1(1.0f), poly_div(poly_set1(1.0f), den));
+        return poly_select(poly_lt(x, poly_set1(0.0f)), poly_sub(poly_set1(0.0f), res), res);
+    }
+
+    POLY_INLINE poly_float poly_interpolation_linear(poly_float A, poly_float B, poly_float alpha)
+    {
+        alpha = poly_clip(poly_set1(0.0f), alpha, poly_set1(1.0f));
+        return poly_add(poly_mul(A, poly_sub(poly_set1(1.0f), alpha)), poly_mul(B, alpha));
+    }
+
+    POLY_INLINE poly_float poly_interpolate_hermite_x(poly_float yy0, poly_float yy1, poly_float yy2, poly_float yy3, poly_float xx)
+    {
+        poly_float half = poly_set1(0.5f);
+        poly_float c0 = yy1;
+        poly_float c1 = poly_mul(half, poly_sub(yy2, yy0));
+        poly_float y0my1 = poly_sub(yy0, yy1);
+        poly_float c3 = poly_add(poly_sub(yy1, yy2), poly_mul(half, poly_sub(poly_sub(yy3, y0my1), yy2)));
+        poly_float c2 = poly_sub(poly_add(y0my1, c1), c3);
+        return poly_add(poly_mul(poly_add(poly_mul(poly_add(poly_mul(c3, xx), c2), xx), c1), xx), c0);
+    }
+
+    // Lane-aware LEAF_poly_blep(): t is the 0-1 phase and dt the phase increment
+    POLY_INLINE poly_float poly_blep(poly_float t, poly_float dt)
+    {
+        poly_float one = poly_set1(1.0f);
+        dt = poly_abs(dt);
+        poly_float x = poly_div(t, dt);
+        poly_float y = poly_div(poly_sub(t, one), dt);
+        poly_float rising = poly_sub(poly_sub(poly_add(x, x), poly_mul(x, x)), one);
+        poly_float falling = poly_add(poly_add(poly_mul(y, y), poly_add(y, y)), one);
+        poly_float r = poly_select(poly_gt(t, poly_sub(one, dt)), falling, poly_set1(0.0f));
+        return poly_select(poly_lt(t, dt), rising, r);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_POLYVALUES_H_INCLUDED
@@ -9,15 +9,23 @@
 #if _WIN32 || _WIN64
 
 #include "..\Inc\leaf-analysis.h"
+#include "..\Inc\leaf-kernels.h"
 #include "..\Externals\d_fft_mayer.h"
 #include <intrin.h>
 #else
 
 #include "../Inc/leaf-analysis.h"
+#include "../Inc/leaf-kernels.h"
 #include "../Externals/d_fft_mayer.h"
 
 #endif
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 #if LEAF_DEBUG
 #include "../../TestPlugin/JuceLibraryCode/JuceHeader.h"
 #endif
@@ -62,7 +70,7 @@ Lfloat   tEnvelopeFollower_tick(tEnvelopeFollower* const ef, Lfloat x)
     //ef->y = envelope_pow[(uint16_t)(ef->y * (Lfloat)UINT16_MAX)] * ef->d_coeff; //not quite the right behavior - too much loss of precision?
     //ef->y = powf(ef->y, 1.000009f) * ef->d_coeff;  // too expensive
     
-#ifdef NO_DENORMAL_CHECK
+#if LEAF_NO_DENORMAL_CHECK
 #else
     if( e->y < VSF)   e->y = 0.0f;
 #endif
@@ -224,6 +232,90 @@ Lfloat tPowerFollower_getPower(tPowerFollower* const pf)
     return p->curr;
 }
 
+//===========================================================================
+/* Silence Detector */
+//===========================================================================
+void    tSilenceDetector_init(tSilenceDetector* const sd, Lfloat threshold, Lfloat holdTime, LEAF* const leaf)
+{
+    tSilenceDetector_initToPool(sd, threshold, holdTime, &leaf->mempool);
+}
+
+void    tSilenceDetector_initToPool (tSilenceDetector* const sd, Lfloat threshold, Lfloat holdTime, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tSilenceDetector* d = *sd = (_tSilenceDetector*) mpool_alloc(sizeof(_tSilenceDetector), m);
+    d->mempool = m;
+    LEAF* leaf = d->mempool->leaf;
+    LEAF_registerObject(d->mempool, &d->node, d, (LEAFSampleRateFunc) tSilenceDetector_setSampleRate, NULL);
+    
+    d->threshold = threshold;
+    d->sampleRate = leaf->sampleRate;
+    d->silentSamples = 0;
+    d->silent = 0;
+    tSilenceDetector_setHoldTime(sd, holdTime);
+}
+
+void    tSilenceDetector_free (tSilenceDetector* const sd)
+{
+    _tSilenceDetector* d = *sd;
+    
+    LEAF_unregisterObject(d->mempool, &d->node);
+    mpool_free((char*)d, d->mempool);
+}
+
+int     tSilenceDetector_tickBlock (tSilenceDetector* const sd, const Lfloat* input, int size)
+{
+    _tSilenceDetector* d = *sd;
+    
+    if (LEAF_kernel_maxAbs(input, size) > d->threshold)
+    {
+        d->silentSamples = 0;
+        d->silent = 0;
+    }
+    else
+    {
+        // saturate rather than wrap after a long silence
+        if (d->silentSamples < UINT32_MAX - (uint32_t) size) d->silentSamples += size;
+        d->silent = d->silentSamples >= d->holdSamples;
+    }
+    return d->silent;
+}
+
+int     tSilenceDetector_isSilent (tSilenceDetector* const sd)
+{
+    _tSilenceDetector* d = *sd;
+    return d->silent;
+}
+
+void    tSilenceDetector_reset (tSilenceDetector* const sd)
+{
+    _tSilenceDetector* d = *sd;
+    d->silentSamples = 0;
+    d->silent = 0;
+}
+
+void    tSilenceDetector_setThreshold (tSilenceDetector* const sd, Lfloat threshold)
+{
+    _tSilenceDetector* d = *sd;
+    d->threshold = threshold;
+}
+
+void    tSilenceDetector_setHoldTime (tSilenceDetector* const sd, Lfloat holdTime)
+{
+    _tSilenceDetector* d = *sd;
+    
+    if (holdTime < 0.0f) holdTime = 0.0f;
+    d->holdTime = holdTime;
+    d->holdSamples = (uint32_t) (holdTime * 0.001f * d->sampleRate);
+}
+
+void    tSilenceDetector_setSampleRate (tSilenceDetector* const sd, Lfloat sr)
+{
+    _tSilenceDetector* d = *sd;
+    d->sampleRate = sr;
+    tSilenceDetector_setHoldTime(sd, d->holdTime);
+}
+
 
 
 
@@ -349,6 +441,7 @@ void tAttackDetection_initToPool     (tAttackDetection* const ad, int blocksize,
     _tMempool* m = *mp;
     _tAttackDetection* a = *ad = (_tAttackDetection*) mpool_alloc(sizeof(_tAttackDetection), m);
     a->mempool = m;
+    LEAF_registerObject(a->mempool, &a->node, a, (LEAFSampleRateFunc) tAttackDetection_setSampleRate, NULL);
     
     atkdtk_init(ad, blocksize, atk, rel);
 }
@@ -357,6 +450,7 @@ void tAttackDetection_free (tAttackDetection* const ad)
 {
     _tAttackDetection* a = *ad;
     
+    LEAF_unregisterObject(a->mempool, &a->node);
     mpool_free((char*)a, a->mempool);
 }
 
@@ -458,9 +552,6 @@ static void atkdtk_envelope(tAttackDetection* const ad, Lfloat *in)
 /***************************** private procedures *****************************/
 /******************************************************************************/
 
-#define REALFFT mayer_realfft
-#define REALIFFT mayer_realifft
-
 static void snac_analyzeframe(tSNAC* const s);
 static void snac_autocorrelation(tSNAC* const s);
 static void snac_normalize(tSNAC* const s);
@@ -493,11 +584,17 @@ void    tSNAC_initToPool    (tSNAC* const snac, int overlaparg, tMempool* const
     s->fidelity = 0.;
     s->minrms = DEFMINRMS;
     s->framesize = SNAC_FRAME_SIZE;
+    s->sharedScratch = 0;
     
     s->inputbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * SNAC_FRAME_SIZE, m);
     s->processbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE * 2), m);
     s->spectrumbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE / 2), m);
     s->biasbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * SNAC_FRAME_SIZE, m);
+#if LEAF_KERNEL_FFT_NEEDS_SCRATCH
+    s->fftScratch = (Lfloat*) mpool_alloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE * 2), m);
+#else
+    s->fftScratch = NULL;
+#endif
     
     snac_biasbuf(snac);
     tSNAC_setOverlap(snac, overlaparg);
@@ -508,9 +605,13 @@ void tSNAC_free (tSNAC* const snac)
     _tSNAC* s = *snac;
     
     mpool_free((char*)s->inputbuf, s->mempool);
-    mpool_free((char*)s->processbuf, s->mempool);
-    mpool_free((char*)s->spectrumbuf, s->mempool);
+    if (!s->sharedScratch)
+    {
+        mpool_free((char*)s->processbuf, s->mempool);
+        mpool_free((char*)s->spectrumbuf, s->mempool);
+    }
     mpool_free((char*)s->biasbuf, s->mempool);
+    if (s->fftScratch != NULL) mpool_free((char*)s->fftScratch, s->mempool);
     mpool_free((char*)s, s->mempool);
 }
 
@@ -586,6 +687,33 @@ Lfloat tSNAC_getFidelity(tSNAC* const snac)
 }
 
 
+// processbuf and spectrumbuf only carry data within one snac_analyzeframe call,
+// so tSNACs that are never analysed concurrently can use the same ones
+void tSNAC_setScratch(tSNAC* const snac, Lfloat* processbuf, Lfloat* spectrumbuf)
+{
+    _tSNAC* s = *snac;
+    
+    if (!s->sharedScratch)
+    {
+        mpool_free((char*)s->processbuf, s->mempool);
+        mpool_free((char*)s->spectrumbuf, s->mempool);
+    }
+    
+    if (processbuf != NULL && spectrumbuf != NULL)
+    {
+        s->processbuf = processbuf;
+        s->spectrumbuf = spectrumbuf;
+        s->sharedScratch = 1;
+    }
+    else
+    {
+        s->processbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE * 2), s->mempool);
+        s->spectrumbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE / 2), s->mempool);
+        s->sharedScratch = 0;
+    }
+}
+
+
 /******************************************************************************/
 /***************************** private procedures *****************************/
 /******************************************************************************/
@@ -598,19 +726,14 @@ static void snac_analyzeframe(tSNAC* const snac)
     
     int n, tindex = s->timeindex;
     int framesize = s->framesize;
-    int mask = framesize - 1;
     Lfloat norm = 1.f / sqrtf((Lfloat)(framesize * 2));
     
     Lfloat *inputbuf = s->inputbuf;
     Lfloat *processbuf = s->processbuf;
     
-    // copy input to processing buffers
-    for(n=0; n<framesize; n++)
-    {
-        processbuf[n] = inputbuf[tindex] * norm;
-        tindex++;
-        tindex &= mask;
-    }
+    // copy input to processing buffers, oldest sample first
+    LEAF_kernel_scale(&inputbuf[tindex], norm, processbuf, framesize - tindex);
+    LEAF_kernel_scale(inputbuf, norm, &processbuf[framesize - tindex], tindex);
     
     // zeropadding
     for(n=framesize; n<(framesize<<1); n++) processbuf[n] = 0.;
@@ -633,7 +756,7 @@ static void snac_autocorrelation(tSNAC* const snac)
     Lfloat *processbuf = s->processbuf;
     Lfloat *spectrumbuf = s->spectrumbuf;
     
-    REALFFT(fftsize, processbuf);
+    LEAF_kernel_realFFT(processbuf, s->fftScratch, fftsize);
     
     // compute power spectrum
     processbuf[0] *= processbuf[0];                      // DC
@@ -653,7 +776,7 @@ static void snac_autocorrelation(tSNAC* const snac)
     }
     
     // transform power spectrum to autocorrelation function
-    REALIFFT(fftsize, processbuf);
+    LEAF_kernel_realIFFT(processbuf, s->fftScratch, fftsize);
     return;
 }
 
@@ -839,6 +962,7 @@ void tPeriodDetection_initToPool (tPeriodDetection* const pd, Lfloat* in, int bu
     _tPeriodDetection* p = *pd = (_tPeriodDetection*) mpool_calloc(sizeof(_tPeriodDetection), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tPeriodDetection_setSampleRate, NULL);
     
     p->invSampleRate = leaf->invSampleRate;
     p->inBuffer = in;
@@ -871,6 +995,7 @@ void tPeriodDetection_free (tPeriodDetection* const pd)
     
     tEnvPD_free(&p->env);
     tSNAC_free(&p->snac);
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -959,6 +1084,22 @@ void tPeriodDetection_setSampleRate (tPeriodDetection* const pd, Lfloat sr)
     p->radius = expf(-1000.0f * p->hopSize * p->invSampleRate / p->timeConstant);
 }
 
+void tPeriodDetection_setAnalysisPhase (tPeriodDetection* const pd, Lfloat phase)
+{
+    _tPeriodDetection* p = *pd;
+    _tSNAC* s = p->snac;
+    
+    // SNAC analyses on the first block of each hop, so the cycle is
+    // whichever is longer of the block and the SNAC hop
+    int hop = s->framesize / s->overlap;
+    int cycle = p->frameSize > hop ? p->frameSize : hop;
+    int delay = (int)(LEAF_clip(0.0f, phase, 1.0f) * cycle) % cycle;
+    
+    // shift block boundaries within a block, then whole blocks against the SNAC hop
+    p->index = (p->frameSize - (delay % p->frameSize)) % p->frameSize;
+    s->timeindex = (uint16_t)(-((delay / p->frameSize) * p->frameSize) & (s->framesize - 1));
+}
+
 //==========================================================================================
 
 void    tZeroCrossingInfo_init  (tZeroCrossingInfo* const zc, LEAF* const leaf)
@@ -1055,11 +1196,17 @@ void    tZeroCrossingCollector_initToPool    (tZeroCrossingCollector* const zc,
     z->_size = pow(2.0, ceil(log2((double)size)));
     z->_mask = z->_size - 1;
 
-    z->_info = (tZeroCrossingInfo*) mpool_calloc(sizeof(tZeroCrossingInfo) * z->_size, m);
+    z->_before_crossing = (Lfloat*) mpool_calloc(sizeof(Lfloat) * z->_size, m);
+    z->_after_crossing = (Lfloat*) mpool_calloc(sizeof(Lfloat) * z->_size, m);
+    z->_crossing_peak = (Lfloat*) mpool_calloc(sizeof(Lfloat) * z->_size, m);
+    z->_crossing_width = (Lfloat*) mpool_calloc(sizeof(Lfloat) * z->_size, m);
+    z->_leading_edge = (int*) mpool_alloc(sizeof(int) * z->_size, m);
+    z->_trailing_edge = (int*) mpool_alloc(sizeof(int) * z->_size, m);
 
     for (unsigned i = 0; i < z->_size; i++)
     {
-        tZeroCrossingInfo_initToPool(&z->_info[i], mp);
+        z->_leading_edge[i] = INT_MIN;
+        z->_trailing_edge[i] = INT_MIN;
     }
     
     z->_pos = 0;
@@ -1077,12 +1224,12 @@ void    tZeroCrossingCollector_free  (tZeroCrossingCollector* const zc)
 {
     _tZeroCrossingCollector* z = *zc;
     
-    for (unsigned i = 0; i < z->_size; i++)
-    {
-        tZeroCrossingInfo_free(&z->_info[i]);
-    }
-    
-    mpool_free((char*)z->_info, z->mempool);
+    mpool_free((char*)z->_trailing_edge, z->mempool);
+    mpool_free((char*)z->_leading_edge, z->mempool);
+    mpool_free((char*)z->_crossing_width, z->mempool);
+    mpool_free((char*)z->_crossing_peak, z->mempool);
+    mpool_free((char*)z->_after_crossing, z->mempool);
+    mpool_free((char*)z->_before_crossing, z->mempool);
     mpool_free((char*)z, z->mempool);
 }
 
@@ -1124,12 +1271,25 @@ int     tZeroCrossingCollector_getState(tZeroCrossingCollector* const zc)
     return z->_state;
 }
 
-tZeroCrossingInfo const tZeroCrossingCollector_getCrossing(tZeroCrossingCollector* const zc, int index)
+Lfloat   tZeroCrossingCollector_getFractionalPeriod(tZeroCrossingCollector* const zc, int slot, int nextSlot)
 {
     _tZeroCrossingCollector* z = *zc;
     
-    int i = (z->_num_edges - 1) - index;
-    return z->_info[(z->_pos + i) & z->_mask];
+    // Get the start edge
+    Lfloat prev1 = z->_before_crossing[slot];
+    Lfloat curr1 = z->_after_crossing[slot];
+    Lfloat dy1 = curr1 - prev1;
+    Lfloat dx1 = -prev1 / dy1;
+    
+    // Get the next edge
+    Lfloat prev2 = z->_before_crossing[nextSlot];
+    Lfloat curr2 = z->_after_crossing[nextSlot];
+    Lfloat dy2 = curr2 - prev2;
+    Lfloat dx2 = -prev2 / dy2;
+    
+    // Calculate the fractional period
+    Lfloat result = z->_leading_edge[nextSlot] - z->_leading_edge[slot];
+    return result + (dx2 - dx1);
 }
 
 int     tZeroCrossingCollector_getNumEdges(tZeroCrossingCollector* const zc)
@@ -1209,19 +1369,22 @@ static inline void update_state(tZeroCrossingCollector* const zc, Lfloat s)
         {
             --z->_pos;
             z->_pos &= z->_mask;
-            tZeroCrossingInfo crossing = z->_info[z->_pos & z->_mask];
-            crossing->_before_crossing = z->_prev;
-            crossing->_after_crossing = s;
-            crossing->_peak = s;
-            crossing->_leading_edge = (int) z->_frame;
-            crossing->_trailing_edge = INT_MIN;
-            crossing->_width = 0.0f;
+            unsigned int c = z->_pos;
+            z->_before_crossing[c] = z->_prev;
+            z->_after_crossing[c] = s;
+            z->_crossing_peak[c] = s;
+            z->_leading_edge[c] = (int) z->_frame;
+            z->_trailing_edge[c] = INT_MIN;
+            z->_crossing_width[c] = 0.0f;
             ++z->_num_edges;
             z->_state = 1;
         }
         else
         {
-            tZeroCrossingInfo_updatePeak(&z->_info[z->_pos & z->_mask], s, z->_frame);
+            unsigned int c = z->_pos;
+            z->_crossing_peak[c] = fmaxf(s, z->_crossing_peak[c]);
+            if ((z->_crossing_width[c] == 0.0f) && (s < (z->_crossing_peak[c] * 0.3f)))
+                z->_crossing_width[c] = z->_frame - z->_leading_edge[c];
         }
         if (s > z->_peak_update)
         {
@@ -1231,7 +1394,7 @@ static inline void update_state(tZeroCrossingCollector* const zc, Lfloat s)
     else if (z->_state && (s < z->_hysteresis))
     {
         z->_state = 0;
-        z->_info[z->_pos & z->_mask]->_trailing_edge = z->_frame;
+        z->_trailing_edge[z->_pos] = z->_frame;
         if (z->_peak == 0.0f)
             z->_peak = z->_peak_update;
     }
@@ -1246,17 +1409,17 @@ static inline void shift(tZeroCrossingCollector* const zc, int n)
 {
     _tZeroCrossingCollector* z = *zc;
     
-    tZeroCrossingInfo crossing = z->_info[z->_pos & z->_mask];
+    unsigned int c = z->_pos & z->_mask;
     
-    crossing->_leading_edge -= n;
+    z->_leading_edge[c] -= n;
     if (!z->_state)
-        crossing->_trailing_edge -= n;
+        z->_trailing_edge[c] -= n;
     int i = 1;
     for (; i != z->_num_edges; ++i)
     {
         int idx = (z->_pos + i) & z->_mask;
-        z->_info[idx]->_leading_edge -= n;
-        int edge = (z->_info[idx]->_trailing_edge -= n);
+        z->_leading_edge[idx] -= n;
+        int edge = (z->_trailing_edge[idx] -= n);
         if (edge < 0.0f)
             break;
     }
@@ -1285,8 +1448,10 @@ void    tBitset_initToPool  (tBitset* const bitset, int numBits, tMempool* const
     _tBitset* b = *bitset = (_tBitset*) mpool_alloc(sizeof(_tBitset), m);
     b->mempool = m;
     
+    b->_num_bits = numBits;
+    
     // Size of the array value in bits
-    b->_value_size = (CHAR_BIT * sizeof(unsigned int));
+    b->_value_size = (CHAR_BIT * sizeof(uint64_t));
     
     // Size of the array needed to store numBits bits
     b->_size = (numBits + b->_value_size - 1) / b->_value_size;
@@ -1294,7 +1459,7 @@ void    tBitset_initToPool  (tBitset* const bitset, int numBits, tMempool* const
     // Siz of the array in bits
     b->_bit_size = b->_size * b->_value_size;
     
-    b->_bits = (unsigned int*) mpool_calloc(sizeof(unsigned int) * b->_size, m);
+    b->_bits = (uint64_t*) mpool_calloc(sizeof(uint64_t) * b->_size, m);
 }
 
 void    tBitset_free    (tBitset* const bitset)
@@ -1313,11 +1478,11 @@ int     tBitset_get     (tBitset* const bitset, int index)
     if (index > b->_bit_size)
         return -1;
     
-    unsigned int mask = 1 << (index % b->_value_size);
+    uint64_t mask = (uint64_t) 1 << (index % b->_value_size);
     return (b->_bits[index / b->_value_size] & mask) != 0;
 }
 
-unsigned int*   tBitset_getData   (tBitset* const bitset)
+uint64_t*   tBitset_getData   (tBitset* const bitset)
 {
     _tBitset* b = *bitset;
     
@@ -1331,9 +1496,9 @@ void     tBitset_set     (tBitset* const bitset, int index, unsigned int val)
     if (index > b->_bit_size)
         return;
     
-    unsigned int mask = 1 << (index % b->_value_size);
+    uint64_t mask = (uint64_t) 1 << (index % b->_value_size);
     int i = index / b->_value_size;
-    b->_bits[i] ^= (-val ^ b->_bits[i]) & mask;
+    b->_bits[i] ^= (-(uint64_t) val ^ b->_bits[i]) & mask;
 }
 
 void     tBitset_setMultiple (tBitset* const bitset, int index, int n, unsigned int val)
@@ -1359,11 +1524,11 @@ void     tBitset_setMultiple (tBitset* const bitset, int index, int n, unsigned
         mod = b->_value_size - mod;
         
         // Calculate the mask
-        unsigned int mask = ~(UINT_MAX >> mod);
+        uint64_t mask = ~(UINT64_MAX >> mod);
         
         // Adjust the mask if we're not going to reach the end of this int
         if (n < mod)
-            mask &= (UINT_MAX >> (mod - n));
+            mask &= (UINT64_MAX >> (mod - n));
         
         if (val)
             b->_bits[i] |= mask;
@@ -1382,7 +1547,7 @@ void     tBitset_setMultiple (tBitset* const bitset, int index, int n, unsigned
     if (n >= b->_value_size)
     {
         // Store a local value to work with
-        unsigned int val_ = val ? UINT_MAX : 0;
+        uint64_t val_ = val ? UINT64_MAX : 0;
         
         do
         {
@@ -1398,7 +1563,7 @@ void     tBitset_setMultiple (tBitset* const bitset, int index, int n, unsigned
         mod = n & (b->_value_size - 1);
         
         // Calculate the mask
-        unsigned int mask = (1 << mod) - 1;
+        uint64_t mask = ((uint64_t) 1 << mod) - 1;
         
         if (val)
             b->_bits[i] |= mask;
@@ -1435,8 +1600,7 @@ void    tBACF_initToPool    (tBACF* const bacf, tBitset* const bitset, tMempool*
     _tBACF* b = *bacf = (_tBACF*) mpool_alloc(sizeof(_tBACF), m);
     b->mempool = m;
     
-    b->_bitset = *bitset;
-    b->_mid_array = ((b->_bitset->_bit_size / b->_bitset->_value_size) / 2) - 1;
+    tBACF_set(bacf, bitset);
 }
 
 void    tBACF_free  (tBACF* const bacf)
@@ -1446,62 +1610,175 @@ void    tBACF_free  (tBACF* const bacf)
     mpool_free((char*) b, b->mempool);
 }
 
-int    tBACF_getCorrelation  (tBACF* const bacf, int pos)
+static inline int bacf_popcount(uint64_t x)
 {
-    _tBACF* b = *bacf;
-    
-    int value_size = b->_bitset->_value_size;
-    const int index = pos / value_size;
-    const int shift = pos % value_size;
-    
-    const unsigned int* p1 = b->_bitset->_bits;
-    const unsigned int* p2 = b->_bitset->_bits + index;
-    int count = 0;
-    
-    if (shift == 0)
-    {
-        for (unsigned i = 0; i != b->_mid_array; ++i)
-        {
-            // built in compiler popcount functions should be faster but we want this to be portable
-            // could try to add some define that call the correct function depending on compiler
-            // or let the user pointer popcount() to whatever they want
-            // something to look into...
 #ifdef __GNUC__
-            count += __builtin_popcount(*p1++ ^ *p2++);
+    return __builtin_popcountll(x);
+#elif _MSC_VER && _WIN64
+    return (int) __popcnt64(x);
 #elif _MSC_VER
-            count += __popcnt(*p1++ ^ *p2++);
+    return __popcnt((unsigned int) x) + __popcnt((unsigned int) (x >> 32));
 #else
-            count += popcount(*p1++ ^ *p2++);
+    return popcount((unsigned int) x) + popcount((unsigned int) (x >> 32));
 #endif
+}
+
+// 64 bits of the bitstream starting shift bits into word i
+static inline uint64_t bacf_shifted(const uint64_t* bits, int i, int shift)
+{
+    if (shift == 0)
+        return bits[i];
+    return (bits[i] >> shift) | (bits[i + 1] << (64 - shift));
+}
+
+// XOR popcount of the first half of the bitstream against up to BACF_MAX_LAGS shifted copies,
+// in one pass so each word of the first half is loaded once for all lags
+static void bacf_correlate(_tBACF* const b, const int* positions, int* counts, int num)
+{
+    const uint64_t* bits = b->_bitset->_bits;
+    const uint64_t* p2[BACF_MAX_LAGS];
+    int shift[BACF_MAX_LAGS];
+    int words = b->_mid_array;
+    int i = 0;
+    
+    for (int l = 0; l < num; ++l)
+    {
+        p2[l] = bits + (positions[l] >> 6);
+        shift[l] = positions[l] & 63;
+        counts[l] = 0;
+    }
+    
+#if defined(__AVX2__)
+    // nibble lookup popcount (Mula), summed per 64-bit lane with sad_epu8
+    if (words >= 4)
+    {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i acc[BACF_MAX_LAGS];
+        __m128i right[BACF_MAX_LAGS];
+        __m128i left[BACF_MAX_LAGS];
+        
+        for (int l = 0; l < num; ++l)
+        {
+            acc[l] = zero;
+            // a left shift by 64 yields zero, so lag multiples of 64 need no special case
+            right[l] = _mm_cvtsi32_si128(shift[l]);
+            left[l] = _mm_cvtsi32_si128(64 - shift[l]);
+        }
+        
+        for (; i + 4 <= words; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (bits + i));
+            for (int l = 0; l < num; ++l)
+            {
+                __m256i lo = _mm256_loadu_si256((const __m256i*) (p2[l] + i));
+                __m256i hi = _mm256_loadu_si256((const __m256i*) (p2[l] + i + 1));
+                __m256i v = _mm256_or_si256(_mm256_srl_epi64(lo, right[l]), _mm256_sll_epi64(hi, left[l]));
+                v = _mm256_xor_si256(a, v);
+                __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble)),
+                                            _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+                acc[l] = _mm256_add_epi64(acc[l], _mm256_sad_epu8(c, zero));
+            }
+        }
+        
+        for (int l = 0; l < num; ++l)
+        {
+            __m128i s = _mm_add_epi64(_mm256_castsi256_si128(acc[l]), _mm256_extracti128_si256(acc[l], 1));
+            counts[l] += (int) (_mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1));
         }
     }
-    else
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    // vcnt per byte, widened pairwise into 32-bit lanes
+    if (words >= 2)
     {
-        const int shift2 = value_size - shift;
-        for (unsigned i = 0; i != b->_mid_array; ++i)
+        uint32x4_t acc[BACF_MAX_LAGS];
+        int64x2_t right[BACF_MAX_LAGS];
+        int64x2_t left[BACF_MAX_LAGS];
+        
+        for (int l = 0; l < num; ++l)
         {
-            unsigned int v = *p2++ >> shift;
-            v |= *p2 << shift2;
-#ifdef __GNUC__
-            count += __builtin_popcount(*p1++ ^ v++);
-#elif _MSC_VER
-            count += __popcnt(*p1++ ^ v++);
-#else
-            count += popcount(*p1++ ^ v++);
-#endif
+            acc[l] = vdupq_n_u32(0);
+            // a shift by 64 yields zero, so lag multiples of 64 need no special case
+            right[l] = vdupq_n_s64(-shift[l]);
+            left[l] = vdupq_n_s64(64 - shift[l]);
+        }
+        
+        for (; i + 2 <= words; i += 2)
+        {
+            uint64x2_t a = vld1q_u64(bits + i);
+            for (int l = 0; l < num; ++l)
+            {
+                uint64x2_t v = vorrq_u64(vshlq_u64(vld1q_u64(p2[l] + i), right[l]),
+                                         vshlq_u64(vld1q_u64(p2[l] + i + 1), left[l]));
+                uint8x16_t c = vcntq_u8(vreinterpretq_u8_u64(veorq_u64(a, v)));
+                acc[l] = vpadalq_u16(acc[l], vpaddlq_u8(c));
+            }
         }
+        
+        for (int l = 0; l < num; ++l)
+        {
+            uint64x2_t s = vpaddlq_u32(acc[l]);
+            counts[l] += (int) (vgetq_lane_u64(s, 0) + vgetq_lane_u64(s, 1));
+        }
+    }
+#endif
+    
+    for (; i < words; ++i)
+    {
+        uint64_t a = bits[i];
+        for (int l = 0; l < num; ++l)
+            counts[l] += bacf_popcount(a ^ bacf_shifted(p2[l], i, shift[l]));
     }
+    
+    if (b->_mid_tail)
+    {
+        uint64_t mask = ((uint64_t) 1 << b->_mid_tail) - 1;
+        uint64_t a = bits[i];
+        for (int l = 0; l < num; ++l)
+            counts[l] += bacf_popcount((a ^ bacf_shifted(p2[l], i, shift[l])) & mask);
+    }
+}
+
+int    tBACF_getCorrelation  (tBACF* const bacf, int pos)
+{
+    _tBACF* b = *bacf;
+    
+    int count;
+    bacf_correlate(b, &pos, &count, 1);
     return count;
 }
 
+void    tBACF_getCorrelations  (tBACF* const bacf, const int* positions, int* counts, int numPositions)
+{
+    _tBACF* b = *bacf;
+    
+    for (int i = 0; i < numPositions; i += BACF_MAX_LAGS)
+    {
+        int n = numPositions - i;
+        if (n > BACF_MAX_LAGS) n = BACF_MAX_LAGS;
+        bacf_correlate(b, positions + i, counts + i, n);
+    }
+}
+
 void    tBACF_set  (tBACF* const bacf, tBitset* const bitset)
 {
     _tBACF* b = *bacf;
     
     b->_bitset = *bitset;
-    b->_mid_array = ((b->_bitset->_bit_size / b->_bitset->_value_size) / 2) - 1;
+    
+    // compare the same span as the original 32-bit word layout: half the
+    // stream less one 32-bit word, as whole 64-bit words plus a 32-bit tail
+    unsigned int words32 = (b->_bitset->_num_bits + 31) / 32;
+    b->_mid_bits = ((words32 / 2) - 1) * 32;
+    b->_mid_array = b->_mid_bits / 64;
+    b->_mid_tail = b->_mid_bits % 64;
 }
 
+// lags evaluated together while searching for a correlation minimum
+#define BACF_SEARCH_LAGS 4
+
 static inline void set_bitstream(tPeriodDetector* const detector);
 static inline void autocorrelate(tPeriodDetector* const detector);
 
@@ -1523,6 +1800,7 @@ void    tPeriodDetector_initToPool  (tPeriodDetector* const detector, Lfloat low
     _tMempool* m = *mempool;
     _tPeriodDetector* p = *detector = (_tPeriodDetector*) mpool_alloc(sizeof(_tPeriodDetector), m);
     p->mempool = m;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tPeriodDetector_setSampleRate, NULL);
     
     LEAF* leaf = p->mempool->leaf;
     
@@ -1557,6 +1835,7 @@ void    tPeriodDetector_free    (tPeriodDetector* const detector)
     tBitset_free(&p->_bits);
     tBACF_free(&p->_bacf);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*) p, p->mempool);
 }
 
@@ -1634,17 +1913,17 @@ Lfloat   tPeriodDetector_predictPeriod   (tPeriodDetector* const detector)
         if (n > 1)
         {
             Lfloat threshold = tZeroCrossingCollector_getPeak(&p->_zc) * PULSE_THRESHOLD;
-            for (int i = n - 1; i > 0; --i)
+            int edge2 = tZeroCrossingCollector_getSlot(&p->_zc, n - 1);
+            for (int i = n - 1; i > 0; --i, edge2 = tZeroCrossingCollector_prevSlot(&p->_zc, edge2))
             {
-                tZeroCrossingInfo edge2 = tZeroCrossingCollector_getCrossing(&p->_zc, i);
-                if (edge2->_peak >= threshold)
+                if (tZeroCrossingCollector_getCrossingPeak(&p->_zc, edge2) >= threshold)
                 {
-                    for (int j = i-1; j >= 0; --j)
+                    int edge1 = tZeroCrossingCollector_prevSlot(&p->_zc, edge2);
+                    for (int j = i-1; j >= 0; --j, edge1 = tZeroCrossingCollector_prevSlot(&p->_zc, edge1))
                     {
-                        tZeroCrossingInfo edge1 = tZeroCrossingCollector_getCrossing(&p->_zc, j);
-                        if (edge1->_peak >= threshold)
+                        if (tZeroCrossingCollector_getCrossingPeak(&p->_zc, edge1) >= threshold)
                         {
-                            Lfloat period = tZeroCrossingInfo_fractionalPeriod(&edge1, &edge2);
+                            Lfloat period = tZeroCrossingCollector_getFractionalPeriod(&p->_zc, edge1, edge2);
                             if (period > p->_min_period)
                                 return (p->_predicted_period = period);
                         }
@@ -1690,6 +1969,15 @@ void    tPeriodDetector_setSampleRate   (tPeriodDetector* const detector, Lfloat
     p->_min_period = (1.0f / p->highestFreq) * p->sampleRate;
 }
 
+void    tPeriodDetector_setAnalysisPhase    (tPeriodDetector* const detector, Lfloat phase)
+{
+    _tPeriodDetector* p = *detector;
+    _tZeroCrossingCollector* z = p->_zc;
+    
+    // the collector becomes ready every half window from its last reset
+    z->_frame = (int)(LEAF_clip(0.0f, phase, 1.0f) * (z->_window_size / 2 - 1));
+}
+
 static inline void set_bitstream(tPeriodDetector* const detector)
 {
     _tPeriodDetector* p = *detector;
@@ -1701,18 +1989,21 @@ static inline void set_bitstream(tPeriodDetector* const detector)
     p->_num_pulses = 0;
     tBitset_clear(&p->_bits);
     
-    for (int i = 0; i != tZeroCrossingCollector_getNumEdges(&p->_zc); ++i)
+    int numEdges = tZeroCrossingCollector_getNumEdges(&p->_zc);
+    int slot = tZeroCrossingCollector_getSlot(&p->_zc, 0);
+    for (int i = 0; i != numEdges; ++i, slot = tZeroCrossingCollector_nextSlot(&p->_zc, slot))
     {
-        tZeroCrossingInfo info = tZeroCrossingCollector_getCrossing(&p->_zc, i);
-        if (info->_peak >= threshold)
+        if (tZeroCrossingCollector_getCrossingPeak(&p->_zc, slot) >= threshold)
         {
+            int leading = tZeroCrossingCollector_getLeadingEdge(&p->_zc, slot);
+            int trailing = tZeroCrossingCollector_getTrailingEdge(&p->_zc, slot);
             ++p->_num_pulses;
-            if (info->_leading_edge < leading_edge)
-                leading_edge = info->_leading_edge;
-            if (info->_trailing_edge > trailing_edge)
-                trailing_edge = info->_trailing_edge;
-            int pos = fmax(info->_leading_edge, 0);
-            int n = info->_trailing_edge - pos;
+            if (leading < leading_edge)
+                leading_edge = leading;
+            if (trailing > trailing_edge)
+                trailing_edge = trailing;
+            int pos = fmax(leading, 0);
+            int n = trailing - pos;
             tBitset_setMultiple(&p->_bits, pos, n, 1);
         }
     }
@@ -1737,17 +2028,17 @@ static inline void autocorrelate(tPeriodDetector* const detector)
     {
         int shouldBreak = 0;
         int n = tZeroCrossingCollector_getNumEdges(&p->_zc);
-        for (int i = 0; i != n - 1; ++i)
+        int curr = tZeroCrossingCollector_getSlot(&p->_zc, 0);
+        for (int i = 0; i != n - 1; ++i, curr = tZeroCrossingCollector_nextSlot(&p->_zc, curr))
         {
-            tZeroCrossingInfo curr = tZeroCrossingCollector_getCrossing(&p->_zc, i);
-            if (curr->_peak >= threshold)
+            if (tZeroCrossingCollector_getCrossingPeak(&p->_zc, curr) >= threshold)
             {
-                for (int j = i + 1; j != n; ++j)
+                int next = tZeroCrossingCollector_nextSlot(&p->_zc, curr);
+                for (int j = i + 1; j != n; ++j, next = tZeroCrossingCollector_nextSlot(&p->_zc, next))
                 {
-                    tZeroCrossingInfo next = tZeroCrossingCollector_getCrossing(&p->_zc, j);
-                    if (next->_peak >= threshold)
+                    if (tZeroCrossingCollector_getCrossingPeak(&p->_zc, next) >= threshold)
                     {
-                        int period = tZeroCrossingInfo_period(&curr, &next);
+                        int period = tZeroCrossingCollector_getPeriod(&p->_zc, curr, next);
                         if (period > p->_mid_point)
                             break;
                         if (period >= p->_min_period)
@@ -1755,7 +2046,7 @@ static inline void autocorrelate(tPeriodDetector* const detector)
                             
                             int count = tBACF_getCorrelation(&p->_bacf, period);
                             
-                            int mid = p->_bacf->_mid_array * CHAR_BIT * sizeof(unsigned int);
+                            int mid = p->_bacf->_mid_bits;
                             
                             int start = period;
                             
@@ -1766,23 +2057,45 @@ static inline void autocorrelate(tPeriodDetector* const detector)
                             }
                             else if (period < 32) // Search minimum if the resolution is low
                             {
-                                // Search upwards for the minimum autocorrelation count
-                                for (int d = start + 1; d < mid; ++d)
+                                // Search upwards for the minimum autocorrelation count,
+                                // a few lags per pass over the bitstream
+                                int lags[BACF_SEARCH_LAGS], counts[BACF_SEARCH_LAGS];
+                                int found = 0;
+                                for (int d = start + 1; d < mid && !found; d += BACF_SEARCH_LAGS)
                                 {
-                                    int c = tBACF_getCorrelation(&p->_bacf, d);
-                                    if (c > count)
-                                        break;
-                                    count = c;
-                                    period = d;
+                                    int n = 0;
+                                    for (; n < BACF_SEARCH_LAGS && d + n < mid; ++n)
+                                        lags[n] = d + n;
+                                    tBACF_getCorrelations(&p->_bacf, lags, counts, n);
+                                    for (int k = 0; k < n; ++k)
+                                    {
+                                        if (counts[k] > count)
+                                        {
+                                            found = 1;
+                                            break;
+                                        }
+                                        count = counts[k];
+                                        period = lags[k];
+                                    }
                                 }
                                 // Search downwards for the minimum autocorrelation count
-                                for (int d = start - 1; d > p->_min_period; --d)
+                                found = 0;
+                                for (int d = start - 1; d > p->_min_period && !found; d -= BACF_SEARCH_LAGS)
                                 {
-                                    int c = tBACF_getCorrelation(&p->_bacf, d);
-                                    if (c > count)
-                                        break;
-                                    count = c;
-                                    period = d;
+                                    int n = 0;
+                                    for (; n < BACF_SEARCH_LAGS && d - n > p->_min_period; ++n)
+                                        lags[n] = d - n;
+                                    tBACF_getCorrelations(&p->_bacf, lags, counts, n);
+                                    for (int k = 0; k < n; ++k)
+                                    {
+                                        if (counts[k] > count)
+                                        {
+                                            found = 1;
+                                            break;
+                                        }
+                                        count = counts[k];
+                                        period = lags[k];
+                                    }
                                 }
                             }
                             
@@ -1827,9 +2140,9 @@ static inline void sub_collector_init(_sub_collector* collector, tZeroCrossingCo
 
 static inline Lfloat sub_collector_period_of(_sub_collector* collector, _auto_correlation_info info)
 {
-    tZeroCrossingInfo first = tZeroCrossingCollector_getCrossing(&collector->_zc, info._i1);
-    tZeroCrossingInfo next = tZeroCrossingCollector_getCrossing(&collector->_zc, info._i2);
-    return tZeroCrossingInfo_fractionalPeriod(&first, &next);
+    int first = tZeroCrossingCollector_getSlot(&collector->_zc, info._i1);
+    int next = tZeroCrossingCollector_getSlot(&collector->_zc, info._i2);
+    return tZeroCrossingCollector_getFractionalPeriod(&collector->_zc, first, next);
 }
 
 static inline void sub_collector_save(_sub_collector* collector, _auto_correlation_info info)
@@ -1923,6 +2236,7 @@ void    tPitchDetector_initToPool   (tPitchDetector* const detector, Lfloat lowe
     _tPitchDetector* p = *detector = (_tPitchDetector*) mpool_alloc(sizeof(_tPitchDetector), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tPitchDetector_setSampleRate, NULL);
     
     tPeriodDetector_initToPool(&p->_pd, lowestFreq, highestFreq, -120.0f, mempool);
     p->_current.frequency = 0.0f;
@@ -1936,6 +2250,7 @@ void    tPitchDetector_free (tPitchDetector* const detector)
     _tPitchDetector* p = *detector;
     
     tPeriodDetector_free(&p->_pd);
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*) p, p->mempool);
 }
 
@@ -2159,6 +2474,7 @@ void    tDualPitchDetector_initToPool   (tDualPitchDetector* const detector, Lfl
     _tDualPitchDetector* p = *detector = (_tDualPitchDetector*) mpool_alloc(sizeof(_tDualPitchDetector), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tDualPitchDetector_setSampleRate, NULL);
     
     tPeriodDetection_initToPool(&p->_pd1, inBuffer, bufSize, bufSize / 2, mempool);
     tPitchDetector_initToPool(&p->_pd2, lowestFreq, highestFreq, mempool);
@@ -2183,6 +2499,7 @@ void    tDualPitchDetector_free (tDualPitchDetector* const detector)
     tPeriodDetection_free(&p->_pd1);
     tPitchDetector_free(&p->_pd2);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*) p, p->mempool);
 }
 
@@ -2313,6 +2630,14 @@ void    tDualPitchDetector_setSampleRate (tDualPitchDetector* const detector, Lf
     tPitchDetector_setSampleRate(&p->_pd2, p->sampleRate);
 }
 
+void    tDualPitchDetector_setAnalysisPhase (tDualPitchDetector* const detector, Lfloat phase)
+{
+    _tDualPitchDetector* p = *detector;
+    
+    tPeriodDetection_setAnalysisPhase(&p->_pd1, phase);
+    tPeriodDetector_setAnalysisPhase(&p->_pd2->_pd, phase);
+}
+
 static inline void compute_predicted_frequency(tDualPitchDetector* const detector)
 {
     _tDualPitchDetector* p = *detector;
@@ -2332,3 +2657,157 @@ static inline void compute_predicted_frequency(tDualPitchDetector* const detecto
     p->_predicted_frequency = 0.0f;
 }
 
+//===========================================================================
+// PITCHTRACKERBANK
+//===========================================================================
+
+void    tPitchTrackerBank_init  (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, LEAF* const leaf)
+{
+    tPitchTrackerBank_initToPool(bank, numChannels, lowestFreq, highestFreq, bufSize, &leaf->mempool);
+}
+
+void    tPitchTrackerBank_initToPool    (tPitchTrackerBank* const bank, int numChannels, Lfloat lowestFreq, Lfloat highestFreq, int bufSize, tMempool* const mempool)
+{
+    _tMempool* m = *mempool;
+    _tPitchTrackerBank* b = *bank = (_tPitchTrackerBank*) mpool_alloc(sizeof(_tPitchTrackerBank), m);
+    b->mempool = m;
+    LEAF_registerObject(b->mempool, &b->node, b, (LEAFSampleRateFunc) tPitchTrackerBank_setSampleRate, NULL);
+    
+    b->numChannels = numChannels;
+    b->bufSize = bufSize;
+    
+    b->processbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE * 2), m);
+    b->spectrumbuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (SNAC_FRAME_SIZE / 2), m);
+    b->frequencies = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numChannels, m);
+    b->periodicities = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numChannels, m);
+    b->buffers = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * numChannels, m);
+    b->detectors = (tDualPitchDetector*) mpool_alloc(sizeof(tDualPitchDetector) * numChannels, m);
+    
+    for (int i = 0; i < numChannels; ++i)
+    {
+        b->buffers[i] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * bufSize, m);
+        tDualPitchDetector_initToPool(&b->detectors[i], lowestFreq, highestFreq, b->buffers[i], bufSize, mempool);
+        
+        // channels are ticked one after another, so their SNACs can share one set of FFT buffers
+        tSNAC_setScratch(&b->detectors[i]->_pd1->snac, b->processbuf, b->spectrumbuf);
+        
+        // spread the channels' analysis bursts evenly over the analysis period
+        tDualPitchDetector_setAnalysisPhase(&b->detectors[i], (Lfloat)i / (Lfloat)numChannels);
+    }
+}
+
+void    tPitchTrackerBank_free  (tPitchTrackerBank* const bank)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    for (int i = 0; i < b->numChannels; ++i)
+    {
+        tDualPitchDetector_free(&b->detectors[i]);
+        mpool_free((char*) b->buffers[i], b->mempool);
+    }
+    mpool_free((char*) b->detectors, b->mempool);
+    mpool_free((char*) b->buffers, b->mempool);
+    mpool_free((char*) b->periodicities, b->mempool);
+    mpool_free((char*) b->frequencies, b->mempool);
+    mpool_free((char*) b->spectrumbuf, b->mempool);
+    mpool_free((char*) b->processbuf, b->mempool);
+    LEAF_unregisterObject(b->mempool, &b->node);
+    mpool_free((char*) b, b->mempool);
+}
+
+int     tPitchTrackerBank_tick  (tPitchTrackerBank* const bank, Lfloat* samples)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    int ready = 0;
+    for (int i = 0; i < b->numChannels; ++i)
+    {
+        if (tDualPitchDetector_tick(&b->detectors[i], samples[i]))
+        {
+            b->frequencies[i] = tDualPitchDetector_getFrequency(&b->detectors[i]);
+            b->periodicities[i] = tDualPitchDetector_getPeriodicity(&b->detectors[i]);
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int     tPitchTrackerBank_tickBlock (tPitchTrackerBank* const bank, Lfloat** inputs, int size)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    int ready = 0;
+    for (int i = 0; i < b->numChannels; ++i)
+    {
+        tDualPitchDetector d = b->detectors[i];
+        Lfloat* in = inputs[i];
+        int channelReady = 0;
+        
+        for (int j = 0; j < size; ++j)
+            channelReady += tDualPitchDetector_tick(&d, in[j]);
+        
+        if (channelReady)
+        {
+            b->frequencies[i] = tDualPitchDetector_getFrequency(&d);
+            b->periodicities[i] = tDualPitchDetector_getPeriodicity(&d);
+            ready += channelReady;
+        }
+    }
+    return ready;
+}
+
+Lfloat   tPitchTrackerBank_getFrequency  (tPitchTrackerBank* const bank, int channel)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    return b->frequencies[channel];
+}
+
+Lfloat   tPitchTrackerBank_getPeriodicity    (tPitchTrackerBank* const bank, int channel)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    return b->periodicities[channel];
+}
+
+Lfloat*  tPitchTrackerBank_getFrequencies    (tPitchTrackerBank* const bank)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    return b->frequencies;
+}
+
+Lfloat*  tPitchTrackerBank_getPeriodicities  (tPitchTrackerBank* const bank)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    return b->periodicities;
+}
+
+void    tPitchTrackerBank_setHysteresis (tPitchTrackerBank* const bank, Lfloat hysteresis)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    for (int i = 0; i < b->numChannels; ++i)
+        tDualPitchDetector_setHysteresis(&b->detectors[i], hysteresis);
+}
+
+void    tPitchTrackerBank_setPeriodicityThreshold   (tPitchTrackerBank* const bank, Lfloat thresh)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    for (int i = 0; i < b->numChannels; ++i)
+        tDualPitchDetector_setPeriodicityThreshold(&b->detectors[i], thresh);
+}
+
+void    tPitchTrackerBank_setSampleRate (tPitchTrackerBank* const bank, Lfloat sr)
+{
+    _tPitchTrackerBank* b = *bank;
+    
+    for (int i = 0; i < b->numChannels; ++i)
+    {
+        tDualPitchDetector_setSampleRate(&b->detectors[i], sr);
+        // the zero crossing collectors are rebuilt for the new rate, so stagger them again
+        tDualPitchDetector_setAnalysisPhase(&b->detectors[i], (Lfloat)i / (Lfloat)b->numChannels);
+    }
+}
@@ -29,6 +29,7 @@ void    tDelay_initToPool   (tDelay* const dl, uint32_t delay, uint32_t maxDelay
     _tMempool* m = *mp;
     _tDelay* d = *dl = (_tDelay*) mpool_alloc(sizeof(_tDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -52,6 +53,7 @@ void tDelay_free (tDelay* const dl)
     _tDelay* d = *dl;
     
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
@@ -170,6 +172,7 @@ void tLinearDelay_initToPool  (tLinearDelay* const dl, Lfloat delay, uint32_t ma
     _tMempool* m = *mp;
     _tLinearDelay* d = *dl = (_tLinearDelay*) mpool_alloc(sizeof(_tLinearDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tLinearDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -195,6 +198,7 @@ void tLinearDelay_free (tLinearDelay* const dl)
     _tLinearDelay* d = *dl;
     
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
@@ -382,6 +386,7 @@ void tHermiteDelay_initToPool  (tHermiteDelay* const dl, Lfloat delay, uint32_t
     _tMempool* m = *mp;
     _tHermiteDelay* d = *dl = (_tHermiteDelay*) mpool_alloc(sizeof(_tHermiteDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tHermiteDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -426,6 +431,7 @@ void tHermiteDelay_free (tHermiteDelay* const dl)
     _tHermiteDelay* d = *dl;
 
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
@@ -596,6 +602,7 @@ void tLagrangeDelay_initToPool  (tLagrangeDelay* const dl, Lfloat delay, uint32_
     _tMempool* m = *mp;
     _tLagrangeDelay* d = *dl = (_tLagrangeDelay*) mpool_alloc(sizeof(_tLagrangeDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tLagrangeDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -639,6 +646,7 @@ void tLagrangeDelay_free (tLagrangeDelay* const dl)
     _tLagrangeDelay* d = *dl;
 
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
@@ -833,6 +841,7 @@ void tAllpassDelay_initToPool  (tAllpassDelay* const dl, Lfloat delay, uint32_t
     _tMempool* m = *mp;
     _tAllpassDelay* d = *dl = (_tAllpassDelay*) mpool_alloc(sizeof(_tAllpassDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tAllpassDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -860,6 +869,7 @@ void tAllpassDelay_free (tAllpassDelay* const dl)
     _tAllpassDelay* d = *dl;
     
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
@@ -1006,6 +1016,7 @@ void tTapeDelay_initToPool (tTapeDelay* const dl, Lfloat delay, uint32_t maxDela
     _tMempool* m = *mp;
     _tTapeDelay* d = *dl = (_tTapeDelay*) mpool_alloc(sizeof(_tTapeDelay), m);
     d->mempool = m;
+    LEAF_registerObject(d->mempool, &d->node, d, NULL, (LEAFClearFunc) tTapeDelay_clear);
 
     d->maxDelay = maxDelay;
 
@@ -1028,6 +1039,7 @@ void tTapeDelay_free (tTapeDelay* const dl)
     _tTapeDelay* d = *dl;
 
     mpool_free((char*)d->buff, d->mempool);
+    LEAF_unregisterObject(d->mempool, &d->node);
     mpool_free((char*)d, d->mempool);
 }
 
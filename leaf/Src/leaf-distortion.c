@@ -12,6 +12,7 @@
 #include "..\Inc\leaf-tables.h"
 #include "..\Inc\leaf-math.h"
 #include "..\Inc\leaf-filters.h"
+#include "..\Inc\leaf-kernels.h"
 #else
 
 
@@ -19,6 +20,7 @@
 #include "../Inc/leaf-tables.h"
 #include "../Inc/leaf-math.h"
 #include "../Inc/leaf-filters.h"
+#include "../Inc/leaf-kernels.h"
 #ifdef ARM_MATH_CM7
 #include "arm_math.h"
 #endif
@@ -77,6 +79,23 @@ void tSampleReducer_setRatio(tSampleReducer* const sr, Lfloat ratio)
 //============================================================================================================
 // Oversampler
 //============================================================================================================
+static void tOversampler_setCoeffs(_tOversampler* const os)
+{
+    int idx = (int)(log2f(os->ratio))-1+os->offset;
+    os->numTaps = __leaf_tablesize_firNumTaps[idx];
+    os->phaseLength = os->numTaps / os->ratio;
+    os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+    
+    // upsampling skips the stuffed zeros, so phase j only ever meets every ratio-th
+    // coefficient; gathering each phase's taps lets it run as one contiguous dot product
+    for (uint32_t j = 0; j < os->ratio; j++)
+    {
+        Lfloat* phase = os->phaseCoeffs + j * os->phaseLength;
+        for (uint32_t t = 0; t < os->phaseLength; t++)
+            phase[t] = os->pCoeffs[(os->ratio - 1 - j) + t * os->ratio] * os->ratio;
+    }
+}
+
 // Latency is equal to the phase length (numTaps / ratio)
 void tOversampler_init (tOversampler* const osr, int ratio, int extraQuality, LEAF* const leaf)
 {
@@ -98,12 +117,20 @@ void tOversampler_initToPool (tOversampler* const osr, int maxRatio, int extraQu
         os->maxRatio = maxRatio;
         os->allowHighQuality = extraQuality;
         os->ratio = os->maxRatio;
-        uint_fast16_t idx = (int)(log2f(os->ratio))-1+os->offset;
-        os->numTaps = __leaf_tablesize_firNumTaps[idx];
-        os->phaseLength = os->numTaps / os->ratio;
-        os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
-        os->upState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
-        os->downState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
+        
+        // room for the longest table any ratio or quality setting can reach
+        uint32_t maxTaps = 0;
+        for (int r = 2; r <= maxRatio; r *= 2)
+        {
+            int idx = (int)(log2f(r))-1;
+            if (__leaf_tablesize_firNumTaps[idx] > maxTaps) maxTaps = __leaf_tablesize_firNumTaps[idx];
+            if (extraQuality && __leaf_tablesize_firNumTaps[idx+6] > maxTaps) maxTaps = __leaf_tablesize_firNumTaps[idx+6];
+        }
+        os->phaseCoeffs = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps, m);
+        tOversampler_setCoeffs(os);
+        
+        os->upState = (Lfloat*) mpool_calloc(sizeof(Lfloat) * os->numTaps * 2, m);
+        os->downState = (Lfloat*) mpool_calloc(sizeof(Lfloat) * os->numTaps * 2, m);
     }
 }
 
@@ -113,6 +140,7 @@ void tOversampler_free (tOversampler* const osr)
     
     mpool_free((char*)os->upState, os->mempool);
     mpool_free((char*)os->downState, os->mempool);
+    mpool_free((char*)os->phaseCoeffs, os->mempool);
     mpool_free((char*)os, os->mempool);
 }
 
@@ -145,12 +173,8 @@ void tOversampler_upsample(tOversampler* const osr, Lfloat input, Lfloat* output
     }
     
     Lfloat *pState = os->upState;                 /* State pointer */
-    Lfloat *pCoeffs = os->pCoeffs;               /* Coefficient pointer */
     Lfloat *pStateCur;
-    Lfloat *ptr1;                               /* Temporary pointer for state buffer */
-    Lfloat *ptr2;                               /* Temporary pointer for coefficient buffer */
-    Lfloat sum0;                                /* Accumulators */
-    uint_fast16_t i, tapCnt;                    /* Loop counters */
+    uint_fast16_t tapCnt;                       /* Loop counter */
     uint_fast16_t phaseLen = os->phaseLength;            /* Length of each polyphase filter component */
     uint_fast16_t j;
     
@@ -161,51 +185,10 @@ void tOversampler_upsample(tOversampler* const osr, Lfloat input, Lfloat* output
     /* Copy new input sample into the state buffer */
     *pStateCur = input;
     
-    /* Address modifier index of coefficient buffer */
-    j = 1U;
-    
-    /* Loop over the Interpolation factor. */
-    i = os->ratio;
-    
-    while (i > 0U)
+    /* One output per polyphase component, each already scaled by the interpolation factor */
+    for (j = 0; j < os->ratio; j++)
     {
-        /* Set accumulator to zero */
-        sum0 = 0.0f;
-        
-        /* Initialize state pointer */
-        ptr1 = pState;
-        
-        /* Initialize coefficient pointer */
-        ptr2 = pCoeffs + (os->ratio - j);
-        
-        /* Loop over the polyPhase length.
-         Repeat until we've computed numTaps-(4*os->L) coefficients. */
-        
-        /* Initialize tapCnt with number of samples */
-        tapCnt = phaseLen;
-        
-        while (tapCnt > 0U)
-        {
-            /* Perform the multiply-accumulate */
-            sum0 += *ptr1++ * *ptr2;
-            
-            /* Upsampling is done by stuffing L-1 zeros between each sample.
-             * So instead of multiplying zeros with coefficients,
-             * Increment the coefficient pointer by interpolation factor times. */
-            ptr2 += os->ratio;
-            
-            /* Decrement loop counter */
-            tapCnt--;
-        }
-        
-        /* The result is in the accumulator, store in the destination buffer. */
-        *output++ = sum0 * os->ratio;
-        
-        /* Increment the address modifier index of coefficient buffer */
-        j++;
-        
-        /* Decrement the loop counter */
-        i--;
+        output[j] = LEAF_kernel_dot(pState, os->phaseCoeffs + j * phaseLen, phaseLen);
     }
     
     /* Advance the state pointer by 1
@@ -246,10 +229,6 @@ Lfloat tOversampler_downsample(tOversampler *const osr, Lfloat* input)
     Lfloat *pState = os->downState;                 /* State pointer */
     Lfloat *pCoeffs = os->pCoeffs;               /* Coefficient pointer */
     Lfloat *pStateCur;                          /* Points to the current sample of the state */
-    Lfloat *px0;                                /* Temporary pointer for state buffer */
-    Lfloat *pb;                                 /* Temporary pointer for coefficient buffer */
-    Lfloat x0, c0;                              /* Temporary variables to hold state and coefficient values */
-    Lfloat acc0;                                /* Accumulator */
     uint32_t numTaps = os->numTaps;                 /* Number of filter coefficients in the filter */
     uint32_t i, tapCnt;
     Lfloat output;
@@ -267,40 +246,13 @@ Lfloat tOversampler_downsample(tOversampler *const osr, Lfloat* input)
         
     } while (--i);
     
-    /* Set accumulator to zero */
-    acc0 = 0.0f;
-    
-    /* Initialize state pointer */
-    px0 = pState;
-    
-    /* Initialize coeff pointer */
-    pb = pCoeffs;
-    
-    /* Initialize tapCnt with number of taps */
-    tapCnt = numTaps;
-    
-    while (tapCnt > 0U)
-    {
-        /* Read coefficients */
-        c0 = *pb++;
-        
-        /* Fetch 1 state variable */
-        x0 = *px0++;
-        
-        /* Perform the multiply-accumulate */
-        acc0 += x0 * c0;
-        
-        /* Decrement loop counter */
-        tapCnt--;
-    }
+    /* Only the output sample that is kept gets computed */
+    output = LEAF_kernel_dot(pState, pCoeffs, numTaps);
     
     /* Advance the state pointer by the decimation factor
      * to process the next group of decimation factor number samples */
     pState = pState + os->ratio;
     
-    /* The result is in the accumulator, store in the destination buffer. */
-    output = acc0;
-    
     /* Processing is complete.
      Now copy the last numTaps - 1 samples to the start of the state buffer.
      This prepares the state buffer for the next function call. */
@@ -334,10 +286,7 @@ void    tOversampler_setRatio       (tOversampler* const osr, int ratio)
         ratio == 16 || ratio == 32 || ratio == 64)
     {
         os->ratio = ratio;
-        int idx = (int)(log2f(os->ratio))-1+os->offset;
-        os->numTaps = __leaf_tablesize_firNumTaps[idx];
-        os->phaseLength = os->numTaps / os->ratio;
-        os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+        tOversampler_setCoeffs(os);
     }
 }
 
@@ -352,10 +301,7 @@ void    tOversampler_setQuality     (tOversampler* const osr, int quality)
     
     if (os->ratio == 1) return;
     
-    int idx = (int)(log2f(os->ratio))-1+os->offset;
-    os->numTaps = __leaf_tablesize_firNumTaps[idx];
-    os->phaseLength = os->numTaps / os->ratio;
-    os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+    tOversampler_setCoeffs(os);
 }
 
 int tOversampler_getLatency(tOversampler* const osr)
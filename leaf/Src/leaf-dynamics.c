@@ -52,6 +52,7 @@ void tCompressor_initToPool (tCompressor* const comp, tMempool* const mp)
     _tCompressor* c = *comp = (_tCompressor*) mpool_alloc(sizeof(_tCompressor), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tCompressor_setSampleRate, NULL);
     c->sampleRate = leaf->sampleRate;
     
     c->tauAttack = expf(-1.0f/(0.001f * 50.0f * c->sampleRate));
@@ -80,6 +81,7 @@ void tCompressor_free (tCompressor* const comp)
 {
     _tCompressor* c = *comp;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -270,6 +272,295 @@ void tCompressor_setSampleRate(tCompressor* const comp, Lfloat sampleRate)
     _tCompressor* c = *comp;
     c->sampleRate = sampleRate;
 }
+
+//requires tables to be set with set function
+//same as tCompressor_tickWithTable but with the object state held in locals for the whole block
+void tCompressor_tickBlockWithTable(tCompressor* const comp, Lfloat* in, Lfloat* out, int size)
+{
+    _tCompressor* c = *comp;
+    
+    Lfloat* atodbTable = c->atodbTable;
+    Lfloat* dbtoaTable = c->dbtoaTable;
+    Lfloat atodbScalar = c->atodbScalar;
+    Lfloat atodbOffset = c->atodbOffset;
+    Lfloat dbtoaScalar = c->dbtoaScalar;
+    Lfloat dbtoaOffset = c->dbtoaOffset;
+    int atodbMax = c->atodbTableSizeMinus1;
+    int dbtoaMax = c->dbtoaTableSizeMinus1;
+    Lfloat T = c->T;
+    Lfloat W = c->W;
+    Lfloat M = c->M;
+    Lfloat inv4W = c->inv4W;
+    Lfloat tauAttack = c->tauAttack;
+    Lfloat tauRelease = c->tauRelease;
+    Lfloat slope = 1.0f - c->invR; // feed-forward topology;
+    Lfloat y = c->y_T[0];
+    Lfloat x = c->x_T[0];
+    int isActive = c->isActive;
+    
+    for (int i = 0; i < size; i++)
+    {
+        Lfloat sample = in[i];
+        int inAmpIndex = LEAF_clip (0, (fastabsf(sample) * atodbScalar) - atodbOffset, atodbMax);
+        Lfloat in_db = atodbTable[inAmpIndex];
+        Lfloat out_db;
+        Lfloat overshoot = in_db - T;
+        
+        if (overshoot <= -W)
+        {
+            out_db = in_db;
+            isActive = 0;
+        }
+        else if (overshoot < W)
+        {
+            Lfloat squareit = (overshoot + W);
+            out_db = in_db + slope * ((squareit * squareit) * inv4W);
+            isActive = 1;
+        }
+        else
+        {
+            out_db = in_db + slope * overshoot;
+            isActive = 1;
+        }
+        
+        x = out_db - in_db;
+        if (x > y)
+            y = tauAttack * y + (1.0f-tauAttack) * x;
+        else
+            y = tauRelease * y + (1.0f-tauRelease) * x;
+        
+        int attenuationDbIndex = LEAF_clip (0, ((M - y) * dbtoaScalar) - dbtoaOffset, dbtoaMax);
+        out[i] = dbtoaTable[attenuationDbIndex] * sample;
+    }
+    
+    c->y_T[1] = c->y_T[0] = y;
+    c->x_T[0] = x;
+    c->isActive = isActive;
+}
+
+//==============================================================================
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Multiband Compressor ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+#define MULTIBAND_ATODB_MIN 0.00001f
+#define MULTIBAND_ATODB_MAX 1.0f
+#define MULTIBAND_DBTOA_MIN -100.0f
+#define MULTIBAND_DBTOA_MAX 40.0f
+
+static void tMultibandCompressor_computeCoefficients(_tMultibandCompressor* mb, int which)
+{
+    // Butterworth (Q = 1/sqrt(2)) section, cascaded twice for each LR4 output
+    Lfloat f = LEAF_clip(10.0f, mb->freqs[which], mb->sampleRate * 0.49f);
+    Lfloat K = tanf(PI * f / mb->sampleRate);
+    Lfloat KK = K * K;
+    Lfloat norm = 1.0f / (1.0f + LEAF_SQRT2 * K + KK);
+    mb->lpB0[which] = KK * norm;
+    mb->hpB0[which] = norm;
+    mb->a1[which] = 2.0f * (KK - 1.0f) * norm;
+    mb->a2[which] = (1.0f - LEAF_SQRT2 * K + KK) * norm;
+}
+
+void tMultibandCompressor_init (tMultibandCompressor* const comp, int numBands, int maxBlockSize, LEAF* const leaf)
+{
+    tMultibandCompressor_initToPool(comp, numBands, maxBlockSize, &leaf->mempool);
+}
+
+void tMultibandCompressor_initToPool (tMultibandCompressor* const comp, int numBands, int maxBlockSize, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tMultibandCompressor* mb = *comp = (_tMultibandCompressor*) mpool_calloc(sizeof(_tMultibandCompressor), m);
+    mb->mempool = m;
+    LEAF* leaf = mb->mempool->leaf;
+    LEAF_registerObject(mb->mempool, &mb->node, mb, (LEAFSampleRateFunc) tMultibandCompressor_setSampleRate, NULL);
+    
+    mb->sampleRate = leaf->sampleRate;
+    mb->numBands = LEAF_clip(2, numBands, MULTIBAND_MAX_BANDS);
+    mb->maxBlockSize = maxBlockSize > 0 ? maxBlockSize : 1;
+    
+    mb->atodbTable = (Lfloat*) mpool_alloc(sizeof(Lfloat) * MULTIBAND_TABLE_SIZE, m);
+    mb->dbtoaTable = (Lfloat*) mpool_alloc(sizeof(Lfloat) * MULTIBAND_TABLE_SIZE, m);
+    LEAF_generate_atodb(mb->atodbTable, MULTIBAND_TABLE_SIZE, MULTIBAND_ATODB_MIN, MULTIBAND_ATODB_MAX);
+    LEAF_generate_dbtoa(mb->dbtoaTable, MULTIBAND_TABLE_SIZE, MULTIBAND_DBTOA_MIN, MULTIBAND_DBTOA_MAX);
+    
+    for (int i = 0; i < mb->numBands; i++)
+    {
+        tCompressor_initToPool(&mb->comps[i], mp);
+        tCompressor_setTables(&mb->comps[i], mb->atodbTable, mb->dbtoaTable,
+                              MULTIBAND_ATODB_MIN, MULTIBAND_ATODB_MAX,
+                              MULTIBAND_DBTOA_MIN, MULTIBAND_DBTOA_MAX,
+                              MULTIBAND_TABLE_SIZE, MULTIBAND_TABLE_SIZE);
+        mb->bands[i] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * mb->maxBlockSize, m);
+    }
+    
+    // default crossovers spread logarithmically between 200Hz and 5kHz
+    Lfloat spread = mb->numBands > 2 ? 1.0f / (Lfloat)(mb->numBands - 2) : 0.0f;
+    for (int i = 0; i < mb->numBands - 1; i++)
+    {
+        mb->freqs[i] = 200.0f * powf(25.0f, i * spread);
+        tMultibandCompressor_computeCoefficients(mb, i);
+    }
+}
+
+void tMultibandCompressor_free (tMultibandCompressor* const comp)
+{
+    _tMultibandCompressor* mb = *comp;
+    
+    for (int i = 0; i < mb->numBands; i++)
+    {
+        mpool_free((char*)mb->bands[i], mb->mempool);
+        tCompressor_free(&mb->comps[i]);
+    }
+    mpool_free((char*)mb->dbtoaTable, mb->mempool);
+    mpool_free((char*)mb->atodbTable, mb->mempool);
+    LEAF_unregisterObject(mb->mempool, &mb->node);
+    mpool_free((char*)mb, mb->mempool);
+}
+
+// LR4 split of one crossover. The two Butterworth lowpass and two highpass sections share
+// their poles, so they run as four lanes of the same recurrence. in and hi may alias.
+static void tMultibandCompressor_split(_tMultibandCompressor* mb, int k, Lfloat* in, Lfloat* lo, Lfloat* hi, int size)
+{
+    Lfloat lp = mb->lpB0[k];
+    Lfloat hp = mb->hpB0[k];
+    Lfloat a1 = mb->a1[k];
+    Lfloat a2 = mb->a2[k];
+    Lfloat b0[4] = { lp, hp, lp, hp };
+    Lfloat b1[4] = { 2.0f * lp, -2.0f * hp, 2.0f * lp, -2.0f * hp };
+    Lfloat z1[4], z2[4], v[4], y[4];
+    
+    for (int j = 0; j < 4; j++)
+    {
+        z1[j] = mb->z1[k][j];
+        z2[j] = mb->z2[k][j];
+    }
+    
+    for (int i = 0; i < size; i++)
+    {
+        v[0] = v[1] = in[i];
+        for (int j = 0; j < 2; j++)
+        {
+            y[j] = b0[j] * v[j] + z1[j];
+            z1[j] = b1[j] * v[j] - a1 * y[j] + z2[j];
+            z2[j] = b0[j] * v[j] - a2 * y[j];
+        }
+        v[2] = y[0];
+        v[3] = y[1];
+        for (int j = 2; j < 4; j++)
+        {
+            y[j] = b0[j] * v[j] + z1[j];
+            z1[j] = b1[j] * v[j] - a1 * y[j] + z2[j];
+            z2[j] = b0[j] * v[j] - a2 * y[j];
+        }
+        lo[i] = y[2];
+        hi[i] = y[3];
+    }
+    
+    for (int j = 0; j < 4; j++)
+    {
+        mb->z1[k][j] = z1[j];
+        mb->z2[k][j] = z2[j];
+    }
+}
+
+// Allpass with the same poles as crossover k, equal to the sum of its LR4 outputs
+static void tMultibandCompressor_allpass(_tMultibandCompressor* mb, int band, int k, Lfloat* buf, int size)
+{
+    Lfloat a1 = mb->a1[k];
+    Lfloat a2 = mb->a2[k];
+    Lfloat z1 = mb->apz1[band][k];
+    Lfloat z2 = mb->apz2[band][k];
+    
+    for (int i = 0; i < size; i++)
+    {
+        Lfloat x = buf[i];
+        Lfloat y = a2 * x + z1;
+        z1 = a1 * x - a1 * y + z2;
+        z2 = x - a2 * y;
+        buf[i] = y;
+    }
+    
+    mb->apz1[band][k] = z1;
+    mb->apz2[band][k] = z2;
+}
+
+void tMultibandCompressor_tickBlock (tMultibandCompressor* const comp, Lfloat* in, Lfloat* out, int size)
+{
+    _tMultibandCompressor* mb = *comp;
+    int last = mb->numBands - 1;
+    
+    while (size > 0)
+    {
+        int n = size < mb->maxBlockSize ? size : mb->maxBlockSize;
+        
+        // the highest band buffer carries the remainder down the crossover tree
+        Lfloat* rest = in;
+        for (int k = 0; k < last; k++)
+        {
+            tMultibandCompressor_split(mb, k, rest, mb->bands[k], mb->bands[last], n);
+            rest = mb->bands[last];
+            for (int b = 0; b < k; b++)
+                tMultibandCompressor_allpass(mb, b, k, mb->bands[b], n);
+        }
+        
+        for (int b = 0; b <= last; b++)
+            tCompressor_tickBlockWithTable(&mb->comps[b], mb->bands[b], mb->bands[b], n);
+        
+        for (int i = 0; i < n; i++)
+        {
+            Lfloat sum = 0.0f;
+            for (int b = 0; b <= last; b++) sum += mb->bands[b][i];
+            out[i] = sum;
+        }
+        
+        in += n;
+        out += n;
+        size -= n;
+    }
+}
+
+Lfloat tMultibandCompressor_tick (tMultibandCompressor* const comp, Lfloat input)
+{
+    Lfloat output;
+    tMultibandCompressor_tickBlock(comp, &input, &output, 1);
+    return output;
+}
+
+void tMultibandCompressor_setCrossover (tMultibandCompressor* const comp, int which, Lfloat freq)
+{
+    _tMultibandCompressor* mb = *comp;
+    if (which < 0 || which >= mb->numBands - 1) return;
+    
+    mb->freqs[which] = freq;
+    tMultibandCompressor_computeCoefficients(mb, which);
+}
+
+void tMultibandCompressor_setBandParams (tMultibandCompressor* const comp, int band, Lfloat thresh, Lfloat ratio, Lfloat knee, Lfloat makeup, Lfloat attack, Lfloat release)
+{
+    _tMultibandCompressor* mb = *comp;
+    if (band < 0 || band >= mb->numBands) return;
+    
+    tCompressor_setParams(&mb->comps[band], thresh, ratio, knee, makeup, attack, release);
+}
+
+tCompressor* tMultibandCompressor_getBand (tMultibandCompressor* const comp, int band)
+{
+    _tMultibandCompressor* mb = *comp;
+    if (band < 0 || band >= mb->numBands) return NULL;
+    
+    return &mb->comps[band];
+}
+
+void tMultibandCompressor_setSampleRate (tMultibandCompressor* const comp, Lfloat sampleRate)
+{
+    _tMultibandCompressor* mb = *comp;
+    mb->sampleRate = sampleRate;
+    
+    for (int i = 0; i < mb->numBands; i++)
+        tCompressor_setSampleRate(&mb->comps[i], sampleRate);
+    for (int i = 0; i < mb->numBands - 1; i++)
+        tMultibandCompressor_computeCoefficients(mb, i);
+}
+
 /* Feedback Leveler */
 
 void tFeedbackLeveler_init (tFeedbackLeveler* const fb, Lfloat targetLevel, Lfloat factor, Lfloat strength, int mode, LEAF* const leaf)
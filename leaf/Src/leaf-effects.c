@@ -10,11 +10,13 @@
 
 #include "..\Inc\leaf-effects.h"
 #include "..\leaf.h"
+#include "..\Externals\d_fft_mayer.h"
 
 #else
 
 #include "../Inc/leaf-effects.h"
 #include "../leaf.h"
+#include "../Externals/d_fft_mayer.h"
 
 #endif
 
@@ -43,6 +45,7 @@ void tTalkbox_initToPool (tTalkbox* const voc, int bufsize, tMempool* const mp)
     _tTalkbox* v = *voc = (_tTalkbox*) mpool_alloc(sizeof(_tTalkbox), m);
     v->mempool = m;
     LEAF* leaf = v->mempool->leaf;
+    LEAF_registerObject(v->mempool, &v->node, v, (LEAFSampleRateFunc) tTalkbox_setSampleRate, NULL);
     
     v->param[0] = 0.5f;  //wet
     v->param[1] = 0.0f;  //dry
@@ -83,6 +86,7 @@ void tTalkbox_free (tTalkbox* const voc)
     mpool_free((char*)v->dl, v->mempool);
     mpool_free((char*)v->Rt, v->mempool);
     mpool_free((char*)v->k, v->mempool);
+    LEAF_unregisterObject(v->mempool, &v->node);
     mpool_free((char*)v, v->mempool);
 }
 
@@ -381,6 +385,7 @@ void tTalkboxLfloat_initToPool (tTalkboxLfloat* const voc, int bufsize, tMempool
     _tTalkboxLfloat* v = *voc = (_tTalkboxLfloat*) mpool_alloc(sizeof(_tTalkboxLfloat), m);
     v->mempool = m;
     LEAF* leaf = v->mempool->leaf;
+    LEAF_registerObject(v->mempool, &v->node, v, (LEAFSampleRateFunc) tTalkboxLfloat_setSampleRate, NULL);
 
     v->param[0] = 0.5f;  //wet
     v->param[1] = 0.0f;  //dry
@@ -421,6 +426,7 @@ void tTalkboxLfloat_free (tTalkboxLfloat* const voc)
     mpool_free((char*)v->dl, v->mempool);
     mpool_free((char*)v->Rt, v->mempool);
     mpool_free((char*)v->k, v->mempool);
+    LEAF_unregisterObject(v->mempool, &v->node);
     mpool_free((char*)v, v->mempool);
 }
 
@@ -716,6 +722,7 @@ void tVocoder_initToPool (tVocoder* const voc, tMempool* const mp)
     _tVocoder* v = *voc = (_tVocoder*) mpool_alloc(sizeof(_tVocoder), m);
     v->mempool = m;
     LEAF* leaf = v->mempool->leaf;
+    LEAF_registerObject(v->mempool, &v->node, v, (LEAFSampleRateFunc) tVocoder_setSampleRate, NULL);
     
     v->invSampleRate = leaf->invSampleRate;
     
@@ -735,6 +742,7 @@ void tVocoder_free (tVocoder* const voc)
 {
     _tVocoder* v = *voc;
     
+    LEAF_unregisterObject(v->mempool, &v->node);
     mpool_free((char*)v, v->mempool);
 }
 
@@ -875,7 +883,7 @@ Lfloat       tVocoder_tick        (tVocoder* const voc, Lfloat synth, Lfloat voi
     
     v->kout = oo;
     v->kval = k & 0x1;
-#ifdef NO_DENORMAL_CHECK
+#if LEAF_NO_DENORMAL_CHECK
 #else
     if(fabs(v->f[0][11])<1.0e-10) v->f[0][11] = 0.0f; //catch HF envelope denormal
     
@@ -920,6 +928,7 @@ void tRosenbergGlottalPulse_initToPool (tRosenbergGlottalPulse* const gp, tMempo
     _tRosenbergGlottalPulse* g = *gp = (_tRosenbergGlottalPulse*) mpool_alloc(sizeof(_tRosenbergGlottalPulse), m);
     g->mempool = m;
     LEAF* leaf = g->mempool->leaf;
+    LEAF_registerObject(g->mempool, &g->node, g, (LEAFSampleRateFunc) tRosenbergGlottalPulse_setSampleRate, NULL);
     
     g->invSampleRate = leaf->invSampleRate;
 
@@ -933,6 +942,7 @@ void tRosenbergGlottalPulse_initToPool (tRosenbergGlottalPulse* const gp, tMempo
 void tRosenbergGlottalPulse_free (tRosenbergGlottalPulse* const gp)
 {
     _tRosenbergGlottalPulse* g = *gp;
+    LEAF_unregisterObject(g->mempool, &g->node);
     mpool_free((char*)g, g->mempool);
 }
 
@@ -1058,6 +1068,7 @@ void tSOLAD_initToPool (tSOLAD* const wp, int loopSize, tMempool* const mp)
     _tMempool* m = *mp;
     _tSOLAD* w = *wp = (_tSOLAD*) mpool_calloc(sizeof(_tSOLAD), m);
     w->mempool = m;
+    LEAF_registerObject(w->mempool, &w->node, w, (LEAFSampleRateFunc) tSOLAD_setSampleRate, NULL);
     
     w->loopSize = loopSize;
     w->pitchfactor = 1.;
@@ -1080,6 +1091,7 @@ void tSOLAD_free (tSOLAD* const wp)
     tAttackDetection_free(&w->ad);
     tHighpass_free(&w->hp);
     mpool_free((char*)w->delaybuf, w->mempool);
+    LEAF_unregisterObject(w->mempool, &w->node);
     mpool_free((char*)w, w->mempool);
 }
 
@@ -1417,6 +1429,7 @@ void tPitchShift_initToPool (tPitchShift* const psr, tDualPitchDetector* const d
     _tPitchShift* ps = *psr = (_tPitchShift*) mpool_alloc(sizeof(_tPitchShift), m);
     ps->mempool = m;
     LEAF* leaf = ps->mempool->leaf;
+    LEAF_registerObject(ps->mempool, &ps->node, ps, (LEAFSampleRateFunc) tPitchShift_setSampleRate, NULL);
     
     ps->pd = *dpd;
     ps->bufSize = bufSize;
@@ -1433,6 +1446,7 @@ void tPitchShift_free (tPitchShift* const psr)
     _tPitchShift* ps = *psr;
     
     tSOLAD_free(&ps->sola);
+    LEAF_unregisterObject(ps->mempool, &ps->node);
     mpool_free((char*)ps, ps->mempool);
 }
 
@@ -1482,6 +1496,350 @@ void    tPitchShift_setSampleRate(tPitchShift* const psr, Lfloat sr)
 }
 
 
+//============================================================================================================
+// PHASEVOCODER
+//============================================================================================================
+
+// STFT pitch shifter / time stretcher. Frames are analysed with a Hann window at an analysis hop of
+// hopSize / pitch, or hopSize / (pitch * stretch) when reading a source, resynthesised at hopSize with identity phase locking (Laroche & Dolson),
+// overlap-added, and the synthesized signal is then resampled by the pitch ratio.
+
+void tPhaseVocoder_init (tPhaseVocoder* const pvr, int frameSize, int overlap, LEAF* const leaf)
+{
+    tPhaseVocoder_initToPool(pvr, frameSize, overlap, &leaf->mempool);
+}
+
+void tPhaseVocoder_initToPool (tPhaseVocoder* const pvr, int frameSize, int overlap, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tPhaseVocoder* pv = *pvr = (_tPhaseVocoder*) mpool_alloc(sizeof(_tPhaseVocoder), m);
+    pv->mempool = m;
+    LEAF_registerObject(pv->mempool, &pv->node, pv, NULL, (LEAFClearFunc) tPhaseVocoder_clear);
+    
+    if (overlap < 4) overlap = 4;
+    if (overlap > frameSize / 4) overlap = frameSize / 4;
+    
+    pv->frameSize = frameSize;
+    pv->overlap = overlap;
+    pv->hopSize = frameSize / overlap;
+    pv->numBins = frameSize / 2 + 1;
+    
+    pv->window = (Lfloat*) mpool_alloc(sizeof(Lfloat) * frameSize, m);
+    pv->frame = (Lfloat*) mpool_alloc(sizeof(Lfloat) * frameSize, m);
+    pv->magnitude = (Lfloat*) mpool_alloc(sizeof(Lfloat) * pv->numBins, m);
+    pv->phase = (Lfloat*) mpool_alloc(sizeof(Lfloat) * pv->numBins, m);
+    pv->lastPhase = (Lfloat*) mpool_alloc(sizeof(Lfloat) * pv->numBins, m);
+    pv->synthPhase = (Lfloat*) mpool_alloc(sizeof(Lfloat) * pv->numBins, m);
+    pv->peaks = (int*) mpool_alloc(sizeof(int) * pv->numBins, m);
+    pv->ola = (Lfloat*) mpool_alloc(sizeof(Lfloat) * frameSize, m);
+    pv->input = (Lfloat*) mpool_alloc(sizeof(Lfloat) * frameSize * 2, m);
+    pv->output = (Lfloat*) mpool_alloc(sizeof(Lfloat) * frameSize * 4, m);
+    pv->inputMask = frameSize * 2 - 1;
+    pv->outputMask = frameSize * 4 - 1;
+    
+    // periodic Hann, applied on analysis and synthesis; its square sums to 3/8 per overlapping frame
+    for (int i = 0; i < frameSize; i++)
+        pv->window[i] = 0.5f - 0.5f * cosf(TWO_PI * (Lfloat)i / (Lfloat)frameSize);
+    pv->norm = 1.0f / ((Lfloat)frameSize * (Lfloat)overlap * 0.375f);
+    
+    pv->phaseLocking = 1;
+    pv->pitch = 1.0f;
+    pv->stretch = 1.0f;
+    
+    tPhaseVocoder_clear(pvr);
+}
+
+void tPhaseVocoder_free (tPhaseVocoder* const pvr)
+{
+    _tPhaseVocoder* pv = *pvr;
+    
+    mpool_free((char*)pv->output, pv->mempool);
+    mpool_free((char*)pv->input, pv->mempool);
+    mpool_free((char*)pv->ola, pv->mempool);
+    mpool_free((char*)pv->peaks, pv->mempool);
+    mpool_free((char*)pv->synthPhase, pv->mempool);
+    mpool_free((char*)pv->lastPhase, pv->mempool);
+    mpool_free((char*)pv->phase, pv->mempool);
+    mpool_free((char*)pv->magnitude, pv->mempool);
+    mpool_free((char*)pv->frame, pv->mempool);
+    mpool_free((char*)pv->window, pv->mempool);
+    LEAF_unregisterObject(pv->mempool, &pv->node);
+    mpool_free((char*)pv, pv->mempool);
+}
+
+static inline Lfloat wrapPhase(Lfloat phase)
+{
+    return phase - TWO_PI * roundf(phase * (1.0f / TWO_PI));
+}
+
+// pv->frame holds a windowed analysis frame; replaces it with the windowed resynthesis and overlap-adds it
+static void phaseVocoderProcessFrame(_tPhaseVocoder* const pv)
+{
+    int n = pv->frameSize;
+    int half = n / 2;
+    int numBins = pv->numBins;
+    Lfloat* mag = pv->magnitude;
+    Lfloat* phase = pv->phase;
+    Lfloat* synth = pv->synthPhase;
+    
+    mayer_realfft(n, pv->frame);
+    
+    // bin k is frame[k] + i * -frame[n - k]
+    mag[0] = fabsf(pv->frame[0]);
+    phase[0] = pv->frame[0] < 0.0f ? PI : 0.0f;
+    mag[half] = fabsf(pv->frame[half]);
+    phase[half] = pv->frame[half] < 0.0f ? PI : 0.0f;
+    for (int k = 1; k < half; k++)
+    {
+        Lfloat re = pv->frame[k];
+        Lfloat im = -pv->frame[n - k];
+        mag[k] = sqrtf(re * re + im * im);
+        phase[k] = atan2f(im, re);
+    }
+    
+    if (pv->firstFrame)
+    {
+        for (int k = 0; k < numBins; k++) synth[k] = phase[k];
+        pv->firstFrame = 0;
+    }
+    else
+    {
+        Lfloat ha = (Lfloat)pv->analysisHop;
+        Lfloat hs = (Lfloat)pv->hopSize;
+        Lfloat binFreq = TWO_PI / (Lfloat)n;
+        int numPeaks = 0;
+        
+        if (pv->phaseLocking)
+        {
+            for (int k = 2; k < numBins - 2; k++)
+            {
+                Lfloat m = mag[k];
+                if (m > mag[k-1] && m > mag[k-2] && m >= mag[k+1] && m >= mag[k+2])
+                    pv->peaks[numPeaks++] = k;
+            }
+        }
+        
+        if (numPeaks == 0)
+        {
+            // every bin advances by its own instantaneous frequency
+            for (int k = 0; k < numBins; k++)
+            {
+                Lfloat omega = binFreq * (Lfloat)k;
+                Lfloat delta = wrapPhase(phase[k] - pv->lastPhase[k] - omega * ha);
+                synth[k] = wrapPhase(synth[k] + (omega + delta / ha) * hs);
+            }
+        }
+        else
+        {
+            // peaks advance by their instantaneous frequency, the rest of each
+            // peak's region keeps its analysis phase offset from the peak
+            int start = 0;
+            for (int p = 0; p < numPeaks; p++)
+            {
+                int peak = pv->peaks[p];
+                int end = numBins;
+                if (p + 1 < numPeaks)
+                {
+                    int next = pv->peaks[p + 1];
+                    end = peak + 1;
+                    for (int k = peak + 1; k < next; k++)
+                        if (mag[k] < mag[end]) end = k;
+                    end++;
+                }
+                
+                Lfloat omega = binFreq * (Lfloat)peak;
+                Lfloat delta = wrapPhase(phase[peak] - pv->lastPhase[peak] - omega * ha);
+                Lfloat peakPhase = wrapPhase(synth[peak] + (omega + delta / ha) * hs);
+                Lfloat rotation = peakPhase - phase[peak];
+                
+                for (int k = start; k < end; k++)
+                    synth[k] = wrapPhase(phase[k] + rotation);
+                
+                start = end;
+            }
+        }
+    }
+    
+    for (int k = 0; k < numBins; k++) pv->lastPhase[k] = phase[k];
+    
+    pv->frame[0] = mag[0] * cosf(synth[0]);
+    pv->frame[half] = mag[half] * cosf(synth[half]);
+    for (int k = 1; k < half; k++)
+    {
+        pv->frame[k] = mag[k] * cosf(synth[k]);
+        pv->frame[n - k] = -mag[k] * sinf(synth[k]);
+    }
+    
+    mayer_realifft(n, pv->frame);
+    
+    Lfloat* ola = pv->ola;
+    for (int i = 0; i < n; i++)
+        ola[i] += pv->frame[i] * pv->window[i] * pv->norm;
+    
+    // the first hop is complete, move it to the output ring
+    int hop = pv->hopSize;
+    for (int i = 0; i < hop; i++)
+        pv->output[(pv->outputWrite + i) & pv->outputMask] = ola[i];
+    pv->outputWrite += hop;
+    
+    memmove(ola, ola + hop, sizeof(Lfloat) * (n - hop));
+    memset(ola + n - hop, 0, sizeof(Lfloat) * hop);
+    
+    // drop the oldest samples rather than overrun the ring if the pitch jumps
+    if (pv->outputWrite - pv->outputRead > pv->outputMask - hop)
+        pv->outputRead = pv->outputWrite - (pv->outputMask - hop);
+}
+
+// live input has to be consumed at the rate it arrives, so only a source is stretched
+static inline void phaseVocoderAdvance(_tPhaseVocoder* const pv, Lfloat stretch)
+{
+    pv->analysisFrac += (Lfloat)pv->hopSize / (pv->pitch * stretch);
+    int step = (int)pv->analysisFrac;
+    pv->analysisFrac -= (Lfloat)step;
+    if (step < 1) step = 1;
+    pv->analysisPos += step;
+    pv->analysisHop = step;
+}
+
+// resamples the synthesized signal by the pitch ratio
+static inline Lfloat phaseVocoderRead(_tPhaseVocoder* const pv)
+{
+    uint32_t r = pv->outputRead;
+    uint32_t mask = pv->outputMask;
+    Lfloat out = LEAF_interpolate_hermite_x(pv->output[(r - 1) & mask],
+                                            pv->output[r & mask],
+                                            pv->output[(r + 1) & mask],
+                                            pv->output[(r + 2) & mask],
+                                            pv->outputFrac);
+    pv->outputFrac += pv->pitch;
+    int step = (int)pv->outputFrac;
+    pv->outputFrac -= (Lfloat)step;
+    pv->outputRead += step;
+    return out;
+}
+
+Lfloat tPhaseVocoder_tick (tPhaseVocoder* const pvr, Lfloat input)
+{
+    Lfloat out;
+    tPhaseVocoder_tickBlock(pvr, &input, &out, 1);
+    return out;
+}
+
+void tPhaseVocoder_tickBlock (tPhaseVocoder* const pvr, Lfloat* in, Lfloat* out, int size)
+{
+    _tPhaseVocoder* pv = *pvr;
+    uint32_t n = pv->frameSize;
+    
+    for (int i = 0; i < size; i++)
+    {
+        pv->input[pv->inputWrite & pv->inputMask] = in[i];
+        pv->inputWrite++;
+        
+        while (pv->inputWrite - pv->analysisPos >= n)
+        {
+            for (uint32_t j = 0; j < n; j++)
+                pv->frame[j] = pv->input[(pv->analysisPos + j) & pv->inputMask] * pv->window[j];
+            phaseVocoderProcessFrame(pv);
+            phaseVocoderAdvance(pv, 1.0f);
+        }
+        
+        // hold off until a hop of headroom is buffered, so the
+        // resampler never catches up with the next frame
+        uint32_t available = pv->outputWrite - pv->outputRead;
+        if (!pv->primed) pv->primed = available >= (uint32_t)pv->hopSize + 4;
+        if (!pv->primed || available < 3)
+        {
+            pv->primed = 0;
+            out[i] = 0.0f;
+            continue;
+        }
+        
+        out[i] = phaseVocoderRead(pv);
+    }
+}
+
+void tPhaseVocoder_stretchBlock (tPhaseVocoder* const pvr, Lfloat* source, int length, Lfloat* out, int size)
+{
+    _tPhaseVocoder* pv = *pvr;
+    uint32_t n = pv->frameSize;
+    
+    for (int i = 0; i < size; i++)
+    {
+        while (pv->outputWrite - pv->outputRead < 3)
+        {
+            for (uint32_t j = 0; j < n; j++)
+            {
+                uint32_t idx = pv->analysisPos + j;
+                pv->frame[j] = idx < (uint32_t)length ? source[idx] * pv->window[j] : 0.0f;
+            }
+            phaseVocoderProcessFrame(pv);
+            phaseVocoderAdvance(pv, pv->stretch);
+        }
+        
+        out[i] = phaseVocoderRead(pv);
+    }
+}
+
+void tPhaseVocoder_setPitch (tPhaseVocoder* const pvr, Lfloat ratio)
+{
+    _tPhaseVocoder* pv = *pvr;
+    pv->pitch = LEAF_clip(0.25f, ratio, 4.0f);
+}
+
+void tPhaseVocoder_setStretch (tPhaseVocoder* const pvr, Lfloat stretch)
+{
+    _tPhaseVocoder* pv = *pvr;
+    pv->stretch = LEAF_clip(0.1f, stretch, 10.0f);
+}
+
+void tPhaseVocoder_setPhaseLocking (tPhaseVocoder* const pvr, int lock)
+{
+    _tPhaseVocoder* pv = *pvr;
+    pv->phaseLocking = lock;
+}
+
+void tPhaseVocoder_setPosition (tPhaseVocoder* const pvr, Lfloat position)
+{
+    _tPhaseVocoder* pv = *pvr;
+    tPhaseVocoder_clear(pvr);
+    if (position < 0.0f) position = 0.0f;
+    pv->analysisPos = (uint32_t)position;
+    pv->analysisFrac = position - (Lfloat)pv->analysisPos;
+}
+
+Lfloat tPhaseVocoder_getPosition (tPhaseVocoder* const pvr)
+{
+    _tPhaseVocoder* pv = *pvr;
+    return (Lfloat)pv->analysisPos + pv->analysisFrac;
+}
+
+int tPhaseVocoder_getLatency (tPhaseVocoder* const pvr)
+{
+    _tPhaseVocoder* pv = *pvr;
+    return pv->frameSize + pv->hopSize - 1;
+}
+
+void tPhaseVocoder_clear (tPhaseVocoder* const pvr)
+{
+    _tPhaseVocoder* pv = *pvr;
+    
+    memset(pv->ola, 0, sizeof(Lfloat) * pv->frameSize);
+    memset(pv->input, 0, sizeof(Lfloat) * (pv->inputMask + 1));
+    memset(pv->output, 0, sizeof(Lfloat) * (pv->outputMask + 1));
+    memset(pv->synthPhase, 0, sizeof(Lfloat) * pv->numBins);
+    memset(pv->lastPhase, 0, sizeof(Lfloat) * pv->numBins);
+    
+    pv->inputWrite = 0;
+    pv->analysisPos = 0;
+    pv->analysisFrac = 0.0f;
+    pv->analysisHop = pv->hopSize;
+    pv->outputWrite = 0;
+    pv->outputRead = 0;
+    pv->outputFrac = 0.0f;
+    pv->primed = 0;
+    pv->firstFrame = 1;
+}
+
 //============================================================================================================
 // SIMPLERETUNE
 //============================================================================================================
@@ -1496,6 +1854,7 @@ void tSimpleRetune_initToPool (tSimpleRetune* const rt, int numVoices, Lfloat mi
     _tMempool* m = *mp;
     _tSimpleRetune* r = *rt = (_tSimpleRetune*) mpool_calloc(sizeof(_tSimpleRetune), m);
     r->mempool = *mp;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tSimpleRetune_setSampleRate, NULL);
     
     r->bufSize = bufSize;
     r->numVoices = numVoices;
@@ -1535,6 +1894,7 @@ void tSimpleRetune_free (tSimpleRetune* const rt)
     mpool_free((char*)r->outBuffer, r->mempool);
     mpool_free((char*)r->inBuffer, r->mempool);
     mpool_free((char*)r->pdBuffer, r->mempool);
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
@@ -1640,6 +2000,7 @@ void tRetune_initToPool (tRetune* const rt, int numVoices, Lfloat minInputFreq,
     _tMempool* m = *mp;
     _tRetune* r = *rt = (_tRetune*) mpool_calloc(sizeof(_tRetune), m);
     r->mempool = *mp;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tRetune_setSampleRate, NULL);
     
     r->bufSize = bufSize;
     r->numVoices = numVoices;
@@ -1683,6 +2044,7 @@ void tRetune_free (tRetune* const rt)
     mpool_free((char*)r->inBuffer, r->mempool);
     mpool_free((char*)r->outBuffers, r->mempool);
     mpool_free((char*)r->output, r->mempool);
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
@@ -1789,6 +2151,7 @@ void tFormantShifter_initToPool (tFormantShifter* const fsr, int order, tMempool
     _tMempool* m = *mp;
     _tFormantShifter* fs = *fsr = (_tFormantShifter*) mpool_alloc(sizeof(_tFormantShifter), m);
     fs->mempool = m;
+    LEAF_registerObject(fs->mempool, &fs->node, fs, (LEAFSampleRateFunc) tFormantShifter_setSampleRate, NULL);
     
     LEAF* leaf = fs->mempool->leaf;
     
@@ -1840,6 +2203,7 @@ void tFormantShifter_free (tFormantShifter* const fsr)
     tHighpass_free(&fs->hp2);
     tFeedbackLeveler_free(&fs->fbl1);
     tFeedbackLeveler_free(&fs->fbl2);
+    LEAF_unregisterObject(fs->mempool, &fs->node);
     mpool_free((char*)fs, fs->mempool);
 }
 
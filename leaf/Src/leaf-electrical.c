@@ -173,7 +173,9 @@ void tWDF_init(tWDF* const wdf, WDFComponentType type, Lfloat value, tWDF* const
 void    tWDF_initToPool(tWDF* const wdf, WDFComponentType type, Lfloat value, tWDF* const rL, tWDF* const rR, tMempool* const mp)
 {
     _tMempool* m = *mp;
-    *wdf = (_tWDF*) mpool_alloc(sizeof(_tWDF), m);
+    _tWDF* r = *wdf = (_tWDF*) mpool_alloc(sizeof(_tWDF), m);
+    r->mempool = m;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tWDF_setSampleRate, NULL);
     
     wdf_init(wdf, type, value, rL, rR);
 }
@@ -182,6 +184,7 @@ void    tWDF_free (tWDF* const wdf)
 {
     _tWDF* r = *wdf;
     
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
@@ -36,9 +36,9 @@ void    tEnvelope_initToPool    (tEnvelope* const envlp, Lfloat attack, Lfloat d
     _tEnvelope* env = *envlp = (_tEnvelope*) mpool_alloc(sizeof(_tEnvelope), m);
     env->mempool = m;
     
-    env->exp_buff = __leaf_table_exp_decay;
-    env->inc_buff = __leaf_table_attack_decay_inc;
-    env->buff_size = sizeof(__leaf_table_exp_decay);
+    env->exp_buff = LEAF_getExpDecayTable(m->leaf);
+    env->inc_buff = LEAF_getAttackDecayIncTable(m->leaf);
+    env->buff_size = sizeof(Lfloat) * EXP_DECAY_TABLE_SIZE;
     
     env->loop = loop;
     
@@ -225,10 +225,11 @@ void    tADSR_initToPool    (tADSR* const adsrenv, Lfloat attack, Lfloat decay,
     _tMempool* m = *mp;
     _tADSR* adsr = *adsrenv = (_tADSR*) mpool_alloc(sizeof(_tADSR), m);
     adsr->mempool = m;
+    LEAF_registerObject(adsr->mempool, &adsr->node, adsr, (LEAFSampleRateFunc) tADSR_setSampleRate, NULL);
 
-    adsr->exp_buff = __leaf_table_exp_decay;
-    adsr->inc_buff = __leaf_table_attack_decay_inc;
-    adsr->buff_size = sizeof(__leaf_table_exp_decay);
+    adsr->exp_buff = LEAF_getExpDecayTable(m->leaf);
+    adsr->inc_buff = LEAF_getAttackDecayIncTable(m->leaf);
+    adsr->buff_size = sizeof(Lfloat) * EXP_DECAY_TABLE_SIZE;
 
     if (attack > 8192.0f)
         attack = 8192.0f;
@@ -290,6 +291,7 @@ void    tADSR_initToPool    (tADSR* const adsrenv, Lfloat attack, Lfloat decay,
 void    tADSR_free (tADSR* const adsrenv)
 {
     _tADSR* adsr = *adsrenv;
+    LEAF_unregisterObject(adsr->mempool, &adsr->node);
     mpool_free((char*)adsr, adsr->mempool);
 }
 
@@ -505,6 +507,95 @@ void tADSR_setSampleRate(tADSR* const adsrenv, Lfloat sr)
     tADSR_setLeakFactor(adsrenv, adsr->baseLeakFactor);
 }
 
+// Runs each stage as a tight loop and only falls back to tADSR_tick() on the
+// sample where a stage ends, so the transitions are exactly those of tick.
+void tADSR_tickBlock(tADSR* const adsrenv, Lfloat* out, int size)
+{
+    _tADSR* adsr = *adsrenv;
+    const Lfloat* exp_buff = adsr->exp_buff;
+    int i = 0;
+
+    while (i < size)
+    {
+        // A retrigger during the attack leaves both the ramp and the attack
+        // running for a while, so let tick() sort out overlapping stages.
+        if ((adsr->inRamp + adsr->inAttack + adsr->inDecay + adsr->inSustain + adsr->inRelease) > 1)
+        {
+            out[i++] = tADSR_tick(adsrenv);
+            continue;
+        }
+
+        if (adsr->inRamp)
+        {
+            Lfloat phase = adsr->rampPhase;
+            for (; (i < size) && (phase <= UINT16_MAX); i++)
+            {
+                out[i] = adsr->rampPeak * exp_buff[(uint32_t)phase];
+                phase += adsr->rampInc;
+            }
+            adsr->rampPhase = phase;
+        }
+        else if (adsr->inAttack)
+        {
+            Lfloat phase = adsr->attackPhase;
+            for (; (i < size) && (phase <= UINT16_MAX); i++)
+            {
+                out[i] = adsr->gain * exp_buff[UINT16_MAX - (uint32_t)phase];
+                phase += adsr->attackInc;
+            }
+            adsr->attackPhase = phase;
+        }
+        else if (adsr->inDecay)
+        {
+            Lfloat phase = adsr->decayPhase;
+            Lfloat range = 1.0f - adsr->sustain;
+            for (; (i < size) && (phase < UINT16_MAX); i++)
+            {
+                out[i] = (adsr->gain * (adsr->sustain + (exp_buff[(uint32_t)phase] * range))) * adsr->leakFactor;
+                phase += adsr->decayInc;
+            }
+            adsr->decayPhase = phase;
+        }
+        else if (adsr->inRelease)
+        {
+            Lfloat phase = adsr->releasePhase;
+            for (; (i < size) && (phase < UINT16_MAX); i++)
+            {
+                out[i] = adsr->releasePeak * exp_buff[(uint32_t)phase];
+                phase += adsr->releaseInc;
+            }
+            adsr->releasePhase = phase;
+        }
+        else if (adsr->inSustain)
+        {
+            Lfloat next = adsr->next;
+            for (; i < size; i++)
+            {
+                next *= adsr->leakFactor;
+                out[i] = next;
+            }
+            adsr->next = next;
+            return;
+        }
+        else
+        {
+            for (; i < size; i++) out[i] = adsr->next;
+            return;
+        }
+
+        if (i > 0) adsr->next = out[i-1];
+
+        // Stage boundary
+        if (i < size) out[i++] = tADSR_tick(adsrenv);
+    }
+}
+
+int tADSR_isIdle(tADSR* const adsrenv)
+{
+    _tADSR* adsr = *adsrenv;
+    return !(adsr->inRamp || adsr->inAttack || adsr->inDecay || adsr->inSustain || adsr->inRelease);
+}
+
 #endif // LEAF_INCLUDE_ADSR_TABLES
 
 
@@ -527,6 +618,7 @@ void    tADSRS_initToPool    (tADSRS* const adsrenv, Lfloat attack, Lfloat decay
     _tMempool* m = *mp;
     _tADSRS* adsr = *adsrenv = (_tADSRS*) mpool_alloc(sizeof(_tADSRS), m);
     adsr->mempool = m;
+    LEAF_registerObject(adsr->mempool, &adsr->node, adsr, (LEAFSampleRateFunc) tADSRS_setSampleRate, NULL);
     
     LEAF* leaf = adsr->mempool->leaf;
     
@@ -568,6 +660,7 @@ void    tADSRS_initToPool    (tADSRS* const adsrenv, Lfloat attack, Lfloat decay
 void    tADSRS_free  (tADSRS* const adsrenv)
 {
     _tADSRS* adsr = *adsrenv;
+    LEAF_unregisterObject(adsr->mempool, &adsr->node);
     mpool_free((char*)adsr, adsr->mempool);
 }
 
@@ -686,6 +779,270 @@ void tADSRS_setSampleRate(tADSRS* const adsrenv, Lfloat sr)
     tADSRS_setLeakFactor(adsrenv, adsr->baseLeakFactor);
 }
 
+// The stages are one-pole recurrences, so each is run as its own loop until
+// the next value would cross the stage threshold; tADSRS_tick() then handles
+// the crossing sample. The gain smoother is folded into the same loops.
+void tADSRS_tickBlock(tADSRS* const adsrenv, Lfloat* out, int size)
+{
+    _tADSRS* adsr = *adsrenv;
+    Lfloat target = adsr->factor * adsr->targetGainSquared;
+    int i = 0;
+
+    while (i < size)
+    {
+        Lfloat y = adsr->output;
+        Lfloat g = adsr->gain;
+
+        switch (adsr->state)
+        {
+            case env_idle:
+                // Output stays at zero, only the gain smoother moves on
+                adsr->gain = adsr->targetGainSquared + (g - adsr->targetGainSquared) * powf(adsr->oneMinusFactor, (Lfloat)(size - i));
+                for (; i < size; i++) out[i] = 0.0f;
+                return;
+            case env_attack:
+                for (; i < size; i++)
+                {
+                    Lfloat n = adsr->attackBase + y * adsr->attackCoef;
+                    if (n >= 1.0f) break;
+                    y = n;
+                    g = target + adsr->oneMinusFactor * g;
+                    out[i] = y * g;
+                }
+                break;
+            case env_decay:
+                for (; i < size; i++)
+                {
+                    Lfloat n = adsr->decayBase + y * adsr->decayCoef * adsr->leakFactor;
+                    if (n <= adsr->sustainLevel) break;
+                    y = n;
+                    g = target + adsr->oneMinusFactor * g;
+                    out[i] = y * g;
+                }
+                break;
+            case env_sustain:
+                for (; i < size; i++)
+                {
+                    y = y * adsr->leakFactor;
+                    g = target + adsr->oneMinusFactor * g;
+                    out[i] = y * g;
+                }
+                break;
+            case env_release:
+                for (; i < size; i++)
+                {
+                    Lfloat n = adsr->releaseBase + y * adsr->releaseCoef;
+                    if (n <= 0.0f) break;
+                    y = n;
+                    g = target + adsr->oneMinusFactor * g;
+                    out[i] = y * g;
+                }
+                break;
+            default:
+                break;
+        }
+
+        adsr->output = y;
+        adsr->gain = g;
+
+        // Stage boundary
+        if (i < size) out[i++] = tADSRS_tick(adsrenv);
+    }
+}
+
+int tADSRS_isIdle(tADSRS* const adsrenv)
+{
+    _tADSRS* adsr = *adsrenv;
+    return adsr->state == env_idle;
+}
+
+#ifdef SIMD_64
+/* tPolyADSRS: tADSRS with one voice per lane. Every stage's recurrence is
+ * computed for all lanes and the right one picked per lane; the scalar stage
+ * bookkeeping only runs on ticks where some voice crosses into a new stage. */
+void    tPolyADSRS_init(tPolyADSRS* const adsrenv, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf)
+{
+    tPolyADSRS_initToPool(adsrenv, attack, decay, sustain, release, &leaf->mempool);
+}
+
+void    tPolyADSRS_initToPool    (tPolyADSRS* const adsrenv, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tPolyADSRS* adsr = *adsrenv = (_tPolyADSRS*) mpool_calloc(sizeof(_tPolyADSRS), m);
+    adsr->mempool = m;
+    LEAF_registerObject(adsr->mempool, &adsr->node, adsr, (LEAFSampleRateFunc) tPolyADSRS_setSampleRate, NULL);
+    
+    LEAF* leaf = adsr->mempool->leaf;
+    
+    adsr->sampleRate = leaf->sampleRate;
+    adsr->sampleRateInMs = adsr->sampleRate * 0.001f;
+    adsr->invSampleRate = leaf->invSampleRate;
+    adsr->targetRatioA = 0.3f;
+    adsr->targetRatioDR = 0.0001f;
+    adsr->factor = 0.01f;
+    adsr->oneMinusFactor = 0.99f;
+    adsr->baseLeakFactor = 1.0f;
+    adsr->leakFactor = 1.0f;
+    
+    adsr->sustainLevel = sustain;
+    tPolyADSRS_setAttack(adsrenv, attack);
+    tPolyADSRS_setDecay(adsrenv, decay);
+    tPolyADSRS_setRelease(adsrenv, release);
+    
+    for (int i = 0; i < POLY_FLOAT_LANES; i++)
+    {
+        adsr->state[i] = env_idle;
+        adsr->gain[i] = 1.0f;
+        adsr->targetGainSquared[i] = 1.0f;
+    }
+}
+
+void    tPolyADSRS_free  (tPolyADSRS* const adsrenv)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    LEAF_unregisterObject(adsr->mempool, &adsr->node);
+    mpool_free((char*)adsr, adsr->mempool);
+}
+
+poly_float tPolyADSRS_tick(tPolyADSRS* const adsrenv)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    poly_float y = poly_load(adsr->output);
+    poly_float state = poly_load(adsr->state);
+    poly_mask inAttack = poly_eq(state, poly_set1(env_attack));
+    poly_mask inDecay = poly_eq(state, poly_set1(env_decay));
+    poly_mask inSustain = poly_eq(state, poly_set1(env_sustain));
+    poly_mask inRelease = poly_eq(state, poly_set1(env_release));
+    
+    poly_float attack = poly_add(poly_set1(adsr->attackBase), poly_mul(y, poly_set1(adsr->attackCoef)));
+    poly_float decay = poly_add(poly_set1(adsr->decayBase), poly_mul(poly_mul(y, poly_set1(adsr->decayCoef)), poly_set1(adsr->leakFactor)));
+    poly_float sustain = poly_mul(y, poly_set1(adsr->leakFactor));
+    poly_float release = poly_add(poly_set1(adsr->releaseBase), poly_mul(y, poly_set1(adsr->releaseCoef)));
+    
+    y = poly_select(inRelease, release, y);
+    y = poly_select(inSustain, sustain, y);
+    y = poly_select(inDecay, decay, y);
+    y = poly_select(inAttack, attack, y);
+    
+    poly_mask ended = poly_and(inAttack, poly_ge(y, poly_set1(1.0f)));
+    ended = poly_or(ended, poly_and(inDecay, poly_le(y, poly_set1(adsr->sustainLevel))));
+    ended = poly_or(ended, poly_and(inRelease, poly_le(y, poly_set1(0.0f))));
+    
+    if (poly_any(ended))
+    {
+        Lfloat out[POLY_FLOAT_LANES];
+        poly_store(out, y);
+        for (int i = 0; i < POLY_FLOAT_LANES; i++)
+        {
+            if (adsr->state[i] == env_attack && out[i] >= 1.0f)
+            {
+                out[i] = 1.0f;
+                adsr->state[i] = env_decay;
+            }
+            else if (adsr->state[i] == env_decay && out[i] <= adsr->sustainLevel)
+            {
+                out[i] = adsr->sustainLevel;
+                adsr->state[i] = env_sustain;
+            }
+            else if (adsr->state[i] == env_release && out[i] <= 0.0f)
+            {
+                out[i] = 0.0f;
+                adsr->state[i] = env_idle;
+            }
+        }
+        y = poly_load(out);
+    }
+    poly_store(adsr->output, y);
+    
+    poly_float gain = poly_add(poly_mul(poly_set1(adsr->factor), poly_load(adsr->targetGainSquared)),
+                               poly_mul(poly_set1(adsr->oneMinusFactor), poly_load(adsr->gain)));
+    poly_store(adsr->gain, gain);
+    
+    return poly_mul(y, gain);
+}
+
+void     tPolyADSRS_setAttack(tPolyADSRS* const adsrenv, Lfloat attack)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    adsr->attack = attack;
+    adsr->attackCoef = calcADSR3Coef(attack * adsr->sampleRateInMs, adsr->targetRatioA);
+    adsr->attackBase = (1.0f + adsr->targetRatioA) * (1.0f - adsr->attackCoef);
+}
+
+void     tPolyADSRS_setDecay(tPolyADSRS* const adsrenv, Lfloat decay)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    adsr->decay = decay;
+    adsr->decayCoef = calcADSR3Coef(decay * adsr->sampleRateInMs, adsr->targetRatioDR);
+    adsr->decayBase = (adsr->sustainLevel - adsr->targetRatioDR) * (1.0f - adsr->decayCoef);
+}
+
+void     tPolyADSRS_setSustain(tPolyADSRS* const adsrenv, Lfloat sustain)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    adsr->sustainLevel = sustain;
+    adsr->decayBase = (adsr->sustainLevel - adsr->targetRatioDR) * (1.0f - adsr->decayCoef);
+}
+
+void     tPolyADSRS_setRelease(tPolyADSRS* const adsrenv, Lfloat release)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    adsr->release = release;
+    adsr->releaseCoef = calcADSR3Coef(release * adsr->sampleRateInMs, adsr->targetRatioDR);
+    adsr->releaseBase = -adsr->targetRatioDR * (1.0f - adsr->releaseCoef);
+}
+
+// 0.999999 is slow leak, 0.9 is fast leak
+void     tPolyADSRS_setLeakFactor(tPolyADSRS* const adsrenv, Lfloat leakFactor)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    adsr->baseLeakFactor = leakFactor;
+    adsr->leakFactor = powf(leakFactor, 44100.0f * adsr->invSampleRate);
+}
+
+void tPolyADSRS_on(tPolyADSRS* const adsrenv, int voice, Lfloat velocity)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    adsr->state[voice] = env_attack;
+    adsr->targetGainSquared[voice] = velocity * velocity;
+}
+
+void tPolyADSRS_off(tPolyADSRS* const adsrenv, int voice)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    if (adsr->state[voice] != env_idle)
+    {
+        adsr->state[voice] = env_release;
+    }
+}
+
+int tPolyADSRS_isIdle(tPolyADSRS* const adsrenv, int voice)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    return adsr->state[voice] == env_idle;
+}
+
+void tPolyADSRS_setSampleRate(tPolyADSRS* const adsrenv, Lfloat sr)
+{
+    _tPolyADSRS* adsr = *adsrenv;
+    
+    adsr->sampleRate = sr;
+    adsr->sampleRateInMs = adsr->sampleRate * 0.001f;
+    adsr->invSampleRate = 1.0f/sr;
+    
+    tPolyADSRS_setAttack(adsrenv, adsr->attack);
+    tPolyADSRS_setDecay(adsrenv, adsr->decay);
+    tPolyADSRS_setRelease(adsrenv, adsr->release);
+    tPolyADSRS_setLeakFactor(adsrenv, adsr->baseLeakFactor);
+}
+#endif // SIMD_64
+
 //================================================================================
 
 /* ADSR 4 */ // new version of our original table-based ADSR but with the table passed in by the user
@@ -1112,6 +1469,105 @@ void    tADSRT_setSampleRate(tADSRT* const adsrenv, Lfloat sr)
     adsr->leakFactor = powf(adsr->baseLeakFactor, 44100.0f * adsr->invSampleRate);
 }
 
+static inline Lfloat tADSRT_lookup(_tADSRT* const adsr, Lfloat phase)
+{
+    uint32_t intPart = (uint32_t)phase;
+    Lfloat LfloatPart = phase - intPart;
+    Lfloat secondValue = (phase + 1.0f > adsr->buff_sizeMinusOne) ? 0.0f : adsr->exp_buff[intPart + 1];
+    return LEAF_interpolation_linear(adsr->exp_buff[intPart], secondValue, LfloatPart);
+}
+
+// Runs each stage as a tight loop and only falls back to tADSRT_tick() on the
+// sample where a stage ends. Sustain is constant and idle is silent, so those
+// are filled without touching the table.
+#ifdef ITCMRAM
+    void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT_tickBlock(tADSRT* const adsrenv, Lfloat* out, int size)
+#else
+void    tADSRT_tickBlock(tADSRT* const adsrenv, Lfloat* out, int size)
+#endif
+{
+    _tADSRT* adsr = *adsrenv;
+    const Lfloat end = adsr->buff_sizeMinusOne;
+    int i = 0;
+
+    while (i < size)
+    {
+        switch (adsr->whichStage)
+        {
+            case env_ramp:
+            {
+                Lfloat phase = adsr->rampPhase;
+                for (; (i < size) && (phase <= end); i++)
+                {
+                    out[i] = adsr->rampPeak * tADSRT_lookup(adsr, phase);
+                    phase += adsr->rampInc;
+                }
+                adsr->rampPhase = phase;
+                break;
+            }
+            case env_attack:
+            {
+                Lfloat phase = adsr->attackPhase;
+                for (; (i < size) && (phase <= end); i++)
+                {
+                    out[i] = adsr->gain * (1.0f - tADSRT_lookup(adsr, phase));
+                    phase += adsr->attackInc;
+                }
+                adsr->attackPhase = phase;
+                break;
+            }
+            case env_decay:
+            {
+                Lfloat phase = adsr->decayPhase;
+                Lfloat range = 1.0f - adsr->sustain;
+                for (; (i < size) && (phase <= end); i++)
+                {
+                    out[i] = (adsr->gain * (adsr->sustain + (tADSRT_lookup(adsr, phase) * range))) * adsr->leakFactor;
+                    phase += adsr->decayInc;
+                }
+                adsr->decayPhase = phase;
+                break;
+            }
+            case env_sustain:
+            {
+                Lfloat next = adsr->sustain * adsr->gain * (adsr->leakFactor * adsr->sustainWithLeak);
+                for (; i < size; i++) out[i] = next;
+                adsr->next = next;
+                return;
+            }
+            case env_release:
+            {
+                Lfloat phase = adsr->releasePhase;
+                for (; (i < size) && (phase <= end); i++)
+                {
+                    out[i] = adsr->releasePeak * tADSRT_lookup(adsr, phase);
+                    phase += adsr->releaseInc;
+                }
+                adsr->releasePhase = phase;
+                break;
+            }
+            default:
+                for (; i < size; i++) out[i] = adsr->next;
+                return;
+        }
+
+        if (i > 0) adsr->next = out[i-1];
+
+        // Stage boundary
+        if (i < size) out[i++] = tADSRT_tick(adsrenv);
+    }
+}
+
+#ifdef ITCMRAM
+    int __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT_isIdle(tADSRT* const adsrenv)
+#else
+int     tADSRT_isIdle(tADSRT* const adsrenv)
+#endif
+{
+    _tADSRT* adsr = *adsrenv;
+    return adsr->whichStage == env_idle;
+}
+
 /////-----------------
 /* Ramp */
 void    tRamp_init(tRamp* const r, Lfloat time, int samples_per_tick, LEAF* const leaf)
@@ -1124,6 +1580,7 @@ void    tRamp_initToPool    (tRamp* const r, Lfloat time, int samples_per_tick,
     _tMempool* m = *mp;
     _tRamp* ramp = *r = (_tRamp*) mpool_alloc(sizeof(_tRamp), m);
     ramp->mempool = m;
+    LEAF_registerObject(ramp->mempool, &ramp->node, ramp, (LEAFSampleRateFunc) tRamp_setSampleRate, NULL);
     
     LEAF* leaf = ramp->mempool->leaf;
     
@@ -1149,6 +1606,7 @@ void    tRamp_initToPool    (tRamp* const r, Lfloat time, int samples_per_tick,
 void    tRamp_free (tRamp* const r)
 {
     _tRamp* ramp = *r;
+    LEAF_unregisterObject(ramp->mempool, &ramp->node);
     mpool_free((char*)ramp, ramp->mempool);
 }
 
@@ -1368,6 +1826,7 @@ void    tExpSmooth_initToPool   (tExpSmooth* const expsmooth, Lfloat val, Lfloat
     _tMempool* m = *mp;
     _tExpSmooth* smooth = *expsmooth = (_tExpSmooth*) mpool_alloc(sizeof(_tExpSmooth), m);
     smooth->mempool = m;
+    LEAF_registerObject(smooth->mempool, &smooth->node, smooth, (LEAFSampleRateFunc) tExpSmooth_setSampleRate, NULL);
     
     smooth->curr = val;
     smooth->dest = val;
@@ -1382,6 +1841,7 @@ void    tExpSmooth_initToPool   (tExpSmooth* const expsmooth, Lfloat val, Lfloat
 void    tExpSmooth_free (tExpSmooth* const expsmooth)
 {
     _tExpSmooth* smooth = *expsmooth;
+    LEAF_unregisterObject(smooth->mempool, &smooth->node);
     mpool_free((char*)smooth, smooth->mempool);
 }
 
@@ -1514,7 +1974,7 @@ Lfloat tSlide_tickNoInput(tSlide* const sl)
     {
         s->currentOut = s->prevOut + ((in - s->prevOut) * s->invDownSlide);
     }
-#ifdef NO_DENORMAL_CHECK
+#if LEAF_NO_DENORMAL_CHECK
 #else
     if (s->currentOut < VSF) s->currentOut = 0.0f;
 #endif
@@ -1536,7 +1996,7 @@ Lfloat tSlide_tick(tSlide* const sl, Lfloat in)
     {
         s->currentOut = s->prevOut + ((in - s->prevOut) * s->invDownSlide);
     }
-#ifdef NO_DENORMAL_CHECK
+#if LEAF_NO_DENORMAL_CHECK
 #else
     if (s->currentOut < VSF) s->currentOut = 0.0f;
 #endif
@@ -10,6 +10,7 @@
 
 #include "..\Inc\leaf-filters.h"
 #include "..\Inc\leaf-tables.h"
+#include "..\Inc\leaf-kernels.h"
 #include "..\leaf.h"
 
 #else
@@ -17,6 +18,7 @@
 #include "../Inc/leaf-filters.h"
 #include "../Inc/leaf-tables.h"
 #include "../Inc/leaf-math.h"
+#include "../Inc/leaf-kernels.h"
 #include "../leaf.h"
 #endif
 
@@ -177,6 +179,7 @@ void    tThiranAllpassSOCascade_initToPool     (tThiranAllpassSOCascade* const f
     _tMempool* m = *mp;
     _tThiranAllpassSOCascade* f = *ft = (_tThiranAllpassSOCascade*) mpool_alloc(sizeof(_tThiranAllpassSOCascade), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, NULL, (LEAFClearFunc) tThiranAllpassSOCascade_clear);
     f->numFilts = numFilts;
     f->filters = (tAllpassSO*) mpool_calloc(sizeof(tAllpassSO) * numFilts, m);
     f->k1[0] = -0.00050469f;
@@ -207,6 +210,7 @@ void    tThiranAllpassSOCascade_free  (tThiranAllpassSOCascade* const ft)
         tAllpassSO_free(&f->filters[i]);
     }
     mpool_free((char*)f->filters, f->mempool); //do I need to free the pointers separately?
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -318,6 +322,7 @@ void    tOnePole_initToPool     (tOnePole* const ft, Lfloat freq, tMempool* cons
     _tOnePole* f = *ft = (_tOnePole*) mpool_alloc(sizeof(_tOnePole), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tOnePole_setSampleRate, (LEAFClearFunc) tOnePole_clear);
     
     f->gain = 1.0f;
     f->a0 = 1.0;
@@ -334,6 +339,7 @@ void    tOnePole_free   (tOnePole* const ft)
 {
     _tOnePole* f = *ft;
     
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -409,6 +415,13 @@ void tOnePole_setSampleRate(tOnePole* const ft, Lfloat sr)
     f->a1 = 1.0f - f->b0;
 }
 
+void tOnePole_clear(tOnePole* const ft)
+{
+    _tOnePole* f = *ft;
+    f->lastIn = 0.0f;
+    f->lastOut = 0.0f;
+}
+
 
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ CookOnePole Filter ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
 void    tCookOnePole_init(tCookOnePole* const ft, LEAF* const leaf)
@@ -422,6 +435,7 @@ void    tCookOnePole_initToPool     (tCookOnePole* const ft, tMempool* const mp)
     _tCookOnePole* f = *ft = (_tCookOnePole*) mpool_alloc(sizeof(_tCookOnePole), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tCookOnePole_setSampleRate, NULL);
     
     f->poleCoeff     = 0.9f;
     f->sgain         = 0.1f;
@@ -434,6 +448,7 @@ void    tCookOnePole_free   (tCookOnePole* const ft)
 {
     _tCookOnePole* f = *ft;
     
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -495,6 +510,7 @@ void    tTwoPole_initToPool     (tTwoPole* const ft, tMempool* const mp)
     _tTwoPole* f = *ft = (_tTwoPole*) mpool_alloc(sizeof(_tTwoPole), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tTwoPole_setSampleRate, NULL);
     
     f->gain = 1.0f;
     f->a0 = 1.0;
@@ -510,6 +526,7 @@ void    tTwoPole_initToPool     (tTwoPole* const ft, tMempool* const mp)
 void    tTwoPole_free  (tTwoPole* const ft)
 {
     _tTwoPole* f = *ft;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -615,6 +632,7 @@ void    tOneZero_initToPool     (tOneZero* const ft, Lfloat theZero, tMempool* c
     _tMempool* m = *mp;
     _tOneZero* f = *ft = (_tOneZero*) mpool_alloc(sizeof(_tOneZero), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tOneZero_setSampleRate, NULL);
     LEAF* leaf  = f->mempool->leaf;
     
     f->gain = 1.0f;
@@ -627,6 +645,7 @@ void    tOneZero_initToPool     (tOneZero* const ft, Lfloat theZero, tMempool* c
 void    tOneZero_free   (tOneZero* const ft)
 {
     _tOneZero* f = *ft;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -727,6 +746,7 @@ void    tTwoZero_initToPool     (tTwoZero* const ft, tMempool* const mp)
     _tTwoZero* f = *ft = (_tTwoZero*) mpool_alloc(sizeof(_tTwoZero), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tTwoZero_setSampleRate, NULL);
     
     f->twoPiTimesInvSampleRate = leaf->twoPiTimesInvSampleRate;
     f->gain = 1.0f;
@@ -737,6 +757,7 @@ void    tTwoZero_initToPool     (tTwoZero* const ft, tMempool* const mp)
 void    tTwoZero_free   (tTwoZero* const ft)
 {
     _tTwoZero* f = *ft;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -936,6 +957,7 @@ void    tBiQuad_initToPool     (tBiQuad* const ft, tMempool* const mp)
     _tBiQuad* f = *ft = (_tBiQuad*) mpool_alloc(sizeof(_tBiQuad), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tBiQuad_setSampleRate, NULL);
     
     f->gain = 1.0f;
     
@@ -953,6 +975,7 @@ void    tBiQuad_initToPool     (tBiQuad* const ft, tMempool* const mp)
 void    tBiQuad_free   (tBiQuad* const ft)
 {
     _tBiQuad* f = *ft;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -1102,6 +1125,7 @@ void    tSVF_initToPool     (tSVF* const svff, SVFType type, Lfloat freq, Lfloat
     _tMempool* m = *mp;
     _tSVF* svf = *svff = (_tSVF*) mpool_alloc(sizeof(_tSVF), m);
     svf->mempool = m;
+    LEAF_registerObject(svf->mempool, &svf->node, svf, (LEAFSampleRateFunc) tSVF_setSampleRate, (LEAFClearFunc) tSVF_clear);
     
     LEAF* leaf = svf->mempool->leaf;
     
@@ -1163,19 +1187,13 @@ void    tSVF_initToPool     (tSVF* const svff, SVFType type, Lfloat freq, Lfloat
         svf->cBK = -1.0f;
         svf->cL = -2.0f;
     }
-    if (leaf->sampleRate > 90000)
-    {
-        svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        svf->table = __filterTanhTable_48000;
-    }
+    svf->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 90000);
 }
 
 void    tSVF_free   (tSVF* const svff)
 {
     _tSVF* svf = *svff;
+    LEAF_unregisterObject(svf->mempool, &svf->node);
     mpool_free((char*)svf, svf->mempool);
 }
 
@@ -1359,14 +1377,14 @@ void    tSVF_setSampleRate  (tSVF* const svff, Lfloat sr)
     svf->sampleRate = sr;
     svf->invSampleRate = 1.0f/svf->sampleRate;
     svf->sampleRatio = 48000.0f /svf->sampleRate;
-    if (sr > 80000)
-    {
-        svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        svf->table = __filterTanhTable_48000;
-    }
+    svf->table = LEAF_getFilterTanTable(svf->mempool->leaf, sr, 80000);
+}
+
+void    tSVF_clear  (tSVF* const svff)
+{
+    _tSVF* svf = *svff;
+    svf->ic1eq = 0.0f;
+    svf->ic2eq = 0.0f;
 }
 
 //only works for lowpass right now
@@ -1384,6 +1402,145 @@ Lfloat    tSVF_getPhaseAtFrequency  (tSVF* const svff, Lfloat freq)
 }
 
 
+#ifdef SIMD_64
+/* tPolySVF: the tSVF structure with one voice per lane. Coefficients are
+ * computed per voice when its cutoff or Q changes; the tick is all vector. */
+static void tPolySVF_updateVoice(_tPolySVF* const svf, int voice)
+{
+    Lfloat g = tanf(PI * svf->cutoff[voice] * svf->invSampleRate);
+    svf->k[voice] = 1.0f/svf->Q[voice];
+    svf->a1[voice] = 1.0f/(1.0f + g * (g + svf->k[voice]));
+    svf->a2[voice] = g * svf->a1[voice];
+    svf->a3[voice] = g * svf->a2[voice];
+}
+
+void tPolySVF_init(tPolySVF* const svff, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+{
+    tPolySVF_initToPool     (svff, type, freq, Q, &leaf->mempool);
+}
+
+void    tPolySVF_initToPool     (tPolySVF* const svff, SVFType type, Lfloat freq, Lfloat Q, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tPolySVF* svf = *svff = (_tPolySVF*) mpool_calloc(sizeof(_tPolySVF), m);
+    svf->mempool = m;
+    LEAF_registerObject(svf->mempool, &svf->node, svf, (LEAFSampleRateFunc) tPolySVF_setSampleRate, NULL);
+    
+    LEAF* leaf = svf->mempool->leaf;
+    
+    svf->sampleRate = leaf->sampleRate;
+    svf->invSampleRate = leaf->invSampleRate;
+    
+    for (int i = 0; i < POLY_FLOAT_LANES; i++)
+    {
+        svf->cutoff[i] = LEAF_clip(0.0f, freq, svf->sampleRate * 0.5f);
+        svf->Q[i] = Q;
+        tPolySVF_updateVoice(svf, i);
+    }
+    tPolySVF_setFilterType(svff, type);
+}
+
+void    tPolySVF_free   (tPolySVF* const svff)
+{
+    _tPolySVF* svf = *svff;
+    LEAF_unregisterObject(svf->mempool, &svf->node);
+    mpool_free((char*)svf, svf->mempool);
+}
+
+poly_float tPolySVF_tick(tPolySVF* const svff, poly_float v0)
+{
+    _tPolySVF* svf = *svff;
+    
+    poly_float ic1eq = poly_load(svf->ic1eq);
+    poly_float ic2eq = poly_load(svf->ic2eq);
+    poly_float a2 = poly_load(svf->a2);
+    
+    poly_float v1,v2,v3;
+    v3 = poly_sub(v0, ic2eq);
+    v1 = poly_add(poly_mul(poly_load(svf->a1), ic1eq), poly_mul(a2, v3));
+    v2 = poly_add(poly_add(ic2eq, poly_mul(a2, ic1eq)), poly_mul(poly_load(svf->a3), v3));
+    poly_store(svf->ic1eq, poly_sub(poly_add(v1, v1), ic1eq));
+    poly_store(svf->ic2eq, poly_sub(poly_add(v2, v2), ic2eq));
+    
+    poly_float out = poly_mul(v0, poly_set1(svf->cH));
+    out = poly_add(out, poly_mul(v1, poly_set1(svf->cB)));
+    out = poly_add(out, poly_mul(poly_mul(poly_load(svf->k), v1), poly_set1(svf->cBK)));
+    return poly_add(out, poly_mul(v2, poly_set1(svf->cL)));
+}
+
+void     tPolySVF_setFreq(tPolySVF* const svff, int voice, Lfloat freq)
+{
+    _tPolySVF* svf = *svff;
+    
+    svf->cutoff[voice] = LEAF_clip(0.0f, freq, svf->sampleRate * 0.5f);
+    tPolySVF_updateVoice(svf, voice);
+}
+
+void     tPolySVF_setQ(tPolySVF* const svff, int voice, Lfloat Q)
+{
+    _tPolySVF* svf = *svff;
+    
+    svf->Q[voice] = Q;
+    tPolySVF_updateVoice(svf, voice);
+}
+
+void    tPolySVF_setFreqAndQ(tPolySVF* const svff, int voice, Lfloat freq, Lfloat Q)
+{
+    _tPolySVF* svf = *svff;
+    
+    svf->cutoff[voice] = LEAF_clip(0.0f, freq, svf->sampleRate * 0.5f);
+    svf->Q[voice] = Q;
+    tPolySVF_updateVoice(svf, voice);
+}
+
+void    tPolySVF_setFilterType(tPolySVF* const svff, SVFType type)
+{
+    _tPolySVF* svf = *svff;
+    
+    svf->type = type;
+    svf->cH = 0.0f;
+    svf->cB = 0.0f;
+    svf->cBK = 0.0f;
+    svf->cL = 1.0f;
+    
+    if (type == SVFTypeBandpass)
+    {
+        svf->cB = 1.0f;
+        svf->cL = 0.0f;
+    }
+    else if (type == SVFTypeHighpass)
+    {
+        svf->cH = 1.0f;
+        svf->cBK = -1.0f;
+        svf->cL = -1.0f;
+    }
+    else if (type == SVFTypeNotch)
+    {
+        svf->cH = 1.0f;
+        svf->cBK = -1.0f;
+        svf->cL = 0.0f;
+    }
+    else if (type == SVFTypePeak)
+    {
+        svf->cH = 1.0f;
+        svf->cBK = -1.0f;
+        svf->cL = -2.0f;
+    }
+}
+
+void    tPolySVF_setSampleRate  (tPolySVF* const svff, Lfloat sr)
+{
+    _tPolySVF* svf = *svff;
+    svf->sampleRate = sr;
+    svf->invSampleRate = 1.0f/svf->sampleRate;
+    for (int i = 0; i < POLY_FLOAT_LANES; i++)
+    {
+        svf->cutoff[i] = LEAF_clip(0.0f, svf->cutoff[i], svf->sampleRate * 0.5f);
+        tPolySVF_updateVoice(svf, i);
+    }
+}
+#endif // SIMD_64
+
 // Less efficient, more accurate version of SVF, in which cutoff frequency is taken as Lfloating point Hz value and tanf
 // is calculated when frequency changes.
 void tSVF_LP_init(tSVF_LP* const svff, Lfloat freq, Lfloat Q, LEAF* const leaf)
@@ -1396,6 +1553,7 @@ void    tSVF_LP_initToPool     (tSVF_LP* const svff, Lfloat freq, Lfloat Q, tMem
     _tMempool* m = *mp;
     _tSVF_LP* svf = *svff = (_tSVF_LP*) mpool_alloc(sizeof(_tSVF_LP), m);
     svf->mempool = m;
+    LEAF_registerObject(svf->mempool, &svf->node, svf, (LEAFSampleRateFunc) tSVF_LP_setSampleRate, NULL);
     
     LEAF* leaf = svf->mempool->leaf;
     
@@ -1420,19 +1578,13 @@ void    tSVF_LP_initToPool     (tSVF_LP* const svff, Lfloat freq, Lfloat Q, tMem
     svf->a5 = svf->g*svf->a4;
     svf->nan = 0;
     
-    if (leaf->sampleRate > 80000)
-    {
-        svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        svf->table = __filterTanhTable_48000;
-    }
+    svf->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tSVF_LP_free   (tSVF_LP* const svff)
 {
     _tSVF_LP* svf = *svff;
+    LEAF_unregisterObject(svf->mempool, &svf->node);
     mpool_free((char*)svf, svf->mempool);
 }
 
@@ -1564,14 +1716,7 @@ void    tSVF_LP_setSampleRate  (tSVF_LP* const svff, Lfloat sr)
     svf->sampleRate = sr;
     svf->invSampleRate = 1.0f/svf->sampleRate;
     svf->sampleRatio = 48000.0f/sr;
-    if (sr > 80000)
-    {
-        svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        svf->table = __filterTanhTable_48000;
-    }
+    svf->table = LEAF_getFilterTanTable(svf->mempool->leaf, sr, 80000);
 }
 
 //only works for lowpass right now
@@ -1588,7 +1733,7 @@ Lfloat    tSVF_LP_getPhaseAtFrequency  (tSVF_LP* const svff, Lfloat freq)
     return atan2f(num, den);
 }
 
-#if LEAF_INCLUDE_FILTERTAN_TABLE
+#if LEAF_INCLUDE_FILTERTAN_TABLE || LEAF_GENERATE_TABLES
 // Efficient version of tSVF where frequency is set based on 12-bit integer input for lookup in tanh wavetable.
 void   tEfficientSVF_init(tEfficientSVF* const svff, SVFType type, uint16_t input, Lfloat Q, LEAF* const leaf)
 {
@@ -1600,20 +1745,14 @@ void    tEfficientSVF_initToPool    (tEfficientSVF* const svff, SVFType type, ui
     _tMempool* m = *mp;
     _tEfficientSVF* svf = *svff = (_tEfficientSVF*) mpool_alloc(sizeof(_tEfficientSVF), m);
     svf->mempool = m;
+    LEAF_registerObject(svf->mempool, &svf->node, svf, (LEAFSampleRateFunc) tEfficientSVF_setSampleRate, NULL);
     
     svf->type = type;
     
     svf->ic1eq = 0.0f;
     svf->ic2eq = 0.0f;
     LEAF* leaf = svf->mempool->leaf;
-    if (leaf->sampleRate > 80000)
-    {
-    	svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	svf->table = __filterTanhTable_48000;
-    }
+    svf->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
     
     svf->g = svf->table[input];
     svf->k = 1.0f/Q;
@@ -1625,6 +1764,7 @@ void    tEfficientSVF_initToPool    (tEfficientSVF* const svff, SVFType type, ui
 void    tEfficientSVF_free (tEfficientSVF* const svff)
 {
     _tEfficientSVF* svf = *svff;
+    LEAF_unregisterObject(svf->mempool, &svf->node);
     mpool_free((char*)svf, svf->mempool);
 }
 
@@ -1691,14 +1831,7 @@ void    tEfficientSVF_setFreqAndQ   (tEfficientSVF* const svff, uint16_t input,
 void    tEfficientSVF_setSampleRate  (tEfficientSVF* const svff, Lfloat sampleRate)
 {
 	_tEfficientSVF* svf = *svff;
-	if (sampleRate > 80000)
-    {
-    	svf->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	svf->table = __filterTanhTable_48000;
-    }
+	svf->table = LEAF_getFilterTanTable(svf->mempool->leaf, sampleRate, 80000);
 }
 
 #endif // LEAF_INCLUDE_FILTERTAN_TABLE
@@ -1715,6 +1848,7 @@ void tHighpass_initToPool    (tHighpass* const ft, Lfloat freq, tMempool* const
     _tHighpass* f = *ft = (_tHighpass*) mpool_calloc(sizeof(_tHighpass), m);
     f->mempool = m;
     LEAF* leaf = f->mempool->leaf;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tHighpass_setSampleRate, (LEAFClearFunc) tHighpass_clear);
     
     f->twoPiTimesInvSampleRate = leaf->twoPiTimesInvSampleRate;
     f->R = (1.0f - (freq * f->twoPiTimesInvSampleRate));
@@ -1727,6 +1861,7 @@ void tHighpass_initToPool    (tHighpass* const ft, Lfloat freq, tMempool* const
 void tHighpass_free  (tHighpass* const ft)
 {
     _tHighpass* f = *ft;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -1760,6 +1895,13 @@ void tHighpass_setSampleRate(tHighpass* const ft, Lfloat sr)
     f->R = (1.0f - (f->frequency * f->twoPiTimesInvSampleRate));
 }
 
+void tHighpass_clear(tHighpass* const ft)
+{
+    _tHighpass* f = *ft;
+    f->xs = 0.0f;
+    f->ys = 0.0f;
+}
+
 void tButterworth_init(tButterworth* const ft, int order, Lfloat f1, Lfloat f2, LEAF* const leaf)
 {
     tButterworth_initToPool(ft, order, f1, f2, &leaf->mempool);
@@ -1770,6 +1912,7 @@ void    tButterworth_initToPool     (tButterworth* const ft, int order, Lfloat f
     _tMempool* m = *mp;
     _tButterworth* f = *ft = (_tButterworth*) mpool_alloc(sizeof(_tButterworth), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tButterworth_setSampleRate, NULL);
     
     f->f1 = f1;
     f->f2 = f2;
@@ -1798,6 +1941,7 @@ void    tButterworth_free   (tButterworth* const ft)
     for (int i = 0; i < f->numSVF; ++i) tSVF_free(&f->svf[i]);
     
     mpool_free((char*)f->svf, f->mempool);
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -1811,6 +1955,46 @@ Lfloat tButterworth_tick(tButterworth* const ft, Lfloat samp)
     return samp;
 }
 
+// The sections stay SVFs rather than going through LEAF_kernel_biquadCascade():
+// a transposed direct form biquad in single precision loses tens of dB of accuracy
+// at low cutoffs, where these SVFs hold up. Running them section by section across
+// the block still keeps each section's state in registers.
+void    tButterworth_tickBlock(tButterworth* const ft, Lfloat* in, Lfloat* out, int size)
+{
+    _tButterworth* f = *ft;
+    
+    if (f->numSVF == 0 && in != out)
+    {
+        for (int n = 0; n < size; ++n) out[n] = in[n];
+        return;
+    }
+    
+    Lfloat* src = in;
+    for (int i = 0; i < f->numSVF; ++i)
+    {
+        _tSVF* svf = f->svf[i];
+        Lfloat ic1eq = svf->ic1eq, ic2eq = svf->ic2eq;
+        Lfloat a1 = svf->a1, a2 = svf->a2, a3 = svf->a3;
+        Lfloat cH = svf->cH, cB = svf->cB, cL = svf->cL, cBK = svf->cBK, k = svf->k;
+        
+        for (int n = 0; n < size; ++n)
+        {
+            Lfloat v0 = src[n];
+            Lfloat v1,v2,v3;
+            v3 = v0 - ic2eq;
+            v1 = (a1 * ic1eq) + (a2 * v3);
+            v2 = ic2eq + (a2 * ic1eq) + (a3 * v3);
+            ic1eq = (2.0f * v1) - ic1eq;
+            ic2eq = (2.0f * v2) - ic2eq;
+            out[n] = (v0 * cH) + (v1 * cB) + (k * v1 * cBK) + (v2 * cL);
+        }
+        
+        svf->ic1eq = ic1eq;
+        svf->ic2eq = ic2eq;
+        src = out;
+    }
+}
+
 void tButterworth_setF1(tButterworth* const ft, Lfloat f1)
 {
     _tButterworth* f = *ft;
@@ -1860,8 +2044,9 @@ void    tFIR_initToPool     (tFIR* const firf, Lfloat* coeffs, int numTaps, tMem
     
     fir->numTaps = numTaps;
     fir->coeff = coeffs;
-    fir->past = (Lfloat*) mpool_alloc(sizeof(Lfloat) * fir->numTaps, m);
-    for (int i = 0; i < fir->numTaps; ++i) fir->past[i] = 0.0f;
+    fir->pos = 0;
+    fir->past = (Lfloat*) mpool_alloc(sizeof(Lfloat) * fir->numTaps * 2, m);
+    for (int i = 0; i < fir->numTaps * 2; ++i) fir->past[i] = 0.0f;
 }
 
 void    tFIR_free   (tFIR* const firf)
@@ -1876,13 +2061,18 @@ Lfloat   tFIR_tick(tFIR* const firf, Lfloat input)
 {
     _tFIR* fir = *firf;
     
-    fir->past[0] = input;
-    Lfloat y = 0.0f;
-    for (int i = 0; i < fir->numTaps; ++i) y += fir->past[i]*fir->coeff[i];
-    for (int i = fir->numTaps-1; i > 0; --i) fir->past[i] = fir->past[i-1];
+    Lfloat y;
+    LEAF_kernel_fir(fir->coeff, fir->numTaps, fir->past, &fir->pos, &input, &y, 1);
     return y;
 }
 
+void    tFIR_tickBlock(tFIR* const firf, Lfloat* in, Lfloat* out, int size)
+{
+    _tFIR* fir = *firf;
+    
+    LEAF_kernel_fir(fir->coeff, fir->numTaps, fir->past, &fir->pos, in, out, size);
+}
+
 //---------------------------------------------
 ////
 /// Median filter implemented based on James McCartney's median filter in Supercollider,
@@ -1973,6 +2163,7 @@ void    tVZFilter_initToPool     (tVZFilter* const vf, VZFilterType type, Lfloat
     _tMempool* m = *mp;
     _tVZFilter* f = *vf = (_tVZFilter*) mpool_alloc(sizeof(_tVZFilter), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tVZFilter_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -1995,19 +2186,13 @@ void    tVZFilter_initToPool     (tVZFilter* const vf, VZFilterType type, Lfloat
     f->g = tanf(PI * f->fc * f->invSampleRate);  // embedded integrator gain (Fig 3.11)
     tVZFilter_setBandwidth(vf,f->B);
     tVZFilter_calcCoeffs(vf);
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tVZFilter_free   (tVZFilter* const vf)
 {
     _tVZFilter* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -2485,14 +2670,7 @@ void    tVZFilter_setSampleRate  (tVZFilter* const vf, Lfloat sr)
     f->sampleRate = sr;
     f->invSampleRate = 1.0f/f->sampleRate;
     f->sampRatio = 48000.0f / sr;
-    if (sr > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sr, 80000);
 }
 
 
@@ -2506,6 +2684,7 @@ void    tVZFilterLS_initToPool     (tVZFilterLS* const vf, Lfloat freq, Lfloat Q
     _tMempool* m = *mp;
     _tVZFilterLS* f = *vf = (_tVZFilterLS*) mpool_alloc(sizeof(_tVZFilterLS), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tVZFilterLS_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -2524,19 +2703,13 @@ void    tVZFilterLS_initToPool     (tVZFilterLS* const vf, Lfloat freq, Lfloat Q
     f->g = f->gPreDiv * f->invSqrtA;               // scale SVF-cutoff frequency for shelvers
     f->R2Plusg = f->R2+f->g;
     f->h = 1.0f / (1.0f + (f->R2*f->g) + (f->g*f->g));  // factor for feedback
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tVZFilterLS_free   (tVZFilterLS* const vf)
 {
     _tVZFilterLS* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -2546,14 +2719,7 @@ void    tVZFilterLS_setSampleRate  (tVZFilterLS* const vf, Lfloat sampleRate)
         f->sampleRate = sampleRate;
     f->invSampleRate = 1.0f / sampleRate;
     f->sampRatio = 48000.0f / f->sampleRate;
-    if (sampleRate > 80000)
-       {
-       	f->table = __filterTanhTable_96000;
-       }
-       else
-       {
-       	f->table = __filterTanhTable_48000;
-       }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sampleRate, 80000);
 }
 Lfloat   tVZFilterLS_tick               (tVZFilterLS* const vf, Lfloat input)
 {
@@ -2674,6 +2840,7 @@ void    tVZFilterHS_initToPool     (tVZFilterHS* const vf, Lfloat freq, Lfloat Q
     _tMempool* m = *mp;
     _tVZFilterHS* f = *vf = (_tVZFilterHS*) mpool_alloc(sizeof(_tVZFilterHS), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tVZFilterHS_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -2692,19 +2859,13 @@ void    tVZFilterHS_initToPool     (tVZFilterHS* const vf, Lfloat freq, Lfloat Q
     f->g = f->gPreDiv * f->sqrtA;               // scale SVF-cutoff frequency for shelvers
     f->R2Plusg = f->R2+f->g;
     f->h = 1.0f / (1.0f + (f->R2*f->g) + (f->g*f->g));  // factor for feedback
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tVZFilterHS_free   (tVZFilterHS* const vf)
 {
     _tVZFilterHS* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -2714,14 +2875,7 @@ void    tVZFilterHS_setSampleRate  (tVZFilterHS* const vf, Lfloat sampleRate)
         f->sampleRate = sampleRate;
     f->invSampleRate = 1.0f / sampleRate;
     f->sampRatio = 48000.0f / f->sampleRate;
-    if (sampleRate > 80000)
-          {
-          	f->table = __filterTanhTable_96000;
-          }
-          else
-          {
-          	f->table = __filterTanhTable_48000;
-          }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sampleRate, 80000);
 }
 Lfloat   tVZFilterHS_tick               (tVZFilterHS* const vf, Lfloat input)
 {
@@ -2845,6 +2999,7 @@ void    tVZFilterBell_initToPool     (tVZFilterBell* const vf, Lfloat freq, Lflo
     _tMempool* m = *mp;
     _tVZFilterBell* f = *vf = (_tVZFilterBell*) mpool_alloc(sizeof(_tVZFilterBell), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tVZFilterBell_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -2867,19 +3022,13 @@ void    tVZFilterBell_initToPool     (tVZFilterBell* const vf, Lfloat freq, Lflo
     f->R2 = 2.0f*fastsqrtf(((r*r+1.0f)/r-2.0f)/(4.0f*f->G));
     f->R2Plusg = f->R2+f->g;
     f->h = 1.0f / (1.0f + (f->R2*f->g) + (f->g*f->g));  // factor for feedback
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tVZFilterBell_free   (tVZFilterBell* const vf)
 {
     _tVZFilterBell* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -2889,14 +3038,7 @@ void    tVZFilterBell_setSampleRate  (tVZFilterBell* const vf, Lfloat sampleRate
         f->sampleRate = sampleRate;
     f->invSampleRate = 1.0f / sampleRate;
     f->sampRatio = 48000.0f / f->sampleRate;
-    if (sampleRate > 80000)
-          {
-          	f->table = __filterTanhTable_96000;
-          }
-          else
-          {
-          	f->table = __filterTanhTable_48000;
-          }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sampleRate, 80000);
 }
 Lfloat   tVZFilterBell_tick               (tVZFilterBell* const vf, Lfloat input)
 {
@@ -3124,6 +3266,7 @@ void    tVZFilterBR_initToPool     (tVZFilterBR* const vf, Lfloat freq, Lfloat Q
     _tMempool* m = *mp;
     _tVZFilterBR* f = *vf = (_tVZFilterBR*) mpool_alloc(sizeof(_tVZFilterBR), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tVZFilterBR_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -3139,19 +3282,13 @@ void    tVZFilterBR_initToPool     (tVZFilterBR* const vf, Lfloat freq, Lfloat Q
     f->g = tanf(PI * fc * f->invSampleRate);
     f->R2Plusg = f->R2+f->g;
     f->h = 1.0f / (1.0f + (f->R2*f->g) + (f->g*f->g));  // factor for feedback precomputation
-    if (leaf->sampleRate > 80000)
-    {
-        f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tVZFilterBR_free   (tVZFilterBR* const vf)
 {
     _tVZFilterBR* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -3161,14 +3298,7 @@ void    tVZFilterBR_setSampleRate  (tVZFilterBR* const vf, Lfloat sampleRate)
         f->sampleRate = sampleRate;
     f->invSampleRate = 1.0f / sampleRate;
     f->sampRatio = 48000.0f / f->sampleRate;
-    if (sampleRate > 80000)
-       {
-           f->table = __filterTanhTable_96000;
-       }
-       else
-       {
-           f->table = __filterTanhTable_48000;
-       }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sampleRate, 80000);
 }
 Lfloat   tVZFilterBR_tick               (tVZFilterBR* const vf, Lfloat input)
 {
@@ -3274,6 +3404,7 @@ void    tDiodeFilter_initToPool     (tDiodeFilter* const vf, Lfloat cutoff, Lflo
     _tMempool* m = *mp;
     _tDiodeFilter* f = *vf = (_tDiodeFilter*) mpool_alloc(sizeof(_tDiodeFilter), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tDiodeFilter_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -3295,19 +3426,13 @@ void    tDiodeFilter_initToPool     (tDiodeFilter* const vf, Lfloat cutoff, Lflo
     f->g1inv = 1.f/(2.f*f->gamma);
     f->g2inv = 1.f/(6.f*f->gamma);
     f->sampRatio = 48000.0f / leaf->sampleRate;
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tDiodeFilter_free   (tDiodeFilter* const vf)
 {
     _tDiodeFilter* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -3490,14 +3615,7 @@ void    tDiodeFilter_setSampleRate(tDiodeFilter* const vf, Lfloat sr)
     
     f->invSampleRate = 1.0f/sr;
     f->sampRatio = 48000.0f / sr;
-    if (sr > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sr, 80000);
 }
 
 
@@ -3511,6 +3629,7 @@ void    tLadderFilter_initToPool     (tLadderFilter* const vf, Lfloat cutoff, Lf
     _tMempool* m = *mp;
     _tLadderFilter* f = *vf = (_tLadderFilter*) mpool_alloc(sizeof(_tLadderFilter), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tLadderFilter_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     
@@ -3537,19 +3656,13 @@ void    tLadderFilter_initToPool     (tLadderFilter* const vf, Lfloat cutoff, Lf
     f->b[0] = 0.02f;
     f->b[0] = 0.03f;
     f->b[0] = 0.04f;
-    if (leaf->sampleRate > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(leaf, leaf->sampleRate, 80000);
 }
 
 void    tLadderFilter_free   (tLadderFilter* const vf)
 {
     _tLadderFilter* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -3688,14 +3801,7 @@ void    tLadderFilter_setSampleRate(tLadderFilter* const vf, Lfloat sr)
     
     f->invSampleRate = 1.0f/sr;
     f->sampleRatio = 48000.0f / sr * f->invOS;
-    if (sr > 80000)
-    {
-    	f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-    	f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sr, 80000);
 }
 
 
@@ -3706,14 +3812,7 @@ void    tLadderFilter_setOversampling(tLadderFilter* const vf, int os)
     f->oversampling = os;
     f->invOS = 1.0f / ((Lfloat) os);
     Lfloat sr = f->oversampling / f->invSampleRate;
-    if (sr > 80000)
-    {
-        f->table = __filterTanhTable_96000;
-    }
-    else
-    {
-        f->table = __filterTanhTable_48000;
-    }
+    f->table = LEAF_getFilterTanTable(f->mempool->leaf, sr, 80000);
 
 }
 
@@ -3729,6 +3828,7 @@ void    tTiltFilter_initToPool     (tTiltFilter* const vf, Lfloat cutoff, tMempo
     _tMempool* m = *mp;
     _tTiltFilter* f = *vf = (_tTiltFilter*) mpool_alloc(sizeof(_tTiltFilter), m);
     f->mempool = m;
+    LEAF_registerObject(f->mempool, &f->node, f, (LEAFSampleRateFunc) tTiltFilter_setSampleRate, NULL);
     
     LEAF* leaf = f->mempool->leaf;
     f->cutoff = cutoff;
@@ -3746,6 +3846,7 @@ void    tTiltFilter_initToPool     (tTiltFilter* const vf, Lfloat cutoff, tMempo
 void    tTiltFilter_free   (tTiltFilter* const vf)
 {
     _tTiltFilter* f = *vf;
+    LEAF_unregisterObject(f->mempool, &f->node);
     mpool_free((char*)f, f->mempool);
 }
 
@@ -0,0 +1,693 @@
+/*==============================================================================
+
+ leaf-graph.c
+
+ ==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-graph.h"
+
+#else
+
+#include "../Inc/leaf-graph.h"
+
+#endif
+
+#if LEAF_USE_THREADS
+#if _WIN32 || _WIN64
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+#endif
+
+// Pauses a thread spins through looking for work before it yields, or between
+// blocks before it sleeps
+#define GRAPH_SPIN_COUNT 4096
+
+// Subtracted from the count of workers in a block to close it to late arrivals
+#define GRAPH_CLOSED 0x40000000
+
+#if LEAF_USE_THREADS
+#if _WIN32 || _WIN64
+typedef HANDLE graph_thread_t;
+
+struct _tBlockGraphSync
+{
+    SRWLOCK lock;
+    CONDITION_VARIABLE wake;
+};
+#else
+typedef pthread_t graph_thread_t;
+
+struct _tBlockGraphSync
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+};
+#endif
+#endif
+
+typedef struct _tBlockGraphWorker
+{
+    _tBlockGraph* graph;
+    int index;
+
+    // Chase-Lev deque of ready nodes. The owning thread pushes and pops at the
+    // bottom and other threads steal from the top. Both restart at 0 each block
+    // and every node is pushed once per block, so it never wraps.
+    int* items;
+    volatile int top;
+    volatile int bottom;
+
+#if LEAF_USE_THREADS
+    graph_thread_t thread;
+#endif
+    char padding[64]; // keeps neighbouring workers' top and bottom off each other's cache lines
+} _tBlockGraphWorker;
+
+static inline void graph_pause(void)
+{
+#if LEAF_USE_THREADS
+#if _WIN32 || _WIN64
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+#endif
+}
+
+static inline void graph_idle(int* spins)
+{
+    if (++(*spins) < GRAPH_SPIN_COUNT)
+    {
+        graph_pause();
+        return;
+    }
+#if LEAF_USE_THREADS
+#if _WIN32 || _WIN64
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+#endif
+}
+
+static inline void graph_push(_tBlockGraphWorker* w, int node)
+{
+    int b = w->bottom;
+    LEAF_ATOMIC_STORE(&w->items[b], node);
+    LEAF_ATOMIC_STORE(&w->bottom, b + 1);
+}
+
+static inline int graph_pop(_tBlockGraphWorker* w)
+{
+    int b = w->bottom - 1;
+    LEAF_ATOMIC_STORE(&w->bottom, b);
+    LEAF_ATOMIC_FENCE();
+    int t = LEAF_ATOMIC_LOAD(&w->top);
+    if (t > b)
+    {
+        LEAF_ATOMIC_STORE(&w->bottom, b + 1);
+        return -1;
+    }
+
+    int node = LEAF_ATOMIC_LOAD(&w->items[b]);
+    if (t == b)
+    {
+        // the last node, so a thief may be taking it too
+        if (!LEAF_ATOMIC_CAS(&w->top, t, t + 1)) node = -1;
+        LEAF_ATOMIC_STORE(&w->bottom, b + 1);
+    }
+    return node;
+}
+
+static inline int graph_steal(_tBlockGraphWorker* w)
+{
+    int t = LEAF_ATOMIC_LOAD(&w->top);
+    LEAF_ATOMIC_FENCE();
+    int b = LEAF_ATOMIC_LOAD(&w->bottom);
+    if (t >= b) return -1;
+
+    int node = LEAF_ATOMIC_LOAD(&w->items[t]);
+    if (!LEAF_ATOMIC_CAS(&w->top, t, t + 1)) return -1;
+    return node;
+}
+
+static void graph_work(_tBlockGraph* g, int self)
+{
+    _tBlockGraphWorker* w = &g->workers[self];
+    int spins = 0;
+
+    while (LEAF_ATOMIC_LOAD(&g->remaining) > 0)
+    {
+        int index = graph_pop(w);
+        for (int i = 1; index < 0 && i < g->numThreads; i++)
+            index = graph_steal(&g->workers[(self + i) % g->numThreads]);
+
+        if (index < 0)
+        {
+            graph_idle(&spins);
+            continue;
+        }
+        spins = 0;
+
+        _tBlockGraphNode* node = &g->nodes[index];
+        node->process(node->userData, g->blockSize);
+
+        // successors made ready here go on this thread's deque, so a chain stays on one core
+        for (int i = 0; i < node->numSuccessors; i++)
+        {
+            int s = node->successors[i];
+            if (LEAF_ATOMIC_ADD(&g->nodes[s].pending, -1) == 0)
+                graph_push(w, s);
+        }
+        LEAF_ATOMIC_ADD(&g->remaining, -1);
+    }
+}
+
+#if LEAF_USE_THREADS
+
+static double graph_clock(void)
+{
+#if _WIN32 || _WIN64
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+static void graph_wake(_tBlockGraph* g)
+{
+    struct _tBlockGraphSync* s = g->sync;
+#if _WIN32 || _WIN64
+    AcquireSRWLockExclusive(&s->lock);
+    WakeAllConditionVariable(&s->wake);
+    ReleaseSRWLockExclusive(&s->lock);
+#else
+    pthread_mutex_lock(&s->lock);
+    pthread_cond_broadcast(&s->wake);
+    pthread_mutex_unlock(&s->lock);
+#endif
+}
+
+// Sleepers are counted before the generation is checked again, and the calling
+// thread bumps the generation before it checks for sleepers, so with the fences
+// between them at least one side sees the other and no wake-up is lost.
+static void graph_sleep(_tBlockGraph* g, int seen)
+{
+    struct _tBlockGraphSync* s = g->sync;
+#if _WIN32 || _WIN64
+    AcquireSRWLockExclusive(&s->lock);
+    LEAF_ATOMIC_ADD(&g->sleepers, 1);
+    LEAF_ATOMIC_FENCE();
+    while (LEAF_ATOMIC_LOAD(&g->generation) == seen)
+        SleepConditionVariableSRW(&s->wake, &s->lock, INFINITE, 0);
+    LEAF_ATOMIC_ADD(&g->sleepers, -1);
+    ReleaseSRWLockExclusive(&s->lock);
+#else
+    pthread_mutex_lock(&s->lock);
+    LEAF_ATOMIC_ADD(&g->sleepers, 1);
+    LEAF_ATOMIC_FENCE();
+    while (LEAF_ATOMIC_LOAD(&g->generation) == seen)
+        pthread_cond_wait(&s->wake, &s->lock);
+    LEAF_ATOMIC_ADD(&g->sleepers, -1);
+    pthread_mutex_unlock(&s->lock);
+#endif
+}
+
+// A worker joins a block only while it is open. The calling thread closes it once
+// every node has finished and waits just for the workers that joined, so one
+// that was asleep or descheduled when the block started holds nothing up.
+static int graph_enter(_tBlockGraph* g)
+{
+    int n = LEAF_ATOMIC_LOAD(&g->active);
+    while (n >= 0)
+    {
+        if (LEAF_ATOMIC_CAS(&g->active, n, n + 1)) return 1;
+        n = LEAF_ATOMIC_LOAD(&g->active);
+    }
+    return 0;
+}
+
+static void graph_workerLoop(_tBlockGraphWorker* w)
+{
+    _tBlockGraph* g = w->graph;
+    int seen = 0;
+
+    for (;;)
+    {
+        int spins = 0;
+        while (LEAF_ATOMIC_LOAD(&g->generation) == seen)
+        {
+            if (++spins < GRAPH_SPIN_COUNT) graph_pause();
+            else graph_sleep(g, seen);
+        }
+        if (LEAF_ATOMIC_LOAD(&g->quit)) return;
+
+        seen = LEAF_ATOMIC_LOAD(&g->generation);
+        if (graph_enter(g))
+        {
+            graph_work(g, w->index);
+            LEAF_ATOMIC_ADD(&g->active, -1);
+        }
+    }
+}
+
+#if _WIN32 || _WIN64
+static DWORD WINAPI graph_threadMain(LPVOID arg)
+{
+    graph_workerLoop((_tBlockGraphWorker*) arg);
+    return 0;
+}
+
+static int graph_startThread(_tBlockGraphWorker* w)
+{
+    w->thread = CreateThread(NULL, 0, graph_threadMain, w, 0, NULL);
+    if (w->thread == NULL) return 0;
+    // run at the priority of the thread calling init, as pthreads do by default
+    SetThreadPriority(w->thread, GetThreadPriority(GetCurrentThread()));
+    return 1;
+}
+
+static void graph_joinThread(_tBlockGraphWorker* w)
+{
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+}
+#else
+static void* graph_threadMain(void* arg)
+{
+    graph_workerLoop((_tBlockGraphWorker*) arg);
+    return NULL;
+}
+
+static int graph_startThread(_tBlockGraphWorker* w)
+{
+    // inherit the scheduling policy and priority of the thread calling init
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+    int started = pthread_create(&w->thread, &attr, graph_threadMain, w) == 0;
+    pthread_attr_destroy(&attr);
+    return started;
+}
+
+static void graph_joinThread(_tBlockGraphWorker* w)
+{
+    pthread_join(w->thread, NULL);
+}
+#endif
+
+#endif // LEAF_USE_THREADS
+
+// Whether node "to" can be reached from node "from" by following dependencies
+static int graph_reaches(_tBlockGraph* g, int from, int to)
+{
+    char* visited = (char*) mpool_calloc(sizeof(char) * g->numNodes, g->mempool);
+    int* stack = (int*) mpool_alloc(sizeof(int) * g->numNodes, g->mempool);
+    int found = 0;
+    int size = 0;
+
+    stack[size++] = from;
+    visited[from] = 1;
+    while (size > 0 && !found)
+    {
+        _tBlockGraphNode* node = &g->nodes[stack[--size]];
+        for (int i = 0; i < node->numSuccessors; i++)
+        {
+            int s = node->successors[i];
+            if (s == to) found = 1;
+            if (!visited[s])
+            {
+                visited[s] = 1;
+                stack[size++] = s;
+            }
+        }
+    }
+
+    mpool_free((char*)stack, g->mempool);
+    mpool_free((char*)visited, g->mempool);
+    return found;
+}
+
+void tBlockGraph_init(tBlockGraph* const graph, int maxNodes, int numThreads, LEAF* const leaf)
+{
+    tBlockGraph_initToPool(graph, maxNodes, numThreads, &leaf->mempool);
+}
+
+void tBlockGraph_initToPool(tBlockGraph* const graph, int maxNodes, int numThreads, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tBlockGraph* g = *graph = (_tBlockGraph*) mpool_calloc(sizeof(_tBlockGraph), m);
+    g->mempool = m;
+
+    if (maxNodes < 1) maxNodes = 1;
+#if !LEAF_USE_THREADS
+    numThreads = 1;
+#endif
+    if (numThreads < 1) numThreads = 1;
+
+    g->maxNodes = maxNodes;
+    g->numNodes = 0;
+    g->nodes = (_tBlockGraphNode*) mpool_calloc(sizeof(_tBlockGraphNode) * maxNodes, m);
+
+    g->workers = (_tBlockGraphWorker*) mpool_calloc(sizeof(_tBlockGraphWorker) * numThreads, m);
+    for (int i = 0; i < numThreads; i++)
+    {
+        g->workers[i].graph = g;
+        g->workers[i].index = i;
+        g->workers[i].items = (int*) mpool_alloc(sizeof(int) * maxNodes, m);
+    }
+    g->maxThreads = numThreads;
+    g->numThreads = 1;
+
+    g->clock = NULL;
+    g->deadline = 1.0f;
+    g->load = 0.0f;
+    g->peakLoad = 0.0f;
+    g->deadlineMisses = 0;
+    g->active = -GRAPH_CLOSED;
+
+#if LEAF_USE_THREADS
+    g->clock = graph_clock;
+    g->sync = (struct _tBlockGraphSync*) mpool_calloc(sizeof(struct _tBlockGraphSync), m);
+#if _WIN32 || _WIN64
+    InitializeSRWLock(&g->sync->lock);
+    InitializeConditionVariable(&g->sync->wake);
+#else
+    pthread_mutex_init(&g->sync->lock, NULL);
+    pthread_cond_init(&g->sync->wake, NULL);
+#endif
+    // if the system runs out of threads, render with the ones that started
+    for (int i = 1; i < numThreads; i++)
+    {
+        if (!graph_startThread(&g->workers[i])) break;
+        g->numThreads++;
+    }
+#endif
+}
+
+void tBlockGraph_free(tBlockGraph* const graph)
+{
+    _tBlockGraph* g = *graph;
+
+#if LEAF_USE_THREADS
+    LEAF_ATOMIC_STORE(&g->quit, 1);
+    LEAF_ATOMIC_ADD(&g->generation, 1);
+    graph_wake(g);
+    for (int i = 1; i < g->numThreads; i++)
+        graph_joinThread(&g->workers[i]);
+#if !(_WIN32 || _WIN64)
+    pthread_cond_destroy(&g->sync->wake);
+    pthread_mutex_destroy(&g->sync->lock);
+#endif
+    mpool_free((char*)g->sync, g->mempool);
+#endif
+
+    for (int i = 0; i < g->numNodes; i++)
+    {
+        if (g->nodes[i].successors != NULL)
+            mpool_free((char*)g->nodes[i].successors, g->mempool);
+    }
+    // workers that failed to start still have deques
+    for (int i = 0; i < g->maxThreads; i++)
+        mpool_free((char*)g->workers[i].items, g->mempool);
+    mpool_free((char*)g->workers, g->mempool);
+    mpool_free((char*)g->nodes, g->mempool);
+    mpool_free((char*)g, g->mempool);
+}
+
+int tBlockGraph_addNode(tBlockGraph* const graph, void (*process)(void* userData, int blockSize), void* userData)
+{
+    _tBlockGraph* g = *graph;
+    if (g->numNodes >= g->maxNodes) return -1;
+
+    _tBlockGraphNode* node = &g->nodes[g->numNodes];
+    node->process = process;
+    node->userData = userData;
+    node->successors = NULL;
+    node->numSuccessors = 0;
+    node->maxSuccessors = 0;
+    node->numPredecessors = 0;
+    node->pending = 0;
+    return g->numNodes++;
+}
+
+int tBlockGraph_addDependency(tBlockGraph* const graph, int first, int then)
+{
+    _tBlockGraph* g = *graph;
+    if (first < 0 || first >= g->numNodes || then < 0 || then >= g->numNodes || first == then) return 0;
+
+    _tBlockGraphNode* node = &g->nodes[first];
+    for (int i = 0; i < node->numSuccessors; i++)
+    {
+        if (node->successors[i] == then) return 1;
+    }
+    // a cycle would leave its nodes waiting on each other forever
+    if (graph_reaches(g, then, first)) return 0;
+
+    if (node->numSuccessors == node->maxSuccessors)
+    {
+        int size = node->maxSuccessors > 0 ? node->maxSuccessors * 2 : 4;
+        int* successors = (int*) mpool_alloc(sizeof(int) * size, g->mempool);
+        if (successors == NULL) return 0;
+        for (int i = 0; i < node->numSuccessors; i++)
+            successors[i] = node->successors[i];
+        if (node->successors != NULL)
+            mpool_free((char*)node->successors, g->mempool);
+        node->successors = successors;
+        node->maxSuccessors = size;
+    }
+    node->successors[node->numSuccessors++] = then;
+    g->nodes[then].numPredecessors++;
+    return 1;
+}
+
+void tBlockGraph_process(tBlockGraph* const graph, int blockSize)
+{
+    _tBlockGraph* g = *graph;
+    double start = (g->clock != NULL) ? g->clock() : 0.0;
+
+    if (g->numNodes > 0)
+    {
+        // the last block is closed and every worker that joined it has left, so the deques are free to reset
+        for (int i = 0; i < g->numThreads; i++)
+        {
+            g->workers[i].top = 0;
+            g->workers[i].bottom = 0;
+        }
+
+        // deal the nodes with no dependencies out across the threads
+        int next = 0;
+        for (int i = 0; i < g->numNodes; i++)
+        {
+            _tBlockGraphNode* node = &g->nodes[i];
+            node->pending = node->numPredecessors;
+            if (node->numPredecessors == 0)
+            {
+                _tBlockGraphWorker* w = &g->workers[next];
+                w->items[w->bottom++] = i;
+                if (++next == g->numThreads) next = 0;
+            }
+        }
+        g->blockSize = blockSize;
+        g->remaining = g->numNodes;
+
+#if LEAF_USE_THREADS
+        if (g->numThreads > 1)
+        {
+            LEAF_ATOMIC_STORE(&g->active, 0);
+            LEAF_ATOMIC_ADD(&g->generation, 1);
+            LEAF_ATOMIC_FENCE();
+            if (LEAF_ATOMIC_LOAD(&g->sleepers) > 0) graph_wake(g);
+        }
+#endif
+
+        graph_work(g, 0);
+
+#if LEAF_USE_THREADS
+        if (g->numThreads > 1)
+        {
+            int spins = 0;
+            LEAF_ATOMIC_ADD(&g->active, -GRAPH_CLOSED);
+            while (LEAF_ATOMIC_LOAD(&g->active) != -GRAPH_CLOSED) graph_idle(&spins);
+        }
+#endif
+    }
+
+    if (g->clock != NULL)
+    {
+        Lfloat period = (Lfloat) blockSize * g->mempool->leaf->invSampleRate;
+        g->load = (period > 0.0f) ? (Lfloat) (g->clock() - start) / period : 0.0f;
+        if (g->load > g->peakLoad) g->peakLoad = g->load;
+        if (g->load > g->deadline) g->deadlineMisses++;
+    }
+}
+
+void tBlockGraph_setDeadline(tBlockGraph* const graph, Lfloat fraction)
+{
+    _tBlockGraph* g = *graph;
+    g->deadline = fraction;
+}
+
+void tBlockGraph_setClock(tBlockGraph* const graph, double (*clock)(void))
+{
+    _tBlockGraph* g = *graph;
+    g->clock = clock;
+}
+
+uint32_t tBlockGraph_getNumDeadlineMisses(tBlockGraph* const graph)
+{
+    _tBlockGraph* g = *graph;
+    return g->deadlineMisses;
+}
+
+Lfloat tBlockGraph_getLoad(tBlockGraph* const graph)
+{
+    _tBlockGraph* g = *graph;
+    return g->load;
+}
+
+Lfloat tBlockGraph_getPeakLoad(tBlockGraph* const graph)
+{
+    _tBlockGraph* g = *graph;
+    return g->peakLoad;
+}
+
+void tBlockGraph_resetStats(tBlockGraph* const graph)
+{
+    _tBlockGraph* g = *graph;
+    g->peakLoad = 0.0f;
+    g->deadlineMisses = 0;
+}
+
+//==============================================================================
+
+#define PARAM_SNAPSHOT_FRESH 4
+
+void tParamSnapshot_init(tParamSnapshot* const snapshot, int numParams, LEAF* const leaf)
+{
+    tParamSnapshot_initToPool(snapshot, numParams, &leaf->mempool);
+}
+
+void tParamSnapshot_initToPool(tParamSnapshot* const snapshot, int numParams, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tParamSnapshot* p = *snapshot = (_tParamSnapshot*) mpool_alloc(sizeof(_tParamSnapshot), m);
+    p->mempool = m;
+    
+    p->numParams = numParams;
+    for (int i = 0; i < 3; i++)
+        p->buffers[i] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numParams, m);
+    p->writeBuffer = 0;
+    p->middle = 1;
+    p->readBuffer = 2;
+    
+    p->applied = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numParams, m);
+    p->changed = (uint32_t*) mpool_calloc(sizeof(uint32_t) * ((numParams + 31) >> 5), m);
+    p->primed = 0;
+    
+    p->setters = (void (**)(void* const, Lfloat)) mpool_calloc(sizeof(void (*)(void* const, Lfloat)) * numParams, m);
+    p->objects = (void**) mpool_calloc(sizeof(void*) * numParams, m);
+}
+
+void tParamSnapshot_free(tParamSnapshot* const snapshot)
+{
+    _tParamSnapshot* p = *snapshot;
+    
+    mpool_free((char*)p->objects, p->mempool);
+    mpool_free((char*)p->setters, p->mempool);
+    mpool_free((char*)p->changed, p->mempool);
+    mpool_free((char*)p->applied, p->mempool);
+    for (int i = 0; i < 3; i++)
+        mpool_free((char*)p->buffers[i], p->mempool);
+    mpool_free((char*)p, p->mempool);
+}
+
+void tParamSnapshot_bind(tParamSnapshot* const snapshot, int index, void (*set)(void* const object, Lfloat value), void* object)
+{
+    _tParamSnapshot* p = *snapshot;
+    p->setters[index] = set;
+    p->objects[index] = object;
+}
+
+// checks the bits so it still works under -ffast-math
+static inline int snapshot_isnan(float f)
+{
+    union { float f; uint32_t x; } u = { f };
+    return (u.x << 1) > 0xff000000u;
+}
+
+void tParamSnapshot_setValue(tParamSnapshot* const snapshot, int index, Lfloat value)
+{
+    _tParamSnapshot* p = *snapshot;
+    // a NaN never compares equal to the applied value, so it would reach the setter every block
+    if (snapshot_isnan(value)) return;
+    p->buffers[p->writeBuffer][index] = value;
+}
+
+void tParamSnapshot_publish(tParamSnapshot* const snapshot)
+{
+    _tParamSnapshot* p = *snapshot;
+    
+    int published = p->writeBuffer;
+    p->writeBuffer = LEAF_ATOMIC_EXCHANGE(&p->middle, published | PARAM_SNAPSHOT_FRESH) & 3;
+    
+    // the buffer handed back may be stale or one the audio thread never saw, so carry
+    // the published values over. The audio thread only reads published buffers.
+    Lfloat* src = p->buffers[published];
+    Lfloat* dst = p->buffers[p->writeBuffer];
+    for (int i = 0; i < p->numParams; i++) dst[i] = src[i];
+}
+
+int tParamSnapshot_update(tParamSnapshot* const snapshot)
+{
+    _tParamSnapshot* p = *snapshot;
+    
+    if (LEAF_ATOMIC_LOAD(&p->middle) & PARAM_SNAPSHOT_FRESH)
+        p->readBuffer = LEAF_ATOMIC_EXCHANGE(&p->middle, p->readBuffer) & 3;
+    
+    // changes are found by value rather than flagged by the writer, so a snapshot
+    // replaced before the audio thread saw it can't lose them
+    const Lfloat* values = p->buffers[p->readBuffer];
+    int numChanged = 0;
+    for (int w = 0; w < ((p->numParams + 31) >> 5); w++) p->changed[w] = 0;
+    for (int i = 0; i < p->numParams; i++)
+    {
+        if (p->primed && values[i] == p->applied[i]) continue;
+        
+        p->applied[i] = values[i];
+        p->changed[i >> 5] |= 1u << (i & 31);
+        numChanged++;
+        if (p->setters[i] != NULL) p->setters[i](p->objects[i], values[i]);
+    }
+    p->primed = 1;
+    return numChanged;
+}
+
+Lfloat tParamSnapshot_getValue(tParamSnapshot* const snapshot, int index)
+{
+    _tParamSnapshot* p = *snapshot;
+    return p->applied[index];
+}
+
+int tParamSnapshot_hasChanged(tParamSnapshot* const snapshot, int index)
+{
+    _tParamSnapshot* p = *snapshot;
+    return (p->changed[index >> 5] >> (index & 31)) & 1;
+}
+
+//==============================================================================
+
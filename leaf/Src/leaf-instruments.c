@@ -28,6 +28,7 @@ void        t808Cowbell_initToPool      (t808Cowbell* const cowbellInst, int use
     _tMempool* m = *mp;
     _t808Cowbell* cowbell = *cowbellInst = (_t808Cowbell*) mpool_alloc(sizeof(_t808Cowbell), m);
     cowbell->mempool = m;
+    LEAF_registerObject(cowbell->mempool, &cowbell->node, cowbell, (LEAFSampleRateFunc) t808Cowbell_setSampleRate, NULL);
     
     tSquare_initToPool(&cowbell->p[0], mp);
     tSquare_setFreq(&cowbell->p[0], 540.0f);
@@ -67,6 +68,7 @@ void        t808Cowbell_free    (t808Cowbell* const cowbellInst)
     tHighpass_free(&cowbell->highpass);
     tNoise_free(&cowbell->stick);
     tEnvelope_free(&cowbell->envStick);
+    LEAF_unregisterObject(cowbell->mempool, &cowbell->node);
     mpool_free((char*)cowbell, cowbell->mempool);
 }
 
@@ -164,6 +166,7 @@ void    t808Hihat_initToPool  (t808Hihat* const hihatInst, tMempool* const mp)
     _tMempool* m = *mp;
     _t808Hihat* hihat = *hihatInst = (_t808Hihat*) mpool_alloc(sizeof(_t808Hihat), m);
     hihat->mempool = m;
+    LEAF_registerObject(hihat->mempool, &hihat->node, hihat, (LEAFSampleRateFunc) t808Hihat_setSampleRate, NULL);
     
     for (int i = 0; i < 6; i++)
     {
@@ -214,6 +217,7 @@ void    t808Hihat_free  (t808Hihat* const hihatInst)
     
     tHighpass_free(&hihat->highpass);
     
+    LEAF_unregisterObject(hihat->mempool, &hihat->node);
     mpool_free((char*)hihat, hihat->mempool);
 }
 
@@ -348,6 +352,7 @@ void    t808Snare_initToPool    (t808Snare* const snareInst, tMempool* const mp)
     _tMempool* m = *mp;
     _t808Snare* snare = *snareInst = (_t808Snare*) mpool_alloc(sizeof(_t808Snare), m);
     snare->mempool = m;
+    LEAF_registerObject(snare->mempool, &snare->node, snare, (LEAFSampleRateFunc) t808Snare_setSampleRate, NULL);
     
     Lfloat ratio[2] = {1.0, 1.5};
     for (int i = 0; i < 2; i++)
@@ -391,6 +396,7 @@ void    t808Snare_free  (t808Snare* const snareInst)
     tEnvelope_free(&snare->noiseEnvGain);
     tEnvelope_free(&snare->noiseEnvFilter);
     
+    LEAF_unregisterObject(snare->mempool, &snare->node);
     mpool_free((char*)snare, snare->mempool);
 }
 
@@ -506,6 +512,7 @@ void    t808SnareSmall_initToPool    (t808SnareSmall* const snareInst, tMempool*
     _tMempool* m = *mp;
     _t808SnareSmall* snare = *snareInst = (_t808SnareSmall*) mpool_alloc(sizeof(_t808SnareSmall), m);
     snare->mempool = m;
+    LEAF_registerObject(snare->mempool, &snare->node, snare, (LEAFSampleRateFunc) t808SnareSmall_setSampleRate, NULL);
     
     Lfloat ratio[2] = {1.0, 1.5};
     for (int i = 0; i < 2; i++)
@@ -548,6 +555,7 @@ void    t808SnareSmall_free  (t808SnareSmall* const snareInst)
     tADSRS_free(&snare->noiseEnvGain);
     tADSRS_free(&snare->noiseEnvFilter);
     
+    LEAF_unregisterObject(snare->mempool, &snare->node);
     mpool_free((char*)snare, snare->mempool);
 }
 
@@ -663,6 +671,7 @@ void t808Kick_initToPool (t808Kick* const kickInst, tMempool* const mp)
     _tMempool* m = *mp;
     _t808Kick* kick = *kickInst = (_t808Kick*) mpool_alloc(sizeof(_t808Kick), m);
     kick->mempool = m;
+    LEAF_registerObject(kick->mempool, &kick->node, kick, (LEAFSampleRateFunc) t808Kick_setSampleRate, NULL);
     
     tCycle_initToPool(&kick->tone, mp);
     kick->toneInitialFreq = 40.0f;
@@ -690,6 +699,7 @@ void    t808Kick_free   (t808Kick* const kickInst)
     tNoise_free(&kick->noiseOsc);
     tEnvelope_free(&kick->noiseEnvGain);
     
+    LEAF_unregisterObject(kick->mempool, &kick->node);
     mpool_free((char*)kick, kick->mempool);
 }
 
@@ -756,6 +766,7 @@ void t808KickSmall_initToPool (t808KickSmall* const kickInst, tMempool* const mp
     _tMempool* m = *mp;
     _t808KickSmall* kick = *kickInst = (_t808KickSmall*) mpool_alloc(sizeof(_t808KickSmall), m);
     kick->mempool = m;
+    LEAF_registerObject(kick->mempool, &kick->node, kick, (LEAFSampleRateFunc) t808KickSmall_setSampleRate, NULL);
     
     tCycle_initToPool(&kick->tone, mp);
     kick->toneInitialFreq = 40.0f;
@@ -783,6 +794,7 @@ void    t808KickSmall_free   (t808KickSmall* const kickInst)
     tNoise_free(&kick->noiseOsc);
     tADSRS_free(&kick->noiseEnvGain);
     
+    LEAF_unregisterObject(kick->mempool, &kick->node);
     mpool_free((char*)kick, kick->mempool);
 }
 
@@ -838,3 +850,304 @@ void        t808KickSmall_setSampleRate  (t808KickSmall* const kickInst, Lfloat
 
 
 
+
+//==============================================================================
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Voice Engine ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+#define VOICE_ENGINE_SILENCE 0.0001f // -80dB
+
+void    tVoiceEngine_init           (tVoiceEngine* const ve, int maxNumVoices, int maxBlockSize, LEAF* const leaf)
+{
+    tVoiceEngine_initToPool(ve, maxNumVoices, maxBlockSize, &leaf->mempool);
+}
+
+void    tVoiceEngine_initToPool     (tVoiceEngine* const ve, int maxNumVoices, int maxBlockSize, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tVoiceEngine* e = *ve = (_tVoiceEngine*) mpool_alloc(sizeof(_tVoiceEngine), m);
+    e->mempool = m;
+    LEAF* leaf = e->mempool->leaf;
+    LEAF_registerObject(e->mempool, &e->node, e, (LEAFSampleRateFunc) tVoiceEngine_setSampleRate, NULL);
+    
+    e->maxNumVoices = maxNumVoices;
+    e->maxBlockSize = maxBlockSize > 0 ? maxBlockSize : 1;
+    e->sampleRate = leaf->sampleRate;
+    e->invSampleRate = leaf->invSampleRate;
+    
+    tSimplePoly_initToPool(&e->poly, maxNumVoices, mp);
+    
+    e->stage = (int*) mpool_calloc(sizeof(int) * maxNumVoices, m);
+    e->level = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->gain = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->phase = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->inc = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->a1 = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->a2 = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->a3 = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->ic1eq = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    e->ic2eq = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices, m);
+    
+    e->voiceBuffer = (Lfloat*) mpool_calloc(sizeof(Lfloat) * e->maxBlockSize, m);
+    e->envBuffer = (Lfloat*) mpool_calloc(sizeof(Lfloat) * e->maxBlockSize, m);
+    
+    for (int i = 0; i < maxNumVoices; i++) e->stage[i] = env_idle;
+    
+    e->Q = 0.707f;
+    tVoiceEngine_setCutoff(ve, 5000.0f);
+    tVoiceEngine_setEnvelope(ve, 5.0f, 200.0f, 0.7f, 200.0f);
+}
+
+void    tVoiceEngine_free           (tVoiceEngine* const ve)
+{
+    _tVoiceEngine* e = *ve;
+    
+    mpool_free((char*)e->envBuffer, e->mempool);
+    mpool_free((char*)e->voiceBuffer, e->mempool);
+    mpool_free((char*)e->ic2eq, e->mempool);
+    mpool_free((char*)e->ic1eq, e->mempool);
+    mpool_free((char*)e->a3, e->mempool);
+    mpool_free((char*)e->a2, e->mempool);
+    mpool_free((char*)e->a1, e->mempool);
+    mpool_free((char*)e->inc, e->mempool);
+    mpool_free((char*)e->phase, e->mempool);
+    mpool_free((char*)e->gain, e->mempool);
+    mpool_free((char*)e->level, e->mempool);
+    mpool_free((char*)e->stage, e->mempool);
+    tSimplePoly_free(&e->poly);
+    LEAF_unregisterObject(e->mempool, &e->node);
+    mpool_free((char*)e, e->mempool);
+}
+
+static void tVoiceEngine_startVoice(_tVoiceEngine* e, int voice, int note, int vel)
+{
+    // retrigger from the current level of a voice that is still sounding to avoid clicks
+    if (e->stage[voice] == env_idle)
+    {
+        e->level[voice] = 0.0f;
+        e->phase[voice] = 0.0f;
+        e->ic1eq[voice] = 0.0f;
+        e->ic2eq[voice] = 0.0f;
+    }
+    e->stage[voice] = env_attack;
+    e->gain[voice] = vel * (1.0f / 127.0f);
+    e->inc[voice] = mtof(note) * e->invSampleRate;
+}
+
+int     tVoiceEngine_noteOn         (tVoiceEngine* const ve, int note, uint8_t vel)
+{
+    _tVoiceEngine* e = *ve;
+    
+    int voice = tSimplePoly_noteOn(&e->poly, note, vel);
+    if (voice >= 0) tVoiceEngine_startVoice(e, voice, note, vel);
+    return voice;
+}
+
+int     tVoiceEngine_noteOff        (tVoiceEngine* const ve, int note)
+{
+    _tVoiceEngine* e = *ve;
+    
+    // the voice stays assigned in the poly handler until its release has finished
+    int voice = tSimplePoly_markPendingNoteOff(&e->poly, note);
+    if (voice >= 0) e->stage[voice] = env_release;
+    return voice;
+}
+
+// Render the envelope of a voice into envBuffer one stage span at a time
+static void tVoiceEngine_renderEnvelope(_tVoiceEngine* e, int v, int size)
+{
+    Lfloat* env = e->envBuffer;
+    Lfloat level = e->level[v];
+    int stage = e->stage[v];
+    int i = 0;
+    
+    while (i < size)
+    {
+        if (stage == env_attack)
+        {
+            Lfloat inc = e->attackInc;
+            int end = i + (int)((1.0f - level) / inc) + 1;
+            if (end > size) end = size;
+            for (; i < end; i++)
+            {
+                level += inc;
+                level = (level < 1.0f) ? level : 1.0f;
+                env[i] = level;
+            }
+            if (level >= 1.0f) stage = env_decay;
+        }
+        else if (stage == env_decay)
+        {
+            Lfloat sustain = e->sustain;
+            Lfloat coeff = e->decayCoeff;
+            for (; i < size; i++)
+            {
+                level = sustain + (level - sustain) * coeff;
+                env[i] = level;
+            }
+        }
+        else
+        {
+            Lfloat coeff = e->releaseCoeff;
+            for (; i < size; i++)
+            {
+                level *= coeff;
+                env[i] = level;
+            }
+        }
+    }
+    
+    e->level[v] = level;
+    e->stage[v] = stage;
+}
+
+static void tVoiceEngine_renderVoice(_tVoiceEngine* e, int v, Lfloat* out, int size)
+{
+    Lfloat* buf = e->voiceBuffer;
+    Lfloat* env = e->envBuffer;
+    Lfloat phase = e->phase[v];
+    Lfloat inc = e->inc[v];
+    Lfloat a1 = e->a1[v];
+    Lfloat a2 = e->a2[v];
+    Lfloat a3 = e->a3[v];
+    Lfloat ic1eq = e->ic1eq[v];
+    Lfloat ic2eq = e->ic2eq[v];
+    Lfloat gain = e->gain[v];
+    
+    tVoiceEngine_renderEnvelope(e, v, size);
+    
+    // polyBLEP saw into SVF lowpass, as tPBSaw and tSVF_tick
+    for (int i = 0; i < size; i++)
+    {
+        Lfloat saw = (2.0f * phase) - 1.0f - LEAF_poly_blep(phase, inc);
+        phase += inc;
+        if (phase >= 1.0f) phase -= 1.0f;
+        
+        Lfloat v3 = saw - ic2eq;
+        Lfloat v1 = (a1 * ic1eq) + (a2 * v3);
+        Lfloat v2 = ic2eq + (a2 * ic1eq) + (a3 * v3);
+        ic1eq = (2.0f * v1) - ic1eq;
+        ic2eq = (2.0f * v2) - ic2eq;
+        buf[i] = v2;
+    }
+    
+    // no recursion here, so the envelope and mix vectorize
+    for (int i = 0; i < size; i++)
+    {
+        out[i] += buf[i] * env[i] * gain;
+    }
+    
+    e->phase[v] = phase;
+    e->ic1eq[v] = ic1eq;
+    e->ic2eq[v] = ic2eq;
+}
+
+void    tVoiceEngine_tickBlock      (tVoiceEngine* const ve, Lfloat* out, int size)
+{
+    _tVoiceEngine* e = *ve;
+    
+    while (size > 0)
+    {
+        int n = size < e->maxBlockSize ? size : e->maxBlockSize;
+        
+        for (int i = 0; i < n; i++) out[i] = 0.0f;
+        
+        for (int v = 0; v < e->maxNumVoices; v++)
+        {
+            if (e->stage[v] == env_idle) continue;
+            
+            tVoiceEngine_renderVoice(e, v, out, n);
+            
+            if (e->stage[v] == env_release && e->level[v] < VOICE_ENGINE_SILENCE)
+            {
+                e->stage[v] = env_idle;
+                e->level[v] = 0.0f;
+                
+                // the poly handler may hand the voice straight back to a stolen note
+                tSimplePoly_deactivateVoice(&e->poly, v);
+                int recovered = tSimplePoly_getPitchAndCheckActive(&e->poly, v);
+                if (recovered >= 0)
+                    tVoiceEngine_startVoice(e, v, recovered, tSimplePoly_getVelocity(&e->poly, v));
+            }
+        }
+        
+        out += n;
+        size -= n;
+    }
+}
+
+void    tVoiceEngine_setEnvelope    (tVoiceEngine* const ve, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release)
+{
+    _tVoiceEngine* e = *ve;
+    
+    Lfloat minTime = 1000.0f * e->invSampleRate;
+    e->attack = (attack < minTime) ? minTime : attack;
+    e->decay = (decay < minTime) ? minTime : decay;
+    e->release = (release < minTime) ? minTime : release;
+    e->sustain = LEAF_clip(0.0f, sustain, 1.0f);
+    
+    e->attackInc = 1000.0f / (e->attack * e->sampleRate);
+    e->decayCoeff = expf(-1000.0f / (e->decay * e->sampleRate));
+    e->releaseCoeff = expf(-1000.0f / (e->release * e->sampleRate));
+}
+
+static void tVoiceEngine_updateFilter(_tVoiceEngine* e)
+{
+    Lfloat g = tanf(PI * e->cutoff * e->invSampleRate);
+    Lfloat k = 1.0f / e->Q;
+    Lfloat a1 = 1.0f / (1.0f + g * (g + k));
+    Lfloat a2 = g * a1;
+    Lfloat a3 = g * a2;
+    
+    for (int v = 0; v < e->maxNumVoices; v++)
+    {
+        e->a1[v] = a1;
+        e->a2[v] = a2;
+        e->a3[v] = a3;
+    }
+}
+
+void    tVoiceEngine_setCutoff      (tVoiceEngine* const ve, Lfloat freq)
+{
+    _tVoiceEngine* e = *ve;
+    e->cutoff = LEAF_clip(10.0f, freq, e->sampleRate * 0.49f);
+    tVoiceEngine_updateFilter(e);
+}
+
+void    tVoiceEngine_setResonance   (tVoiceEngine* const ve, Lfloat Q)
+{
+    _tVoiceEngine* e = *ve;
+    e->Q = (Q < 0.1f) ? 0.1f : Q;
+    tVoiceEngine_updateFilter(e);
+}
+
+void    tVoiceEngine_setPitch       (tVoiceEngine* const ve, int voice, Lfloat pitch)
+{
+    _tVoiceEngine* e = *ve;
+    if (voice < 0 || voice >= e->maxNumVoices) return;
+    e->inc[voice] = mtof(pitch) * e->invSampleRate;
+}
+
+int     tVoiceEngine_getNumSoundingVoices (tVoiceEngine* const ve)
+{
+    _tVoiceEngine* e = *ve;
+    int count = 0;
+    for (int v = 0; v < e->maxNumVoices; v++) count += (e->stage[v] != env_idle);
+    return count;
+}
+
+int     tVoiceEngine_isSounding     (tVoiceEngine* const ve, int voice)
+{
+    _tVoiceEngine* e = *ve;
+    return e->stage[voice] != env_idle;
+}
+
+void    tVoiceEngine_setSampleRate  (tVoiceEngine* const ve, Lfloat sr)
+{
+    _tVoiceEngine* e = *ve;
+    e->sampleRate = sr;
+    e->invSampleRate = 1.0f / sr;
+    
+    tVoiceEngine_setEnvelope(ve, e->attack, e->decay, e->sustain, e->release);
+    tVoiceEngine_setCutoff(ve, e->cutoff);
+}
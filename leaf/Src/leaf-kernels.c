@@ -0,0 +1,252 @@
+/*==============================================================================
+
+ leaf-kernels.c
+
+ ==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-kernels.h"
+#include "..\Inc\leaf_polyvalues.h"
+#include "..\Externals\d_fft_mayer.h"
+
+#else
+
+#include "../Inc/leaf-kernels.h"
+#include "../Inc/leaf_polyvalues.h"
+#include "../Externals/d_fft_mayer.h"
+
+#endif
+
+#include "math.h"
+
+#if LEAF_USE_CMSIS
+#include "arm_math.h"
+#endif
+
+// plain C unless CMSIS is in use or poly_float maps onto a vector unit
+#if !LEAF_USE_CMSIS && !LEAF_POLY_SCALAR
+#define LEAF_KERNEL_POLY 1
+#endif
+
+#if LEAF_KERNEL_POLY
+POLY_INLINE Lfloat kernel_hsum(poly_float a)
+{
+    Lfloat v[POLY_FLOAT_LANES];
+    poly_store(v, a);
+    Lfloat sum = 0.0f;
+    for (int i = 0; i < POLY_FLOAT_LANES; i++) sum += v[i];
+    return sum;
+}
+#endif
+
+static inline Lfloat kernel_dot(const Lfloat* a, const Lfloat* b, int n)
+{
+#if LEAF_USE_CMSIS
+    float32_t result;
+    arm_dot_prod_f32((float32_t*) a, (float32_t*) b, (uint32_t) n, &result);
+    return result;
+#else
+    Lfloat sum = 0.0f;
+    int i = 0;
+#if LEAF_KERNEL_POLY
+    // two accumulators so consecutive multiply-adds don't wait on each other
+    poly_float acc0 = poly_set1(0.0f);
+    poly_float acc1 = poly_set1(0.0f);
+    for (; i + 2 * POLY_FLOAT_LANES <= n; i += 2 * POLY_FLOAT_LANES)
+    {
+        acc0 = poly_add(acc0, poly_mul(poly_load(&a[i]), poly_load(&b[i])));
+        acc1 = poly_add(acc1, poly_mul(poly_load(&a[i + POLY_FLOAT_LANES]), poly_load(&b[i + POLY_FLOAT_LANES])));
+    }
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+        acc0 = poly_add(acc0, poly_mul(poly_load(&a[i]), poly_load(&b[i])));
+    sum = kernel_hsum(poly_add(acc0, acc1));
+#endif
+    for (; i < n; i++) sum += a[i] * b[i];
+    return sum;
+#endif
+}
+
+Lfloat LEAF_kernel_dot(const Lfloat* a, const Lfloat* b, int n)
+{
+    return kernel_dot(a, b, n);
+}
+
+void LEAF_kernel_add(const Lfloat* a, const Lfloat* b, Lfloat* out, int n)
+{
+#if LEAF_USE_CMSIS
+    arm_add_f32((float32_t*) a, (float32_t*) b, out, (uint32_t) n);
+#else
+    int i = 0;
+#if LEAF_KERNEL_POLY
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+        poly_store(&out[i], poly_add(poly_load(&a[i]), poly_load(&b[i])));
+#endif
+    for (; i < n; i++) out[i] = a[i] + b[i];
+#endif
+}
+
+void LEAF_kernel_mul(const Lfloat* a, const Lfloat* b, Lfloat* out, int n)
+{
+#if LEAF_USE_CMSIS
+    arm_mult_f32((float32_t*) a, (float32_t*) b, out, (uint32_t) n);
+#else
+    int i = 0;
+#if LEAF_KERNEL_POLY
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+        poly_store(&out[i], poly_mul(poly_load(&a[i]), poly_load(&b[i])));
+#endif
+    for (; i < n; i++) out[i] = a[i] * b[i];
+#endif
+}
+
+void LEAF_kernel_scale(const Lfloat* in, Lfloat scale, Lfloat* out, int n)
+{
+#if LEAF_USE_CMSIS
+    arm_scale_f32((float32_t*) in, scale, out, (uint32_t) n);
+#else
+    int i = 0;
+#if LEAF_KERNEL_POLY
+    poly_float s = poly_set1(scale);
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+        poly_store(&out[i], poly_mul(poly_load(&in[i]), s));
+#endif
+    for (; i < n; i++) out[i] = in[i] * scale;
+#endif
+}
+
+Lfloat LEAF_kernel_maxAbs(const Lfloat* in, int n)
+{
+    // arm_absmax_f32() is missing from older CMSIS-DSP releases, so CMSIS builds use the loop
+    Lfloat m = 0.0f;
+    int i = 0;
+#if LEAF_KERNEL_POLY
+    poly_float acc = poly_set1(0.0f);
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+        acc = poly_max(acc, poly_abs(poly_load(&in[i])));
+    Lfloat v[POLY_FLOAT_LANES];
+    poly_store(v, acc);
+    for (int j = 0; j < POLY_FLOAT_LANES; j++) if (v[j] > m) m = v[j];
+#endif
+    for (; i < n; i++)
+    {
+        Lfloat a = fabsf(in[i]);
+        if (a > m) m = a;
+    }
+    return m;
+}
+
+// arm_fir_f32() wants time-reversed coefficients and owns its delay line, so every
+// backend runs the doubled line here and only the dot product changes.
+void LEAF_kernel_fir(const Lfloat* coeffs, int numTaps, Lfloat* hist, int* pos,
+                     const Lfloat* in, Lfloat* out, int n)
+{
+    int p = *pos;
+    for (int i = 0; i < n; i++)
+    {
+        p = (p == 0) ? numTaps - 1 : p - 1;
+        hist[p] = hist[p + numTaps] = in[i];
+        out[i] = kernel_dot(coeffs, &hist[p], numTaps);
+    }
+    *pos = p;
+}
+
+void LEAF_kernel_biquadCascade(const Lfloat* coeffs, Lfloat* state, int numStages,
+                               const Lfloat* in, Lfloat* out, int n)
+{
+#if LEAF_USE_CMSIS
+    if (numStages > 0)
+    {
+        arm_biquad_cascade_df2T_instance_f32 S;
+        S.numStages = (uint8_t) numStages;
+        S.pState = state;
+        S.pCoeffs = (float32_t*) coeffs;
+        arm_biquad_cascade_df2T_f32(&S, (float32_t*) in, out, (uint32_t) n);
+        return;
+    }
+#endif
+    if (numStages == 0 && in != out)
+    {
+        for (int i = 0; i < n; i++) out[i] = in[i];
+        return;
+    }
+
+    // one stage at a time across the whole block, so each stage's
+    // coefficients and state stay in registers
+    const Lfloat* src = in;
+    for (int s = 0; s < numStages; s++)
+    {
+        const Lfloat* c = &coeffs[s * 5];
+        Lfloat b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        Lfloat d1 = state[s * 2];
+        Lfloat d2 = state[s * 2 + 1];
+        for (int i = 0; i < n; i++)
+        {
+            Lfloat x = src[i];
+            Lfloat y = b0 * x + d1;
+            d1 = b1 * x + a1 * y + d2;
+            d2 = b2 * x + a2 * y;
+            out[i] = y;
+        }
+        state[s * 2] = d1;
+        state[s * 2 + 1] = d2;
+        src = out;
+    }
+}
+
+#if LEAF_USE_CMSIS
+// arm_rfft_fast_f32() only covers 32 to 4096 points; anything else goes through mayer
+static int kernel_rfftInit(arm_rfft_fast_instance_f32* S, Lfloat* scratch, int n)
+{
+    if (scratch == NULL) return 0;
+    return arm_rfft_fast_init_f32(S, (uint16_t) n) == ARM_MATH_SUCCESS;
+}
+#endif
+
+void LEAF_kernel_realFFT(Lfloat* buf, Lfloat* scratch, int n)
+{
+#if LEAF_USE_CMSIS
+    arm_rfft_fast_instance_f32 S;
+    if (kernel_rfftInit(&S, scratch, n))
+    {
+        // CMSIS packs {re0, re(n/2), re1, im1, re2, im2, ...}
+        arm_rfft_fast_f32(&S, buf, scratch, 0);
+        int half = n >> 1;
+        buf[0] = scratch[0];
+        buf[half] = scratch[1];
+        for (int k = 1; k < half; k++)
+        {
+            buf[k] = scratch[2 * k];
+            buf[n - k] = -scratch[2 * k + 1];
+        }
+        return;
+    }
+#endif
+    mayer_realfft(n, buf);
+}
+
+void LEAF_kernel_realIFFT(Lfloat* buf, Lfloat* scratch, int n)
+{
+#if LEAF_USE_CMSIS
+    arm_rfft_fast_instance_f32 S;
+    if (kernel_rfftInit(&S, scratch, n))
+    {
+        int half = n >> 1;
+        scratch[0] = buf[0];
+        scratch[1] = buf[half];
+        for (int k = 1; k < half; k++)
+        {
+            scratch[2 * k] = buf[k];
+            scratch[2 * k + 1] = -buf[n - k];
+        }
+        // CMSIS scales the inverse by 1/n, mayer doesn't
+        arm_rfft_fast_f32(&S, scratch, buf, 1);
+        arm_scale_f32(buf, (float32_t) n, buf, (uint32_t) n);
+        return;
+    }
+#endif
+    mayer_realifft(n, buf);
+}
+
+//==============================================================================
+
@@ -9,11 +9,13 @@
 
 #include "..\Inc\leaf-math.h"
 #include "..\Inc\leaf-tables.h"
+#include "..\Inc\leaf_polyvalues.h"
 
 #else
 
 #include "../Inc/leaf-math.h"
 #include "../Inc/leaf-tables.h"
+#include "../Inc/leaf_polyvalues.h"
 
 #endif
 
@@ -237,6 +239,115 @@ Lfloat fast_sinf2(Lfloat x)
     out *= invert;
     return out;
 }
+
+//==============================================================================
+// Block math. Each kernel works on POLY_FLOAT_LANES values at a time; the
+// last partial vector goes through a small zero-padded buffer so every sample
+// sees exactly the same arithmetic.
+
+POLY_INLINE void LEAF_applyArrayKernel(const Lfloat* in, Lfloat* out, int n, poly_float (*kernel)(poly_float))
+{
+    int i = 0;
+    for (; i + POLY_FLOAT_LANES <= n; i += POLY_FLOAT_LANES)
+    {
+        poly_store(out + i, kernel(poly_load(in + i)));
+    }
+    if (i < n)
+    {
+        Lfloat tail[POLY_FLOAT_LANES];
+        int rem = n - i;
+        for (int j = 0; j < POLY_FLOAT_LANES; j++) tail[j] = (j < rem) ? in[i + j] : 0.0f;
+        poly_store(tail, kernel(poly_load(tail)));
+        for (int j = 0; j < rem; j++) out[i + j] = tail[j];
+    }
+}
+
+// 2^x as 2^round(x) times a degree 6 polynomial on [-0.5, 0.5]
+POLY_INLINE poly_float LEAF_exp2Lanes(poly_float x)
+{
+    x = poly_clip(poly_set1(-126.0f), x, poly_set1(127.0f));
+    poly_float k = poly_round(x);
+    poly_float f = poly_sub(x, k);
+    poly_float p = poly_set1(1.5403530393381609e-4f);
+    p = poly_add(poly_mul(p, f), poly_set1(1.3333558146428443e-3f));
+    p = poly_add(poly_mul(p, f), poly_set1(9.6181291076284772e-3f));
+    p = poly_add(poly_mul(p, f), poly_set1(5.5504108664821580e-2f));
+    p = poly_add(poly_mul(p, f), poly_set1(2.4022650695910071e-1f));
+    p = poly_add(poly_mul(p, f), poly_set1(6.9314718055994531e-1f));
+    p = poly_add(poly_mul(p, f), poly_set1(1.0f));
+    return poly_mul(p, poly_pow2i(k));
+}
+
+POLY_INLINE poly_float LEAF_mtofLanes(poly_float x)
+{
+    return poly_mul(poly_set1(8.17579891564f), LEAF_exp2Lanes(poly_mul(x, poly_set1(0.0833333333333333f))));
+}
+
+POLY_INLINE poly_float LEAF_dbtoaLanes(poly_float x)
+{
+    return LEAF_exp2Lanes(poly_mul(x, poly_set1(0.166096404744368f)));
+}
+
+// tanh(|x|) = (1 - e) / (1 + e) with e = exp(-2|x|), which never overflows
+POLY_INLINE poly_float LEAF_tanhLanes(poly_float x)
+{
+    poly_float e = LEAF_exp2Lanes(poly_mul(poly_abs(x), poly_set1(-2.885390081777927f)));
+    poly_float r = poly_div(poly_sub(poly_set1(1.0f), e), poly_add(poly_set1(1.0f), e));
+    return poly_select(poly_lt(x, poly_set1(0.0f)), poly_sub(poly_set1(0.0f), r), r);
+}
+
+POLY_INLINE poly_float LEAF_fastTanhLanes(poly_float x)
+{
+    // fast_tanh() reaches 1 at about 4.97 and overshoots beyond it
+    return poly_fast_tanh(poly_clip(poly_set1(-4.97f), x, poly_set1(4.97f)));
+}
+
+// Two-step reduction by 2*PI, folded into [-PI/2, PI/2] for an odd Taylor series
+POLY_INLINE poly_float LEAF_sinLanes(poly_float x)
+{
+    poly_float k = poly_round(poly_mul(x, poly_set1(INV_TWO_PI)));
+    poly_float r = poly_sub(x, poly_mul(k, poly_set1(6.28125f)));
+    r = poly_sub(r, poly_mul(k, poly_set1(1.9353071795864769e-3f)));
+    r = poly_select(poly_gt(r, poly_set1(HALF_PI)), poly_sub(poly_set1(PI), r), r);
+    r = poly_select(poly_lt(r, poly_set1(-HALF_PI)), poly_sub(poly_set1(-PI), r), r);
+    poly_float r2 = poly_mul(r, r);
+    poly_float p = poly_set1(-2.5052108385441720e-8f);
+    p = poly_add(poly_mul(p, r2), poly_set1(2.7557319223985891e-6f));
+    p = poly_add(poly_mul(p, r2), poly_set1(-1.9841269841269841e-4f));
+    p = poly_add(poly_mul(p, r2), poly_set1(8.3333333333333333e-3f));
+    p = poly_add(poly_mul(p, r2), poly_set1(-1.6666666666666667e-1f));
+    return poly_add(r, poly_mul(poly_mul(r, r2), p));
+}
+
+void LEAF_exp2_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_exp2Lanes);
+}
+
+void LEAF_mtof_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_mtofLanes);
+}
+
+void LEAF_dbtoa_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_dbtoaLanes);
+}
+
+void LEAF_tanh_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_tanhLanes);
+}
+
+void LEAF_fast_tanh_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_fastTanhLanes);
+}
+
+void LEAF_sin_array(const Lfloat* in, Lfloat* out, int n)
+{
+    LEAF_applyArrayKernel(in, out, n, LEAF_sinLanes);
+}
 #if LEAF_INCLUDE_MINBLEP_TABLES
 /// MINBLEPS
 // https://github.com/MrBlueXav/Dekrispator_v2 blepvco.c
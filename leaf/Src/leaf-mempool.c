@@ -61,6 +61,31 @@ static inline size_t mpool_align(size_t size);
 static inline mpool_node_t* create_node(char* block_location, mpool_node_t* next, mpool_node_t* prev, size_t size, size_t header_size);
 static inline void delink_node(mpool_node_t* node);
 
+#if LEAF_CHECK_MEMPOOL_OWNER
+// its address identifies the calling thread
+#if defined(_MSC_VER)
+static __declspec(thread) char mpool_thread_marker;
+#else
+static __thread char mpool_thread_marker;
+#endif
+#endif
+
+static inline void mpool_check_owner(_tMempool* pool)
+{
+#if LEAF_CHECK_MEMPOOL_OWNER
+    if (pool->owner != NULL && pool->owner != &mpool_thread_marker)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFMempoolWrongThread);
+    }
+#endif
+}
+
+// LEAF's counters are shared, so arenas, which are used from other threads, don't touch them
+static inline void mpool_count(_tMempool* pool, unsigned int* count)
+{
+    if (pool->freeQueue == NULL) (*count)++;
+}
+
 /**
  * create memory pool
  */
@@ -77,6 +102,15 @@ void mpool_create (char* memory, size_t size, _tMempool* pool)
     pool->msize  = size;
     
     pool->head = create_node(pool->mpool, NULL, NULL, pool->msize - pool->leaf->header_size, pool->leaf->header_size);
+    
+    pool->objects = NULL;
+    pool->children = NULL;
+    pool->nextSibling = NULL;
+    pool->freeQueue = NULL;
+    pool->freeQueueMask = 0;
+    pool->freeQueueWrite = 0;
+    pool->freeQueueRead = 0;
+    pool->owner = NULL;
 }
 
 
@@ -92,7 +126,8 @@ void leaf_pool_init(LEAF* const leaf, char* memory, size_t size)
  */
 char* mpool_alloc(size_t asize, _tMempool* pool)
 {
-    pool->leaf->allocCount++;
+    mpool_check_owner(pool);
+    mpool_count(pool, &pool->leaf->allocCount);
 #if LEAF_DEBUG
     DBG("alloc " + String(asize));
 #endif
@@ -161,6 +196,12 @@ char* mpool_alloc(size_t asize, _tMempool* pool)
                                node_to_alloc->next,
                                node_to_alloc->prev,
                                leftover - pool->leaf->header_size, pool->leaf->header_size);
+        
+        // The new node takes the allocated node's place in the free list
+        if (new_node->next != NULL) new_node->next->prev = new_node;
+        if (new_node->prev != NULL) new_node->prev->next = new_node;
+        node_to_alloc->next = NULL;
+        node_to_alloc->prev = NULL;
     }
     else
     {
@@ -199,7 +240,8 @@ char* mpool_alloc(size_t asize, _tMempool* pool)
  */
 char* mpool_calloc(size_t asize, _tMempool* pool)
 {
-    pool->leaf->allocCount++;
+    mpool_check_owner(pool);
+    mpool_count(pool, &pool->leaf->allocCount);
 #if LEAF_DEBUG
     DBG("calloc " + String(asize));
 #endif
@@ -265,6 +307,12 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
                                node_to_alloc->next,
                                node_to_alloc->prev,
                                leftover - pool->leaf->header_size, pool->leaf->header_size);
+        
+        // The new node takes the allocated node's place in the free list
+        if (new_node->next != NULL) new_node->next->prev = new_node;
+        if (new_node->prev != NULL) new_node->prev->next = new_node;
+        node_to_alloc->next = NULL;
+        node_to_alloc->prev = NULL;
     }
     else
     {
@@ -306,7 +354,8 @@ char* leaf_calloc(LEAF* const leaf, size_t size)
 
 void mpool_free(char* ptr, _tMempool* pool)
 {
-    pool->leaf->freeCount++;
+    mpool_check_owner(pool);
+    mpool_count(pool, &pool->leaf->freeCount);
 #if LEAF_DEBUG
     DBG("free");
 #endif
@@ -456,16 +505,133 @@ void tMempool_init(tMempool* const mp, char* memory, size_t size, LEAF* const le
 void tMempool_free(tMempool* const mp)
 {
     _tMempool* m = *mp;
-
-    mpool_free((char*)m, m->mempool);
+    _tMempool* parent = m->mempool;
+    
+    for (_tMempool** link = &parent->children; *link != NULL; link = &(*link)->nextSibling)
+    {
+        if (*link == m)
+        {
+            *link = m->nextSibling;
+            break;
+        }
+    }
+    
+    if (m->freeQueue != NULL)
+    {
+        mpool_free((char*)m->freeQueue, parent);
+        mpool_free(m->mpool, parent);
+    }
+    mpool_free((char*)m, parent);
 }
 
 void    tMempool_initToPool     (tMempool* const mp, char* memory, size_t size, tMempool* const mem)
 {
     _tMempool* mm = *mem;
     _tMempool* m = *mp = (_tMempool*) mpool_alloc(sizeof(_tMempool), mm);
+    m->mempool = mm;
     m->leaf = mm->leaf;
     
     mpool_create (memory, size, m);
+    
+    m->nextSibling = mm->children;
+    mm->children = m;
+}
+
+void tMempool_initArena(tMempool* const arena, size_t size, int freeQueueSize, LEAF* const leaf)
+{
+    tMempool_initArenaToPool(arena, size, freeQueueSize, &leaf->mempool);
+}
+
+void tMempool_initArenaToPool(tMempool* const arena, size_t size, int freeQueueSize, tMempool* const mem)
+{
+    _tMempool* mm = *mem;
+    
+    size = mpool_align(size);
+    char* memory = mpool_alloc(size, mm);
+    tMempool_initToPool(arena, memory, size, mem);
+    _tMempool* m = *arena;
+    
+    // power of two capacity so indices can wrap with a mask
+    uint32_t capacity = 1;
+    while (capacity < (uint32_t)freeQueueSize) capacity <<= 1;
+    
+    m->freeQueue = (mpool_deferred_t*) mpool_calloc(sizeof(mpool_deferred_t) * capacity, mm);
+    for (uint32_t i = 0; i < capacity; i++) m->freeQueue[i].sequence = i;
+    m->freeQueueMask = capacity - 1;
+}
+
+void tMempool_claim(tMempool* const arena)
+{
+#if LEAF_CHECK_MEMPOOL_OWNER
+    _tMempool* m = *arena;
+    m->owner = &mpool_thread_marker;
+#endif
+}
+
+// Bounded queue with a sequence number per slot (D. Vyukov): producers race for a
+// slot with compare-and-swap, and only the owner consumes, so it never needs a lock.
+static int mpool_queue_free(_tMempool* m, char* ptr, void (*freeObject)(void** const))
+{
+    if (m->freeQueue == NULL) return 0;
+    
+    uint32_t pos = LEAF_ATOMIC_LOAD(&m->freeQueueWrite);
+    mpool_deferred_t* slot;
+    for (;;)
+    {
+        slot = &m->freeQueue[pos & m->freeQueueMask];
+        int32_t diff = (int32_t)(LEAF_ATOMIC_LOAD(&slot->sequence) - pos);
+        if (diff == 0)
+        {
+            if (LEAF_ATOMIC_CAS(&m->freeQueueWrite, pos, pos + 1)) break;
+        }
+        else if (diff < 0)
+        {
+            return 0; // full
+        }
+        pos = LEAF_ATOMIC_LOAD(&m->freeQueueWrite);
+    }
+    
+    slot->ptr = ptr;
+    slot->freeObject = freeObject;
+    LEAF_ATOMIC_STORE(&slot->sequence, pos + 1);
+    return 1;
+}
+
+int tMempool_queueFree(tMempool* const arena, char* ptr)
+{
+    return mpool_queue_free(*arena, ptr, NULL);
+}
+
+int tMempool_queueFreeObject(tMempool* const arena, void (*freeObject)(void** const), void* object)
+{
+    return mpool_queue_free(*arena, (char*)object, freeObject);
+}
+
+int tMempool_processFreeQueue(tMempool* const arena)
+{
+    _tMempool* m = *arena;
+    if (m->freeQueue == NULL) return 0;
+    
+    int numFreed = 0;
+    for (;;)
+    {
+        uint32_t pos = m->freeQueueRead;
+        mpool_deferred_t* slot = &m->freeQueue[pos & m->freeQueueMask];
+        if (LEAF_ATOMIC_LOAD(&slot->sequence) != pos + 1) break;
+        
+        char* ptr = slot->ptr;
+        void (*freeObject)(void** const) = slot->freeObject;
+        m->freeQueueRead = pos + 1;
+        LEAF_ATOMIC_STORE(&slot->sequence, pos + m->freeQueueMask + 1);
+        
+        if (freeObject != NULL)
+        {
+            void* object = ptr;
+            freeObject(&object);
+        }
+        else mpool_free(ptr, m);
+        numFreed++;
+    }
+    return numFreed;
 }
 
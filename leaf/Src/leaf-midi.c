@@ -20,6 +20,60 @@
 /* Stack */
 //====================================================================================
 
+static inline int tStack_highestBit(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(bits);
+#else
+    int i = 0;
+    while (bits >>= 1) i++;
+    return i;
+#endif
+}
+
+// Largest value in the stack that is less than item, or -1 if there is none
+static int tStack_findLower(_tStack* ns, int item)
+{
+    int w = item >> 5;
+    uint32_t bits = ns->present[w] & ((1u << (item & 31)) - 1u);
+    while (bits == 0)
+    {
+        if (--w < 0) return -1;
+        bits = ns->present[w];
+    }
+    return (w << 5) + tStack_highestBit(bits);
+}
+
+// Insert item directly after pred, or at the front if pred is -1
+static void tStack_link(_tStack* ns, int item, int pred)
+{
+    int succ = (pred < 0) ? ns->head : ns->next[pred];
+    
+    ns->prev[item] = pred;
+    ns->next[item] = succ;
+    if (pred < 0) ns->head = item;
+    else ns->next[pred] = item;
+    if (succ < 0) ns->tail = item;
+    else ns->prev[succ] = item;
+    
+    ns->present[item >> 5] |= (1u << (item & 31));
+    ns->size++;
+}
+
+static void tStack_unlink(_tStack* ns, int item)
+{
+    int pred = ns->prev[item];
+    int succ = ns->next[item];
+    
+    if (pred < 0) ns->head = succ;
+    else ns->next[pred] = succ;
+    if (succ < 0) ns->tail = pred;
+    else ns->prev[succ] = pred;
+    
+    ns->present[item >> 5] &= ~(1u << (item & 31));
+    ns->size--;
+}
+
 void tStack_init(tStack* const stack, LEAF* const leaf)
 {
     tStack_initToPool(stack, &leaf->mempool);
@@ -32,11 +86,9 @@ void    tStack_initToPool           (tStack* const stack, tMempool* const mp)
     ns->mempool = m;
     
     ns->ordered = 0;
-    ns->size = 0;
-    ns->pos = 0;
     ns->capacity = STACK_SIZE;
     
-    for (int i = 0; i < STACK_SIZE; i++) ns->data[i] = -1;
+    tStack_clear(stack);
 }
 
 void    tStack_free        (tStack* const stack)
@@ -46,129 +98,51 @@ void    tStack_free        (tStack* const stack)
     mpool_free((char*)ns, ns->mempool);
 }
 
+int tStack_has(tStack* const stack, uint16_t noteVal)
+{
+    _tStack* ns = *stack;
+    if (noteVal >= STACK_SIZE) return 0;
+    return (ns->present[noteVal >> 5] >> (noteVal & 31)) & 1u;
+}
+
 // If stack contains note, returns index. Else returns -1;
 int tStack_contains(tStack* const stack, uint16_t noteVal)
 {
     _tStack* ns = *stack;
-    for (int i = 0; i < ns->size; i++)
-    {
-        if (ns->data[i] == noteVal)    return i;
-    }
-    return -1;
+    if (!tStack_has(stack, noteVal)) return -1;
+    
+    int i = 0;
+    for (int item = ns->head; item != noteVal; item = ns->next[item]) i++;
+    return i;
 }
 
 void tStack_add(tStack* const stack, uint16_t noteVal)
 {
-    _tStack* ns = *stack;
-    
-    uint8_t j;
-    
-    int whereToInsert = 0;
-    if (ns->ordered)
-    {
-        for (j = 0; j < ns->size; j++)
-        {
-            if (noteVal > ns->data[j])
-            {
-                if ((noteVal < ns->data[j+1]) || (ns->data[j+1] == -1))
-                {
-                    whereToInsert = j+1;
-                    break;
-                }
-            }
-        }
-    }
-    
-    //first move notes that are already in the stack one position to the right
-    for (j = ns->size; j > whereToInsert; j--)
-    {
-        ns->data[j] = ns->data[(j - 1)];
-    }
-    
-    //then, insert the new note into the front of the stack
-    ns->data[whereToInsert] = noteVal;
-    
-    ns->size++;
+    tStack_addIfNotAlreadyThere(stack, noteVal);
 }
 
 int tStack_addIfNotAlreadyThere(tStack* const stack, uint16_t noteVal)
 {
     _tStack* ns = *stack;
     
-    uint8_t j;
-    
-    int added = 0;
+    if (noteVal >= STACK_SIZE || tStack_has(stack, noteVal)) return 0;
     
-    if (tStack_contains(stack, noteVal) == -1)
-    {
-        int whereToInsert = 0;
-        if (ns->ordered)
-        {
-            for (j = 0; j < ns->size; j++)
-            {
-                if (noteVal > ns->data[j])
-                {
-                    if ((noteVal < ns->data[j+1]) || (ns->data[j+1] == -1))
-                    {
-                        whereToInsert = j+1;
-                        break;
-                    }
-                }
-            }
-        }
-        
-        //first move notes that are already in the stack one position to the right
-        for (j = ns->size; j > whereToInsert; j--)
-        {
-            ns->data[j] = ns->data[(j - 1)];
-        }
-        
-        //then, insert the new note into the front of the stack
-        ns->data[whereToInsert] = noteVal;
-        
-        ns->size++;
-        
-        added = 1;
-    }
+    // ordered stacks are kept in ascending order, otherwise new notes go to the front
+    int pred = ns->ordered ? tStack_findLower(ns, noteVal) : -1;
+    tStack_link(ns, noteVal, pred);
     
-    return added;
+    return 1;
 }
 
 // Remove noteVal. return 1 if removed, 0 if not
 int tStack_remove(tStack* const stack, uint16_t noteVal)
 {
-
     _tStack* ns = *stack;
     
-    uint8_t k;
-    int foundIndex = tStack_contains(stack, noteVal);
-    int removed = 0;
-    
-    if (foundIndex >= 0)
-    {
-        for (k = 0; k < (ns->size - foundIndex); k++)
-        {
-            if ((k+foundIndex) >= (ns->capacity - 1))
-            {
-                ns->data[k + foundIndex] = -1;
-            }
-            else
-            {
-                ns->data[k + foundIndex] = ns->data[k + foundIndex + 1];
-                if ((k + foundIndex) == (ns->size - 1))
-                {
-                    ns->data[k + foundIndex + 1] = -1;
-                }
-            }
-            
-        }
-        // in case it got put on the stack multiple times
-        foundIndex--;
-        ns->size--;
-        removed = 1;
-    }
+    if (!tStack_has(stack, noteVal)) return 0;
     
-    return removed;
+    tStack_unlink(ns, noteVal);
+    return 1;
 }
 
 // Doesn't change size of data types
@@ -183,13 +157,9 @@ void tStack_setCapacity(tStack* const stack, uint16_t cap)
     else
         ns->capacity = STACK_SIZE;
     
-    for (int i = cap; i < STACK_SIZE; i++)
+    while (ns->size > ns->capacity)
     {
-        if ((int)ns->data[i] != -1)
-        {
-            ns->data[i] = -1;
-            ns->size -= 1;
-        }
+        tStack_unlink(ns, ns->tail);
     }
     
     if (ns->pos >= cap)
@@ -209,10 +179,12 @@ void tStack_clear(tStack* const stack)
 {
     _tStack* ns = *stack;
     
-    for (int i = 0; i < STACK_SIZE; i++)
+    for (int i = 0; i < STACK_SIZE / 32; i++)
     {
-        ns->data[i] = -1;
+        ns->present[i] = 0;
     }
+    ns->head = -1;
+    ns->tail = -1;
     ns->pos = 0;
     ns->size = 0;
 }
@@ -222,7 +194,6 @@ int tStack_next(tStack* const stack)
 {
     _tStack* ns = *stack;
     
-    int step = 0;
     if (ns->size != 0) // if there is at least one note in the stack
     {
         if (ns->pos > 0) // if you're not at the most recent note (first one), then go backward in the array (moving from earliest to latest)
@@ -234,8 +205,7 @@ int tStack_next(tStack* const stack)
             ns->pos = (ns->size - 1); // if you are the most recent note, go back to the earliest note in the array
         }
         
-        step = ns->data[ns->pos];
-        return step;
+        return tStack_get(stack, ns->pos);
     }
     else
     {
@@ -246,13 +216,48 @@ int tStack_next(tStack* const stack)
 int tStack_get(tStack* const stack, int which)
 {
     _tStack* ns = *stack;
-    return ns->data[which];
+    
+    if (which < 0 || which >= ns->size) return -1;
+    
+    // walk from whichever end is closer
+    int item;
+    if (which < (ns->size >> 1))
+    {
+        item = ns->head;
+        for (int i = 0; i < which; i++) item = ns->next[item];
+    }
+    else
+    {
+        item = ns->tail;
+        for (int i = ns->size - 1; i > which; i--) item = ns->prev[item];
+    }
+    return item;
 }
 
 int tStack_first(tStack* const stack)
 {
     _tStack* ns = *stack;
-    return ns->data[0];
+    return ns->head;
+}
+
+int tStack_last(tStack* const stack)
+{
+    _tStack* ns = *stack;
+    return ns->tail;
+}
+
+int tStack_after(tStack* const stack, uint16_t noteVal)
+{
+    _tStack* ns = *stack;
+    if (!tStack_has(stack, noteVal)) return -1;
+    return ns->next[noteVal];
+}
+
+int tStack_before(tStack* const stack, uint16_t noteVal)
+{
+    _tStack* ns = *stack;
+    if (!tStack_has(stack, noteVal)) return -1;
+    return ns->prev[noteVal];
 }
 
 
@@ -267,6 +272,7 @@ void    tPoly_initToPool            (tPoly* const polyh, int maxNumVoices, tMemp
     _tMempool* m = *mp;
     _tPoly* poly = *polyh = (_tPoly*) mpool_alloc(sizeof(_tPoly), m);
     poly->mempool = m;
+    LEAF_registerObject(poly->mempool, &poly->node, poly, (LEAFSampleRateFunc) tPoly_setSampleRate, NULL);
     
     poly->numVoices = maxNumVoices;
     poly->maxNumVoices = maxNumVoices;
@@ -305,6 +311,7 @@ void    tPoly_initToPool            (tPoly* const polyh, int maxNumVoices, tMemp
     tRamp_initToPool(&poly->pitchBendRamp, 1.0f, 1, mp);
     tStack_initToPool(&poly->stack, mp);
     tStack_initToPool(&poly->orderStack, mp);
+    poly->orderStack->ordered = 1;
     
     poly->pitchGlideIsActive = 0;
 }
@@ -327,6 +334,7 @@ void    tPoly_free  (tPoly* const polyh)
     mpool_free((char*)poly->rampVals, poly->mempool);
     mpool_free((char*)poly->firstReceived, poly->mempool);
     
+    LEAF_unregisterObject(poly->mempool, &poly->node);
     mpool_free((char*)poly, poly->mempool);
 }
 
@@ -363,7 +371,7 @@ int tPoly_noteOn(tPoly* const polyh, int note, uint8_t vel)
     _tPoly* poly = *polyh;
     
     // if not in keymap or already on stack, dont do anything. else, add that note.
-    if (tStack_contains(&poly->stack, note) >= 0) return -1;
+    if (tStack_has(&poly->stack, note)) return -1;
     else
     {
         tPoly_orderedAddToStack(polyh, note);
@@ -399,9 +407,8 @@ int tPoly_noteOn(tPoly* const polyh, int note, uint8_t vel)
         if (!found) //steal
         {
             int whichVoice, whichNote;
-            for (int j = tStack_getSize(&poly->stack) - 1; j >= 0; j--)
+            for (whichNote = tStack_last(&poly->stack); whichNote >= 0; whichNote = tStack_before(&poly->stack, whichNote))
             {
-                whichNote = tStack_get(&poly->stack, j);
                 whichVoice = poly->notes[whichNote][1];
                 if (whichVoice >= 0)
                 {
@@ -471,10 +478,8 @@ int tPoly_noteOff(tPoly* const polyh, uint8_t note)
     //grab old notes off the stack if there are notes waiting to replace the free voice
     if (deactivatedVoice >= 0)
     {
-        for (int j = 0; j < tStack_getSize(&poly->stack); ++j)
+        for (noteToTest = tStack_first(&poly->stack); noteToTest >= 0; noteToTest = tStack_after(&poly->stack, noteToTest))
         {
-            noteToTest = tStack_get(&poly->stack, j);
-            
             if (poly->notes[noteToTest][1] < 0) //if there is a stolen note waiting (marked inactive but on the stack)
             {
                 poly->voices[deactivatedVoice][0] = noteToTest; //set the newly free voice to use the old stolen note
@@ -500,40 +505,8 @@ void tPoly_orderedAddToStack(tPoly* const polyh, uint8_t noteVal)
 {
     _tPoly* poly = *polyh;
     
-    uint8_t j;
-    int myPitch, thisPitch, nextPitch;
-    
-    tStack ns = poly->orderStack;
-    
-    int whereToInsert = 0;
-    
-    for (j = 0; j < ns->size; j++)
-    {
-        myPitch = noteVal;
-        thisPitch = ns->data[j];
-        nextPitch = ns->data[j+1];
-        
-        if (myPitch > thisPitch)
-        {
-            if ((myPitch < nextPitch) || (nextPitch == -1))
-            {
-                whereToInsert = j+1;
-                break;
-            }
-        }
-    }
-    
-    //first move notes that are already in the stack one position to the right
-    for (j = ns->size; j > whereToInsert; j--)
-    {
-        ns->data[j] = ns->data[(j - 1)];
-    }
-    
-    //then, insert the new note into the front of the stack
-    ns->data[whereToInsert] =  noteVal;
-    
-    ns->size++;
-    
+    // orderStack is initialized as an ordered stack, so this keeps it in ascending pitch order
+    tStack_add(&poly->orderStack, noteVal);
 }
 
 void tPoly_setNumVoices(tPoly* const polyh, uint8_t numVoices)
@@ -671,7 +644,7 @@ int tSimplePoly_noteOn(tSimplePoly* const polyh, int note, uint8_t vel)
     _tSimplePoly* poly = *polyh;
     int whichVoice, whichNote, oldNote, alteredVoice;
     // if not in keymap or already on stack, dont do anything. else, add that note.
-    if (tStack_contains(&poly->stack, note) >= 0) return -1;
+    if (tStack_has(&poly->stack, note)) return -1;
     else
     {
         alteredVoice = -1;
@@ -718,9 +691,8 @@ int tSimplePoly_noteOn(tSimplePoly* const polyh, int note, uint8_t vel)
         }
         if ((!found) && (poly->stealing_on)) //steal
         {
-            for (int j = tStack_getSize(&poly->stack) - 1; j >= 0; j--)
+            for (whichNote = tStack_last(&poly->stack); whichNote >= 0; whichNote = tStack_before(&poly->stack, whichNote))
             {
-                whichNote = tStack_get(&poly->stack, j);
                 whichVoice = poly->notes[whichNote][0];
                 if (whichVoice >= 0)
                 {
@@ -770,10 +742,8 @@ int tSimplePoly_noteOff(tSimplePoly* const polyh, uint8_t note)
         //grab old notes off the stack if there are notes waiting to replace the free voice
         if (deactivatedVoice >= 0)
         {
-            for (int j = 0; j < tStack_getSize(&poly->stack); ++j)
+            for (noteToTest = tStack_first(&poly->stack); noteToTest >= 0; noteToTest = tStack_after(&poly->stack, noteToTest))
             {
-                noteToTest = tStack_get(&poly->stack, j);
-
                 if (poly->notes[noteToTest][0] == -3) //if there is a stolen note waiting (marked inactive but on the stack)
                 {
                     poly->voices[deactivatedVoice][0] = noteToTest; //set the newly free voice to use the old stolen note
@@ -800,10 +770,8 @@ void tSimplePoly_deactivateVoice(tSimplePoly* const polyh, uint8_t voice)
         if (poly->recover_stolen)
         {
             //grab old notes off the stack if there are notes waiting to replace the free voice
-            for (int j = 0; j < tStack_getSize(&poly->stack); ++j)
+            for (noteToTest = tStack_first(&poly->stack); noteToTest >= 0; noteToTest = tStack_after(&poly->stack, noteToTest)) //note to check if it is waiting to be recovered
             {
-                noteToTest = tStack_get(&poly->stack, j); //note to check if it is waiting to be recovered
-
                 if (poly->notes[noteToTest][0] == -3) //if there is a stolen note waiting (marked inactive but on the stack)
                 {
                     poly->voices[voice][0] = noteToTest; //set the newly free voice to use the old stolen note
@@ -903,3 +871,450 @@ int tSimplePoly_isOn(tSimplePoly* const polyh, uint8_t voice)
     _tSimplePoly* poly = *polyh;
     return (poly->voices[voice][0] > 0) ? 1 : 0;
 }
+
+//====================================================================================
+/* MIDI Event Queue */
+//====================================================================================
+
+void tMidiEventQueue_init(tMidiEventQueue* const queue, int capacity, LEAF* const leaf)
+{
+    tMidiEventQueue_initToPool(queue, capacity, &leaf->mempool);
+}
+
+void tMidiEventQueue_initToPool(tMidiEventQueue* const queue, int capacity, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tMidiEventQueue* q = *queue = (_tMidiEventQueue*) mpool_alloc(sizeof(_tMidiEventQueue), m);
+    q->mempool = m;
+    
+    // power of two capacity so indices can wrap with a mask
+    uint32_t size = 1;
+    while (size < (uint32_t)capacity) size <<= 1;
+    
+    q->events = (tMidiEvent*) mpool_calloc(sizeof(tMidiEvent) * size, m);
+    q->mask = size - 1;
+    q->writeIndex = 0;
+    q->readIndex = 0;
+    q->dropped = 0;
+    
+    q->poly = NULL;
+    q->simplePoly = NULL;
+    q->bendRange = 2.0f;
+    q->eventCallback = NULL;
+    q->eventUserData = NULL;
+}
+
+void tMidiEventQueue_free(tMidiEventQueue* const queue)
+{
+    _tMidiEventQueue* q = *queue;
+    
+    mpool_free((char*)q->events, q->mempool);
+    mpool_free((char*)q, q->mempool);
+}
+
+int tMidiEventQueue_push(tMidiEventQueue* const queue, uint32_t offset, uint8_t status, uint8_t data1, uint8_t data2)
+{
+    _tMidiEventQueue* q = *queue;
+    
+    uint32_t write = q->writeIndex;
+    uint32_t read = LEAF_ATOMIC_LOAD(&q->readIndex);
+    
+    if (write - read > q->mask)
+    {
+        LEAF_ATOMIC_ADD(&q->dropped, 1);
+        return 0;
+    }
+    
+    tMidiEvent* e = &q->events[write & q->mask];
+    e->offset = offset;
+    e->status = status;
+    e->data1 = data1;
+    e->data2 = data2;
+    
+    LEAF_ATOMIC_STORE(&q->writeIndex, write + 1);
+    return 1;
+}
+
+int tMidiEventQueue_pop(tMidiEventQueue* const queue, tMidiEvent* const event)
+{
+    _tMidiEventQueue* q = *queue;
+    
+    uint32_t read = q->readIndex;
+    uint32_t write = LEAF_ATOMIC_LOAD(&q->writeIndex);
+    
+    if (read == write) return 0;
+    
+    *event = q->events[read & q->mask];
+    LEAF_ATOMIC_STORE(&q->readIndex, read + 1);
+    return 1;
+}
+
+int tMidiEventQueue_getNumEvents(tMidiEventQueue* const queue)
+{
+    _tMidiEventQueue* q = *queue;
+    return (int)(LEAF_ATOMIC_LOAD(&q->writeIndex) - LEAF_ATOMIC_LOAD(&q->readIndex));
+}
+
+uint32_t tMidiEventQueue_getNumDropped(tMidiEventQueue* const queue)
+{
+    _tMidiEventQueue* q = *queue;
+    return LEAF_ATOMIC_LOAD(&q->dropped);
+}
+
+void tMidiEventQueue_setPoly(tMidiEventQueue* const queue, tPoly* const poly)
+{
+    _tMidiEventQueue* q = *queue;
+    q->poly = poly;
+}
+
+void tMidiEventQueue_setSimplePoly(tMidiEventQueue* const queue, tSimplePoly* const poly)
+{
+    _tMidiEventQueue* q = *queue;
+    q->simplePoly = poly;
+}
+
+void tMidiEventQueue_setPitchBendRange(tMidiEventQueue* const queue, Lfloat semitones)
+{
+    _tMidiEventQueue* q = *queue;
+    q->bendRange = semitones;
+}
+
+void tMidiEventQueue_setEventCallback(tMidiEventQueue* const queue, void (*callback)(void* userData, tMidiEvent event), void* userData)
+{
+    _tMidiEventQueue* q = *queue;
+    q->eventCallback = callback;
+    q->eventUserData = userData;
+}
+
+static void tMidiEventQueue_dispatch(_tMidiEventQueue* q, tMidiEvent e)
+{
+    uint8_t type = e.status & 0xF0;
+    
+    if (type == 0x90 && e.data2 > 0)
+    {
+        if (q->poly != NULL) tPoly_noteOn(q->poly, e.data1, e.data2);
+        if (q->simplePoly != NULL) tSimplePoly_noteOn(q->simplePoly, e.data1, e.data2);
+    }
+    else if (type == 0x80 || type == 0x90) // note on with velocity 0 is a note off
+    {
+        if (q->poly != NULL) tPoly_noteOff(q->poly, e.data1);
+        if (q->simplePoly != NULL) tSimplePoly_noteOff(q->simplePoly, e.data1);
+    }
+    else if (type == 0xE0 && q->poly != NULL)
+    {
+        int bend = ((e.data2 << 7) | e.data1) - 8192;
+        tPoly_setPitchBend(q->poly, bend * q->bendRange * (1.0f / 8192.0f));
+    }
+    
+    if (q->eventCallback != NULL) q->eventCallback(q->eventUserData, e);
+}
+
+void tMidiEventQueue_renderBlock(tMidiEventQueue* const queue, int blockSize, void (*render)(void* userData, int offset, int numSamples), void* userData)
+{
+    _tMidiEventQueue* q = *queue;
+    
+    // only events that were queued before the block started belong to it
+    uint32_t read = q->readIndex;
+    uint32_t write = LEAF_ATOMIC_LOAD(&q->writeIndex);
+    int pos = 0;
+    
+    while (read != write)
+    {
+        tMidiEvent e = q->events[read & q->mask];
+        
+        // late events land on the last sample, out of order events land on the current one
+        int offset = (e.offset >= (uint32_t)blockSize) ? blockSize - 1 : (int)e.offset;
+        if (offset < pos) offset = pos;
+        
+        if (offset > pos)
+        {
+            render(userData, pos, offset - pos);
+            pos = offset;
+        }
+        
+        tMidiEventQueue_dispatch(q, e);
+        
+        read++;
+        LEAF_ATOMIC_STORE(&q->readIndex, read);
+    }
+    
+    if (pos < blockSize) render(userData, pos, blockSize - pos);
+}
+
+//====================================================================================
+/* MPE Poly */
+//====================================================================================
+
+void tMPEPoly_init(tMPEPoly* const polyh, int maxNumVoices, LEAF* const leaf)
+{
+    tMPEPoly_initToPool(polyh, maxNumVoices, &leaf->mempool);
+}
+
+void tMPEPoly_initToPool(tMPEPoly* const polyh, int maxNumVoices, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tMPEPoly* poly = *polyh = (_tMPEPoly*) mpool_alloc(sizeof(_tMPEPoly), m);
+    poly->mempool = m;
+    LEAF* leaf = poly->mempool->leaf;
+    LEAF_registerObject(poly->mempool, &poly->node, poly, (LEAFSampleRateFunc) tMPEPoly_setSampleRate, NULL);
+    
+    poly->maxNumVoices = maxNumVoices;
+    tSimplePoly_initToPool(&poly->poly, maxNumVoices, mp);
+    
+    poly->masterChannel = 0;
+    poly->memberBendRange = 48.0f;
+    poly->masterBendRange = 2.0f;
+    poly->masterBend = 0.0f;
+    
+    for (int c = 0; c < 16; c++)
+    {
+        for (int d = 0; d < MPEDimensionNil; d++) poly->channelState[c][d] = 0.0f;
+    }
+    for (int i = 0; i < 128; i++) poly->noteChannels[i] = 0;
+    
+    poly->voiceChannels = (int*) mpool_calloc(sizeof(int) * maxNumVoices, m);
+    poly->values = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices * MPEDimensionNil, m);
+    poly->targets = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices * MPEDimensionNil, m);
+    poly->incs = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxNumVoices * MPEDimensionNil, m);
+    
+    poly->sampleRate = leaf->sampleRate;
+    tMPEPoly_setSmoothingTime(polyh, 5.0f);
+}
+
+void tMPEPoly_free(tMPEPoly* const polyh)
+{
+    _tMPEPoly* poly = *polyh;
+    
+    mpool_free((char*)poly->incs, poly->mempool);
+    mpool_free((char*)poly->targets, poly->mempool);
+    mpool_free((char*)poly->values, poly->mempool);
+    mpool_free((char*)poly->voiceChannels, poly->mempool);
+    tSimplePoly_free(&poly->poly);
+    LEAF_unregisterObject(poly->mempool, &poly->node);
+    mpool_free((char*)poly, poly->mempool);
+}
+
+// jump a voice to the expression of its channel without smoothing
+static void tMPEPoly_snapVoice(_tMPEPoly* poly, int voice, int channel)
+{
+    poly->voiceChannels[voice] = channel;
+    for (int d = 0; d < MPEDimensionNil; d++)
+    {
+        int i = d * poly->maxNumVoices + voice;
+        poly->values[i] = poly->targets[i] = poly->channelState[channel][d];
+        poly->incs[i] = 0.0f;
+    }
+}
+
+static void tMPEPoly_setVoiceExpression(_tMPEPoly* poly, int voice, MPEDimension d, Lfloat value)
+{
+    int i = d * poly->maxNumVoices + voice;
+    poly->targets[i] = value;
+    poly->incs[i] = (value - poly->values[i]) * poly->factor;
+}
+
+// expression on the master channel reaches every channel, and so every voice
+static void tMPEPoly_setChannelExpression(_tMPEPoly* poly, int channel, MPEDimension d, Lfloat value)
+{
+    int all = (channel == poly->masterChannel);
+    for (int c = 0; c < 16; c++)
+    {
+        if (all || c == channel) poly->channelState[c][d] = value;
+    }
+    
+    for (int v = 0; v < poly->maxNumVoices; v++)
+    {
+        if ((all || poly->voiceChannels[v] == channel) && tSimplePoly_getPitchAndCheckActive(&poly->poly, v) >= 0)
+            tMPEPoly_setVoiceExpression(poly, v, d, value);
+    }
+}
+
+int tMPEPoly_noteOn(tMPEPoly* const polyh, int channel, int note, uint8_t vel)
+{
+    _tMPEPoly* poly = *polyh;
+    channel &= 15;
+    
+    int voice = tSimplePoly_noteOn(&poly->poly, note, vel);
+    if (voice >= 0)
+    {
+        poly->noteChannels[note] = channel;
+        tMPEPoly_snapVoice(poly, voice, channel);
+    }
+    return voice;
+}
+
+int tMPEPoly_noteOff(tMPEPoly* const polyh, int channel, int note)
+{
+    _tMPEPoly* poly = *polyh;
+    
+    // the same note number held on another channel is a different note
+    if (poly->noteChannels[note] != (channel & 15)) return -1;
+    
+    int voice = tSimplePoly_findVoiceAssignedToNote(&poly->poly, note);
+    int deactivatedVoice = tSimplePoly_noteOff(&poly->poly, note);
+    
+    // the freed voice may have picked up a stolen note from another channel
+    if (voice >= 0)
+    {
+        int recovered = tSimplePoly_getPitchAndCheckActive(&poly->poly, voice);
+        if (recovered >= 0) tMPEPoly_snapVoice(poly, voice, poly->noteChannels[recovered]);
+    }
+    return deactivatedVoice;
+}
+
+void tMPEPoly_setPitchBend(tMPEPoly* const polyh, int channel, int value)
+{
+    _tMPEPoly* poly = *polyh;
+    channel &= 15;
+    Lfloat bend = (value - 8192) * (1.0f / 8192.0f);
+    
+    if (channel == poly->masterChannel)
+    {
+        poly->masterBend = bend * poly->masterBendRange;
+    }
+    else
+    {
+        tMPEPoly_setChannelExpression(poly, channel, MPEPitchBend, bend * poly->memberBendRange);
+    }
+}
+
+void tMPEPoly_setPressure(tMPEPoly* const polyh, int channel, int value)
+{
+    _tMPEPoly* poly = *polyh;
+    tMPEPoly_setChannelExpression(poly, channel & 15, MPEPressure, value * (1.0f / 127.0f));
+}
+
+void tMPEPoly_setNotePressure(tMPEPoly* const polyh, int channel, int note, int value)
+{
+    _tMPEPoly* poly = *polyh;
+    if (poly->noteChannels[note] != (channel & 15)) return;
+    
+    int voice = tSimplePoly_findVoiceAssignedToNote(&poly->poly, note);
+    if (voice >= 0) tMPEPoly_setVoiceExpression(poly, voice, MPEPressure, value * (1.0f / 127.0f));
+}
+
+void tMPEPoly_setTimbre(tMPEPoly* const polyh, int channel, int value)
+{
+    _tMPEPoly* poly = *polyh;
+    tMPEPoly_setChannelExpression(poly, channel & 15, MPETimbre, value * (1.0f / 127.0f));
+}
+
+void tMPEPoly_processMessage(tMPEPoly* const polyh, uint8_t status, uint8_t data1, uint8_t data2)
+{
+    int channel = status & 0x0F;
+    
+    switch (status & 0xF0)
+    {
+        case 0x90:
+            if (data2 > 0) tMPEPoly_noteOn(polyh, channel, data1, data2);
+            else tMPEPoly_noteOff(polyh, channel, data1);
+            break;
+        case 0x80:
+            tMPEPoly_noteOff(polyh, channel, data1);
+            break;
+        case 0xA0:
+            tMPEPoly_setNotePressure(polyh, channel, data1, data2);
+            break;
+        case 0xB0:
+            if (data1 == 74) tMPEPoly_setTimbre(polyh, channel, data2);
+            break;
+        case 0xD0:
+            tMPEPoly_setPressure(polyh, channel, data1);
+            break;
+        case 0xE0:
+            tMPEPoly_setPitchBend(polyh, channel, (data2 << 7) | data1);
+            break;
+        default:
+            break;
+    }
+}
+
+void tMPEPoly_tickBlock(tMPEPoly* const polyh, int numSamples)
+{
+    _tMPEPoly* poly = *polyh;
+    
+    Lfloat* values = poly->values;
+    Lfloat* targets = poly->targets;
+    Lfloat* incs = poly->incs;
+    Lfloat n = (Lfloat)numSamples;
+    int total = poly->maxNumVoices * MPEDimensionNil;
+    
+    // one linear ramp step per block for every voice and dimension, stopping at the target
+    for (int i = 0; i < total; i++)
+    {
+        Lfloat v = values[i] + incs[i] * n;
+        Lfloat t = targets[i];
+        values[i] = (incs[i] > 0.0f) ? (v < t ? v : t) : (v > t ? v : t);
+    }
+}
+
+void tMPEPoly_setMasterChannel(tMPEPoly* const polyh, int channel)
+{
+    _tMPEPoly* poly = *polyh;
+    poly->masterChannel = channel & 15;
+}
+
+void tMPEPoly_setPitchBendRange(tMPEPoly* const polyh, Lfloat memberSemitones, Lfloat masterSemitones)
+{
+    _tMPEPoly* poly = *polyh;
+    poly->memberBendRange = memberSemitones;
+    poly->masterBendRange = masterSemitones;
+}
+
+void tMPEPoly_setSmoothingTime(tMPEPoly* const polyh, Lfloat time)
+{
+    _tMPEPoly* poly = *polyh;
+    
+    Lfloat minimumTime = 1000.0f / poly->sampleRate;
+    poly->time = (time < minimumTime) ? minimumTime : time;
+    poly->factor = 1000.0f / (poly->time * poly->sampleRate);
+}
+
+Lfloat tMPEPoly_getPitch(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return tSimplePoly_getPitch(&poly->poly, voice) + poly->values[MPEPitchBend * poly->maxNumVoices + voice] + poly->masterBend;
+}
+
+Lfloat tMPEPoly_getPressure(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return poly->values[MPEPressure * poly->maxNumVoices + voice];
+}
+
+Lfloat tMPEPoly_getTimbre(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return poly->values[MPETimbre * poly->maxNumVoices + voice];
+}
+
+Lfloat* tMPEPoly_getExpressionArray(tMPEPoly* const polyh, MPEDimension dimension)
+{
+    _tMPEPoly* poly = *polyh;
+    return &poly->values[dimension * poly->maxNumVoices];
+}
+
+int tMPEPoly_getKey(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return tSimplePoly_getPitchAndCheckActive(&poly->poly, voice);
+}
+
+int tMPEPoly_getVelocity(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return tSimplePoly_getVelocity(&poly->poly, voice);
+}
+
+int tMPEPoly_getChannel(tMPEPoly* const polyh, int voice)
+{
+    _tMPEPoly* poly = *polyh;
+    return poly->voiceChannels[voice];
+}
+
+void tMPEPoly_setSampleRate(tMPEPoly* const polyh, Lfloat sr)
+{
+    _tMPEPoly* poly = *polyh;
+    poly->sampleRate = sr;
+    tMPEPoly_setSmoothingTime(polyh, poly->time);
+}
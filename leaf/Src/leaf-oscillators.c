@@ -58,17 +58,20 @@ void    tCycle_initToPool   (tCycle* const cy, tMempool* const mp)
     _tCycle* c = *cy = (_tCycle*) mpool_alloc(sizeof(_tCycle), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tCycle_setSampleRate, NULL);
     
     c->inc      =  0;
     c->phase    =  0;
     c->invSampleRateTimesTwoTo32 = (leaf->invSampleRate * TWO_TO_32);
     c->mask = SINE_TABLE_SIZE - 1;
+    c->table = LEAF_getSineTable(leaf);
 }
 
 void    tCycle_free (tCycle* const cy)
 {
     _tCycle* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -87,9 +90,9 @@ Lfloat   tCycle_tick(tCycle* const cy)
     idx = c->phase >> 21; //11 bit table 
     tempFrac = (c->phase & 2097151u); //(2^21 - 1) all the lower bits i.e. the remainder of a division by 2^21  (2097151 is the 21 bits after the 11 bits that represent the main index)
     
-    samp0 = __leaf_table_sinewave[idx];
+    samp0 = c->table[idx];
     idx = (idx + 1) & c->mask;
-    samp1 = __leaf_table_sinewave[idx];
+    samp1 = c->table[idx];
     
     return (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f)); // 1/2097151 
 }
@@ -136,12 +139,14 @@ void    tTriangle_initToPool    (tTriangle* const cy, tMempool* const mp)
     _tTriangle* c = *cy = (_tTriangle*) mpool_alloc(sizeof(_tTriangle), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tTriangle_setSampleRate, NULL);
     
     c->inc      =  0;
     c->phase    =  0;
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = (c->invSampleRate * TWO_TO_32);
     c->mask = TRI_TABLE_SIZE - 1;
+    c->table = (const Lfloat (*)[TRI_TABLE_SIZE]) LEAF_getTriangleTable(leaf);
     tTriangle_setFreq(cy, 220);
 }
 
@@ -149,6 +154,7 @@ void    tTriangle_free  (tTriangle* const cy)
 {
     _tTriangle* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -169,12 +175,12 @@ Lfloat   tTriangle_tick(tTriangle* const cy)
     uint32_t tempFrac = (c->phase & 2097151);
     frac = (Lfloat)tempFrac * 0.000000476837386f;// 1/2097151 (2097151 is the 21 bits after the 11 bits that represent the main index)
     
-    samp0 = __leaf_table_triangle[c->oct][idx];
-    samp1 = __leaf_table_triangle[c->oct][idx2];
+    samp0 = c->table[c->oct][idx];
+    samp1 = c->table[c->oct][idx2];
     Lfloat oct0 = (samp0 + (samp1 - samp0) * frac);
     
-    samp0 = __leaf_table_triangle[c->oct+1][idx];
-    samp1 = __leaf_table_triangle[c->oct+1][idx2];
+    samp0 = c->table[c->oct+1][idx];
+    samp1 = c->table[c->oct+1][idx2];
     Lfloat oct1 = (samp0 + (samp1 - samp0) * frac);
     
     return oct0 + (oct1 - oct0) * c->w;
@@ -230,12 +236,14 @@ void    tSquare_initToPool  (tSquare* const cy, tMempool* const mp)
     _tSquare* c = *cy = (_tSquare*) mpool_alloc(sizeof(_tSquare), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSquare_setSampleRate, NULL);
     
     c->inc      =  0;
     c->phase    =  0;
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = (c->invSampleRate * TWO_TO_32);
     c->mask = SQR_TABLE_SIZE - 1;
+    c->table = (const Lfloat (*)[SQR_TABLE_SIZE]) LEAF_getSquareTable(leaf);
     tSquare_setFreq(cy, 220);
 }
 
@@ -243,6 +251,7 @@ void    tSquare_free (tSquare* const cy)
 {
     _tSquare* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -263,12 +272,12 @@ Lfloat   tSquare_tick(tSquare* const cy)
     uint32_t tempFrac = (c->phase & 2097151);
     frac = (Lfloat)tempFrac * 0.000000476837386f;// 1/2097151 (2097151 is the 21 bits after the 11 bits that represent the main index)
     
-    samp0 = __leaf_table_squarewave[c->oct][idx];
-    samp1 = __leaf_table_squarewave[c->oct][idx2];
+    samp0 = c->table[c->oct][idx];
+    samp1 = c->table[c->oct][idx2];
     Lfloat oct0 = (samp0 + (samp1 - samp0) * frac);
     
-    samp0 = __leaf_table_squarewave[c->oct+1][idx];
-    samp1 = __leaf_table_squarewave[c->oct+1][idx2];
+    samp0 = c->table[c->oct+1][idx];
+    samp1 = c->table[c->oct+1][idx2];
     Lfloat oct1 = (samp0 + (samp1 - samp0) * frac);
     
     return oct0 + (oct1 - oct0) * c->w;
@@ -324,12 +333,14 @@ void    tSawtooth_initToPool    (tSawtooth* const cy, tMempool* const mp)
     _tSawtooth* c = *cy = (_tSawtooth*) mpool_alloc(sizeof(_tSawtooth), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSawtooth_setSampleRate, NULL);
     
     c->inc      = 0;
     c->phase    = 0;
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = (c->invSampleRate * TWO_TO_32);
     c->mask = SAW_TABLE_SIZE - 1;
+    c->table = (const Lfloat (*)[SAW_TABLE_SIZE]) LEAF_getSawtoothTable(leaf);
     tSawtooth_setFreq(cy, 220);
 }
 
@@ -337,6 +348,7 @@ void    tSawtooth_free (tSawtooth* const cy)
 {
     _tSawtooth* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -357,12 +369,12 @@ Lfloat   tSawtooth_tick(tSawtooth* const cy)
     uint32_t tempFrac = (c->phase & 2097151);
     frac = (Lfloat)tempFrac * 0.000000476837386f; // 1/2097151 (2097151 is the 21 bits after the 11 bits that represent the main index)
     
-    samp0 = __leaf_table_sawtooth[c->oct][idx];
-    samp1 = __leaf_table_sawtooth[c->oct][idx2];
+    samp0 = c->table[c->oct][idx];
+    samp1 = c->table[c->oct][idx2];
     Lfloat oct0 = (samp0 + (samp1 - samp0) * frac);
     
-    samp0 = __leaf_table_sawtooth[c->oct+1][idx];
-    samp1 = __leaf_table_sawtooth[c->oct+1][idx2];
+    samp0 = c->table[c->oct+1][idx];
+    samp1 = c->table[c->oct+1][idx2];
     Lfloat oct1 = (samp0 + (samp1 - samp0) * frac);
     
     
@@ -420,6 +432,7 @@ void    tPBTriangle_initToPool    (tPBTriangle* const osc, tMempool* const mp)
     _tPBTriangle* c = *osc = (_tPBTriangle*) mpool_alloc(sizeof(_tPBTriangle), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPBTriangle_setSampleRate, NULL);
 
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
@@ -434,6 +447,7 @@ void    tPBTriangle_free (tPBTriangle* const cy)
 {
     _tPBTriangle* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -519,6 +533,7 @@ void    tPBSineTriangle_initToPool    (tPBSineTriangle* const osc, tMempool* con
     _tPBSineTriangle* c = *osc = (_tPBSineTriangle*) mpool_alloc(sizeof(_tPBSineTriangle), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPBSineTriangle_setSampleRate, NULL);
     tCycle_initToPool(&c->sine, mp);
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
@@ -533,6 +548,7 @@ void    tPBSineTriangle_free (tPBSineTriangle* const cy)
 {
     _tPBSineTriangle* c = *cy;
     tCycle_free(&c->sine);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -611,6 +627,7 @@ void    tPBPulse_initToPool  (tPBPulse* const osc, tMempool* const mp)
     _tPBPulse* c = *osc = (_tPBPulse*) mpool_alloc(sizeof(_tPBPulse), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPBPulse_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
@@ -625,6 +642,7 @@ void    tPBPulse_free (tPBPulse* const osc)
 {
     _tPBPulse* c = *osc;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -702,6 +720,7 @@ void    tPBSaw_initToPool    (tPBSaw* const osc, tMempool* const mp)
     _tPBSaw* c = *osc = (_tPBSaw*) mpool_alloc(sizeof(_tPBSaw), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPBSaw_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
@@ -714,6 +733,7 @@ void    tPBSaw_free  (tPBSaw* const osc)
 {
     _tPBSaw* c = *osc;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -754,6 +774,75 @@ void    tPBSaw_setSampleRate (tPBSaw* const osc, Lfloat sr)
     tPBSaw_setFreq(osc, c->freq);
 }
 
+#ifdef SIMD_64
+/* tPolyPBSaw: tPBSaw with one voice per lane. The phase is kept as a 0-1
+ * float instead of a wrapping integer so the whole tick stays in vector lanes. */
+void    tPolyPBSaw_init          (tPolyPBSaw* const osc, LEAF* const leaf)
+{
+    tPolyPBSaw_initToPool(osc, &leaf->mempool);
+}
+
+void    tPolyPBSaw_initToPool    (tPolyPBSaw* const osc, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tPolyPBSaw* c = *osc = (_tPolyPBSaw*) mpool_calloc(sizeof(_tPolyPBSaw), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPolyPBSaw_setSampleRate, NULL);
+    
+    c->invSampleRate = leaf->invSampleRate;
+}
+
+void    tPolyPBSaw_free  (tPolyPBSaw* const osc)
+{
+    _tPolyPBSaw* c = *osc;
+    
+    LEAF_unregisterObject(c->mempool, &c->node);
+    mpool_free((char*)c, c->mempool);
+}
+
+poly_float tPolyPBSaw_tick        (tPolyPBSaw* const osc)
+{
+    _tPolyPBSaw* c = *osc;
+    poly_float phase = poly_load(c->phase);
+    poly_float inc = poly_load(c->inc);
+    
+    poly_float out = poly_sub(poly_add(phase, phase), poly_set1(1.0f));
+    out = poly_sub(out, poly_blep(phase, inc));
+    
+    phase = poly_add(phase, inc);
+    phase = poly_sub(phase, poly_trunc(phase));
+    phase = poly_select(poly_lt(phase, poly_set1(0.0f)), poly_add(phase, poly_set1(1.0f)), phase);
+    poly_store(c->phase, phase);
+    
+    return poly_sub(poly_set1(0.0f), out);
+}
+
+void    tPolyPBSaw_setFreq       (tPolyPBSaw* const osc, int voice, Lfloat freq)
+{
+    _tPolyPBSaw* c = *osc;
+    
+    c->freq[voice] = freq;
+    c->inc[voice] = freq * c->invSampleRate;
+}
+
+void    tPolyPBSaw_setFreqs      (tPolyPBSaw* const osc, poly_float freqs)
+{
+    _tPolyPBSaw* c = *osc;
+    
+    poly_store(c->freq, freqs);
+    poly_store(c->inc, poly_mul(freqs, poly_set1(c->invSampleRate)));
+}
+
+void    tPolyPBSaw_setSampleRate (tPolyPBSaw* const osc, Lfloat sr)
+{
+    _tPolyPBSaw* c = *osc;
+    
+    c->invSampleRate = 1.0f/sr;
+    tPolyPBSaw_setFreqs(osc, poly_load(c->freq));
+}
+#endif // SIMD_64
+
 //========================================================================
 
 
@@ -769,6 +858,7 @@ void    tPBSawSquare_initToPool    (tPBSawSquare* const osc, tMempool* const mp)
     _tPBSawSquare* c = *osc = (_tPBSawSquare*) mpool_alloc(sizeof(_tPBSawSquare), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tPBSawSquare_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
@@ -782,6 +872,7 @@ void    tPBSawSquare_free  (tPBSawSquare* const osc)
 {
     _tPBSawSquare* c = *osc;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -863,6 +954,7 @@ void    tSawOS_initToPool    (tSawOS* const osc, uint8_t OS_ratio, uint8_t filte
     _tSawOS* c = *osc = (_tSawOS*) mpool_alloc(sizeof(_tSawOS), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSawOS_setSampleRate, NULL);
     c->OSratio = OS_ratio;
     c->inc      = 0;
     c->phase    = 0;
@@ -885,6 +977,7 @@ void    tSawOS_free  (tSawOS* const osc)
     _tSawOS* c = *osc;
     for (int i = 0; i < c->filterOrder; ++i) tSVF_free(&c->aaFilter[i]);
     mpool_free((char*)c->aaFilter, c->mempool);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -936,6 +1029,7 @@ void    tPhasor_initToPool  (tPhasor* const ph, tMempool* const mp)
     _tPhasor* p = *ph = (_tPhasor*) mpool_alloc(sizeof(_tPhasor), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tPhasor_setSampleRate, NULL);
     
     p->phase = 0;
     p->inc = 0;
@@ -947,6 +1041,7 @@ void    tPhasor_free (tPhasor* const ph)
 {
     _tPhasor* p = *ph;
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -1035,6 +1130,7 @@ void tNeuron_initToPool  (tNeuron* const nr, tMempool* const mp)
     _tNeuron* n = *nr = (_tNeuron*) mpool_alloc(sizeof(_tNeuron), m);
     n->mempool = m;
     LEAF* leaf = n->mempool->leaf;
+    LEAF_registerObject(n->mempool, &n->node, n, (LEAFSampleRateFunc) tNeuron_setSampleRate, NULL);
 
     tPoleZero_initToPool(&n->f, mp);
     
@@ -1069,6 +1165,7 @@ void    tNeuron_free (tNeuron* const nr)
     _tNeuron* n = *nr;
     
     tPoleZero_free(&n->f);
+    LEAF_unregisterObject(n->mempool, &n->node);
     mpool_free((char*)n, n->mempool);
 }
 
@@ -1248,6 +1345,60 @@ void tNeuron_setSampleRate (tNeuron* const nr, Lfloat sr)
 
 //----------------------------------------------------------------------------------------------------------
 
+// Helpers for the minBLEP oscillators' block renderers. Each BLEP in the ring is a table
+// index plus {r, scale} (and a step/slope flag for tMBTriangle), laid out with the given stride.
+// mb_addBLEPs adds up to size samples of count BLEPs, newest first from slot first, into out
+// and advances their table positions past the samples it rendered.
+static void mb_addBLEPs(Lfloat* out, int size, uint16_t* indices, Lfloat* props, int stride,
+                        int first, int count, int maxStep, int maxSlope)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int which = (first - i) & 63;
+        Lfloat* prop = &props[which * stride];
+        Lfloat r = prop[0];
+        Lfloat scale = prop[1];
+        int slope = (stride > 2) && (prop[2] >= 0.5f);
+        int index = indices[which];
+        int n = ((slope ? maxSlope : maxStep) - index + MINBLEP_PHASE_MASK) / MINBLEP_PHASES;
+        if (n > size) n = size;
+        if (n <= 0) continue;
+
+        if (slope)
+        {
+            for (int m = 0; m < n; m++)
+            {
+                const Lfloat* t = &slope_dd_table[index + m * MINBLEP_PHASES];
+                out[m] += scale * (t[0] + r * (t[1] - t[0]));
+            }
+        }
+        else
+        {
+            for (int m = 0; m < n; m++)
+            {
+                const Lfloat_value_delta* t = &step_dd_table[index + m * MINBLEP_PHASES];
+                out[m] += scale * (t->value + r * t->delta);
+            }
+        }
+        indices[which] = index + n * MINBLEP_PHASES;
+    }
+}
+
+// BLEPs finish in the order they were placed, so the ones still running after a block are
+// the unbroken run of unfinished ones counting back from the most recent.
+static int mb_countBLEPs(const uint16_t* indices, const Lfloat* props, int stride,
+                         int first, int count, int maxStep, int maxSlope)
+{
+    int i;
+    for (i = 0; i < count; i++)
+    {
+        int which = (first - i) & 63;
+        int slope = (stride > 2) && (props[which * stride + 2] >= 0.5f);
+        if (indices[which] >= (slope ? maxSlope : maxStep)) break;
+    }
+    return i;
+}
+
 void tMBPulse_init(tMBPulse* const osc, LEAF* const leaf)
 {
     tMBPulse_initToPool(osc, &leaf->mempool);
@@ -1259,6 +1410,7 @@ void tMBPulse_initToPool(tMBPulse* const osc, tMempool* const pool)
     _tMBPulse* c = *osc = (_tMBPulse*) mpool_alloc(sizeof(_tMBPulse), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tMBPulse_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     
@@ -1287,6 +1439,7 @@ void tMBPulse_initToPool(tMBPulse* const osc, tMempool* const pool)
 void tMBPulse_free(tMBPulse* const osc)
 {
     _tMBPulse* c = *osc;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -1312,13 +1465,15 @@ void tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phas
 }
 
 
-Lfloat tMBPulse_tick(tMBPulse* const osc)
+// Advance the phase by one sample, placing a BLEP for each discontinuity crossed, and
+// return the naive waveform value. Shared by tMBPulse_tick and tMBPulse_tickBlock.
+static inline Lfloat tMBPulse_advance(tMBPulse* const osc)
 {
     _tMBPulse* c = *osc;
     
     int    j, k;
     Lfloat  sync;
-    Lfloat  b, p, w, x, z, sw;
+    Lfloat  b, p, w, x, sw;
     
     sync = c->sync;
 
@@ -1327,7 +1482,6 @@ Lfloat tMBPulse_tick(tMBPulse* const osc)
     w = c->_w;  /* phase increment */
     b = c->_b;  /* duty cycle (0, 1) */
     x = c->_x;  /* temporary output variable */
-    z = c->_z;  /* low pass filter state */
     j = c->_j;  /* index into buffer _f */
     k = c->_k;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
 
@@ -1496,6 +1650,23 @@ Lfloat tMBPulse_tick(tMBPulse* const osc)
         }
     }
 
+    c->_p = p;
+    c->_w = w;
+    c->_b = b;
+    c->_x = x;
+    c->_k = k;
+
+    return x;
+}
+
+Lfloat tMBPulse_tick(tMBPulse* const osc)
+{
+    _tMBPulse* c = *osc;
+    
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    Lfloat  x = tMBPulse_advance(osc);
+
     int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
     
     c->_f[currentSamp] = x;
@@ -1524,17 +1695,56 @@ Lfloat tMBPulse_tick(tMBPulse* const osc)
 
     j = (j+1) & 7;
 
-    c->_p = p;
-    c->_w = w;
-    c->_b = b;
-    c->_x = x;
     c->_z = z;
     c->_j = j;
-    c->_k = k;
     
     return -c->out;
 }
 
+void tMBPulse_tickBlock(tMBPulse* const osc, Lfloat* out, int size)
+{
+    _tMBPulse* c = *osc;
+
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    int    n, total = c->numBLEPs;
+
+    // the first DD_SAMPLE_DELAY naive samples were stored by earlier ticks
+    for (n = 0; n < size; n++)
+        out[n] = (n < DD_SAMPLE_DELAY) ? c->_f[(j + n) & 7] : 0.0f;
+
+    // BLEPs still running from before this block
+    mb_addBLEPs(out, size, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, c->numBLEPs, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        uint16_t last = c->mostRecentBLEP;
+        Lfloat x = tMBPulse_advance(osc);
+        int placed = (c->mostRecentBLEP - last) & 63;
+
+        if (placed > 0)
+        {
+            mb_addBLEPs(out + n, size - n, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, placed, c->maxBLEPphase, c->maxBLEPphase);
+            total += placed;
+        }
+
+        if (n + DD_SAMPLE_DELAY < size) out[n + DD_SAMPLE_DELAY] += x;
+        else c->_f[(j + n + DD_SAMPLE_DELAY) & 7] = x;
+    }
+
+    c->numBLEPs = mb_countBLEPs(c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, total < 63 ? total : 63, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        z += 0.5f * (out[n] - z); // LP filtering
+        out[n] = -z;
+    }
+
+    c->out = z;
+    c->_z = z;
+    c->_j = (j + size) & 7;
+}
+
 void tMBPulse_setFreq(tMBPulse* const osc, Lfloat f)
 {
     _tMBPulse* c = *osc;
@@ -1606,6 +1816,7 @@ void tMBTriangle_initToPool(tMBTriangle* const osc, tMempool* const pool)
     _tMBTriangle* c = *osc = (_tMBTriangle*) mpool_alloc(sizeof(_tMBTriangle), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tMBTriangle_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     c->freq = 440.f;
@@ -1632,6 +1843,7 @@ void tMBTriangle_initToPool(tMBTriangle* const osc, tMempool* const pool)
 void tMBTriangle_free(tMBTriangle* const osc)
 {
     _tMBTriangle* c = *osc;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -1658,13 +1870,15 @@ void tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat pha
     c->numBLEPs = (c->numBLEPs + 1) & 63;
 }
 
-Lfloat tMBTriangle_tick(tMBTriangle* const osc)
+// Advance the phase by one sample, placing a BLEP for each discontinuity crossed, and
+// return the naive waveform value. Shared by tMBTriangle_tick and tMBTriangle_tickBlock.
+static inline Lfloat tMBTriangle_advance(tMBTriangle* const osc)
 {
     _tMBTriangle* c = *osc;
     
     int    j, k;
     Lfloat  sync;
-    Lfloat  b, b1, invB, invB1, p, w, sw, z;
+    Lfloat  b, b1, invB, invB1, p, w, sw;
     Lfloat  x = 0.5f;
     
     sync = c->sync;
@@ -1673,7 +1887,6 @@ Lfloat tMBTriangle_tick(tMBTriangle* const osc)
     w = c->_w;  /* phase increment */
     b = c->_b;  /* duty cycle (0, 1) */
     invB = 1.0f / b;
-    z = c->_z;  /* low pass filter state */
     j = c->_j;  /* index into buffer _f */
     k = c->_k;  /* output state, 0 = positive slope, 1 = negative slope */
     
@@ -1850,6 +2063,22 @@ Lfloat tMBTriangle_tick(tMBTriangle* const osc)
             }
         }
     }
+    c->_p = p;
+    c->_w = w;
+    c->_b = b;
+    c->_k = k;
+
+    return x;
+}
+
+Lfloat tMBTriangle_tick(tMBTriangle* const osc)
+{
+    _tMBTriangle* c = *osc;
+    
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    Lfloat  x = tMBTriangle_advance(osc);
+
     int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
     
     c->_f[currentSamp] = x;
@@ -1889,16 +2118,56 @@ Lfloat tMBTriangle_tick(tMBTriangle* const osc)
     z += 0.5f * (c->_f[j] - z);
     c->out = z;
     j = (j+1) & 7;
-    c->_p = p;
-    c->_w = w;
-    c->_b = b;
     c->_z = z;
     c->_j = j;
-    c->_k = k;
     
     return -c->out;
 }
 
+void tMBTriangle_tickBlock(tMBTriangle* const osc, Lfloat* out, int size)
+{
+    _tMBTriangle* c = *osc;
+
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    int    n, total = c->numBLEPs;
+
+    // the first DD_SAMPLE_DELAY naive samples were stored by earlier ticks
+    for (n = 0; n < size; n++)
+        out[n] = (n < DD_SAMPLE_DELAY) ? c->_f[(j + n) & 7] : 0.0f;
+
+    // BLEPs still running from before this block
+    mb_addBLEPs(out, size, c->BLEPindices, &c->BLEPproperties[0][0], 3, c->mostRecentBLEP, c->numBLEPs, c->maxBLEPphase, c->maxBLEPphaseSlope);
+
+    for (n = 0; n < size; n++)
+    {
+        uint16_t last = c->mostRecentBLEP;
+        Lfloat x = tMBTriangle_advance(osc);
+        int placed = (c->mostRecentBLEP - last) & 63;
+
+        if (placed > 0)
+        {
+            mb_addBLEPs(out + n, size - n, c->BLEPindices, &c->BLEPproperties[0][0], 3, c->mostRecentBLEP, placed, c->maxBLEPphase, c->maxBLEPphaseSlope);
+            total += placed;
+        }
+
+        if (n + DD_SAMPLE_DELAY < size) out[n + DD_SAMPLE_DELAY] += x;
+        else c->_f[(j + n + DD_SAMPLE_DELAY) & 7] = x;
+    }
+
+    c->numBLEPs = mb_countBLEPs(c->BLEPindices, &c->BLEPproperties[0][0], 3, c->mostRecentBLEP, total < 63 ? total : 63, c->maxBLEPphase, c->maxBLEPphaseSlope);
+
+    for (n = 0; n < size; n++)
+    {
+        z += 0.5f * (out[n] - z); // LP filtering
+        out[n] = -z;
+    }
+
+    c->out = z;
+    c->_z = z;
+    c->_j = (j + size) & 7;
+}
+
 void tMBTriangle_setFreq(tMBTriangle* const osc, Lfloat f)
 {
     _tMBTriangle* c = *osc;
@@ -1972,6 +2241,7 @@ void tMBSineTri_initToPool(tMBSineTri* const osc, tMempool* const pool)
     _tMBSineTri* c = *osc = (_tMBSineTri*) mpool_alloc(sizeof(_tMBSineTri), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tMBSineTri_setSampleRate, NULL);
 
     c->invSampleRate = leaf->invSampleRate;
     c->freq = 440.f;
@@ -1994,6 +2264,7 @@ void tMBSineTri_initToPool(tMBSineTri* const osc, tMempool* const pool)
     c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
     c->maxBLEPphaseSlope = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH;
     c->sineMask = 2047;
+    c->sineTable = LEAF_getSineTable(leaf);
     memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
     memset (c->_f, 0, 8 * sizeof (Lfloat));
 }
@@ -2001,6 +2272,7 @@ void tMBSineTri_initToPool(tMBSineTri* const osc, tMempool* const pool)
 void tMBSineTri_free(tMBSineTri* const osc)
 {
     _tMBSineTri* c = *osc;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -2252,9 +2524,9 @@ Lfloat tMBSineTri_tick(tMBSineTri* const osc)
     Lfloat tempPhase = (sinPhase * 2048.0f);
     idx = (uint32_t)tempPhase; //11 bit table
     tempFrac = tempPhase - idx;
-    samp0 = __leaf_table_sinewave[idx];
+    samp0 = c->sineTable[idx];
     idx = (idx + 1) & c->sineMask;
-    samp1 = __leaf_table_sinewave[idx];
+    samp1 = c->sineTable[idx];
 
     Lfloat sinOut = (samp0 + (samp1 - samp0) * tempFrac) * 0.5f; // 1/2097151
 
@@ -2385,6 +2657,7 @@ void tMBSaw_initToPool(tMBSaw* const osc, tMempool* const pool)
     _tMBSaw* c = *osc = (_tMBSaw*) mpool_alloc(sizeof(_tMBSaw), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tMBSaw_setSampleRate, NULL);
     
     c->invSampleRate = leaf->invSampleRate;
     c->freq = 440.f;
@@ -2407,6 +2680,7 @@ void tMBSaw_initToPool(tMBSaw* const osc, tMempool* const pool)
 void tMBSaw_free(tMBSaw* const osc)
 {
     _tMBSaw* c = *osc;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -2434,19 +2708,20 @@ void tMBSaw_place_step_dd_noBuffer(tMBSaw* const osc, int index, Lfloat phase, L
 
 
 
-Lfloat tMBSaw_tick(tMBSaw* const osc)
+// Advance the phase by one sample, placing a BLEP for each discontinuity crossed, and
+// return the naive waveform value. Shared by tMBSaw_tick and tMBSaw_tickBlock.
+static inline Lfloat tMBSaw_advance(tMBSaw* const osc)
 {
     _tMBSaw* c = *osc;
 
     int    j;
     Lfloat  sync;
-    Lfloat  p, sw, z;
+    Lfloat  p, sw;
 
     sync = c->sync;
 
 
     p = c->_p;  /* phase [0, 1) */
-    z = c->_z;  /* low pass filter state */
     j = c->_j;  /* index into buffer _f */
 
 
@@ -2501,11 +2776,24 @@ Lfloat tMBSaw_tick(tMBSaw* const osc)
         tMBSaw_place_step_dd_noBuffer(osc, j, 1.0f - p, -inv_sw, -1.0f);
     }
 
+    c->_p = p;
+
+    return 0.5f - p;
+}
+
+Lfloat tMBSaw_tick(tMBSaw* const osc)
+{
+    _tMBSaw* c = *osc;
+
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    Lfloat  x = tMBSaw_advance(osc);
+
     //construct the current output sample based on the state of the active BLEPs
 
     int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
 
-    c->_f[currentSamp] = 0.5f - p;
+    c->_f[currentSamp] = x;
 
     volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
     for (int i = 0; i < numBLEPsAtLoopStart; i++)
@@ -2530,7 +2818,6 @@ Lfloat tMBSaw_tick(tMBSaw* const osc)
     c->out = z;
     j = (j+1) & 7; //don't need 128 sample buffer just for lowpass, so only using the first 16 values before wrapping around (probably only need 4 or 8)
 
-    c->_p = p;
     c->_z = z;
     c->_j = j;
 
@@ -2538,6 +2825,50 @@ Lfloat tMBSaw_tick(tMBSaw* const osc)
     return -c->out;
 }
 
+void tMBSaw_tickBlock(tMBSaw* const osc, Lfloat* out, int size)
+{
+    _tMBSaw* c = *osc;
+
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    int    n, total = c->numBLEPs;
+
+    // the first DD_SAMPLE_DELAY naive samples were stored by earlier ticks
+    for (n = 0; n < size; n++)
+        out[n] = (n < DD_SAMPLE_DELAY) ? c->_f[(j + n) & 7] : 0.0f;
+
+    // BLEPs still running from before this block
+    mb_addBLEPs(out, size, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, c->numBLEPs, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        uint16_t last = c->mostRecentBLEP;
+        Lfloat x = tMBSaw_advance(osc);
+        int placed = (c->mostRecentBLEP - last) & 63;
+
+        if (placed > 0)
+        {
+            mb_addBLEPs(out + n, size - n, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, placed, c->maxBLEPphase, c->maxBLEPphase);
+            total += placed;
+        }
+
+        if (n + DD_SAMPLE_DELAY < size) out[n + DD_SAMPLE_DELAY] += x;
+        else c->_f[(j + n + DD_SAMPLE_DELAY) & 7] = x;
+    }
+
+    c->numBLEPs = mb_countBLEPs(c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, total < 63 ? total : 63, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        z += 0.5f * (out[n] - z); // LP filtering
+        out[n] = -z;
+    }
+
+    c->out = z;
+    c->_z = z;
+    c->_j = (j + size) & 7;
+}
+
 void tMBSaw_setFreq(tMBSaw* const osc, Lfloat f)
 {
     _tMBSaw* c = *osc;
@@ -2603,6 +2934,7 @@ void tMBSawPulse_initToPool(tMBSawPulse* const osc, tMempool* const pool)
     _tMBSawPulse* c = *osc = (_tMBSawPulse*) mpool_alloc(sizeof(_tMBSawPulse), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tMBSawPulse_setSampleRate, NULL);
     c->gain = 1.0f;
     c->active = 1;
     c->invSampleRate = leaf->invSampleRate;
@@ -2631,6 +2963,7 @@ void tMBSawPulse_initToPool(tMBSawPulse* const osc, tMempool* const pool)
 void tMBSawPulse_free(tMBSawPulse* const osc)
 {
     _tMBSawPulse* c = *osc;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -2663,16 +2996,14 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloa
 
 
 
-#ifdef ITCMRAM
-Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_tick(tMBSawPulse* const osc)
-#else
-Lfloat tMBSawPulse_tick(tMBSawPulse* const osc)
-#endif
+// Advance the phase by one sample, placing a BLEP for each discontinuity crossed, and
+// return the naive waveform value. Shared by tMBSawPulse_tick and tMBSawPulse_tickBlock.
+static inline Lfloat tMBSawPulse_advance(tMBSawPulse* const osc)
 {
     _tMBSawPulse* c = *osc;
     int    j, k;
     Lfloat  sync;
-    Lfloat  b, p, w, x, z, sw;
+    Lfloat  b, p, w, x, sw;
     Lfloat shape = c->shape;
     Lfloat sawShape = 1.0f - c->shape;
     sync = c->sync;
@@ -2680,7 +3011,6 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const osc)
     w = c->_w;  /* phase increment */
     b = c->_b;  /* duty cycle (0, 1) */
     x = c->_x;  /* temporary output variable */
-    z = c->_z;  /* low pass filter state */
     j = c->_j;  /* index into buffer _f */
     k = c->_k;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
 
@@ -2872,10 +3202,27 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const osc)
 			}
 		}
 	}
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
-    c->_f[currentSamp] = ((0.5f - p) * sawShape); //saw
+    c->_p = p;
+    c->_w = w;
+    c->_b = b;
+    c->_x = x;
+    c->_k = k;
 
-    c->_f[currentSamp] += (x * shape);//pulse
+    return ((0.5f - p) * sawShape) + (x * shape); //saw plus pulse
+}
+
+#ifdef ITCMRAM
+Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_tick(tMBSawPulse* const osc)
+#else
+Lfloat tMBSawPulse_tick(tMBSawPulse* const osc)
+#endif
+{
+    _tMBSawPulse* c = *osc;
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+
+    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+    c->_f[currentSamp] = tMBSawPulse_advance(osc); //saw and pulse
 
     volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
     for (int i = 0; i < numBLEPsAtLoopStart; i++)
@@ -2901,16 +3248,59 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const osc)
     c->out = z;
     j = (j+1) & 7;
 
-    c->_p = p;
-    c->_w = w;
-    c->_b = b;
-    c->_x = x;
     c->_z = z;
     c->_j = j;
-    c->_k = k;
 
     return -c->out * c->gain;
 }
+
+#ifdef ITCMRAM
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_tickBlock(tMBSawPulse* const osc, Lfloat* out, int size)
+#else
+void tMBSawPulse_tickBlock(tMBSawPulse* const osc, Lfloat* out, int size)
+#endif
+{
+    _tMBSawPulse* c = *osc;
+
+    int    j = c->_j;  /* index into buffer _f */
+    Lfloat  z = c->_z;  /* low pass filter state */
+    int    n, total = c->numBLEPs;
+
+    // the first DD_SAMPLE_DELAY naive samples were stored by earlier ticks
+    for (n = 0; n < size; n++)
+        out[n] = (n < DD_SAMPLE_DELAY) ? c->_f[(j + n) & 7] : 0.0f;
+
+    // BLEPs still running from before this block
+    mb_addBLEPs(out, size, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, c->numBLEPs, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        uint16_t last = c->mostRecentBLEP;
+        Lfloat x = tMBSawPulse_advance(osc);
+        int placed = (c->mostRecentBLEP - last) & 63;
+
+        if (placed > 0)
+        {
+            mb_addBLEPs(out + n, size - n, c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, placed, c->maxBLEPphase, c->maxBLEPphase);
+            total += placed;
+        }
+
+        if (n + DD_SAMPLE_DELAY < size) out[n + DD_SAMPLE_DELAY] += x;
+        else c->_f[(j + n + DD_SAMPLE_DELAY) & 7] = x;
+    }
+
+    c->numBLEPs = mb_countBLEPs(c->BLEPindices, &c->BLEPproperties[0][0], 2, c->mostRecentBLEP, total < 63 ? total : 63, c->maxBLEPphase, c->maxBLEPphase);
+
+    for (n = 0; n < size; n++)
+    {
+        z += 0.5f * (out[n] - z); // LP filtering
+        out[n] = -z * c->gain;
+    }
+
+    c->out = z;
+    c->_z = z;
+    c->_j = (j + size) & 7;
+}
 #ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tMBSawPulse_setFreq(tMBSawPulse* const osc, Lfloat f)
 #else
@@ -2998,6 +3388,7 @@ void    tTable_initToPool(tTable* const cy, Lfloat* waveTable, int size, tMempoo
     _tTable* c = *cy = (_tTable*)mpool_alloc(sizeof(_tTable), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tTable_setSampleRate, NULL);
     
     c->waveTable = waveTable;
     c->size = size;
@@ -3010,6 +3401,7 @@ void    tTable_free(tTable* const cy)
 {
     _tTable* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3057,6 +3449,21 @@ void     tTable_setSampleRate(tTable* const cy, Lfloat sr)
     tTable_setFreq(cy, c->freq);
 }
 
+// The number of tables a wavetable builds at a sample rate: the fundamental, one
+// more for extra anti-aliasing, and one per octave from the base frequency up to maxFreq.
+// The oscillators use this too, as LEAF_setSampleRate() can reach them before their tables.
+static int waveTableNumTables(Lfloat sampleRate, int size, Lfloat maxFreq)
+{
+    int numTables = 2;
+    Lfloat f = sampleRate / (Lfloat) size;
+    while (f < maxFreq)
+    {
+        numTables++;
+        f *= 2.0f; // pass this multiplier in to set spacing of tables? would need to change setFreq too
+    }
+    return numTables;
+}
+
 void tWaveTable_init(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
 {
     tWaveTable_initToPool(cy, table, size, maxFreq, &leaf->mempool);
@@ -3068,6 +3475,7 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
     _tWaveTable* c = *cy = (_tWaveTable*) mpool_alloc(sizeof(_tWaveTable), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tWaveTable_setSampleRate, NULL);
     
     c->sampleRate = leaf->sampleRate;
     
@@ -3078,14 +3486,7 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
     c->invBaseFreq = 1.0f / c->baseFreq;
     
     // Determine how many tables we need
-    // Assume we need at least 2, the fundamental + one to account for setting extra anti aliasing
-    c->numTables = 2;
-    Lfloat f = c->baseFreq;
-    while (f < c->maxFreq)
-    {
-        c->numTables++;
-        f *= 2.0f; // pass this multiplier in to set spacing of tables? would need to change setFreq too
-    }
+    c->numTables = waveTableNumTables(c->sampleRate, size, c->maxFreq);
     
     c->size = size;
     c->sizeMask = size-1;
@@ -3105,7 +3506,7 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
     }
     
     // Make bandlimited copies
-    f = c->sampleRate * 0.25; //start at half nyquist
+    Lfloat f = c->sampleRate * 0.25; //start at half nyquist
     // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
     tButterworth_initToPool(&c->bl, 8, -1.0f, f, mp);
     for (int t = 1; t < c->numTables; ++t)
@@ -3136,6 +3537,7 @@ void tWaveTable_free(tWaveTable* const cy)
         mpool_free((char*)c->tables[t], c->mempool);
     }
     mpool_free((char*)c->tables, c->mempool);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3157,14 +3559,7 @@ void tWaveTable_setSampleRate(tWaveTable* const cy, Lfloat sr)
     c->invBaseFreq = 1.0f / c->baseFreq;
     
     // Determine how many tables we need
-    // Assume we need at least 2, the fundamental + one to account for setting extra anti aliasing
-    c->numTables = 2;
-    Lfloat f = c->baseFreq;
-    while (f < c->maxFreq)
-    {
-        c->numTables++;
-        f *= 2.0f; // pass this multiplier in to set spacing of tables? would need to change setFreq too
-    }
+    c->numTables = waveTableNumTables(c->sampleRate, c->size, c->maxFreq);
     
     // Allocate memory for the tables
     c->tables = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * c->numTables, c->mempool);
@@ -3175,7 +3570,7 @@ void tWaveTable_setSampleRate(tWaveTable* const cy, Lfloat sr)
     }
     
     // Make bandlimited copies
-    f = c->sampleRate * 0.25f; //start at half nyquist
+    Lfloat f = c->sampleRate * 0.25f; //start at half nyquist
     // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
     tButterworth_initToPool(&c->bl, 8, -1.0f, f, &c->mempool);
     tButterworth_setSampleRate(&c->bl, c->sampleRate);
@@ -3211,6 +3606,7 @@ void tWaveOsc_initToPool(tWaveOsc* const cy, tWaveTable* tables, int numTables,
     _tWaveOsc* c = *cy = (_tWaveOsc*) mpool_alloc(sizeof(_tWaveOsc), m);
 
     c->mempool = m;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tWaveOsc_setSampleRate, NULL);
 
     LEAF* leaf = c->mempool->leaf;
     c->tables =  tables;
@@ -3239,6 +3635,7 @@ void tWaveOsc_initToPool(tWaveOsc* const cy, tWaveTable* tables, int numTables,
 void tWaveOsc_free(tWaveOsc* const cy)
 {
     _tWaveOsc* c = *cy;
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3388,7 +3785,7 @@ void tWaveOsc_setSampleRate(tWaveOsc* const cy, Lfloat sr)
     // Determine base frequency
     c->baseFreq = c->sampleRate / (Lfloat) c->size;
     c->invBaseFreq = 1.0f / c->baseFreq;
-    c->numSubTables = c->tables[0]->numTables;
+    c->numSubTables = waveTableNumTables(sr, c->size, c->maxFreq);
     c->invSampleRateTimesTwoTo32 = 1.f/c->sampleRate * TWO_TO_32;
     
     tWaveOsc_setFreq(cy, c->freq);
@@ -3408,6 +3805,7 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
     _tWaveTableS* c = *cy = (_tWaveTableS*) mpool_alloc(sizeof(_tWaveTableS), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tWaveTableS_setSampleRate, NULL);
     
     c->sampleRate = leaf->sampleRate;
     
@@ -3418,13 +3816,7 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
     c->invBaseFreq = 1.0f / c->baseFreq;
     
     // Determine how many tables we need
-    c->numTables = 2;
-    Lfloat f = c->baseFreq;
-    while (f < maxFreq)
-    {
-        c->numTables++;
-        f *= 2.0f; // pass this multiplier in to set spacing of tables?
-    }
+    c->numTables = waveTableNumTables(c->sampleRate, size, c->maxFreq);
     
     // Allocate memory for the tables
     c->tables = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * c->numTables, c->mempool);
@@ -3448,7 +3840,7 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
     }
     
     // Make bandlimited copies
-    f = c->sampleRate * 0.25; //start at half nyquist
+    Lfloat f = c->sampleRate * 0.25; //start at half nyquist
     // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
     tButterworth_initToPool(&c->bl, 8, -1.0f, f, mp);
     tOversampler_initToPool(&c->ds, 2, 1, mp);
@@ -3497,6 +3889,7 @@ void    tWaveTableS_free(tWaveTableS* const cy)
     mpool_free((char*)c->tables, c->mempool);
     mpool_free((char*)c->sizes, c->mempool);
     mpool_free((char*)c->sizeMasks, c->mempool);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3521,13 +3914,7 @@ void    tWaveTableS_setSampleRate(tWaveTableS* const cy, Lfloat sr)
     c->invBaseFreq = 1.0f / c->baseFreq;
     
     // Determine how many tables we need
-    c->numTables = 2;
-    Lfloat f = c->baseFreq;
-    while (f < c->maxFreq)
-    {
-        c->numTables++;
-        f *= 2.0f; // pass this multiplier in to set spacing of tables?
-    }
+    c->numTables = waveTableNumTables(c->sampleRate, size, c->maxFreq);
     
     // Allocate memory for the tables
     c->tables = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * c->numTables, c->mempool);
@@ -3544,7 +3931,7 @@ void    tWaveTableS_setSampleRate(tWaveTableS* const cy, Lfloat sr)
     }
     
     // Make bandlimited copies
-    f = c->sampleRate * 0.25; //start at half nyquist
+    Lfloat f = c->sampleRate * 0.25; //start at half nyquist
     // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
     tButterworth_initToPool(&c->bl, 8, -1.0f, f, &c->mempool);
     tOversampler_initToPool(&c->ds, 2, 1, &c->mempool);
@@ -3595,6 +3982,7 @@ void tWaveOscS_initToPool(tWaveOscS* const cy, tWaveTableS* tables, int numTable
     _tWaveOscS* c = *cy = (_tWaveOscS*) mpool_alloc(sizeof(_tWaveOscS), m);
 
     c->mempool = m;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tWaveOscS_setSampleRate, NULL);
 
     LEAF* leaf = c->mempool->leaf;
     c->tables = tables;
@@ -3624,6 +4012,7 @@ void tWaveOscS_free(tWaveOscS* const cy)
 {
     _tWaveOscS* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3763,7 +4152,7 @@ void tWaveOscS_setSampleRate(tWaveOscS* const cy, Lfloat sr)
     // Determine base frequency
     c->baseFreq = c->sampleRate / (Lfloat) c->size;
     c->invBaseFreq = 1.0f / c->baseFreq;
-    c->numSubTables = c->tables[0]->numTables;
+    c->numSubTables = waveTableNumTables(sr, c->size, c->maxFreq);
     c->invSampleRateTimesTwoTo32 = (1.f/c->sampleRate) * TWO_TO_32;
     
     tWaveOscS_setFreq(cy, c->freq);
@@ -3791,6 +4180,7 @@ void    tIntPhasor_initToPool   (tIntPhasor* const cy, tMempool* const mp)
     _tIntPhasor* c = *cy = (_tIntPhasor*) mpool_alloc(sizeof(_tIntPhasor), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tIntPhasor_setSampleRate, NULL);
     
     c->phase    =  0;
     c->inc  = 0;
@@ -3801,6 +4191,7 @@ void    tIntPhasor_free (tIntPhasor* const cy)
 {
     _tIntPhasor* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3850,6 +4241,7 @@ void    tSquareLFO_initToPool   (tSquareLFO* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tSquareLFO* c = *cy = (_tSquareLFO*) mpool_alloc(sizeof(_tSquareLFO), m);
     c->mempool = m;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSquareLFO_setSampleRate, NULL);
     tIntPhasor_initToPool(&c->phasor,mp);
     tIntPhasor_initToPool(&c->invPhasor,mp); 
     tSquareLFO_setPulseWidth(cy, 0.5f);
@@ -3860,6 +4252,7 @@ void    tSquareLFO_free (tSquareLFO* const cy)
     _tSquareLFO* c = *cy;
     tIntPhasor_free(&c->phasor);
     tIntPhasor_free(&c->invPhasor);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -3916,6 +4309,7 @@ void    tSawSquareLFO_initToPool  (tSawSquareLFO* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tSawSquareLFO* c = *cy = (_tSawSquareLFO*) mpool_alloc(sizeof(_tSawSquareLFO), m);
     c->mempool = m;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSawSquareLFO_setSampleRate, NULL);
     tSquareLFO_initToPool(&c->square,mp);
     tIntPhasor_initToPool(&c->saw,mp); 
 }
@@ -3924,6 +4318,7 @@ void    tSawSquareLFO_free        (tSawSquareLFO* const cy)
     _tSawSquareLFO* c = *cy;
     tIntPhasor_free(&c->saw);
     tSquareLFO_free(&c->square);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
     
@@ -3975,6 +4370,7 @@ void    tTriLFO_initToPool   (tTriLFO* const cy, tMempool* const mp)
     _tTriLFO* c = *cy = (_tTriLFO*) mpool_alloc(sizeof(_tTriLFO), m);
     c->mempool = m;
     LEAF* leaf = c->mempool->leaf;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tTriLFO_setSampleRate, NULL);
     
     c->inc      =  0;
     c->phase    =  0;
@@ -3987,6 +4383,7 @@ void    tTriLFO_free (tTriLFO* const cy)
 {
     _tTriLFO* c = *cy;
     
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
 
@@ -4041,6 +4438,7 @@ void    tSineTriLFO_initToPool  (tSineTriLFO* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tSineTriLFO* c = *cy = (_tSineTriLFO*) mpool_alloc(sizeof(_tSineTriLFO), m);
     c->mempool = m;
+    LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tSineTriLFO_setSampleRate, NULL);
     tTriLFO_initToPool(&c->tri,mp);
     tCycle_initToPool(&c->sine,mp); 
    
@@ -4050,6 +4448,7 @@ void    tSineTriLFO_free        (tSineTriLFO* const cy)
     _tSineTriLFO* c = *cy;
     tCycle_free(&c->sine);
     tTriLFO_free(&c->tri);
+    LEAF_unregisterObject(c->mempool, &c->node);
     mpool_free((char*)c, c->mempool);
 }
     
@@ -4100,6 +4499,7 @@ void    tSineTriLFO_setPhase (tSineTriLFO* const cy, Lfloat phase)
      _tDampedOscillator* c = *cy = (_tDampedOscillator*) mpool_alloc(sizeof(_tDampedOscillator), m);
      c->mempool = m;
      LEAF* leaf = c->mempool->leaf;
+     LEAF_registerObject(c->mempool, &c->node, c, (LEAFSampleRateFunc) tDampedOscillator_setSampleRate, NULL);
 
 
      c->freq_ = 0.0f;
@@ -4116,6 +4516,7 @@ void    tSineTriLFO_setPhase (tSineTriLFO* const cy, Lfloat phase)
  {
 	 _tDampedOscillator* c = *cy;
 
+     LEAF_unregisterObject(c->mempool, &c->node);
      mpool_free((char*)c, c->mempool);
  }
 
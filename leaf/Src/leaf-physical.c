@@ -68,6 +68,7 @@ void    tPluck_initToPool    (tPluck* const pl, Lfloat lowestFrequency, tMempool
     _tPluck* p = *pl = (_tPluck*) mpool_alloc(sizeof(_tPluck), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tPluck_setSampleRate, NULL);
     
     p->sampleRate = leaf->sampleRate;
     
@@ -94,6 +95,7 @@ void    tPluck_free (tPluck* const pl)
     tOneZero_free(&p->loopFilter);
     tAllpassDelay_free(&p->delayLine);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -193,6 +195,7 @@ void    tKarplusStrong_initToPool   (tKarplusStrong* const pl, Lfloat lowestFreq
     _tKarplusStrong* p = *pl = (_tKarplusStrong*) mpool_alloc(sizeof(_tKarplusStrong), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tKarplusStrong_setSampleRate, NULL);
     
     p->sampleRate = leaf->sampleRate;
     
@@ -237,6 +240,7 @@ void    tKarplusStrong_free (tKarplusStrong* const pl)
         tBiQuad_free(&p->biquad[i]);
     }
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -425,6 +429,7 @@ void    tSimpleLivingString_initToPool  (tSimpleLivingString* const pl, Lfloat f
     _tSimpleLivingString* p = *pl = (_tSimpleLivingString*) mpool_alloc(sizeof(_tSimpleLivingString), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSimpleLivingString_setSampleRate, NULL);
     
     p->sampleRate = leaf->sampleRate;
     p->curr=0.0f;
@@ -449,6 +454,7 @@ void    tSimpleLivingString_free (tSimpleLivingString* const pl)
     tHighpass_free(&p->DCblocker);
     tFeedbackLeveler_free(&p->fbLev);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -556,6 +562,7 @@ void    tSimpleLivingString2_initToPool  (tSimpleLivingString2* const pl, Lfloat
     _tSimpleLivingString2* p = *pl = (_tSimpleLivingString2*) mpool_alloc(sizeof(_tSimpleLivingString2), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSimpleLivingString2_setSampleRate, NULL);
 
     p->sampleRate = leaf->sampleRate;
     p->curr=0.0f;
@@ -581,6 +588,7 @@ void    tSimpleLivingString2_free (tSimpleLivingString2* const pl)
     tHighpass_free(&p->DCblocker);
     tFeedbackLeveler_free(&p->fbLev);
 
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -689,6 +697,7 @@ void    tLivingString_initToPool    (tLivingString* const pl, Lfloat freq, Lfloa
     _tLivingString* p = *pl = (_tLivingString*) mpool_alloc(sizeof(_tLivingString), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tLivingString_setSampleRate, (LEAFClearFunc) tLivingString_clear);
     
     p->sampleRate = leaf->sampleRate;
     p->curr=0.0f;
@@ -738,6 +747,7 @@ void    tSimpleLivingString3_initToPool  (tSimpleLivingString3* const pl, int ov
     _tSimpleLivingString3* p = *pl = (_tSimpleLivingString3*) mpool_alloc(sizeof(_tSimpleLivingString3), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSimpleLivingString3_setSampleRate, NULL);
     p->oversampling = oversampling;
     p->sampleRate = leaf->sampleRate * oversampling;
     p->curr=0.0f;
@@ -795,6 +805,7 @@ void    tSimpleLivingString3_free (tSimpleLivingString3* const pl)
     tExpSmooth_free(&p->wlSmooth);
 
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -985,14 +996,13 @@ Lfloat   tSimpleLivingString3_sample(tSimpleLivingString3* const pl)
 void   tSimpleLivingString3_setSampleRate(tSimpleLivingString3* const pl, Lfloat sr)
 {
     _tSimpleLivingString3* p = *pl;
-    p->sampleRate = sr*p->oversampling;
     Lfloat freq = p->sampleRate/p->waveLengthInSamples;
+    p->sampleRate = sr*p->oversampling;
 
     p->waveLengthInSamples = p->sampleRate/freq;
     tExpSmooth_setDest(&p->wlSmooth, p->waveLengthInSamples);
     tOnePole_setSampleRate(&p->bridgeFilter, p->sampleRate);
     tHighpass_setSampleRate(&p->DCblocker, p->sampleRate);
-    tBiQuad_setSampleRate(&p->bridgeFilter2, p->sampleRate);
 }
 
 
@@ -1013,6 +1023,7 @@ void    tSimpleLivingString4_initToPool  (tSimpleLivingString4* const pl, int ov
     _tSimpleLivingString4* p = *pl = (_tSimpleLivingString4*) mpool_alloc(sizeof(_tSimpleLivingString4), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSimpleLivingString4_setSampleRate, NULL);
     p->oversampling = oversampling;
     p->sampleRate = leaf->sampleRate * oversampling;
     p->curr=0.0f;
@@ -1073,6 +1084,7 @@ void    tSimpleLivingString4_free (tSimpleLivingString4* const pl)
     tHighpass_free(&p->DCblocker);
     tFeedbackLeveler_free(&p->fbLev);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -1313,8 +1325,8 @@ Lfloat   tSimpleLivingString4_sample(tSimpleLivingString4* const pl)
 void   tSimpleLivingString4_setSampleRate(tSimpleLivingString4* const pl, Lfloat sr)
 {
     _tSimpleLivingString4* p = *pl;
-    p->sampleRate = sr*p->oversampling;
     Lfloat freq = p->sampleRate/p->waveLengthInSamples;
+    p->sampleRate = sr*p->oversampling;
 
     p->waveLengthInSamples = p->sampleRate/freq;
     tExpSmooth_setDest(&p->wlSmooth, p->waveLengthInSamples);
@@ -1342,6 +1354,7 @@ void    tSimpleLivingString5_initToPool  (tSimpleLivingString5* const pl, int ov
     _tSimpleLivingString5* p = *pl = (_tSimpleLivingString5*) mpool_alloc(sizeof(_tSimpleLivingString5), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSimpleLivingString5_setSampleRate, NULL);
     p->oversampling = oversampling;
     p->sampleRate = leaf->sampleRate * oversampling;
     p->curr=0.0f;
@@ -1445,6 +1458,7 @@ void    tSimpleLivingString5_free (tSimpleLivingString5* const pl)
     
 
 
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -1791,8 +1805,8 @@ Lfloat   tSimpleLivingString5_sample(tSimpleLivingString5* const pl)
 void   tSimpleLivingString5_setSampleRate(tSimpleLivingString5* const pl, Lfloat sr)
 {
     _tSimpleLivingString5* p = *pl;
-    p->sampleRate = sr*p->oversampling;
     Lfloat freq = p->sampleRate/p->waveLengthInSamples;
+    p->sampleRate = sr*p->oversampling;
 
     p->waveLengthInSamples = p->sampleRate/freq;
     tExpSmooth_setDest(&p->wlSmooth, p->waveLengthInSamples);
@@ -1828,6 +1842,7 @@ void    tLivingString_free (tLivingString* const pl)
     tFeedbackLeveler_free(&p->fbLevU);
     tFeedbackLeveler_free(&p->fbLevL);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -1968,6 +1983,22 @@ void   tLivingString_setSampleRate(tLivingString* const pl, Lfloat sr)
     tHighpass_setSampleRate(&p->DCblockerL, p->sampleRate);
 }
 
+void   tLivingString_clear(tLivingString* const pl)
+{
+    _tLivingString* p = *pl;
+    tLinearDelay_clear(&p->delLF);
+    tLinearDelay_clear(&p->delUF);
+    tLinearDelay_clear(&p->delUB);
+    tLinearDelay_clear(&p->delLB);
+    tOnePole_clear(&p->bridgeFilter);
+    tOnePole_clear(&p->nutFilter);
+    tOnePole_clear(&p->prepFilterU);
+    tOnePole_clear(&p->prepFilterL);
+    tHighpass_clear(&p->DCblockerU);
+    tHighpass_clear(&p->DCblockerL);
+    p->curr = 0.0f;
+}
+
 
 //////////---------------------------
 /* Version of Living String with Hermite Interpolation */
@@ -1990,6 +2021,7 @@ void    tLivingString2_initToPool    (tLivingString2* const pl, Lfloat freq, Lfl
     _tLivingString2* p = *pl = (_tLivingString2*) mpool_alloc(sizeof(_tLivingString2), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tLivingString2_setSampleRate, NULL);
 
     p->sampleRate = leaf->sampleRate;
     p->curr=0.0f;
@@ -2048,6 +2080,7 @@ void    tLivingString2_free (tLivingString2* const pl)
     tFeedbackLeveler_free(&p->fbLevU);
     tFeedbackLeveler_free(&p->fbLevL);
 
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -2428,6 +2461,7 @@ void    tComplexLivingString_initToPool    (tComplexLivingString* const pl, Lflo
     _tComplexLivingString* p = *pl = (_tComplexLivingString*) mpool_alloc(sizeof(_tComplexLivingString), m);
     p->mempool = m;
     LEAF* leaf = p->mempool->leaf;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tComplexLivingString_setSampleRate, NULL);
 
     p->sampleRate = leaf->sampleRate;
     p->curr=0.0f;
@@ -2490,6 +2524,7 @@ void    tComplexLivingString_free (tComplexLivingString* const pl)
     tFeedbackLeveler_free(&p->fbLevU);
     tFeedbackLeveler_free(&p->fbLevL);
 
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -3705,6 +3740,7 @@ void    tStiffString_initToPool   (tStiffString* const pm, int numModes, tMempoo
     _tMempool* m = *mp;
     _tStiffString* p = *pm = (_tStiffString*) mpool_alloc(sizeof(_tStiffString), m);
     p->mempool = m;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tStiffString_setSampleRate, NULL);
 
     // initialize variables
     p->numModes = numModes;
@@ -3759,6 +3795,7 @@ void    tStiffString_free (tStiffString* const pm)
     mpool_free((char *) p->decayVal, p->mempool);
     mpool_free((char *) p->amplitudes, p->mempool);
     mpool_free((char *) p->outputWeights, p->mempool);
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char *) p, p->mempool);
 }
 
@@ -30,6 +30,7 @@ void    tPRCReverb_initToPool   (tPRCReverb* const rev, Lfloat t60, tMempool* co
     _tPRCReverb* r = *rev = (_tPRCReverb*) mpool_alloc(sizeof(_tPRCReverb), m);
     r->mempool = m;
     LEAF* leaf = r->mempool->leaf;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tPRCReverb_setSampleRate, (LEAFClearFunc) tPRCReverb_clear);
     
     if (t60 <= 0.0f) t60 = 0.001f;
     
@@ -71,10 +72,11 @@ void    tPRCReverb_free (tPRCReverb* const rev)
     tDelay_free(&r->allpassDelays[0]);
     tDelay_free(&r->allpassDelays[1]);
     tDelay_free(&r->combDelay);
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
-void    tPRCRevert_clear(tPRCReverb* const rev)
+void    tPRCReverb_clear(tPRCReverb* const rev)
 {
     _tPRCReverb* r = *rev;
     
@@ -182,6 +184,7 @@ void    tNReverb_initToPool     (tNReverb* const rev, Lfloat t60, tMempool* cons
     _tNReverb* r = *rev = (_tNReverb*) mpool_alloc(sizeof(_tNReverb), m);
     r->mempool = m;
     LEAF* leaf = r->mempool->leaf;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tNReverb_setSampleRate, (LEAFClearFunc) tNReverb_clear);
     
     if (t60 <= 0.0f) t60 = 0.001f;
     
@@ -235,6 +238,7 @@ void    tNReverb_free (tNReverb* const rev)
         tLinearDelay_free(&r->allpassDelays[i]);
     }
     
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
@@ -268,6 +272,9 @@ void    tNReverb_clear             (tNReverb* const rev)
     {
         tLinearDelay_clear(&r->allpassDelays[i]);
     }
+    
+    r->lowpassState = 0.0f;
+    r->lastOut = 0.0f;
 }
 
 Lfloat   tNReverb_tick(tNReverb* const rev, Lfloat input)
@@ -436,6 +443,7 @@ void    tDattorroReverb_initToPool        (tDattorroReverb* const rev, tMempool*
     _tDattorroReverb* r = *rev = (_tDattorroReverb*) mpool_alloc(sizeof(_tDattorroReverb), m);
     r->mempool = m;
     LEAF* leaf = r->mempool->leaf;
+    LEAF_registerObject(r->mempool, &r->node, r, (LEAFSampleRateFunc) tDattorroReverb_setSampleRate, (LEAFClearFunc) tDattorroReverb_clear);
     
     r->sampleRate = leaf->sampleRate;
     
@@ -530,6 +538,7 @@ void    tDattorroReverb_free (tDattorroReverb* const rev)
     
     tCycle_free(&r->f2_lfo);
     
+    LEAF_unregisterObject(r->mempool, &r->node);
     mpool_free((char*)r, r->mempool);
 }
 
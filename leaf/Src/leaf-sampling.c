@@ -24,19 +24,296 @@
 
 //==============================================================================
 
+void tSampleStream_init(tSampleStream* const ss, tSampleStreamReadFunc read, void* userData, uint32_t length, uint32_t channels,
+                        uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, LEAF* const leaf)
+{
+    tSampleStream_initToPool(ss, read, userData, length, channels, sampleRate, headMs, ringLength, &leaf->mempool);
+}
+
+void tSampleStream_initToPool(tSampleStream* const ss, tSampleStreamReadFunc read, void* userData, uint32_t length, uint32_t channels,
+                              uint32_t sampleRate, Lfloat headMs, uint32_t ringLength, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tSampleStream* s = *ss = (_tSampleStream*) mpool_calloc(sizeof(_tSampleStream), m);
+    s->mempool = m;
+    
+    s->read = read;
+    s->userData = userData;
+    s->length = length;
+    s->channels = (channels > 1) ? 2 : 1;
+    s->sampleRate = sampleRate;
+    
+    s->headLength = (uint32_t) (headMs * 0.001f * sampleRate);
+    if (s->headLength < SAMPLE_STREAM_TAIL_LENGTH) s->headLength = SAMPLE_STREAM_TAIL_LENGTH;
+    if (s->headLength > length) s->headLength = length;
+    
+    // ring positions are masked, so keep the ring a power of two
+    s->ringLength = 16;
+    while (s->ringLength < ringLength) s->ringLength <<= 1;
+    s->ringMask = (s->ringLength * s->channels) - 1;
+    s->chunkLength = s->ringLength >> 2;
+    s->history = s->ringLength >> 2;
+    
+    s->head = (Lfloat*) mpool_calloc(sizeof(Lfloat) * s->headLength * s->channels, m);
+    s->ring = (Lfloat*) mpool_calloc(sizeof(Lfloat) * s->ringLength * s->channels, m);
+    for (int i = 0; i < 2; i++)
+    {
+        _tSampleStreamRegion* r = &s->region[i];
+        r->data = (Lfloat*) mpool_calloc(sizeof(Lfloat) * s->headLength * s->channels, m);
+        r->request = -1;
+    }
+    
+    s->read(s->userData, s->head, 0, s->headLength);
+    s->headEnd = s->headLength * s->channels;
+    
+    // the interpolator wraps around to the last few frames when reading near 0
+    uint32_t tailLength = (length < SAMPLE_STREAM_TAIL_LENGTH) ? length : SAMPLE_STREAM_TAIL_LENGTH;
+    s->read(s->userData, s->tail, length - tailLength, tailLength);
+    s->tailStart = (length - tailLength) * s->channels;
+    
+    // park the ring just after the head
+    s->seekFrame = s->headLength;
+    s->readPos = s->headLength;
+    s->writePos = s->headLength;
+    s->ringValid = 1;
+    s->ringLo = s->ringHi = s->headEnd;
+}
+
+void tSampleStream_free(tSampleStream* const ss)
+{
+    _tSampleStream* s = *ss;
+    
+    mpool_free((char*)s->region[1].data, s->mempool);
+    mpool_free((char*)s->region[0].data, s->mempool);
+    mpool_free((char*)s->ring, s->mempool);
+    mpool_free((char*)s->head, s->mempool);
+    mpool_free((char*)s, s->mempool);
+}
+
+uint32_t tSampleStream_service(tSampleStream* const ss)
+{
+    _tSampleStream* s = *ss;
+    uint32_t total = 0;
+    
+    // Resident regions first, a retrigger or loop wrap lands in them
+    for (int i = 0; i < 2; i++)
+    {
+        _tSampleStreamRegion* r = &s->region[i];
+        uint32_t epoch = LEAF_ATOMIC_LOAD(&r->epoch);
+        if (epoch == r->fillEpoch) continue;
+        
+        int32_t start = LEAF_ATOMIC_LOAD(&r->request);
+        uint32_t n = 0;
+        if ((start >= 0) && ((uint32_t) start < s->length))
+        {
+            n = s->length - start;
+            if (n > s->headLength) n = s->headLength;
+            n = s->read(s->userData, r->data, start, n);
+            total += n;
+        }
+        r->filled = n;
+        LEAF_ATOMIC_STORE(&r->fillEpoch, epoch);
+    }
+    
+    uint32_t epoch = LEAF_ATOMIC_LOAD(&s->seekEpoch);
+    if (epoch != s->fillEpoch)
+    {
+        LEAF_ATOMIC_STORE(&s->writePos, LEAF_ATOMIC_LOAD(&s->seekFrame));
+        LEAF_ATOMIC_STORE(&s->fillEpoch, epoch);
+    }
+    
+    while (1)
+    {
+        uint32_t wp = s->writePos;
+        uint32_t rp = LEAF_ATOMIC_LOAD(&s->readPos);
+        // the play head outran us, skip what it no longer needs
+        if ((int32_t) (wp - rp) < 0) wp = rp;
+        
+        uint32_t used = wp - rp;
+        uint32_t n = (used < s->ringLength) ? s->ringLength - used : 0;
+        if (n > s->chunkLength) n = s->chunkLength;
+        if (n > s->length - wp) n = s->length - wp;
+        uint32_t slot = wp & (s->ringLength - 1);
+        if (n > s->ringLength - slot) n = s->ringLength - slot;
+        if (n == 0) break;
+        
+        n = s->read(s->userData, &s->ring[slot * s->channels], wp, n);
+        
+        // a seek arrived while reading, so this chunk is stale
+        if (LEAF_ATOMIC_LOAD(&s->seekEpoch) != epoch) break;
+        LEAF_ATOMIC_STORE(&s->writePos, wp + n);
+        total += n;
+        if (n == 0) break;
+    }
+    
+    return total;
+}
+
+static void streamRequestRegion(_tSampleStream* s, _tSampleStreamRegion* r, int32_t frame)
+{
+    if (frame != r->request)
+    {
+        r->valid = 0;
+        r->lo = r->hi = 0;
+        LEAF_ATOMIC_STORE(&r->request, frame);
+        LEAF_ATOMIC_STORE(&r->epoch, r->epoch + 1);
+    }
+    if (!r->valid && (LEAF_ATOMIC_LOAD(&r->fillEpoch) == r->epoch))
+    {
+        r->valid = 1;
+        if (r->request >= 0)
+        {
+            r->lo = r->request * s->channels;
+            r->hi = r->lo + r->filled * s->channels;
+        }
+    }
+}
+
+void tSampleStream_update(tSampleStream* const ss, Lfloat position, int32_t startFrame, int32_t endFrame)
+{
+    _tSampleStream* s = *ss;
+    
+    if (endFrame >= 0)
+    {
+        // cover the frames leading up to the end, plus the interpolator's lookahead
+        endFrame = endFrame + 3 - (int32_t) s->headLength;
+        if (endFrame < 0) endFrame = 0;
+    }
+    streamRequestRegion(s, &s->region[0], startFrame);
+    streamRequestRegion(s, &s->region[1], endFrame);
+    
+    // Aim the ring at the first frame the resident regions don't cover
+    uint32_t pos = (position > 0.0f) ? (uint32_t) position : 0;
+    uint32_t target = pos;
+    uint32_t element = pos * s->channels;
+    if (pos < s->headLength) target = s->headLength;
+    for (int i = 0; i < 2; i++)
+    {
+        _tSampleStreamRegion* r = &s->region[i];
+        if ((r->lo <= element) && (element < r->hi)) target = r->hi / s->channels;
+    }
+    
+    if (target < s->length)
+    {
+        if ((target < s->readPos) || (target >= s->readPos + s->ringLength))
+        {
+            uint32_t frame = (target > 4) ? target - 4 : 0;
+            s->ringValid = 0;
+            s->readPos = frame;
+            LEAF_ATOMIC_STORE(&s->seekFrame, frame);
+            LEAF_ATOMIC_STORE(&s->readPos, frame);
+            LEAF_ATOMIC_STORE(&s->seekEpoch, s->seekEpoch + 1);
+        }
+        else if (pos > s->readPos + s->history)
+        {
+            LEAF_ATOMIC_STORE(&s->readPos, pos - s->history);
+        }
+    }
+    
+    if (!s->ringValid && (LEAF_ATOMIC_LOAD(&s->fillEpoch) == s->seekEpoch)) s->ringValid = 1;
+    s->ringLo = s->readPos * s->channels;
+    if (s->ringValid) s->ringHi = LEAF_ATOMIC_LOAD(&s->writePos) * s->channels;
+    else s->ringHi = s->ringLo;
+}
+
+static inline Lfloat streamGet(_tSampleStream* s, uint32_t i)
+{
+    if (i < s->headEnd) return s->head[i];
+    if ((s->region[0].lo <= i) && (i < s->region[0].hi)) return s->region[0].data[i - s->region[0].lo];
+    if ((s->region[1].lo <= i) && (i < s->region[1].hi)) return s->region[1].data[i - s->region[1].lo];
+    if ((s->ringLo <= i) && (i < s->ringHi)) return s->ring[i & s->ringMask];
+    if (i >= s->tailStart) return s->tail[i - s->tailStart];
+    s->underruns++;
+    return 0.0f;
+}
+
+Lfloat tSampleStream_get(tSampleStream* const ss, int idx)
+{
+    return streamGet(*ss, (uint32_t) idx);
+}
+
+uint32_t tSampleStream_getNumUnderruns(tSampleStream* const ss)
+{
+    _tSampleStream* s = *ss;
+    return s->underruns;
+}
+
+void tSampleStream_resetUnderruns(tSampleStream* const ss)
+{
+    _tSampleStream* s = *ss;
+    s->underruns = 0;
+}
+
+//==============================================================================
+
+static const int bufferBytesPerSample[BufferFormatNil] = { sizeof(Lfloat), sizeof(int16_t), 3 };
+
+static const Lfloat bufferDefaultScale[BufferFormatNil] = { 1.0f, 1.0f / 32768.0f, 1.0f / 8388608.0f };
+
+static inline int32_t int24At(const uint8_t* data, int idx)
+{
+    const uint8_t* b = &data[idx * 3];
+    // assemble in the top three bytes and shift back down to sign extend
+    return ((int32_t) (((uint32_t) b[0] << 8) | ((uint32_t) b[1] << 16) | ((uint32_t) b[2] << 24))) >> 8;
+}
+
+static inline void setFormat(_tBuffer* s, void* data, BufferFormat format)
+{
+    s->data = data;
+    s->format = format;
+    s->buff = (format == BufferFloat) ? (Lfloat*) data : NULL;
+    s->scale = bufferDefaultScale[format];
+    s->invScale = 1.0f / s->scale;
+}
+
+// Write one sample in the buffer's storage format
+static inline void bufferWrite(_tBuffer* s, int idx, Lfloat sample)
+{
+    if (s->format == BufferFloat)
+    {
+        s->buff[idx] = sample;
+        return;
+    }
+    
+    Lfloat max = (s->format == BufferInt16) ? 32767.0f : 8388607.0f;
+    int32_t q = (int32_t) lrintf(LEAF_clip(-max - 1.0f, sample * s->invScale, max));
+    if (s->format == BufferInt16)
+    {
+        ((int16_t*) s->data)[idx] = (int16_t) q;
+    }
+    else
+    {
+        uint8_t* b = &((uint8_t*) s->data)[idx * 3];
+        b[0] = (uint8_t) q;
+        b[1] = (uint8_t) (q >> 8);
+        b[2] = (uint8_t) (q >> 16);
+    }
+}
+
 void  tBuffer_init (tBuffer* const sb, uint32_t length, LEAF* const leaf)
 {
     tBuffer_initToPool(sb, length, &leaf->mempool);
 }
 
 void  tBuffer_initToPool (tBuffer* const sb, uint32_t length, tMempool* const mp)
+{
+    tBuffer_initToPoolWithFormat(sb, length, BufferFloat, mp);
+}
+
+void  tBuffer_initWithFormat (tBuffer* const sb, uint32_t length, BufferFormat format, LEAF* const leaf)
+{
+    tBuffer_initToPoolWithFormat(sb, length, format, &leaf->mempool);
+}
+
+void  tBuffer_initToPoolWithFormat (tBuffer* const sb, uint32_t length, BufferFormat format, tMempool* const mp)
 {
     _tMempool* m = *mp;
     _tBuffer* s = *sb = (_tBuffer*) mpool_alloc(sizeof(_tBuffer), m);
     s->mempool = m;
     LEAF* leaf = s->mempool->leaf;
     
-    s->buff = (Lfloat*) mpool_alloc( sizeof(Lfloat) * length, m);
+    if (format >= BufferFormatNil) format = BufferFloat;
+    setFormat(s, mpool_alloc(bufferBytesPerSample[format] * length, m), format);
     s->sampleRate = leaf->sampleRate;
     s->channels = 1;
     s->bufferLength = length;
@@ -44,13 +321,14 @@ void  tBuffer_initToPool (tBuffer* const sb, uint32_t length, tMempool* const mp
     s->active = 0;
     s->idx = 0;
     s->mode = RecordOneShot;
+    s->stream = NULL;
 }
 
 void  tBuffer_free (tBuffer* const sb)
 {
     _tBuffer* s = *sb;
     
-    mpool_free((char*)s->buff, s->mempool);
+    mpool_free((char*)s->data, s->mempool);
     mpool_free((char*)s, s->mempool);
 }
 
@@ -60,7 +338,7 @@ void tBuffer_tick (tBuffer* const sb, Lfloat sample)
     
     if (s->active == 1)
     {
-        s->buff[s->idx] = sample;
+        bufferWrite(s, s->idx, sample);
         
         s->idx += 1;
         
@@ -82,11 +360,17 @@ void tBuffer_tick (tBuffer* const sb, Lfloat sample)
 void  tBuffer_read(tBuffer* const sb, Lfloat* buff, uint32_t len)
 {
     _tBuffer* s = *sb;
-    for (unsigned i = 0; i < s->bufferLength; i++)
+    if (s->stream != NULL) return;
+    if (len > s->bufferLength) len = s->bufferLength;
+    if (s->format == BufferFloat)
+    {
+        for (unsigned i = 0; i < len; i++) s->buff[i] = buff[i];
+    }
+    else
     {
-        if (i < len)    s->buff[i] = buff[i];
-        else            s->buff[i] = 0.f;
+        for (unsigned i = 0; i < len; i++) bufferWrite(s, i, buff[i]);
     }
+    memset((char*)s->data + len * bufferBytesPerSample[s->format], 0, (s->bufferLength - len) * bufferBytesPerSample[s->format]);
     s->recordedLength = len;
 }
 
@@ -94,12 +378,54 @@ Lfloat tBuffer_get (tBuffer* const sb, int idx)
 {
     _tBuffer* s = *sb;
     if ((idx < 0) || (idx >= (int) s->bufferLength)) return 0.f;
-    return s->buff[idx];
+    // idx counts frames, whether the samples are in memory or streamed
+    int i = idx * (int) s->channels;
+    if (s->stream != NULL) return streamGet(s->stream, (uint32_t) i);
+    if (s->format == BufferInt16) return ((int16_t*) s->data)[i] * s->scale;
+    if (s->format == BufferInt24) return int24At((uint8_t*) s->data, i) * s->scale;
+    return s->buff[i];
+}
+
+void tBuffer_getBlock (tBuffer* const sb, int idx, Lfloat* output, int size)
+{
+    _tBuffer* s = *sb;
+    
+    // zero whatever falls outside the buffer, then convert the rest in one tight loop
+    int first = 0, last = size;
+    if (idx < 0) first = (-idx < size) ? -idx : size;
+    if (idx + size > (int) s->bufferLength) last = (int) s->bufferLength - idx;
+    if (last < first) last = first;
+    for (int i = 0; i < first; i++) output[i] = 0.0f;
+    for (int i = last; i < size; i++) output[i] = 0.0f;
+    
+    // frames, so interleaved buffers give their first channel
+    Lfloat scale = s->scale;
+    int channels = (int) s->channels;
+    if (s->stream != NULL)
+    {
+        for (int i = first; i < last; i++) output[i] = streamGet(s->stream, (uint32_t) ((idx + i) * channels));
+    }
+    else if (s->format == BufferInt16)
+    {
+        const int16_t* data = (const int16_t*) s->data;
+        for (int i = first; i < last; i++) output[i] = data[(idx + i) * channels] * scale;
+    }
+    else if (s->format == BufferInt24)
+    {
+        const uint8_t* data = (const uint8_t*) s->data;
+        for (int i = first; i < last; i++) output[i] = int24At(data, (idx + i) * channels) * scale;
+    }
+    else
+    {
+        const Lfloat* data = s->buff;
+        for (int i = first; i < last; i++) output[i] = data[(idx + i) * channels];
+    }
 }
 
 void  tBuffer_record(tBuffer* const sb)
 {
     _tBuffer* s = *sb;
+    if (s->stream != NULL) return;
     s->active = 1;
     s->idx = 0;
 }
@@ -131,24 +457,43 @@ void  tBuffer_setRecordMode (tBuffer* const sb, RecordMode mode)
 void  tBuffer_clear (tBuffer* const sb)
 {
     _tBuffer* s = *sb;
-    for (unsigned i = 0; i < s->bufferLength; i++)
-    {
-        s->buff[i] = 0.f;
-    }
+    if (s->stream != NULL) return;
+    memset(s->data, 0, s->bufferLength * bufferBytesPerSample[s->format]);
 
 }
 
 void tBuffer_setBuffer(tBuffer* const sb, Lfloat* externalBuffer, int length, int channels, int sampleRate)
+{
+    tBuffer_setBufferWithFormat(sb, externalBuffer, length, channels, sampleRate, BufferFloat);
+}
+
+void tBuffer_setBufferWithFormat(tBuffer* const sb, void* externalBuffer, int length, int channels, int sampleRate, BufferFormat format)
 {
     _tBuffer* s = *sb;
 
-    s->buff = externalBuffer;
+    if (format >= BufferFormatNil) format = BufferFloat;
+    setFormat(s, externalBuffer, format);
+    s->stream = NULL;
     s->channels = channels;
     s->sampleRate = sampleRate;
     s->recordedLength = length/channels;
     s->bufferLength = s->recordedLength;
 }
 
+void tBuffer_setScale(tBuffer* const sb, Lfloat scale)
+{
+    _tBuffer* s = *sb;
+    if (scale == 0.0f) return;
+    s->scale = scale;
+    s->invScale = 1.0f / scale;
+}
+
+BufferFormat tBuffer_getFormat(tBuffer* const sb)
+{
+    _tBuffer* s = *sb;
+    return s->format;
+}
+
 uint32_t tBuffer_getBufferLength(tBuffer* const sb)
 {
     _tBuffer* s = *sb;
@@ -173,12 +518,223 @@ int tBuffer_isActive(tBuffer* const sb)
     return s->active;
 }
 
+void tBuffer_setStream(tBuffer* const sb, tSampleStream* const ss)
+{
+    _tBuffer* s = *sb;
+    _tSampleStream* stream = *ss;
+    
+    s->stream = stream;
+    s->active = 0;
+    s->idx = 0;
+    s->channels = stream->channels;
+    s->sampleRate = stream->sampleRate;
+    s->bufferLength = stream->length;
+    s->recordedLength = stream->length;
+}
+
+// Read a handful of interpolation taps, deciding on the storage format once
+// for the whole set rather than once per tap
+static inline void bufferGather(_tBuffer* s, const int* idx, Lfloat* out, int n)
+{
+    if (s->stream != NULL)
+    {
+        for (int i = 0; i < n; i++) out[i] = streamGet(s->stream, (uint32_t) idx[i]);
+    }
+    else if (s->format == BufferFloat)
+    {
+        for (int i = 0; i < n; i++) out[i] = s->buff[idx[i]];
+    }
+    else if (s->format == BufferInt16)
+    {
+        const int16_t* data = (const int16_t*) s->data;
+        for (int i = 0; i < n; i++) out[i] = data[idx[i]] * s->scale;
+    }
+    else
+    {
+        const uint8_t* data = (const uint8_t*) s->data;
+        for (int i = 0; i < n; i++) out[i] = int24At(data, idx[i]) * s->scale;
+    }
+}
+
+static inline Lfloat bufferHermite(_tBuffer* s, int i1, int i2, int i3, int i4, Lfloat alpha)
+{
+    int idx[4] = { i1, i2, i3, i4 };
+    Lfloat x[4];
+    bufferGather(s, idx, x, 4);
+    return LEAF_interpolate_hermite_x(x[0], x[1], x[2], x[3], alpha);
+}
+
+static inline Lfloat bufferLerp(_tBuffer* s, int i, Lfloat f)
+{
+    int idx[2] = { i, i + 1 };
+    Lfloat x[2];
+    bufferGather(s, idx, x, 2);
+    return x[0] * (1.0f - f) + x[1] * f;
+}
+
+//============================tSincInterpolator================================
+
+void tSincInterpolator_init(tSincInterpolator* const sinc, int numPhases, int numBands, LEAF* const leaf)
+{
+    tSincInterpolator_initToPool(sinc, numPhases, numBands, &leaf->mempool);
+}
+
+void tSincInterpolator_initToPool(tSincInterpolator* const sinc, int numPhases, int numBands, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tSincInterpolator* si = *sinc = (_tSincInterpolator*) mpool_alloc(sizeof(_tSincInterpolator), m);
+    si->mempool = m;
+    
+    if (numPhases < 1) numPhases = 1;
+    if (numBands < 1) numBands = 1;
+    si->numPhases = numPhases;
+    si->numBands = numBands;
+    
+    // one extra phase per band so that the last phase can be interpolated toward alpha = 1
+    si->table = (Lfloat*) mpool_alloc(sizeof(Lfloat) * numBands * (numPhases + 1) * SINC_TAPS, m);
+    
+    Lfloat halfWidth = SINC_TAPS / 2;
+    for (int b = 0; b < numBands; b++)
+    {
+        // band b plays back at up to b + 1 times the original rate, leave a little
+        // room below the resulting nyquist for the transition band
+        Lfloat cutoff = 0.9f / (Lfloat) (b + 1);
+        
+        for (int ph = 0; ph <= numPhases; ph++)
+        {
+            Lfloat* h = &si->table[(b * (numPhases + 1) + ph) * SINC_TAPS];
+            Lfloat alpha = (Lfloat) ph / (Lfloat) numPhases;
+            Lfloat sum = 0.0f;
+            
+            for (int k = 0; k < SINC_TAPS; k++)
+            {
+                Lfloat d = (Lfloat) (k - (SINC_TAPS / 2 - 1)) - alpha;
+                Lfloat x = PI * cutoff * d;
+                Lfloat sincValue = (fabsf(x) < 1.0e-6f) ? 1.0f : sinf(x) / x;
+                Lfloat window = 0.42f + 0.5f * cosf(PI * d / halfWidth) + 0.08f * cosf(TWO_PI * d / halfWidth);
+                h[k] = cutoff * sincValue * window;
+                sum += h[k];
+            }
+            
+            // unity gain at DC for every phase
+            for (int k = 0; k < SINC_TAPS; k++) h[k] /= sum;
+        }
+    }
+}
+
+void tSincInterpolator_free(tSincInterpolator* const sinc)
+{
+    _tSincInterpolator* si = *sinc;
+    
+    mpool_free((char*)si->table, si->mempool);
+    mpool_free((char*)si, si->mempool);
+}
+
+Lfloat tSincInterpolator_tick(tSincInterpolator* const sinc, const Lfloat* input, Lfloat alpha, Lfloat rate)
+{
+    _tSincInterpolator* si = *sinc;
+    
+    int band = (int) rate;
+    if ((Lfloat) band == rate) band--;
+    if (band < 0) band = 0;
+    else if (band >= si->numBands) band = si->numBands - 1;
+    
+    Lfloat phase = alpha * si->numPhases;
+    int ph = (int) phase;
+    if (ph < 0) ph = 0;
+    else if (ph >= si->numPhases) ph = si->numPhases - 1;
+    Lfloat frac = phase - ph;
+    
+    const Lfloat* h0 = &si->table[(band * (si->numPhases + 1) + ph) * SINC_TAPS];
+    const Lfloat* h1 = h0 + SINC_TAPS;
+    
+    // elementwise products and a pairwise sum, so the compiler can vectorize
+    // both without reassociating a running total
+    Lfloat y[SINC_TAPS];
+    for (int k = 0; k < SINC_TAPS; k++)
+    {
+        y[k] = input[k] * (h0[k] + frac * (h1[k] - h0[k]));
+    }
+    for (int w = SINC_TAPS / 2; w > 0; w >>= 1)
+    {
+        for (int k = 0; k < w; k++) y[k] += y[k + w];
+    }
+    return y[0];
+}
+
+// Interpolate at base + alpha with a sinc kernel, wrapping around length frames
+static inline Lfloat bufferSinc(_tBuffer* s, tSincInterpolator* const sinc, int base, Lfloat alpha, Lfloat rate,
+                                int length, int channels, int channel)
+{
+    int idx[SINC_TAPS];
+    Lfloat x[SINC_TAPS];
+    int first = base - (SINC_TAPS / 2 - 1);
+    
+    if ((first >= 0) && (first + SINC_TAPS <= length))
+    {
+        if ((s->stream == NULL) && (s->format == BufferFloat) && (channels == 1))
+        {
+            return tSincInterpolator_tick(sinc, &s->buff[first], alpha, rate);
+        }
+        for (int k = 0; k < SINC_TAPS; k++) idx[k] = (first + k) * channels + channel;
+    }
+    else
+    {
+        for (int k = 0; k < SINC_TAPS; k++)
+        {
+            int j = (first + k) % length;
+            if (j < 0) j += length;
+            idx[k] = j * channels + channel;
+        }
+    }
+    
+    bufferGather(s, idx, x, SINC_TAPS);
+    return tSincInterpolator_tick(sinc, x, alpha, rate);
+}
+
 //================================tSampler=====================================
 
 static void handleStartEndChange(tSampler* const sp);
 
 static void attemptStartEndChange(tSampler* const sp);
 
+// Interpolate between taps i2 and i3 of the four taps i1 to i4, which step
+// through the buffer in direction dir
+static inline Lfloat samplerInterpolate(_tSampler* p, int channels, int channel,
+                                        int i1, int i2, int i3, int i4, Lfloat alpha, int dir)
+{
+    _tBuffer* buff = p->samp;
+    if (p->sinc == NULL)
+    {
+        return bufferHermite(buff, i1 * channels + channel, i2 * channels + channel,
+                             i3 * channels + channel, i4 * channels + channel, alpha);
+    }
+    // the sinc kernel runs forward, so start from the lower of the middle taps
+    if (dir > 0) return bufferSinc(buff, &p->sinc, i2, alpha, p->inc, buff->recordedLength, channels, channel);
+    return bufferSinc(buff, &p->sinc, i3, 1.0f - alpha, p->inc, buff->recordedLength, channels, channel);
+}
+
+// samplerInterpolate() over frames already converted to float, x[k] holding frame k
+static inline Lfloat samplerInterpolateFloat(_tSampler* p, const Lfloat* x,
+                                             int i1, int i2, int i3, int i4, Lfloat alpha, int dir)
+{
+    if (p->sinc == NULL) return LEAF_interpolate_hermite_x(x[i1], x[i2], x[i3], x[i4], alpha);
+    if (dir > 0) return tSincInterpolator_tick(&p->sinc, &x[i2 - (SINC_TAPS / 2 - 1)], alpha, p->inc);
+    return tSincInterpolator_tick(&p->sinc, &x[i3 - (SINC_TAPS / 2 - 1)], 1.0f - alpha, p->inc);
+}
+
+static void streamUpdate(_tSampler* p)
+{
+    // keep the regions around the loop points resident, and while idle park the
+    // play head at the start so that play() doesn't wait on the disk
+    int32_t cfxlen = (int32_t) p->cfxlen;
+    int32_t lo = (p->start < p->end) ? p->start : p->end;
+    int32_t hi = (p->start < p->end) ? p->end : p->start;
+    lo = (lo > cfxlen + 2) ? lo - cfxlen - 2 : 0;
+    
+    tSampleStream_update(&p->samp->stream, (p->active == 0) ? (Lfloat) lo : p->idx, lo, hi);
+}
+
 void tSampler_init(tSampler* const sp, tBuffer* const b, LEAF* const leaf)
 {
     tSampler_initToPool(sp, b, &leaf->mempool, leaf);
@@ -189,6 +745,7 @@ void tSampler_initToPool(tSampler* const sp, tBuffer* const b, tMempool* const m
     _tMempool* m = *mp;
     _tSampler* p = *sp = (_tSampler*) mpool_alloc(sizeof(_tSampler), m);
     p->mempool = m;
+    LEAF_registerObject(p->mempool, &p->node, p, (LEAFSampleRateFunc) tSampler_setSampleRate, NULL);
     
     _tBuffer* s = *b;
     
@@ -239,6 +796,8 @@ void tSampler_initToPool(tSampler* const sp, tBuffer* const b, tMempool* const m
     p->inCrossfade = 0;
     p->flipStart = -1;
     p->flipIdx = -1;
+    
+    p->sinc = NULL;
 }
 
 void tSampler_free (tSampler* const sp)
@@ -246,6 +805,7 @@ void tSampler_free (tSampler* const sp)
     _tSampler* p = *sp;
     tRamp_free(&p->gain);
     
+    LEAF_unregisterObject(p->mempool, &p->node);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -273,6 +833,8 @@ Lfloat tSampler_tick        (tSampler* const sp)
     
     attemptStartEndChange(sp);
     
+    if (p->samp->stream != NULL) streamUpdate(p);
+    
     if (p->active == 0)         return 0.f;
     
     if ((p->inc == 0.0f) || (p->len < 2))
@@ -287,8 +849,6 @@ Lfloat tSampler_tick        (tSampler* const sp)
     Lfloat flipsample = 0.0f;
     Lfloat flipMix = 0.0f;
     
-    Lfloat* buff = p->samp->buff;
-    
     // Variables so start is also before end
     int myStart = p->start;
     int myEnd = p->end;
@@ -322,11 +882,7 @@ Lfloat tSampler_tick        (tSampler* const sp)
     i3 = (i3 < length*(1-rev)) ? i3 + (length * rev) : i3 - (length * (1-rev));
     i4 = (i4 < length*(1-rev)) ? i4 + (length * rev) : i4 - (length * (1-rev));
     
-    sample = LEAF_interpolate_hermite_x (buff[i1],
-                                         buff[i2],
-                                         buff[i3],
-                                         buff[i4],
-                                         alpha);
+    sample = samplerInterpolate(p, 1, 0, i1, i2, i3, i4, alpha, dir);
     
     int32_t cfxlen = p->cfxlen;
     if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
@@ -372,11 +928,7 @@ Lfloat tSampler_tick        (tSampler* const sp)
             c3 = (c3 < length * (1-rev)) ? c3 + (length * rev) : c3 - (length * (1-rev));
             c4 = (c4 < length * (1-rev)) ? c4 + (length * rev) : c4 - (length * (1-rev));
             
-            cfxsample = LEAF_interpolate_hermite_x (buff[c1],
-                                                    buff[c2],
-                                                    buff[c3],
-                                                    buff[c4],
-                                                    alpha);
+            cfxsample = samplerInterpolate(p, 1, 0, c1, c2, c3, c4, alpha, dir);
             if (cfxlen > 0.0f) crossfadeMix = (Lfloat) offset / (Lfloat) cfxlen;
             else crossfadeMix = 0.0f;
         }
@@ -412,11 +964,7 @@ Lfloat tSampler_tick        (tSampler* const sp)
             f3 = (f3 < length*rev) ? f3 + (length * (1-rev)) : f3 - (length * rev);
             f4 = (f4 < length*rev) ? f4 + (length * (1-rev)) : f4 - (length * rev);
             
-            flipsample = LEAF_interpolate_hermite_x (buff[f1],
-                                                     buff[f2],
-                                                     buff[f3],
-                                                     buff[f4],
-                                                     falpha);
+            flipsample = samplerInterpolate(p, 1, 0, f1, f2, f3, f4, falpha, -dir);
             flipMix = (Lfloat) (cfxlen - flipLength) / (Lfloat) cfxlen;
         }
     }
@@ -532,6 +1080,8 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
 
     attemptStartEndChange(sp);
 
+    if (p->samp->stream != NULL) streamUpdate(p);
+
     if (p->active == 0)         return 0.f;
 
     if ((p->inc == 0.0f) || (p->len < 2))
@@ -545,8 +1095,6 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
     Lfloat flipsample[2] = {0.0f, 0.0f};
     Lfloat flipMix = 0.0f;
 
-    Lfloat* buff = p->samp->buff;
-
     // Variables so start is also before end
     int myStart = p->start;
     int myEnd = p->end;
@@ -580,17 +1128,9 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
     i3 = (i3 < length*(1-rev)) ? i3 + (length * rev) : i3 - (length * (1-rev));
     i4 = (i4 < length*(1-rev)) ? i4 + (length * rev) : i4 - (length * (1-rev));
 
-    outputArray[0] = LEAF_interpolate_hermite_x (buff[i1 * p->channels],
-                                         buff[i2 * p->channels],
-                                         buff[i3 * p->channels],
-                                         buff[i4 * p->channels],
-                                         alpha);
+    outputArray[0] = samplerInterpolate(p, p->channels, 0, i1, i2, i3, i4, alpha, dir);
 
-    outputArray[1] = LEAF_interpolate_hermite_x (buff[(i1 * p->channels) + 1],
-                                         buff[(i2 * p->channels) + 1],
-                                         buff[(i3 * p->channels) + 1],
-                                         buff[(i4 * p->channels) + 1],
-                                         alpha);
+    outputArray[1] = samplerInterpolate(p, p->channels, 1, i1, i2, i3, i4, alpha, dir);
 
     int32_t cfxlen = p->cfxlen;
     if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
@@ -636,17 +1176,9 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
             c3 = (c3 < length * (1-rev)) ? c3 + (length * rev) : c3 - (length * (1-rev));
             c4 = (c4 < length * (1-rev)) ? c4 + (length * rev) : c4 - (length * (1-rev));
 
-            cfxsample[0] = LEAF_interpolate_hermite_x (buff[c1 * p->channels],
-                                                    buff[c2 * p->channels],
-                                                    buff[c3 * p->channels],
-                                                    buff[c4 * p->channels],
-                                                    alpha);
+            cfxsample[0] = samplerInterpolate(p, p->channels, 0, c1, c2, c3, c4, alpha, dir);
 
-            cfxsample[1] = LEAF_interpolate_hermite_x (buff[(c1 * p->channels) + 1],
-                                                                buff[(c2 * p->channels) + 1],
-                                                                buff[(c3 * p->channels) + 1],
-                                                                buff[(c4 * p->channels) + 1],
-                                                                alpha);
+            cfxsample[1] = samplerInterpolate(p, p->channels, 1, c1, c2, c3, c4, alpha, dir);
 
             crossfadeMix = (Lfloat) offset / (Lfloat) cfxlen;
         }
@@ -682,17 +1214,9 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
             f3 = (f3 < length*rev) ? f3 + (length * (1-rev)) : f3 - (length * rev);
             f4 = (f4 < length*rev) ? f4 + (length * (1-rev)) : f4 - (length * rev);
 
-            flipsample[0] = LEAF_interpolate_hermite_x (buff[f1 * p->channels],
-                                                     buff[f2 * p->channels],
-                                                     buff[f3 * p->channels],
-                                                     buff[f4 * p->channels],
-                                                     falpha);
+            flipsample[0] = samplerInterpolate(p, p->channels, 0, f1, f2, f3, f4, falpha, -dir);
 
-            flipsample[1] = LEAF_interpolate_hermite_x (buff[(f1 * p->channels) + 1],
-                                                     buff[(f2 * p->channels) + 1],
-                                                     buff[(f3 * p->channels) + 1],
-                                                     buff[(f4 * p->channels) + 1],
-                                                     falpha);
+            flipsample[1] = samplerInterpolate(p, p->channels, 1, f1, f2, f3, f4, falpha, -dir);
 
             if (cfxlen > 0) flipMix = (Lfloat) (cfxlen - flipLength) / (Lfloat) cfxlen;
             else flipMix = 1.0f;
@@ -806,6 +1330,163 @@ Lfloat tSampler_tickStereo        (tSampler* const sp, Lfloat* outputArray)
 }
 
 
+// Number of upcoming ticks, up to maxTicks, for which tSampler_tick would do
+// nothing but interpolate and advance: no pending start/end change, no fade or
+// retrigger, no index wrapping, crossfade, flip, loop or end of sample.
+// Returns 0 when the next tick needs the full bookkeeping.
+static int samplerPlainSpan(_tSampler* p, int maxTicks)
+{
+    if ((p->active != 1) || (p->targetstart >= 0) || (p->targetend >= 0)) return 0;
+    if ((p->inc == 0.0f) || (p->len < 2)) return 0;
+    if ((p->flipStart >= 0) || (p->flipIdx >= 0)) return 0;
+    
+    int myStart = p->start;
+    int myEnd = p->end;
+    if (p->flip < 0)
+    {
+        myStart = p->end;
+        myEnd = p->start;
+    }
+    int dir = p->bnf * p->dir * p->flip;
+    Lfloat inc = fmodf(p->inc, (Lfloat)p->len);
+    
+    // Positions for which the tick is plain
+    Lfloat lo = 1.0f;
+    Lfloat hi = (Lfloat) p->samp->recordedLength - 2.0f;
+    if (p->mode == PlayLoop)
+    {
+        int32_t cfxlen = p->cfxlen;
+        if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
+        int32_t fadeLeftStart = 0;
+        if (myStart >= cfxlen) fadeLeftStart = myStart - cfxlen;
+        lo = fmaxf(lo, (Lfloat) (fadeLeftStart + cfxlen + 1));
+        hi = fminf(hi, (Lfloat) (myEnd - cfxlen - 1));
+    }
+    else
+    {
+        lo = fmaxf(lo, (Lfloat) myStart);
+        hi = fminf(hi, (Lfloat) myEnd);
+        if (p->mode == PlayNormal)
+        {
+            // stay clear of the point where the end fade starts
+            Lfloat fade = p->ticksPerSevenMs * p->inc;
+            if (dir > 0) hi = fminf(hi, (Lfloat) myEnd - fade);
+            else lo = fmaxf(lo, (Lfloat) myStart + fade);
+        }
+    }
+    
+    // Leave room for the rounding of the running index
+    Lfloat x = p->idx;
+    Lfloat margin = 2.0f + (Lfloat) maxTicks * (fabsf(x) + inc) * 2.4e-7f;
+    lo += margin;
+    hi -= margin;
+    if ((x < lo) || (x > hi)) return 0;
+    
+    // Ticks until the index leaves the plain range, counting the last advance
+    Lfloat room = (dir > 0) ? (hi - x) : (x - lo);
+    Lfloat span = room / inc;
+    if (span >= (Lfloat) maxTicks) return maxTicks;
+    return (int) span;
+}
+
+// Frames converted per span of tSampler_tickBlock(), and the frames beyond the
+// play head on either side that the sinc and hermite taps reach
+#define SAMPLER_SCRATCH_FRAMES 256
+#define SAMPLER_TAP_REACH (SINC_TAPS / 2 + 2)
+
+void tSampler_tickBlock (tSampler* const sp, Lfloat* out, int size)
+{
+    _tSampler* p = *sp;
+    _tBuffer* buff = p->samp;
+    Lfloat scratch[SAMPLER_SCRATCH_FRAMES];
+    
+    int n = 0;
+    while (n < size)
+    {
+        int span = samplerPlainSpan(p, size - n);
+        if (span <= 0)
+        {
+            out[n++] = tSampler_tick(sp);
+            continue;
+        }
+        
+        // streams are told where the play head is once per span instead of once per tick
+        if (buff->stream != NULL)
+        {
+            if (span > 32) span = 32;
+            streamUpdate(p);
+        }
+        
+        int dir = p->bnf * p->dir * p->flip;
+        int rev = (dir < 0) ? 1 : 0;
+        Lfloat inc = fmodf(p->inc, (Lfloat)p->len);
+        Lfloat step = dir * inc;
+        Lfloat idxf = p->idx;
+        Lfloat sample = p->last;
+        if (p->mode == PlayLoop) p->inCrossfade = 0;
+        
+        // Mono float buffers in memory are read in place. Anything else has the
+        // frames this span touches converted once, so the loop below interpolates
+        // from floats without looking at the storage format.
+        const Lfloat* x = NULL;
+        int first = 0;
+        if (buff->channels == 1)
+        {
+            int direct = (buff->stream == NULL) && (buff->format == BufferFloat);
+            Lfloat reach = (Lfloat) (SAMPLER_SCRATCH_FRAMES - 2 * SAMPLER_TAP_REACH - 4);
+            if (!direct && ((Lfloat) span * inc > reach)) span = (int) (reach / inc);
+            if (span > 0)
+            {
+                Lfloat last = idxf + step * (span - 1);
+                first = (int) fminf(idxf, last) + rev - SAMPLER_TAP_REACH - 1;
+                int count = (int) fmaxf(idxf, last) + rev + SAMPLER_TAP_REACH + 2 - first;
+                // near the ends the sinc taps wrap around, which the per-tap path handles
+                if ((first >= 0) && (first + count <= (int) buff->recordedLength))
+                {
+                    if (direct)
+                    {
+                        x = buff->buff;
+                        first = 0;
+                    }
+                    else
+                    {
+                        tBuffer_getBlock(&p->samp, first, scratch, count);
+                        x = scratch;
+                    }
+                }
+            }
+        }
+        if (span <= 0)
+        {
+            out[n++] = tSampler_tick(sp);
+            continue;
+        }
+        
+        for (int i = 0; i < span; i++)
+        {
+            int idx = (int) idxf;
+            Lfloat alpha = rev + (idxf - idx) * dir;
+            idx += rev;
+            
+            if (x != NULL)
+            {
+                int k = idx - first;
+                sample = samplerInterpolateFloat(p, x, k - dir, k, k + dir, k + (2 * dir), alpha, dir);
+            }
+            else sample = samplerInterpolate(p, 1, 0, idx - dir, idx, idx + dir, idx + (2 * dir), alpha, dir);
+            sample = sample * tRamp_tick(&p->gain);
+            out[n + i] = sample;
+            
+            idxf += step;
+        }
+        
+        p->idx = idxf;
+        p->last = sample;
+        n += span;
+    }
+}
+
+
 void tSampler_setMode      (tSampler* const sp, PlayMode mode)
 {
     _tSampler* p = *sp;
@@ -1141,6 +1822,13 @@ void tSampler_setRate      (tSampler* const sp, Lfloat rate)
 }
 
 
+void tSampler_setInterpolator (tSampler* const sp, tSincInterpolator* const sinc)
+{
+    _tSampler* p = *sp;
+    
+    p->sinc = (sinc != NULL) ? *sinc : NULL;
+}
+
 void tSampler_setSampleRate(tSampler* const sp, Lfloat sr)
 {
     _tSampler* p = *sp;
@@ -1164,6 +1852,7 @@ void    tAutoSampler_initToPool (tAutoSampler* const as, tBuffer* const b, tMemp
     _tMempool* m = *mp;
     _tAutoSampler* a = *as = (_tAutoSampler*) mpool_alloc(sizeof(_tAutoSampler), m);
     a->mempool = m;
+    LEAF_registerObject(a->mempool, &a->node, a, (LEAFSampleRateFunc) tAutoSampler_setSampleRate, NULL);
     
     tBuffer_setRecordMode(b, RecordOneShot);
     tSampler_initToPool(&a->sampler, b, mp, leaf);
@@ -1178,6 +1867,7 @@ void    tAutoSampler_free (tAutoSampler* const as)
     tEnvelopeFollower_free(&a->ef);
     tSampler_free(&a->sampler);
     
+    LEAF_unregisterObject(a->mempool, &a->node);
     mpool_free((char*)a, a->mempool);
 }
 
@@ -1282,6 +1972,12 @@ void    tAutoSampler_setSampleRate (tAutoSampler* const as, Lfloat sr)
 }
 
 
+static inline Lfloat mbSamplerInterpolate(_tMBSampler* c, int i, Lfloat f)
+{
+    if (c->sinc == NULL) return bufferLerp(c->samp, i, f);
+    return bufferSinc(c->samp, &c->sinc, i, f, fabsf(c->_w), c->samp->recordedLength, 1, 0);
+}
+
 void tMBSampler_init(tMBSampler* const sp, tBuffer* const b, LEAF* const leaf)
 {
     tMBSampler_initToPool(sp, b, &leaf->mempool);
@@ -1312,6 +2008,7 @@ void tMBSampler_initToPool(tMBSampler* const sp, tBuffer* const b, tMempool* con
     c->start = 0;
     c->end = 1;
     c->currentLoopLength = 1;
+    c->sinc = NULL;
     tMBSampler_setEnd(sp, c->samp->bufferLength);
 }
 
@@ -1349,7 +2046,6 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
     
     Lfloat last, beforeLast;
     int start, end, length;
-    Lfloat* buff;
     int    j;
     //Lfloat  syncin;
     Lfloat  a, p, w, z;
@@ -1358,8 +2054,6 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
     start = c->start;
     end = c->end;
 
-    buff = c->samp->buff;
-    
     last = c->last;
     beforeLast = c->beforeLast;
     p = c->_p;  /* position */
@@ -1421,12 +2115,12 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = mbSamplerInterpolate(c, i, f);
             
             f = p + w;
             i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = mbSamplerInterpolate(c, i, f);
  
             place_step_dd(c->_f, j, p - start, w, next - last);
             Lfloat nextSlope = (afterNext - next) / w;
@@ -1458,7 +2152,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = mbSamplerInterpolate(c, i, f);
 
 
             if ((end - p) < 480) // 480 samples should be enough to let the tExpSmooth go from 1 to 0 (10ms at 48k, 5ms at 192k)
@@ -1473,7 +2167,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p + w;
             int i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = mbSamplerInterpolate(c, i, f);
             
             Lfloat nextSlope = (afterNext - next) / w;
             Lfloat lastSlope = (last - beforeLast) / w;
@@ -1493,12 +2187,12 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = mbSamplerInterpolate(c, i, f);
 
             f = p + w;
             i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = mbSamplerInterpolate(c, i, f);
 
             place_step_dd(c->_f, j, end - p, w, next - last);
             Lfloat nextSlope = (afterNext - next) / w;
@@ -1536,7 +2230,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = mbSamplerInterpolate(c, i, f);
         }
         
         if (c->_last_w > 0.0f)
@@ -1544,7 +2238,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const sp)
             Lfloat f = p + w;
             int i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = mbSamplerInterpolate(c, i, f);
             
             Lfloat nextSlope = (afterNext - next) / w;
             Lfloat lastSlope = (last - beforeLast) / w;
@@ -1638,3 +2332,287 @@ void tMBSampler_setRate      (tMBSampler* const sp, Lfloat rate)
     p->_w = rate;
 }
 
+void tMBSampler_setInterpolator (tMBSampler* const sp, tSincInterpolator* const sinc)
+{
+    _tMBSampler* p = *sp;
+    
+    p->sinc = (sinc != NULL) ? *sinc : NULL;
+}
+
+//================================tGranulator==================================
+
+void tGranulator_init(tGranulator* const gr, tBuffer* const b, int maxGrains, LEAF* const leaf)
+{
+    tGranulator_initToPool(gr, b, maxGrains, &leaf->mempool);
+}
+
+void tGranulator_initToPool(tGranulator* const gr, tBuffer* const b, int maxGrains, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tGranulator* g = *gr = (_tGranulator*) mpool_alloc(sizeof(_tGranulator), m);
+    g->mempool = m;
+    LEAF* leaf = g->mempool->leaf;
+    LEAF_registerObject(g->mempool, &g->node, g, (LEAFSampleRateFunc) tGranulator_setSampleRate, NULL);
+    
+    g->samp = *b;
+    g->sampleRate = leaf->sampleRate;
+    
+    g->window = (Lfloat*) mpool_alloc(sizeof(Lfloat) * (GRANULATOR_WINDOW_SIZE + 1), m);
+    for (int i = 0; i <= GRANULATOR_WINDOW_SIZE; i++)
+    {
+        g->window[i] = 0.5f - 0.5f * cosf(TWO_PI * (Lfloat) i / (Lfloat) GRANULATOR_WINDOW_SIZE);
+    }
+    
+    if (maxGrains < 1) maxGrains = 1;
+    g->maxGrains = maxGrains;
+    g->pos = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxGrains, m);
+    g->inc = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxGrains, m);
+    g->phase = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxGrains, m);
+    g->phaseInc = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxGrains, m);
+    g->amp = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxGrains, m);
+    g->active = (int*) mpool_alloc(sizeof(int) * maxGrains, m);
+    g->freeList = (int*) mpool_alloc(sizeof(int) * maxGrains, m);
+    
+    g->numActive = 0;
+    g->numFree = maxGrains;
+    for (int i = 0; i < maxGrains; i++) g->freeList[i] = maxGrains - 1 - i;
+    
+    g->position = 0.0f;
+    g->positionSpread = 0.0f;
+    g->grainSize = 50.0f;
+    g->sizeSpread = 0.0f;
+    g->rate = 1.0f;
+    g->rateSpread = 0.0f;
+    g->gain = 0.5f;
+    g->density = 0.0f;
+    g->spawnInterval = 0.0f;
+    g->spawnCountdown = 0.0f;
+}
+
+void tGranulator_free(tGranulator* const gr)
+{
+    _tGranulator* g = *gr;
+    
+    mpool_free((char*)g->freeList, g->mempool);
+    mpool_free((char*)g->active, g->mempool);
+    mpool_free((char*)g->amp, g->mempool);
+    mpool_free((char*)g->phaseInc, g->mempool);
+    mpool_free((char*)g->phase, g->mempool);
+    mpool_free((char*)g->inc, g->mempool);
+    mpool_free((char*)g->pos, g->mempool);
+    mpool_free((char*)g->window, g->mempool);
+    LEAF_unregisterObject(g->mempool, &g->node);
+    mpool_free((char*)g, g->mempool);
+}
+
+void tGranulator_trigger(tGranulator* const gr)
+{
+    _tGranulator* g = *gr;
+    LEAF* leaf = g->mempool->leaf;
+    int length = g->samp->recordedLength;
+    
+    if ((g->numFree == 0) || (length < 2)) return;
+    
+    int v = g->freeList[--g->numFree];
+    
+    Lfloat start = g->position + g->positionSpread * (leaf->random() * 2.0f - 1.0f);
+    start -= floorf(start);
+    g->pos[v] = start * (Lfloat) (length - 1);
+    
+    Lfloat size = g->grainSize * 0.001f * g->sampleRate;
+    size *= 1.0f + g->sizeSpread * (leaf->random() * 2.0f - 1.0f);
+    if (size < 16.0f) size = 16.0f;
+    g->phase[v] = 0.0f;
+    g->phaseInc[v] = 1.0f / size;
+    
+    Lfloat rate = g->rate * g->samp->sampleRate / g->sampleRate;
+    if (g->rateSpread != 0.0f)
+    {
+        rate *= exp2f(g->rateSpread * (leaf->random() * 2.0f - 1.0f) * (1.0f / 12.0f));
+    }
+    g->inc[v] = rate;
+    g->amp[v] = g->gain;
+    
+    g->active[g->numActive++] = v;
+}
+
+// Add every active grain into out for n samples, one grain at a time
+static void granulatorRender(_tGranulator* g, Lfloat* out, int n)
+{
+    _tBuffer* buff = g->samp;
+    int length = buff->recordedLength;
+    Lfloat flength = (Lfloat) length;
+    const Lfloat* window = g->window;
+    int direct = (buff->stream == NULL) && (buff->format == BufferFloat) && (buff->channels == 1);
+    
+    for (int a = 0; a < g->numActive; )
+    {
+        int v = g->active[a];
+        Lfloat pos = g->pos[v];
+        Lfloat inc = g->inc[v];
+        Lfloat phase = g->phase[v];
+        Lfloat phaseInc = g->phaseInc[v];
+        Lfloat amp = g->amp[v];
+        
+        // stop at the end of the window rather than checking every sample
+        int m = n;
+        Lfloat left = (1.0f - phase) / phaseInc;
+        if (left < (Lfloat) m) m = (int) ceilf(left);
+        
+        for (int i = 0; i < m; i++)
+        {
+            Lfloat wp = phase * GRANULATOR_WINDOW_SIZE;
+            int wi = (int) wp;
+            if (wi >= GRANULATOR_WINDOW_SIZE) wi = GRANULATOR_WINDOW_SIZE - 1;
+            Lfloat w = window[wi] + (wp - wi) * (window[wi + 1] - window[wi]);
+            
+            int i1 = (int) pos;
+            Lfloat f = pos - i1;
+            int i2 = i1 + 1;
+            if (i2 >= length) i2 -= length;
+            
+            Lfloat x;
+            if (direct)
+            {
+                x = buff->buff[i1] + f * (buff->buff[i2] - buff->buff[i1]);
+            }
+            else
+            {
+                int idx[2] = { i1 * (int) buff->channels, i2 * (int) buff->channels };
+                Lfloat y[2];
+                bufferGather(buff, idx, y, 2);
+                x = y[0] + f * (y[1] - y[0]);
+            }
+            out[i] += x * w * amp;
+            
+            phase += phaseInc;
+            pos += inc;
+            if (pos >= flength) pos -= flength;
+            else if (pos < 0.0f) pos += flength;
+        }
+        
+        if (phase >= 1.0f)
+        {
+            // finished, hand the grain back and fill its slot from the end
+            g->freeList[g->numFree++] = v;
+            g->active[a] = g->active[--g->numActive];
+        }
+        else
+        {
+            g->pos[v] = pos;
+            g->phase[v] = phase;
+            a++;
+        }
+    }
+}
+
+void tGranulator_tickBlock(tGranulator* const gr, Lfloat* out, int size)
+{
+    _tGranulator* g = *gr;
+    
+    for (int i = 0; i < size; i++) out[i] = 0.0f;
+    if (g->samp->recordedLength < 2) return;
+    
+    int n = 0;
+    while (n < size)
+    {
+        int seg = size - n;
+        if (g->density > 0.0f)
+        {
+            if (g->spawnCountdown <= 0.0f)
+            {
+                tGranulator_trigger(gr);
+                g->spawnCountdown += g->spawnInterval;
+                continue;
+            }
+            int untilSpawn = (int) ceilf(g->spawnCountdown);
+            if (untilSpawn < seg) seg = untilSpawn;
+            g->spawnCountdown -= (Lfloat) seg;
+        }
+        
+        granulatorRender(g, &out[n], seg);
+        n += seg;
+    }
+}
+
+Lfloat tGranulator_tick(tGranulator* const gr)
+{
+    Lfloat out;
+    tGranulator_tickBlock(gr, &out, 1);
+    return out;
+}
+
+void tGranulator_setBuffer(tGranulator* const gr, tBuffer* const b)
+{
+    _tGranulator* g = *gr;
+    
+    g->samp = *b;
+    
+    while (g->numActive > 0) g->freeList[g->numFree++] = g->active[--g->numActive];
+}
+
+void tGranulator_setPosition(tGranulator* const gr, Lfloat position)
+{
+    _tGranulator* g = *gr;
+    g->position = LEAF_clip(0.0f, position, 1.0f);
+}
+
+void tGranulator_setPositionSpread(tGranulator* const gr, Lfloat spread)
+{
+    _tGranulator* g = *gr;
+    g->positionSpread = LEAF_clip(0.0f, spread, 1.0f);
+}
+
+void tGranulator_setGrainSize(tGranulator* const gr, Lfloat ms)
+{
+    _tGranulator* g = *gr;
+    g->grainSize = ms;
+}
+
+void tGranulator_setSizeSpread(tGranulator* const gr, Lfloat spread)
+{
+    _tGranulator* g = *gr;
+    g->sizeSpread = LEAF_clip(0.0f, spread, 1.0f);
+}
+
+void tGranulator_setDensity(tGranulator* const gr, Lfloat grainsPerSecond)
+{
+    _tGranulator* g = *gr;
+    
+    if (grainsPerSecond < 0.0f) grainsPerSecond = 0.0f;
+    g->density = grainsPerSecond;
+    g->spawnInterval = (grainsPerSecond > 0.0f) ? g->sampleRate / grainsPerSecond : 0.0f;
+    if (g->spawnCountdown > g->spawnInterval) g->spawnCountdown = g->spawnInterval;
+}
+
+void tGranulator_setRate(tGranulator* const gr, Lfloat rate)
+{
+    _tGranulator* g = *gr;
+    g->rate = rate;
+}
+
+void tGranulator_setRateSpread(tGranulator* const gr, Lfloat semitones)
+{
+    _tGranulator* g = *gr;
+    g->rateSpread = semitones;
+}
+
+void tGranulator_setGain(tGranulator* const gr, Lfloat gain)
+{
+    _tGranulator* g = *gr;
+    g->gain = gain;
+}
+
+int tGranulator_getNumActiveGrains(tGranulator* const gr)
+{
+    _tGranulator* g = *gr;
+    return g->numActive;
+}
+
+void tGranulator_setSampleRate(tGranulator* const gr, Lfloat sr)
+{
+    _tGranulator* g = *gr;
+    
+    g->sampleRate = sr;
+    tGranulator_setDensity(gr, g->density);
+}
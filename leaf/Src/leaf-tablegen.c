@@ -0,0 +1,281 @@
+/*==============================================================================
+
+ leaf-tablegen.c
+
+ ==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-tables.h"
+#include "..\Inc\leaf-kernels.h"
+
+#else
+
+#include "../Inc/leaf-tables.h"
+#include "../Inc/leaf-kernels.h"
+
+#endif
+
+// Octaves in each band-limited wavetable set
+#define OCTAVE_TABLES 11
+
+#if LEAF_GENERATE_TABLES
+
+struct _tLeafTables
+{
+    Lfloat* sine;
+    Lfloat* triangle;
+    Lfloat* square;
+    Lfloat* sawtooth;
+    Lfloat* expDecay;
+    Lfloat* attackDecayInc;
+    Lfloat* filterTan[2]; // at the LEAF sample rate and at twice it
+};
+
+typedef enum OctaveShape
+{
+    OctaveTriangle = 0,
+    OctaveSquare,
+    OctaveSawtooth
+} OctaveShape;
+
+#if LEAF_INCLUDE_TRIANGLE_TABLE || LEAF_INCLUDE_SQUARE_TABLE || LEAF_INCLUDE_SAWTOOTH_TABLE
+// Fourier series from wtgenerator.py, normalized to a peak of 1. tTriangle, tSquare
+// and tSawtooth pick octave k = log2(freq * size / sampleRate), so octave k keeps
+// harmonics up to (size / 2) >> k. Each octave is built with one inverse FFT.
+static Lfloat* leaf_generateOctaves(LEAF* const leaf, OctaveShape shape, int size)
+{
+    Lfloat* tables = (Lfloat*) mpool_alloc(sizeof(Lfloat) * OCTAVE_TABLES * size, leaf->mempool);
+    if (tables == NULL) return NULL;
+
+    for (int k = 0; k < OCTAVE_TABLES; k++)
+    {
+        Lfloat* t = &tables[k * size];
+        int maxHarmonic = (size / 2) >> k;
+        if (maxHarmonic >= size / 2) maxHarmonic = size / 2 - 1;
+
+        for (int i = 0; i < size; i++) t[i] = 0.0f;
+
+        // Sine amplitudes go in the imaginary half; the unscaled inverse gives
+        // sum(2 * buf[size - h] * sin(2 pi h i / size))
+        for (int h = 1; h <= maxHarmonic; h++)
+        {
+            double amp = 0.0;
+            if (shape == OctaveSawtooth)
+                amp = -2.0 / (PI * h);
+            else if (h & 1)
+            {
+                if (shape == OctaveSquare)
+                    amp = 4.0 / (PI * h);
+                else
+                    amp = ((h & 2) ? -8.0 : 8.0) / (PI * PI * h * h);
+            }
+            t[size - h] = (Lfloat) (amp * 0.5);
+        }
+        LEAF_kernel_realIFFT(t, NULL, size);
+    }
+    return tables;
+}
+#endif
+
+#if LEAF_INCLUDE_SINE_TABLE
+static Lfloat* leaf_generateSine(LEAF* const leaf)
+{
+    Lfloat* t = (Lfloat*) mpool_alloc(sizeof(Lfloat) * SINE_TABLE_SIZE, leaf->mempool);
+    if (t == NULL) return NULL;
+    for (int i = 0; i < SINE_TABLE_SIZE; i++)
+        t[i] = (Lfloat) sin(TWO_PI * (double) i / SINE_TABLE_SIZE);
+    return t;
+}
+#endif
+
+#if LEAF_INCLUDE_ADSR_TABLES
+// envelope_decay2() in wtgenerator.py
+static Lfloat* leaf_generateExpDecay(LEAF* const leaf)
+{
+    Lfloat* t = (Lfloat*) mpool_alloc(sizeof(Lfloat) * EXP_DECAY_TABLE_SIZE, leaf->mempool);
+    if (t == NULL) return NULL;
+    for (int i = 0; i < EXP_DECAY_TABLE_SIZE; i++)
+    {
+        double x = 1.0 - (double) i / EXP_DECAY_TABLE_SIZE;
+        t[i] = (Lfloat) (x * x);
+    }
+    return t;
+}
+
+// inverseAttackDecayIncrements() in wtgenerator.py: index i is a time of i / 8 ms.
+// tADSR scales these by 44100 / sampleRate, so they stay at that rate here.
+static Lfloat* leaf_generateAttackDecayInc(LEAF* const leaf)
+{
+    Lfloat* t = (Lfloat*) mpool_alloc(sizeof(Lfloat) * ATTACK_DECAY_INC_TABLE_SIZE, leaf->mempool);
+    if (t == NULL) return NULL;
+    t[0] = (Lfloat) ATTACK_DECAY_INC_TABLE_SIZE;
+    for (int i = 1; i < ATTACK_DECAY_INC_TABLE_SIZE; i++)
+        t[i] = (Lfloat) (ATTACK_DECAY_INC_TABLE_SIZE / ((double) i * 0.000125 * 44100.0));
+    return t;
+}
+#endif
+
+// Index i is MIDI note i * 134 / 4096. The filters multiply by 48000 / sampleRate,
+// so storing tan(pi f / sampleRate) * sampleRate / 48000 makes that exact.
+static void leaf_fillFilterTan(Lfloat* t, double sampleRate)
+{
+    double maxFreq = sampleRate * 0.49;
+    for (int i = 0; i < FILTERTAN_TABLE_SIZE; i++)
+    {
+        double midi = i * (134.0 / FILTERTAN_TABLE_SIZE);
+        double freq = 440.0 * pow(2.0, (midi - 69.0) / 12.0);
+        if (freq > maxFreq) freq = maxFreq;
+        t[i] = (Lfloat) (tan(PI * freq / sampleRate) * (sampleRate / 48000.0));
+    }
+}
+
+// Everything is built here, on the thread that calls LEAF_init(), so objects
+// initialized later, including from an arena on another thread, only read the
+// tables. The wavetables and envelope tables are built when their LEAF_INCLUDE_
+// flag is set. The filter tables are always built, as the filters always are.
+void leaf_tables_init(LEAF* const leaf)
+{
+    struct _tLeafTables* tables = (struct _tLeafTables*) mpool_calloc(sizeof(struct _tLeafTables), leaf->mempool);
+    if (tables == NULL) return;
+
+#if LEAF_INCLUDE_SINE_TABLE
+    tables->sine = leaf_generateSine(leaf);
+#endif
+#if LEAF_INCLUDE_TRIANGLE_TABLE
+    tables->triangle = leaf_generateOctaves(leaf, OctaveTriangle, TRI_TABLE_SIZE);
+#endif
+#if LEAF_INCLUDE_SQUARE_TABLE
+    tables->square = leaf_generateOctaves(leaf, OctaveSquare, SQR_TABLE_SIZE);
+#endif
+#if LEAF_INCLUDE_SAWTOOTH_TABLE
+    tables->sawtooth = leaf_generateOctaves(leaf, OctaveSawtooth, SAW_TABLE_SIZE);
+#endif
+#if LEAF_INCLUDE_ADSR_TABLES
+    tables->expDecay = leaf_generateExpDecay(leaf);
+    tables->attackDecayInc = leaf_generateAttackDecayInc(leaf);
+#endif
+    for (int k = 0; k < 2; k++)
+    {
+        tables->filterTan[k] = (Lfloat*) mpool_alloc(sizeof(Lfloat) * FILTERTAN_TABLE_SIZE, leaf->mempool);
+        if (tables->filterTan[k] != NULL)
+            leaf_fillFilterTan(tables->filterTan[k], leaf->sampleRate * (k + 1));
+    }
+
+    leaf->tables = tables;
+}
+
+#if LEAF_INCLUDE_SINE_TABLE
+const Lfloat* LEAF_getSineTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->sine : NULL;
+}
+#endif
+
+#if LEAF_INCLUDE_TRIANGLE_TABLE
+const Lfloat* LEAF_getTriangleTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->triangle : NULL;
+}
+#endif
+
+#if LEAF_INCLUDE_SQUARE_TABLE
+const Lfloat* LEAF_getSquareTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->square : NULL;
+}
+#endif
+
+#if LEAF_INCLUDE_SAWTOOTH_TABLE
+const Lfloat* LEAF_getSawtoothTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->sawtooth : NULL;
+}
+#endif
+
+#if LEAF_INCLUDE_ADSR_TABLES
+const Lfloat* LEAF_getExpDecayTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->expDecay : NULL;
+}
+
+const Lfloat* LEAF_getAttackDecayIncTable(LEAF* const leaf)
+{
+    return (leaf->tables != NULL) ? leaf->tables->attackDecayInc : NULL;
+}
+#endif
+
+// Like the const 48k and 96k pair, there is a table at the LEAF sample rate and one
+// at twice it, and filters move to the second at the same ratio of switchRate to 48k.
+const Lfloat* LEAF_getFilterTanTable(LEAF* const leaf, Lfloat sampleRate, Lfloat switchRate)
+{
+    if (leaf->tables == NULL) return NULL;
+    int k = (sampleRate > leaf->sampleRate * (switchRate / 48000.0f)) ? 1 : 0;
+    return leaf->tables->filterTan[k];
+}
+
+// Runs on the owning thread with audio stopped, like the rest of LEAF_setSampleRate(),
+// and rebuilds the filter tables in place so a rate change doesn't allocate.
+void leaf_tables_setSampleRate(LEAF* const leaf, Lfloat sampleRate)
+{
+    struct _tLeafTables* tables = leaf->tables;
+    if (tables == NULL) return;
+    for (int k = 0; k < 2; k++)
+    {
+        if (tables->filterTan[k] != NULL)
+            leaf_fillFilterTan(tables->filterTan[k], sampleRate * (k + 1));
+    }
+}
+
+#else
+
+#if LEAF_INCLUDE_SINE_TABLE
+const Lfloat* LEAF_getSineTable(LEAF* const leaf)
+{
+    return __leaf_table_sinewave;
+}
+#endif
+
+#if LEAF_INCLUDE_TRIANGLE_TABLE
+const Lfloat* LEAF_getTriangleTable(LEAF* const leaf)
+{
+    return &__leaf_table_triangle[0][0];
+}
+#endif
+
+#if LEAF_INCLUDE_SQUARE_TABLE
+const Lfloat* LEAF_getSquareTable(LEAF* const leaf)
+{
+    return &__leaf_table_squarewave[0][0];
+}
+#endif
+
+#if LEAF_INCLUDE_SAWTOOTH_TABLE
+const Lfloat* LEAF_getSawtoothTable(LEAF* const leaf)
+{
+    return &__leaf_table_sawtooth[0][0];
+}
+#endif
+
+#if LEAF_INCLUDE_ADSR_TABLES
+const Lfloat* LEAF_getExpDecayTable(LEAF* const leaf)
+{
+    return __leaf_table_exp_decay;
+}
+
+const Lfloat* LEAF_getAttackDecayIncTable(LEAF* const leaf)
+{
+    return __leaf_table_attack_decay_inc;
+}
+#endif
+
+const Lfloat* LEAF_getFilterTanTable(LEAF* const leaf, Lfloat sampleRate, Lfloat switchRate)
+{
+    if (sampleRate > switchRate) return __filterTanhTable_96000;
+    return __filterTanhTable_48000;
+}
+
+#endif // LEAF_GENERATE_TABLES
+
+//==============================================================================
+
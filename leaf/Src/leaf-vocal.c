@@ -147,6 +147,14 @@ void glottis_initToPool(glottis* const glo, tMempool* const mp)
     glottis_setup_waveform(&glot);
 }
 
+// Restart the waveform from the top of a cycle
+void glottis_clear(glottis* const glo)
+{
+	_glottis* glot = *glo;
+	glot->time_in_waveform = 0;
+	glottis_setup_waveform(&glot);
+}
+
 void glottis_free(glottis* const glo)
 {
 	_glottis* glot = *glo;
@@ -486,6 +494,46 @@ void tract_newLength(tract* const t, int numTractSections)
 
 }
 
+// Zero the travelling waves, noise filters and transients, and settle the tract
+// on its target shape so it doesn't glide in from where it was
+void tract_clear(tract* const t)
+{
+    _tract* tr = *t;
+    for (int i = 0; i < tr->n; i++) tr->diameter[i] = tr->target_diameter[i];
+    tr->nose_diameter[0] = tr->velum_target;
+    tr->noseA[0] = tr->nose_diameter[0] * tr->nose_diameter[0];
+    // twice, so the reflections interpolated from match the ones interpolated to
+    tract_calculate_reflections(&tr);
+    tract_calculate_reflections(&tr);
+    tr->last_obstruction = -1;
+    
+    for (int i = 0; i < tr->maxNumTractSections; i++)
+    {
+        tr->R[i] = 0.0f;
+        tr->L[i] = 0.0f;
+        tr->noseR[i] = 0.0f;
+        tr->noseL[i] = 0.0f;
+    }
+    for (int i = 0; i < tr->maxNumTractSections + 1; i++)
+    {
+        tr->junction_outR[i] = 0.0f;
+        tr->junction_outL[i] = 0.0f;
+        tr->nose_junc_outR[i] = 0.0f;
+        tr->nose_junc_outL[i] = 0.0f;
+    }
+    tr->lip_output = 0.0f;
+    tr->nose_output = 0.0f;
+    
+    tSVF_clear(&tr->fricativeNoiseFilt[0]);
+    tSVF_clear(&tr->fricativeNoiseFilt[1]);
+    tSVF_clear(&tr->aspirationNoiseFilt);
+    
+    tr->tpool->size = 0;
+    tr->tpool->next_free = 0;
+    tr->tpool->root = NULL;
+    for (int i = 0; i < MAX_TRANSIENTS; i++) tr->tpool->pool[i]->is_free = 1;
+}
+
 void tract_reshape(tract* const t)
 {
 	_tract* tr = *t;
@@ -762,6 +810,7 @@ void    tVoc_initToPool   (tVoc* const voc, int numTractSections, int maxNumTrac
 	_tMempool* m = *mp;
 	_tVoc* v = *voc = (_tVoc*) mpool_alloc(sizeof(_tVoc), m);
 	v->mempool = m;
+	LEAF_registerObject(v->mempool, &v->node, v, (LEAFSampleRateFunc) tVoc_setSampleRate, (LEAFClearFunc) tVoc_clear);
 	glottis_initToPool(&v->glot, &m); /* initialize glottis */
 	tract_initToPool(&v->tr, numTractSections, maxNumTractSections, &m); /* initialize vocal tract */
 	v->counter = 0;
@@ -772,6 +821,7 @@ void    tVoc_free         (tVoc* const voc)
 	glottis_free(&v->glot);
 	tract_free(&v->tr);
 	//mpool_free((char*)v->buf, v->mempool);
+	LEAF_unregisterObject(v->mempool, &v->node);
 	mpool_free((char*)v, v->mempool);
 }
 
@@ -845,6 +895,14 @@ void    tVoc_setSampleRate(tVoc* const voc, Lfloat sr)
 	v->sampleRate = sr;
 }
 
+void    tVoc_clear(tVoc* const voc)
+{
+	_tVoc* v = *voc;
+	glottis_clear(&v->glot);
+	tract_clear(&v->tr);
+	v->counter = 0;
+}
+
 void    tVoc_setFreq      (tVoc* const voc, Lfloat freq)
 {
 	_tVoc* v = *voc;
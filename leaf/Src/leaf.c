@@ -18,6 +18,15 @@
 
 #endif
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LEAF_DENORMAL_SSE 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define LEAF_DENORMAL_FPCR 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__arm__) && defined(__ARM_FP)
+#define LEAF_DENORMAL_FPSCR 1
+#endif
+
 void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfloat(*random)(void))
 {
     leaf->_internal_mempool.leaf = leaf;
@@ -41,6 +50,44 @@ void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfl
     leaf->allocCount = 0;
     
     leaf->freeCount = 0;
+    
+    leaf->tables = NULL;
+#if LEAF_GENERATE_TABLES
+    leaf_tables_init(leaf);
+#endif
+}
+
+static void leaf_poolSetSampleRate(_tMempool* pool, Lfloat sampleRate)
+{
+    // next is read first in case the callback frees its own node,
+    // as tWaveTable does with the filter it builds its tables with
+    LEAFObjectNode* node = pool->objects;
+    while (node != NULL)
+    {
+        LEAFObjectNode* next = node->next;
+        if (node->setSampleRate != NULL)
+        {
+            void* object = node->object;
+            node->setSampleRate(&object, sampleRate);
+        }
+        node = next;
+    }
+    for (_tMempool* child = pool->children; child != NULL; child = child->nextSibling)
+        leaf_poolSetSampleRate(child, sampleRate);
+}
+
+static void leaf_poolClear(_tMempool* pool)
+{
+    for (LEAFObjectNode* node = pool->objects; node != NULL; node = node->next)
+    {
+        if (node->clear != NULL)
+        {
+            void* object = node->object;
+            node->clear(&object);
+        }
+    }
+    for (_tMempool* child = pool->children; child != NULL; child = child->nextSibling)
+        leaf_poolClear(child);
 }
 
 void LEAF_setSampleRate(LEAF* const leaf, Lfloat sampleRate)
@@ -48,6 +95,37 @@ void LEAF_setSampleRate(LEAF* const leaf, Lfloat sampleRate)
     leaf->sampleRate = sampleRate;
     leaf->invSampleRate = 1.0f/sampleRate;
     leaf->twoPiTimesInvSampleRate = leaf->invSampleRate * TWO_PI;
+    
+#if LEAF_GENERATE_TABLES
+    leaf_tables_setSampleRate(leaf, sampleRate);
+#endif
+    leaf_poolSetSampleRate(&leaf->_internal_mempool, sampleRate);
+}
+
+void LEAF_clearObjects(LEAF* const leaf)
+{
+    leaf_poolClear(&leaf->_internal_mempool);
+}
+
+void LEAF_registerObject(_tMempool* const pool, LEAFObjectNode* const node, void* object,
+                         LEAFSampleRateFunc setSampleRate, LEAFClearFunc clear)
+{
+    node->object = object;
+    node->setSampleRate = setSampleRate;
+    node->clear = clear;
+    node->prev = NULL;
+    node->next = pool->objects;
+    if (pool->objects != NULL) pool->objects->prev = node;
+    pool->objects = node;
+}
+
+void LEAF_unregisterObject(_tMempool* const pool, LEAFObjectNode* const node)
+{
+    if (node->prev != NULL) node->prev->next = node->next;
+    else if (pool->objects == node) pool->objects = node->next;
+    if (node->next != NULL) node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
 }
 
 Lfloat LEAF_getSampleRate(LEAF* const leaf)
@@ -71,3 +149,39 @@ void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFE
 {
     leaf->errorCallback = callback;
 }
+
+void LEAF_enterDenormalScope(LEAFDenormalScope* const scope)
+{
+#if LEAF_DENORMAL_SSE
+    unsigned int csr = _mm_getcsr();
+    scope->savedState = csr;
+    _mm_setcsr(csr | 0x8040); // FTZ (bit 15) and DAZ (bit 6)
+#elif LEAF_DENORMAL_FPCR
+    uint64_t fpcr;
+    __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+    scope->savedState = fpcr;
+    fpcr |= (1ULL << 24); // FZ, which flushes both inputs and results
+    __asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+#elif LEAF_DENORMAL_FPSCR
+    uint32_t fpscr;
+    __asm__ __volatile__ ("vmrs %0, fpscr" : "=r" (fpscr));
+    scope->savedState = fpscr;
+    fpscr |= (1UL << 24); // FZ
+    __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (fpscr));
+#else
+    scope->savedState = 0;
+#endif
+}
+
+void LEAF_exitDenormalScope(LEAFDenormalScope* const scope)
+{
+#if LEAF_DENORMAL_SSE
+    _mm_setcsr((unsigned int) scope->savedState);
+#elif LEAF_DENORMAL_FPCR
+    uint64_t fpcr = scope->savedState;
+    __asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+#elif LEAF_DENORMAL_FPSCR
+    uint32_t fpscr = (uint32_t) scope->savedState;
+    __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (fpscr));
+#endif
+}
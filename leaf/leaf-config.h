@@ -54,10 +54,34 @@
 //! Include tables for minblep insertion, required for all tMB objects.
 #define LEAF_INCLUDE_MINBLEP_TABLES 1
 
+//! Build the sine, triangle, square and sawtooth wavetables, the tADSR/tEnvelope tables and the filter cutoff tables at runtime instead of linking the const arrays from leaf-tables.c. LEAF_init() builds them into the LEAF mempool on the calling thread, so objects initialized later from an arena on another thread only read them. The LEAF_INCLUDE_ flags above still choose which wavetables and envelope tables exist, about 90 KB for each wavetable set and 512 KB for the envelope tables, so size the mempool for them. The filter tables are computed for the LEAF sample rate and twice it rather than fixed at 48k and 96k, and LEAF_setSampleRate() rebuilds them in place. The FIR and minBLEP tables don't depend on sample rate and are always linked.
+#ifndef LEAF_GENERATE_TABLES
+#define LEAF_GENERATE_TABLES 0
+#endif
+
+//! Skip the per-object clamps that zero out tiny values to avoid denormals. Safe when all processing happens inside LEAF_enterDenormalScope().
 #define LEAF_NO_DENORMAL_CHECK 0
 
 #define LEAF_USE_CMSIS 0
 
+//! Report LEAFMempoolWrongThread when an arena claimed with tMempool_claim() is allocated from or freed to by another thread. Needs thread-local storage, so it defaults to on only for debug builds on desktop platforms.
+#ifndef LEAF_CHECK_MEMPOOL_OWNER
+#if !defined(NDEBUG) && (defined(_WIN32) || defined(__APPLE__) || defined(__linux__))
+#define LEAF_CHECK_MEMPOOL_OWNER 1
+#else
+#define LEAF_CHECK_MEMPOOL_OWNER 0
+#endif
+#endif
+
+//! Let tBlockGraph run nodes on worker threads. Needs pthreads or Win32 threads, so it defaults to on only for desktop platforms; without it tBlockGraph runs every node on the calling thread in dependency order.
+#ifndef LEAF_USE_THREADS
+#if defined(_WIN32) || defined(__APPLE__) || defined(__linux__)
+#define LEAF_USE_THREADS 1
+#else
+#define LEAF_USE_THREADS 0
+#endif
+#endif
+
 #ifdef __cplusplus
 //! Use stdlib malloc() and free() internally instead of LEAF's normal mempool behavior for when you want to avoid being limited to and managing mempool a fixed mempool size. Usage of all object remains essentially the same.
 
@@ -70,13 +94,12 @@
 #define _CONSTANT_DATA_LOCATION
 #endif
 
+//! Build the lane-parallel objects (tPolyPBSaw, tPolySVF, tPolyADSRS), which run one voice per lane of a poly_float. Lfloat stays a scalar float, so the rest of LEAF is unchanged in this mode.
 #ifdef SIMD_64
-#include "leaf_polyvalues.h"
-#define Lfloat poly_float
+#include "./Inc/leaf_polyvalues.h"
+#endif
 
-#else
 #define Lfloat float
-#endif
 
 //==============================================================================
 
@@ -52,6 +52,7 @@
 #include ".\Inc\leaf-physical.h"
 #include ".\Inc\leaf-electrical.h"
 #include ".\Inc\leaf-vocal.h"
+#include ".\Inc\leaf-graph.h"
 
 #else
 
@@ -74,6 +75,7 @@
 #include "./Inc/leaf-physical.h"
 #include "./Inc/leaf-electrical.h"
 #include "./Inc/leaf-vocal.h"
+#include "./Inc/leaf-graph.h"
 
 #endif
 
@@ -125,6 +127,8 @@
  @brief String models and more.
  @defgroup electrical Electrical Models
  @brief Circuit models.
+ @defgroup graph Graph
+ @brief Parallel block processing and parameter handoff to the audio thread.
  @defgroup mempool Mempool
  @brief Memory allocation.
  @defgroup math Math
@@ -151,8 +155,9 @@ extern "C" {
      */
     void        LEAF_init            (LEAF* const leaf, Lfloat sampleRate, char* memory, size_t memorySize, Lfloat(*random)(void));
     
-    //! Set the sample rate of LEAF.
+    //! Set the sample rate of LEAF and of every object registered to it.
     /*!
+     Reaches the objects in the default mempool and in every mempool and arena made from it. Within a mempool, objects are updated newest first, so an object that owns others runs after them and can set them to its own rate, as the oversampled string models do. Objects that rebuild tables on a rate change, like tWaveTable, allocate from their mempool here, so call this from the thread that owns the LEAF instance while audio is stopped and no other thread is using an arena.
      @param sampleRate The new audio sample rate.
      */
     void        LEAF_setSampleRate   (LEAF* const leaf, Lfloat sampleRate);
@@ -177,6 +182,25 @@ extern "C" {
      */
     void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFErrorType));
     
+    //! Reset the signal state of every registered object that has a clear function.
+    /*!
+     Clears delay lines, filter and reverb state and the like, leaving parameters as they are.
+     */
+    void        LEAF_clearObjects    (LEAF* const leaf);
+    
+    //! Turn on flush-to-zero and denormals-are-zero for the calling thread, saving the previous mode in scope.
+    /*!
+     Call at the start of each audio block and pair with LEAF_exitDenormalScope() at the end. Inside the scope, recursive filters, reverbs and waveguides decaying towards silence stay at full speed instead of slowing down on denormal values. Scopes can be nested. Sets MXCSR on x86 with SSE, and FPCR or FPSCR on ARM with a hardware FPU; elsewhere it does nothing.
+     @param scope Where to save the floating point state.
+     */
+    void        LEAF_enterDenormalScope  (LEAFDenormalScope* const scope);
+    
+    //! Restore the floating point mode saved by the matching LEAF_enterDenormalScope().
+    /*!
+     @param scope The state saved on entry.
+     */
+    void        LEAF_exitDenormalScope   (LEAFDenormalScope* const scope);
+    
     /*! @} */
     
 #ifdef __cplusplus
@@ -0,0 +1,150 @@
+/*==============================================================================
+
+ leaf-math-bench.c
+
+ Accuracy and speed of the LEAF_*_array block functions in leaf-math.h,
+ measured against double precision libm and against the scalar functions
+ they replace. Exits with 1 if any function exceeds the error bound
+ documented in leaf-math.h.
+
+ Build and run from this directory, for example:
+
+    cc -O2 -I../leaf -I../leaf/Inc leaf-math-bench.c ../leaf/Src/leaf-math.c ../tests/leaf-test-tables.c -lm -o leaf-math-bench
+    ./leaf-math-bench
+
+ ../tests/leaf-test-tables.c stands in for leaf-tables.c, which this tree
+ doesn't carry. None of the functions measured here read its tables.
+
+ Add -mavx to measure the AVX backend, or -DLEAF_POLY_NO_SIMD for the plain C
+ one.
+
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "leaf-math.h"
+#include "leaf_polyvalues.h"
+
+#define BENCH_SIZE 4096
+#define BENCH_SPEED_SAMPLES 20000000
+
+typedef void (*ArrayFunc)(const Lfloat* in, Lfloat* out, int n);
+typedef Lfloat (*ScalarFunc)(Lfloat x);
+typedef double (*ReferenceFunc)(double x);
+
+typedef struct BenchCase
+{
+    const char* name;
+    ArrayFunc array;
+    ScalarFunc scalar;
+    const char* scalarName;
+    ReferenceFunc reference;
+    double lo, hi;
+    double bound;
+    int relative;
+} BenchCase;
+
+static double ref_exp2(double x) { return exp2(x); }
+static double ref_mtof(double x) { return 440.0 * exp2((x - 69.0) / 12.0); }
+static double ref_dbtoa(double x) { return pow(10.0, x / 20.0); }
+static double ref_tanh(double x) { return tanh(x); }
+static double ref_sin(double x) { return sin(x); }
+
+static Lfloat scalar_exp2(Lfloat x) { return exp2f(x); }
+static Lfloat scalar_mtof(Lfloat x) { return mtof(x); }
+static Lfloat scalar_dbtoa(Lfloat x) { return dbtoa(x); }
+static Lfloat scalar_tanh(Lfloat x) { return tanhf(x); }
+static Lfloat scalar_fast_tanh(Lfloat x) { return fast_tanh(x); }
+static Lfloat scalar_sin(Lfloat x) { return sinf(x); }
+
+static const BenchCase cases[] =
+{
+    { "exp2",      LEAF_exp2_array,      scalar_exp2,      "exp2f",     ref_exp2,  -126.0, 127.0,  2.5e-7, 1 },
+    { "mtof",      LEAF_mtof_array,      scalar_mtof,      "mtof",      ref_mtof,  -1400.0, 1400.0, 4.0e-6, 1 },
+    { "dbtoa",     LEAF_dbtoa_array,     scalar_dbtoa,     "dbtoa",     ref_dbtoa, -700.0, 700.0,  3.5e-6, 1 },
+    { "tanh",      LEAF_tanh_array,      scalar_tanh,      "tanhf",     ref_tanh,  -20.0, 20.0,    1.5e-7, 0 },
+    { "fast_tanh", LEAF_fast_tanh_array, scalar_fast_tanh, "fast_tanh", ref_tanh,  -8.0, 8.0,      1.0e-4, 0 },
+    { "sin",       LEAF_sin_array,       scalar_sin,       "sinf",      ref_sin,   -1.0e4, 1.0e4,  3.0e-7, 0 },
+};
+
+static Lfloat in[BENCH_SIZE];
+static Lfloat out[BENCH_SIZE];
+static volatile Lfloat sink;
+
+// Largest error over a dense sweep of [lo, hi]
+static double benchError(const BenchCase* c)
+{
+    const int steps = 1 << 22;
+    double maxError = 0.0;
+    
+    for (int start = 0; start < steps; start += BENCH_SIZE)
+    {
+        for (int i = 0; i < BENCH_SIZE; i++)
+            in[i] = (Lfloat) (c->lo + (c->hi - c->lo) * (double) (start + i) / (double) (steps - 1));
+        c->array(in, out, BENCH_SIZE);
+        
+        for (int i = 0; i < BENCH_SIZE; i++)
+        {
+            double expected = c->reference((double) in[i]);
+            double error = fabs((double) out[i] - expected);
+            if (c->relative) error /= fabs(expected);
+            if (error > maxError) maxError = error;
+        }
+    }
+    return maxError;
+}
+
+static double benchSeconds(clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Nanoseconds per sample for the array function and for a loop over the scalar one
+static void benchSpeed(const BenchCase* c, double* arrayNs, double* scalarNs)
+{
+    const int blocks = BENCH_SPEED_SAMPLES / BENCH_SIZE;
+    
+    for (int i = 0; i < BENCH_SIZE; i++)
+        in[i] = (Lfloat) (c->lo + (c->hi - c->lo) * (double) i / (double) (BENCH_SIZE - 1)) * 0.25f;
+    
+    clock_t start = clock();
+    for (int b = 0; b < blocks; b++)
+    {
+        c->array(in, out, BENCH_SIZE);
+        sink = out[b & (BENCH_SIZE - 1)];
+    }
+    *arrayNs = benchSeconds(start) * 1.0e9 / ((double) blocks * BENCH_SIZE);
+    
+    start = clock();
+    for (int b = 0; b < blocks; b++)
+    {
+        for (int i = 0; i < BENCH_SIZE; i++) out[i] = c->scalar(in[i]);
+        sink = out[b & (BENCH_SIZE - 1)];
+    }
+    *scalarNs = benchSeconds(start) * 1.0e9 / ((double) blocks * BENCH_SIZE);
+}
+
+int main(void)
+{
+    int failed = 0;
+    
+    printf("%d lanes\n\n", POLY_FLOAT_LANES);
+    printf("%-10s %12s %10s %6s %10s %10s %s\n", "function", "max error", "bound", "", "ns/sample", "scalar", "");
+    
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        double error = benchError(&cases[c]);
+        int pass = error <= cases[c].bound;
+        if (!pass) failed = 1;
+        
+        double arrayNs, scalarNs;
+        benchSpeed(&cases[c], &arrayNs, &scalarNs);
+        
+        printf("%-10s %12.3g %10.3g %6s %10.2f %10.2f (%s)\n", cases[c].name, error, cases[c].bound,
+               pass ? "ok" : "FAIL", arrayNs, scalarNs, cases[c].scalarName);
+    }
+    
+    return failed;
+}
@@ -0,0 +1,107 @@
+/*==============================================================================
+
+ leaf-tablegen-test.c
+
+ Checks the tables LEAF_GENERATE_TABLES builds: every octave of the square
+ table starts with its positive half-cycle, as tTriangle and tCycle do, and
+ tSquare plays it that way; and changing the sample rate under live filters
+ reuses the generated cutoff tables instead of allocating new ones. Exits
+ with 1 on a failure.
+
+ Build and run from this directory, for example:
+
+    cc -O1 -fsanitize=address -DLEAF_GENERATE_TABLES=1 -ffunction-sections -fdata-sections -Wl,--gc-sections \
+       -I../leaf -I../leaf/Inc leaf-tablegen-test.c leaf-test-tables.c ../leaf/Src/leaf*.c ../leaf/Externals/d_fft_mayer.c \
+       -lm -o leaf-tablegen-test
+    ./leaf-tablegen-test
+
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "leaf.h"
+
+#define TEST_MEMORY_SIZE 4000000
+
+static char memory[TEST_MEMORY_SIZE];
+
+static Lfloat testRandom(void)
+{
+    return (Lfloat) rand() / (Lfloat) RAND_MAX;
+}
+
+static int checkSquarePolarity(LEAF* leaf)
+{
+    int failed = 0;
+    const Lfloat* table = LEAF_getSquareTable(leaf);
+    for (int k = 0; k < 11; k++)
+    {
+        const Lfloat* t = &table[k * SQR_TABLE_SIZE];
+        Lfloat first = 0.0f, second = 0.0f;
+        for (int i = 0; i < SQR_TABLE_SIZE / 2; i++)
+        {
+            first += t[i];
+            second += t[i + SQR_TABLE_SIZE / 2];
+        }
+        if (first <= 0.0f || second >= 0.0f)
+        {
+            printf("square octave %d: first half sums to %f, second to %f\n", k, first, second);
+            failed = 1;
+        }
+    }
+
+    // 100 Hz at 48k is 480 samples a cycle
+    tSquare square;
+    tSquare_init(&square, leaf);
+    tSquare_setFreq(&square, 100.0f);
+    Lfloat first = 0.0f, second = 0.0f;
+    for (int i = 0; i < 240; i++) first += tSquare_tick(&square);
+    for (int i = 0; i < 240; i++) second += tSquare_tick(&square);
+    tSquare_free(&square);
+    if (first <= 0.0f || second >= 0.0f)
+    {
+        printf("tSquare: first half-cycle sums to %f, second to %f\n", first, second);
+        failed = 1;
+    }
+
+    if (!failed) printf("square polarity OK\n");
+    return failed;
+}
+
+static int checkFilterTables(LEAF* leaf)
+{
+    tSVF svf;
+    tSVF svf2x;
+    tSVF_init(&svf, SVFTypeLowpass, 1000.0f, 0.7f, leaf);
+    tSVF_init(&svf2x, SVFTypeLowpass, 1000.0f, 0.7f, leaf);
+    tSVF_setSampleRate(&svf2x, leaf->sampleRate * 2.0f);
+
+    const Lfloat rates[] = { 44100.0f, 96000.0f, 22050.0f, 192000.0f, 48000.0f };
+    unsigned int allocs = leaf->allocCount;
+    for (int n = 0; n < 10; n++)
+    {
+        for (int i = 0; i < (int) (sizeof(rates) / sizeof(rates[0])); i++)
+        {
+            LEAF_setSampleRate(leaf, rates[i]);
+            tSVF_setSampleRate(&svf2x, rates[i] * 2.0f);
+        }
+    }
+    int failed = leaf->allocCount != allocs;
+    if (failed) printf("filter tables: %u allocations over 50 rate changes\n", (unsigned) (leaf->allocCount - allocs));
+    else printf("filter tables reused OK\n");
+
+    tSVF_free(&svf2x);
+    tSVF_free(&svf);
+    return failed;
+}
+
+int main(void)
+{
+    LEAF leaf;
+    LEAF_init(&leaf, 48000.0f, memory, TEST_MEMORY_SIZE, &testRandom);
+
+    int failed = checkSquarePolarity(&leaf);
+    failed |= checkFilterTables(&leaf);
+    return failed;
+}
@@ -0,0 +1,49 @@
+/*==============================================================================
+
+ leaf-test-tables.c
+
+ Stand-ins for the const tables in leaf-tables.c, which this tree doesn't
+ carry, so the tests and mathbench link. Build the library with
+ -DLEAF_GENERATE_TABLES=1 so objects use generated wavetables, envelope and
+ filter tables, and link with -ffunction-sections -fdata-sections
+ -Wl,--gc-sections so unused table references drop out.
+
+ The oversampler FIR tables are pass-through impulses, and the sine and
+ minBLEP tables are silent. Anything tested against these only checks bookkeeping, not
+ filtering or band-limiting.
+
+ ==============================================================================*/
+
+#include "leaf-tables.h"
+
+const Lfloat __leaf_table_fir2XLow[32] = { 1.0f };
+const Lfloat __leaf_table_fir4XLow[64] = { 1.0f };
+const Lfloat __leaf_table_fir8XLow[64] = { 1.0f };
+const Lfloat __leaf_table_fir16XLow[128] = { 1.0f };
+const Lfloat __leaf_table_fir32XLow[256] = { 1.0f };
+const Lfloat __leaf_table_fir64XLow[256] = { 1.0f };
+const Lfloat __leaf_table_fir2XHigh[128] = { 1.0f };
+const Lfloat __leaf_table_fir4XHigh[256] = { 1.0f };
+const Lfloat __leaf_table_fir8XHigh[256] = { 1.0f };
+const Lfloat __leaf_table_fir16XHigh[512] = { 1.0f };
+const Lfloat __leaf_table_fir32XHigh[512] = { 1.0f };
+const Lfloat __leaf_table_fir64XHigh[1024] = { 1.0f };
+
+const Lfloat* __leaf_tableref_firCoeffs[COEFFS_SIZE] =
+{
+    __leaf_table_fir2XLow, __leaf_table_fir4XLow, __leaf_table_fir8XLow,
+    __leaf_table_fir16XLow, __leaf_table_fir32XLow, __leaf_table_fir64XLow,
+    __leaf_table_fir2XHigh, __leaf_table_fir4XHigh, __leaf_table_fir8XHigh,
+    __leaf_table_fir16XHigh, __leaf_table_fir32XHigh, __leaf_table_fir64XHigh
+};
+
+const uint_fast16_t __leaf_tablesize_firNumTaps[COEFFS_SIZE] =
+{
+    32, 64, 64, 128, 256, 256,
+    128, 256, 256, 512, 512, 1024
+};
+
+const Lfloat __leaf_table_sinewave[SINE_TABLE_SIZE];
+
+const Lfloat_value_delta step_dd_table[MINBLEP_PHASES * STEP_DD_PULSE_LENGTH + 1];
+const Lfloat slope_dd_table[MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH + 1];
@@ -0,0 +1,109 @@
+/*==============================================================================
+
+ leaf-wavetable-test.c
+
+ Changes the LEAF sample rate under live tWaveOsc and tWaveOscS oscillators
+ and checks that each oscillator's octave count matches the tables rebuilt
+ for the new rate, then ticks them at the top of their range. Exits with 1
+ on a mismatch. Build with -fsanitize=address to also catch reads past the
+ end of the table arrays.
+
+ Build and run from this directory, for example:
+
+    cc -O1 -fsanitize=address -DLEAF_GENERATE_TABLES=1 -ffunction-sections -fdata-sections -Wl,--gc-sections \
+       -I../leaf -I../leaf/Inc leaf-wavetable-test.c leaf-test-tables.c ../leaf/Src/leaf*.c ../leaf/Externals/d_fft_mayer.c \
+       -lm -o leaf-wavetable-test
+    ./leaf-wavetable-test
+
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "leaf.h"
+
+#define TEST_MEMORY_SIZE 8000000
+#define TEST_TABLE_SIZE 2048
+
+static char memory[TEST_MEMORY_SIZE];
+
+static Lfloat testRandom(void)
+{
+    return (Lfloat) rand() / (Lfloat) RAND_MAX;
+}
+
+static int checkRate(tWaveOsc* osc, tWaveTable* tables, tWaveOscS* oscS, tWaveTableS* tablesS, LEAF* leaf, Lfloat sampleRate)
+{
+    LEAF_setSampleRate(leaf, sampleRate);
+
+    int failed = 0;
+    if ((*osc)->numSubTables != tables[0]->numTables)
+    {
+        printf("tWaveOsc  at %6.0f Hz: %d octaves, tables have %d\n", sampleRate, (*osc)->numSubTables, tables[0]->numTables);
+        failed = 1;
+    }
+    if ((*oscS)->numSubTables != tablesS[0]->numTables)
+    {
+        printf("tWaveOscS at %6.0f Hz: %d octaves, tables have %d\n", sampleRate, (*oscS)->numSubTables, tablesS[0]->numTables);
+        failed = 1;
+    }
+
+    // the highest octave reads the table above it
+    tWaveOsc_setFreq(osc, sampleRate * 0.45f);
+    tWaveOscS_setFreq(oscS, sampleRate * 0.45f);
+    Lfloat sum = 0.0f;
+    for (int i = 0; i < 256; i++)
+        sum += tWaveOsc_tick(osc) + tWaveOscS_tick(oscS);
+    if (!isfinite(sum))
+    {
+        printf("non-finite output at %6.0f Hz\n", sampleRate);
+        failed = 1;
+    }
+
+    if (!failed) printf("%6.0f Hz: %d and %d octaves OK\n", sampleRate, tables[0]->numTables, tablesS[0]->numTables);
+    return failed;
+}
+
+int main(void)
+{
+    LEAF leaf;
+    LEAF_init(&leaf, 48000.0f, memory, TEST_MEMORY_SIZE, &testRandom);
+
+    Lfloat saw[TEST_TABLE_SIZE];
+    Lfloat square[TEST_TABLE_SIZE];
+    for (int i = 0; i < TEST_TABLE_SIZE; i++)
+    {
+        saw[i] = 2.0f * (Lfloat) i / (Lfloat) TEST_TABLE_SIZE - 1.0f;
+        square[i] = (i < TEST_TABLE_SIZE / 2) ? 1.0f : -1.0f;
+    }
+
+    // tables first, as an application would, so the registry reaches the oscillators before them
+    tWaveTable tables[2];
+    tWaveTableS tablesS[2];
+    tWaveTable_init(&tables[0], saw, TEST_TABLE_SIZE, 20000.0f, &leaf);
+    tWaveTable_init(&tables[1], square, TEST_TABLE_SIZE, 20000.0f, &leaf);
+    tWaveTableS_init(&tablesS[0], saw, TEST_TABLE_SIZE, 20000.0f, &leaf);
+    tWaveTableS_init(&tablesS[1], square, TEST_TABLE_SIZE, 20000.0f, &leaf);
+    tWaveOsc osc;
+    tWaveOscS oscS;
+    tWaveOsc_init(&osc, tables, 2, &leaf);
+    tWaveOscS_init(&oscS, tablesS, 2, &leaf);
+    tWaveOsc_setIndex(&osc, 0.5f);
+    tWaveOscS_setIndex(&oscS, 0.5f);
+
+    const Lfloat rates[] = { 192000.0f, 44100.0f, 96000.0f, 22050.0f, 48000.0f };
+    int failed = 0;
+    for (int i = 0; i < (int) (sizeof(rates) / sizeof(rates[0])); i++)
+        failed |= checkRate(&osc, tables, &oscS, tablesS, &leaf, rates[i]);
+
+    tWaveOscS_free(&oscS);
+    tWaveOsc_free(&osc);
+    for (int i = 0; i < 2; i++)
+    {
+        tWaveTableS_free(&tablesS[i]);
+        tWaveTable_free(&tables[i]);
+    }
+
+    return failed;
+}